@@ -0,0 +1,92 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <absl/flags/flag.h>
+#include <absl/flags/parse.h>
+#include <absl/flags/usage.h>
+#include <nlohmann/json.hpp>
+#include <silkworm/common/util.hpp>
+
+#include <silkrpc/ethdb/cbor.hpp>
+#include <silkrpc/json/types.hpp>
+#include <silkrpc/types/log.hpp>
+
+ABSL_FLAG(uint32_t, logs, 64, "number of logs in each CBOR-encoded chunk as integer");
+ABSL_FLAG(uint32_t, topics, 3, "number of topics in each log as integer");
+ABSL_FLAG(uint32_t, data_size, 64, "size of data in each log as integer");
+ABSL_FLAG(uint32_t, iterations, 10000, "number of decoding iterations as integer");
+
+// Build a CBOR chunk of logs using the same layout as Erigon kLogs values: array of [address, [topics...], data]
+silkworm::Bytes make_logs_cbor(uint32_t num_logs, uint32_t num_topics, uint32_t data_size) {
+    auto logs = nlohmann::json::array();
+    for (uint32_t i{0}; i < num_logs; i++) {
+        auto topics = nlohmann::json::array();
+        for (uint32_t t{0}; t < num_topics; t++) {
+            topics.push_back(nlohmann::json::binary(std::vector<std::uint8_t>(32, static_cast<std::uint8_t>(i + t))));
+        }
+        logs.push_back(nlohmann::json::array({
+            nlohmann::json::binary(std::vector<std::uint8_t>(20, static_cast<std::uint8_t>(i))),
+            topics,
+            nlohmann::json::binary(std::vector<std::uint8_t>(data_size, static_cast<std::uint8_t>(i))),
+        }));
+    }
+    const auto cbor = nlohmann::json::to_cbor(logs);
+    return silkworm::Bytes{cbor.begin(), cbor.end()};
+}
+
+template <typename Decode>
+void run_benchmark(const std::string& name, const silkworm::Bytes& cbor, uint32_t iterations, Decode decode) {
+    std::size_t decoded_logs{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i{0}; i < iterations; i++) {
+        decoded_logs += decode(cbor).size();
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto megabytes = static_cast<double>(cbor.size()) * iterations / (1024 * 1024);
+    std::cout << std::left << std::setw(24) << name
+              << " logs: " << decoded_logs
+              << " elapsed: " << std::fixed << std::setprecision(3) << elapsed << "s"
+              << " throughput: " << std::setprecision(2) << megabytes / elapsed << " MB/s\n";
+}
+
+int main(int argc, char* argv[]) {
+    absl::SetProgramUsageMessage("Measure CBOR decoding throughput of logs: streaming decoder vs nlohmann::json::from_cbor");
+    absl::ParseCommandLine(argc, argv);
+
+    const auto cbor = make_logs_cbor(absl::GetFlag(FLAGS_logs), absl::GetFlag(FLAGS_topics), absl::GetFlag(FLAGS_data_size));
+    const auto iterations = absl::GetFlag(FLAGS_iterations);
+    std::cout << "CBOR chunk size: " << cbor.size() << " bytes iterations: " << iterations << "\n";
+
+    run_benchmark("nlohmann::json", cbor, iterations, [](const silkworm::Bytes& bytes) {
+        return nlohmann::json::from_cbor(bytes).get<std::vector<silkrpc::Log>>();
+    });
+    run_benchmark("silkrpc::cbor_decode", cbor, iterations, [](const silkworm::Bytes& bytes) {
+        std::vector<silkrpc::Log> logs;
+        if (!silkrpc::cbor_decode(bytes, logs)) {
+            std::cerr << "cbor_decode failed\n";
+        }
+        return logs;
+    });
+
+    return 0;
+}
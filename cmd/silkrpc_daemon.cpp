@@ -41,6 +41,8 @@ ABSL_FLAG(uint32_t, num_workers, 16, "number of worker threads as 32-bit integer
 ABSL_FLAG(uint32_t, timeout, silkrpc::kDefaultTimeout.count(), "gRPC call timeout as 32-bit integer");
 ABSL_FLAG(silkrpc::LogLevel, log_verbosity, silkrpc::LogLevel::Critical, "logging verbosity level");
 ABSL_FLAG(silkrpc::WaitMode, wait_mode, silkrpc::WaitMode::blocking, "scheduler wait mode");
+ABSL_FLAG(uint32_t, max_batch_in_flight, silkrpc::kDefaultMaxBatchInFlight, "max number of concurrent requests within one batch as 32-bit integer");
+ABSL_FLAG(uint32_t, estimate_gas_probes, silkrpc::kDefaultEstimateGasProbes, "number of gas limits executed concurrently at each eth_estimateGas search step as 32-bit integer");
 
 //! Assemble the application version using the Cable build information
 std::string get_version_from_build_info() {
@@ -100,7 +102,9 @@ silkrpc::DaemonSettings parse_args(int argc, char* argv[]) {
         absl::GetFlag(FLAGS_num_contexts),
         absl::GetFlag(FLAGS_num_workers),
         absl::GetFlag(FLAGS_log_verbosity),
-        absl::GetFlag(FLAGS_wait_mode)
+        absl::GetFlag(FLAGS_wait_mode),
+        absl::GetFlag(FLAGS_max_batch_in_flight),
+        absl::GetFlag(FLAGS_estimate_gas_probes)
     };
 
     return rpc_daemon_settings;
@@ -16,6 +16,7 @@
 
 #include "debug_api.hpp"
 
+#include <exception>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -47,6 +48,7 @@
 #include <silkrpc/core/storage_walker.hpp>
 #include <silkrpc/ethdb/tables.hpp>
 #include <silkrpc/ethdb/transaction_database.hpp>
+#include <silkrpc/json/reply_writer.hpp>
 #include <silkrpc/json/types.hpp>
 #include <silkrpc/types/block.hpp>
 #include <silkrpc/types/call.hpp>
@@ -293,8 +295,9 @@ asio::awaitable<void> DebugRpcApi::handle_debug_trace_transaction(const nlohmann
             oss << "transaction 0x" << transaction_hash << " not found";
             reply = make_json_error(request["id"], -32000, oss.str());
         } else {
-            debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config};
-            const auto result = co_await executor.execute(tx_with_block->block_with_hash.block, tx_with_block->transaction);
+            debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get(),
+                context_.code_cache().get()};
+            const auto result = co_await executor.execute(tx_with_block->block_with_hash->block, tx_with_block->transaction);
 
             if (result.pre_check_error) {
                 reply = make_json_error(request["id"], -32000, result.pre_check_error.value());
@@ -315,6 +318,27 @@ asio::awaitable<void> DebugRpcApi::handle_debug_trace_transaction(const nlohmann
     co_return;
 }
 
+asio::awaitable<void> DebugRpcApi::handle_debug_trace_transaction(const nlohmann::json& request, Writer& writer) {
+    // The structLogs are serialized step by step while the transaction executes: no trace DOM is kept
+    co_await stream_trace_reply(request, writer, [&](const nlohmann::json& params, ethdb::TransactionDatabase& tx_database,
+            debug::DebugExecutor<>& executor, Writer& result_writer) -> asio::awaitable<std::optional<Error>> {
+        const auto transaction_hash = params[0].get<evmc::bytes32>();
+        SILKRPC_DEBUG << "transaction_hash: " << transaction_hash << "\n";
+
+        const auto tx_with_block = co_await core::read_transaction_by_hash(*context_.block_cache(), tx_database, transaction_hash);
+        if (!tx_with_block) {
+            std::ostringstream oss;
+            oss << "transaction 0x" << transaction_hash << " not found";
+            co_return Error{-32000, oss.str()};
+        }
+        const auto pre_check_error = co_await executor.execute(tx_with_block->block_with_hash->block, tx_with_block->transaction, result_writer);
+        if (pre_check_error) {
+            co_return Error{-32000, pre_check_error.value()};
+        }
+        co_return std::nullopt;
+    });
+}
+
 // https://github.com/ethereum/retesteth/wiki/RPC-Methods#debug_tracecall
 asio::awaitable<void> DebugRpcApi::handle_debug_trace_call(const nlohmann::json& request, nlohmann::json& reply) {
     auto params = request["params"];
@@ -340,8 +364,9 @@ asio::awaitable<void> DebugRpcApi::handle_debug_trace_call(const nlohmann::json&
 
         const auto block_with_hash = co_await core::read_block_by_number_or_hash(*context_.block_cache(), tx_database, block_number_or_hash);
 
-        debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config};
-        const auto result = co_await executor.execute(block_with_hash.block, call);
+        debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get(),
+            context_.code_cache().get()};
+        const auto result = co_await executor.execute(block_with_hash->block, call);
 
         if (result.pre_check_error) {
             reply = make_json_error(request["id"], -32000, result.pre_check_error.value());
@@ -388,8 +413,9 @@ asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_number(const nloh
 
         const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
 
-        debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config};
-        const auto debug_traces = co_await executor.execute(block_with_hash.block);
+        debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get(),
+            context_.code_cache().get()};
+        const auto debug_traces = co_await executor.execute(block_with_hash->block);
 
         reply = make_json_content(request["id"], debug_traces);
     } catch (const std::exception& e) {
@@ -407,6 +433,25 @@ asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_number(const nloh
     co_return;
 }
 
+asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_number(const nlohmann::json& request, Writer& writer) {
+    // The traces are serialized step by step while the block executes: no trace DOM is kept
+    co_await stream_trace_reply(request, writer, [&](const nlohmann::json& params, ethdb::TransactionDatabase& tx_database,
+            debug::DebugExecutor<>& executor, Writer& result_writer) -> asio::awaitable<std::optional<Error>> {
+        const auto block_number = params[0].get<std::uint64_t>();
+        SILKRPC_DEBUG << "block_number: " << block_number << "\n";
+
+        // Read errors propagate to the reply as they are, only a missing block is reported as not found
+        const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
+        if (!block_with_hash) {
+            std::ostringstream oss;
+            oss << "block_number " << block_number << " not found";
+            co_return Error{-32000, oss.str()};
+        }
+        co_await executor.execute(block_with_hash->block, result_writer);
+        co_return std::nullopt;
+    });
+}
+
 // https://github.com/ethereum/retesteth/wiki/RPC-Methods#debug_traceblockbyhash
 asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_hash(const nlohmann::json& request, nlohmann::json& reply) {
     auto params = request["params"];
@@ -432,8 +477,9 @@ asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_hash(const nlohma
 
         const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
 
-        debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config};
-        const auto debug_traces = co_await executor.execute(block_with_hash.block);
+        debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get(),
+            context_.code_cache().get()};
+        const auto debug_traces = co_await executor.execute(block_with_hash->block);
 
         reply = make_json_content(request["id"], debug_traces);
     } catch (const std::exception& e) {
@@ -451,6 +497,71 @@ asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_hash(const nlohma
     co_return;
 }
 
+asio::awaitable<void> DebugRpcApi::handle_debug_trace_block_by_hash(const nlohmann::json& request, Writer& writer) {
+    // The traces are serialized step by step while the block executes: no trace DOM is kept
+    co_await stream_trace_reply(request, writer, [&](const nlohmann::json& params, ethdb::TransactionDatabase& tx_database,
+            debug::DebugExecutor<>& executor, Writer& result_writer) -> asio::awaitable<std::optional<Error>> {
+        const auto block_hash = params[0].get<evmc::bytes32>();
+        SILKRPC_DEBUG << "block_hash: " << block_hash << "\n";
+
+        const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
+        if (!block_with_hash) {
+            std::ostringstream oss;
+            oss << "block_hash " << block_hash << " not found";
+            co_return Error{-32000, oss.str()};
+        }
+        co_await executor.execute(block_with_hash->block, result_writer);
+        co_return std::nullopt;
+    });
+}
+
+asio::awaitable<void> DebugRpcApi::stream_trace_reply(const nlohmann::json& request, Writer& writer, const TraceStreamer& streamer) {
+    // The reply opening is deferred to the first result content, so errors raised before it are plain error replies
+    JsonReplyWriter reply_writer{request["id"], writer};
+    auto params = request["params"];
+    if (params.size() < 1) {
+        auto error_msg = "invalid " + request["method"].get<std::string>() + " params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        co_await reply_writer.close(Error{100, error_msg});
+        co_return;
+    }
+
+    debug::DebugConfig config;
+    if (params.size() > 1) {
+        config = params[1].get<debug::DebugConfig>();
+    }
+    SILKRPC_DEBUG << "config: {" << config << "}\n";
+
+    auto tx = co_await database_->begin();
+
+    std::optional<Error> error;
+    try {
+        ethdb::TransactionDatabase tx_database{*tx};
+        debug::DebugExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get(),
+            context_.code_cache().get()};
+        error = co_await streamer(params, tx_database, executor, reply_writer);
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
+        error = Error{100, e.what()};
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
+        error = Error{100, "unexpected exception"};
+    }
+
+    // Writing the reply end may fail as well (e.g. connection closed), but the transaction must be closed anyway
+    std::exception_ptr write_error;
+    try {
+        co_await reply_writer.close(error);
+    } catch (...) {
+        write_error = std::current_exception();
+    }
+
+    co_await tx->close(); // RAII not (yet) available with coroutines
+    if (write_error) {
+        std::rethrow_exception(write_error);
+    }
+}
+
 asio::awaitable<std::set<evmc::address>> get_modified_accounts(ethdb::TransactionDatabase& tx_database, uint64_t start_block_number, uint64_t end_block_number) {
     auto last_block_number = co_await silkrpc::core::get_block_number(silkrpc::core::kLatestBlockId, tx_database);
 
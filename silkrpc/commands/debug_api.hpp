@@ -17,7 +17,9 @@
 #ifndef SILKRPC_COMMANDS_DEBUG_API_HPP_
 #define SILKRPC_COMMANDS_DEBUG_API_HPP_
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <set>
 
 #include <silkrpc/config.hpp> // NOLINT(build/include_order)
@@ -27,7 +29,9 @@
 #include <asio/thread_pool.hpp>
 #include <nlohmann/json.hpp>
 
+#include <silkrpc/common/writer.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
+#include <silkrpc/core/evm_debug.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
 #include <silkrpc/json/types.hpp>
 #include <silkrpc/ethdb/database.hpp>
@@ -54,11 +58,20 @@ protected:
     asio::awaitable<void> handle_debug_get_modified_accounts_by_hash(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_debug_storage_range_at(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_debug_trace_transaction(const nlohmann::json& request, nlohmann::json& reply);
+    asio::awaitable<void> handle_debug_trace_transaction(const nlohmann::json& request, Writer& writer);
     asio::awaitable<void> handle_debug_trace_call(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_debug_trace_block_by_number(const nlohmann::json& request, nlohmann::json& reply);
+    asio::awaitable<void> handle_debug_trace_block_by_number(const nlohmann::json& request, Writer& writer);
     asio::awaitable<void> handle_debug_trace_block_by_hash(const nlohmann::json& request, nlohmann::json& reply);
+    asio::awaitable<void> handle_debug_trace_block_by_hash(const nlohmann::json& request, Writer& writer);
 
 private:
+    using TraceStreamer = std::function<asio::awaitable<std::optional<Error>>(const nlohmann::json& params, ethdb::TransactionDatabase& tx_database,
+        debug::DebugExecutor<>& executor, Writer& writer)>;
+
+    //! Stream the reply of a debug_trace* request: streamer writes the result and returns the error to reply with, if any
+    asio::awaitable<void> stream_trace_reply(const nlohmann::json& request, Writer& writer, const TraceStreamer& streamer);
+
     Context& context_;
     std::unique_ptr<ethdb::Database>& database_;
     std::unique_ptr<txpool::TransactionPool>& tx_pool_;
@@ -126,12 +126,12 @@ asio::awaitable<void> ErigonRpcApi::handle_erigon_get_logs_by_hash(const nlohman
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
-        const auto receipts{co_await core::get_receipts(tx_database, block_with_hash)};
+        const auto receipts{co_await core::get_receipts(*context_.block_cache(), tx_database, *block_with_hash)};
 
-        SILKRPC_DEBUG << "receipts.size(): " << receipts.size() << "\n";
+        SILKRPC_DEBUG << "receipts.size(): " << receipts->size() << "\n";
         std::vector<Log> logs{};
-        logs.reserve(receipts.size());
-        for (const auto receipt : receipts) {
+        logs.reserve(receipts->size());
+        for (const auto& receipt : *receipts) {
             SILKRPC_DEBUG << "receipt.logs.size(): " << receipt.logs.size() << "\n";
             logs.insert(logs.end(), receipt.logs.begin(), receipt.logs.end());
         }
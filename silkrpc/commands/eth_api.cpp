@@ -20,9 +20,11 @@
 #include <cstring>
 #include <exception>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/endian/conversion.hpp>
 #include <evmc/evmc.hpp>
@@ -35,13 +37,16 @@
 #include <silkworm/types/transaction.hpp>
 
 #include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/filter_registry.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/common/util.hpp>
+#include <silkrpc/concurrency/ordered_scan.hpp>
 #include <silkrpc/core/cached_chain.hpp>
 #include <silkrpc/core/blocks.hpp>
 #include <silkrpc/core/evm_executor.hpp>
 #include <silkrpc/core/evm_access_list_tracer.hpp>
 #include <silkrpc/core/estimate_gas_oracle.hpp>
+#include <silkrpc/core/fee_history_oracle.hpp>
 #include <silkrpc/core/gas_price_oracle.hpp>
 #include <silkrpc/core/rawdb/chain.hpp>
 #include <silkrpc/core/receipts.hpp>
@@ -50,7 +55,9 @@
 #include <silkrpc/ethdb/cbor.hpp>
 #include <silkrpc/ethdb/tables.hpp>
 #include <silkrpc/ethdb/transaction_database.hpp>
+#include <silkrpc/json/reply_writer.hpp>
 #include <silkrpc/json/types.hpp>
+#include <silkrpc/txpool/pool_mirror.hpp>
 #include <silkrpc/types/block.hpp>
 #include <silkrpc/types/call.hpp>
 #include <silkrpc/types/filter.hpp>
@@ -155,7 +162,11 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_gas_price(const nlohmann::json&
             return core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
         };
 
-        GasPriceOracle gas_price_oracle{ block_provider};
+        BlockHashProvider block_hash_provider = [&tx_database](uint64_t block_number) {
+            return core::rawdb::read_canonical_block_hash(tx_database, block_number);
+        };
+
+        GasPriceOracle gas_price_oracle{block_provider, block_hash_provider, *context_.gas_price_cache()};
         const auto gas_price = co_await gas_price_oracle.suggested_price(block_number);
         reply = make_json_content(request["id"], to_quantity(gas_price));
     } catch (const std::exception& e) {
@@ -170,6 +181,55 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_gas_price(const nlohmann::json&
     co_return;
 }
 
+// https://github.com/ethereum/execution-apis/blob/main/src/eth/fee_market.yaml
+asio::awaitable<void> EthereumRpcApi::handle_eth_fee_history(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() < 2 || params.size() > 3) {
+        auto error_msg = "invalid eth_feeHistory params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    const auto block_count = params[0].is_string() ? std::stoul(params[0].get<std::string>(), 0, 16) : params[0].get<uint64_t>();
+    const auto newest_block_id = params[1].get<std::string>();
+    std::vector<double> reward_percentiles;
+    if (params.size() == 3 && !params[2].is_null()) {
+        reward_percentiles = params[2].get<std::vector<double>>();
+    }
+    SILKRPC_DEBUG << "block_count: " << block_count << " newest_block_id: " << newest_block_id
+        << " #reward_percentiles: " << reward_percentiles.size() << "\n";
+
+    auto tx = co_await database_->begin();
+
+    try {
+        ethdb::TransactionDatabase tx_database{*tx};
+        const auto newest_block_number = co_await core::get_block_number(newest_block_id, tx_database);
+
+        BlockProvider block_provider = [this, &tx_database](uint64_t block_number) {
+            return core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
+        };
+        ReceiptsProvider receipts_provider = [this, &tx_database](const IndexedBlock& block_with_hash) {
+            return core::get_receipts(*context_.block_cache(), tx_database, block_with_hash);
+        };
+        BlockHashProvider block_hash_provider = [&tx_database](uint64_t block_number) {
+            return core::rawdb::read_canonical_block_hash(tx_database, block_number);
+        };
+
+        FeeHistoryOracle fee_history_oracle{block_provider, receipts_provider, block_hash_provider, *context_.fee_history_cache()};
+        const auto fee_history = co_await fee_history_oracle.fee_history(newest_block_number, block_count, reward_percentiles);
+        reply = make_json_content(request["id"], fee_history);
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
+        reply = make_json_error(request["id"], 100, e.what());
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
+        reply = make_json_error(request["id"], 100, "unexpected exception");
+    }
+
+    co_await tx->close(); // RAII not (yet) available with coroutines
+    co_return;
+}
+
 // https://eth.wiki/json-rpc/API#eth_getblockbyhash
 asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_by_hash(const nlohmann::json& request, nlohmann::json& reply) {
     auto params = request["params"];
@@ -189,9 +249,9 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_by_hash(const nlohman
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
-        const auto block_number = block_with_hash.block.header.number;
+        const auto block_number = block_with_hash->block.header.number;
         const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_hash, block_number);
-        const Block extended_block{block_with_hash, total_difficulty, full_tx};
+        const Block extended_block{*block_with_hash, total_difficulty, full_tx, block_with_hash->transaction_hashes};
 
         reply = make_json_content(request["id"], extended_block);
     } catch (const std::invalid_argument& iv) {
@@ -229,8 +289,8 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_by_number(const nlohm
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
-        const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_with_hash.hash, block_number);
-        const Block extended_block{block_with_hash, total_difficulty, full_tx};
+        const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_with_hash->hash, block_number);
+        const Block extended_block{*block_with_hash, total_difficulty, full_tx, block_with_hash->transaction_hashes};
 
         reply = make_json_content(request["id"], extended_block);
     } catch (const std::invalid_argument& iv) {
@@ -266,7 +326,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_transaction_count_by_
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
-        const auto tx_count = block_with_hash.block.transactions.size();
+        const auto tx_count = block_with_hash->block.transactions.size();
 
         reply = make_json_content(request["id"], to_quantity(tx_count));
     } catch (const std::exception& e) {
@@ -301,7 +361,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_block_transaction_count_by_
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
 
-        reply = make_json_content(request["id"], to_quantity(block_with_hash.block.transactions.size()));
+        reply = make_json_content(request["id"], to_quantity(block_with_hash->block.transactions.size()));
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -333,14 +393,14 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_uncle_by_block_hash_and_ind
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
-        const auto ommers = block_with_hash.block.ommers;
+        const auto& ommers = block_with_hash->block.ommers;
 
         const auto idx = std::stoul(index, 0, 16);
         if (idx >= ommers.size()) {
             SILKRPC_WARN << "invalid_argument: index not found processing request: " << request.dump() << "\n";
             reply = make_json_content(request["id"], nullptr);
         } else {
-            const auto block_number = block_with_hash.block.header.number;
+            const auto block_number = block_with_hash->block.header.number;
             const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_hash, block_number);
             auto uncle = ommers[idx];
 
@@ -381,14 +441,14 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_uncle_by_block_number_and_i
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
-        const auto ommers = block_with_hash.block.ommers;
+        const auto& ommers = block_with_hash->block.ommers;
 
         const auto idx = std::stoul(index, 0, 16);
         if (idx >= ommers.size()) {
             SILKRPC_WARN << "invalid_argument: index not found processing request: " << request.dump() << "\n";
             reply = make_json_content(request["id"], nullptr);
         } else {
-            const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_with_hash.hash, block_number);
+            const auto total_difficulty = co_await core::rawdb::read_total_difficulty(tx_database, block_with_hash->hash, block_number);
             auto uncle = ommers[idx];
 
             silkworm::BlockWithHash uncle_block_with_hash{{{}, uncle}, uncle.hash()};
@@ -426,7 +486,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_uncle_count_by_block_hash(c
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
-        const auto ommers = block_with_hash.block.ommers;
+        const auto& ommers = block_with_hash->block.ommers;
 
         reply = make_json_content(request["id"], to_quantity(ommers.size()));
     } catch (const std::exception& e) {
@@ -460,7 +520,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_uncle_count_by_block_number
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
-        const auto ommers = block_with_hash.block.ommers;
+        const auto& ommers = block_with_hash->block.ommers;
 
         reply = make_json_content(request["id"], to_quantity(ommers.size()));
     } catch (const std::exception& e) {
@@ -577,15 +637,15 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_transaction_by_block_hash_a
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
-        const auto transactions = block_with_hash.block.transactions;
+        const auto& transactions = block_with_hash->block.transactions;
 
         const auto idx = std::stoul(index, 0, 16);
         if (idx >= transactions.size()) {
             SILKRPC_WARN << "Transaction not found for index: " << index << "\n";
             reply = make_json_content(request["id"], nullptr);
         } else {
-            const auto block_header = block_with_hash.block.header;
-            silkrpc::Transaction txn{transactions[idx], block_with_hash.hash, block_header.number, block_header.base_fee_per_gas, idx};
+            const auto block_header = block_with_hash->block.header;
+            silkrpc::Transaction txn{transactions[idx], block_with_hash->hash, block_header.number, block_header.base_fee_per_gas, idx};
             reply = make_json_content(request["id"], txn);
         }
     } catch (const std::exception& e) {
@@ -619,7 +679,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_raw_transaction_by_block_ha
         ethdb::TransactionDatabase tx_database{*tx};
 
         const auto block_with_hash = co_await core::read_block_by_hash(*context_.block_cache(), tx_database, block_hash);
-        const auto transactions = block_with_hash.block.transactions;
+        const auto& transactions = block_with_hash->block.transactions;
 
         const auto idx = std::stoul(index, 0, 16);
         if (idx >= transactions.size()) {
@@ -663,15 +723,15 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_transaction_by_block_number
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
-        const auto transactions = block_with_hash.block.transactions;
+        const auto& transactions = block_with_hash->block.transactions;
 
         const auto idx = std::stoul(index, 0, 16);
         if (idx >= transactions.size()) {
             SILKRPC_WARN << "Transaction not found for index: " << index << "\n";
             reply = make_json_content(request["id"], nullptr);
         } else {
-            const auto block_header = block_with_hash.block.header;
-            silkrpc::Transaction txn{transactions[idx], block_with_hash.hash, block_header.number, block_header.base_fee_per_gas, idx};
+            const auto block_header = block_with_hash->block.header;
+            silkrpc::Transaction txn{transactions[idx], block_with_hash->hash, block_header.number, block_header.base_fee_per_gas, idx};
             reply = make_json_content(request["id"], txn);
         }
     } catch (const std::exception& e) {
@@ -706,7 +766,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_raw_transaction_by_block_nu
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
-        const auto transactions = block_with_hash.block.transactions;
+        const auto& transactions = block_with_hash->block.transactions;
 
         const auto idx = std::stoul(index, 0, 16);
         if (idx >= transactions.size()) {
@@ -747,27 +807,17 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_transaction_receipt(const n
         ethdb::TransactionDatabase tx_database{*tx};
         reply = make_json_content(request["id"], nullptr);
         const auto block_with_hash = co_await core::read_block_by_transaction_hash(*context_.block_cache(), tx_database, transaction_hash);
-        auto receipts = co_await core::get_receipts(tx_database, block_with_hash);
-        auto transactions = block_with_hash.block.transactions;
-        if (receipts.size() != transactions.size()) {
+        const auto receipts = co_await core::get_receipts(*context_.block_cache(), tx_database, *block_with_hash);
+        const auto& transactions = block_with_hash->block.transactions;
+        if (receipts->size() != transactions.size()) {
             throw std::invalid_argument{"Unexpected size for receipts in handle_eth_get_transaction_receipt"};
         }
 
-        size_t tx_index = -1;
-        for (size_t idx{0}; idx < transactions.size(); idx++) {
-            auto ethash_hash{hash_of_transaction(transactions[idx])};
-
-            SILKRPC_TRACE << "tx " << idx << ") hash: " << silkworm::to_bytes32({ethash_hash.bytes, silkworm::kHashLength}) << "\n";
-            if (std::memcmp(transaction_hash.bytes, ethash_hash.bytes, silkworm::kHashLength) == 0) {
-                tx_index = idx;
-                break;
-            }
-        }
-
-        if (tx_index == -1) {
+        const auto transaction_index = block_with_hash->transaction_index(transaction_hash);
+        if (!transaction_index) {
             throw std::invalid_argument{"Unexpected transaction index in handle_eth_get_transaction_receipt"};
         }
-        reply = make_json_content(request["id"], receipts[tx_index]);
+        reply = make_json_content(request["id"], receipts->at(*transaction_index));
     } catch (const std::invalid_argument& iv) {
         SILKRPC_WARN << "invalid_argument: " << iv.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_content(request["id"], {});
@@ -806,24 +856,32 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_estimate_gas(const nlohmann::js
         SILKRPC_DEBUG << "chain_id: " << chain_id << ", latest_block_number: " << latest_block_number << "\n";
 
         const auto latest_block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, latest_block_number);
-        const auto latest_block = latest_block_with_hash.block;
+        const auto& latest_block = latest_block_with_hash->block;
 
-        EVMExecutor evm_executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, latest_block.header.number};
+        EVMExecutor evm_executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, latest_block.header.number, context_.state_cache().get(), latest_view(*tx),
+            context_.code_cache().get()};
 
+        // Each attempt starts from the block state, while the state read by the previous ones is kept in memory
         ego::Executor executor = [&latest_block, &evm_executor](const silkworm::Transaction &transaction) {
+            evm_executor.reset_state();
             return evm_executor.call(latest_block, transaction);
         };
 
+        // Probes at different gas limits are independent executions starting from the same block state
+        ego::BatchExecutor batch_executor = [&latest_block, &evm_executor](const std::vector<silkworm::Transaction>& transactions) {
+            return evm_executor.call_many(latest_block, transactions);
+        };
+
         ego::BlockHeaderProvider block_header_provider = [&tx_database](uint64_t block_number) {
             return core::rawdb::read_header_by_number(tx_database, block_number);
         };
 
-        StateReader state_reader{tx_database};
+        auto state_reader{make_state_reader(tx_database, *tx)};
         ego::AccountReader account_reader = [&state_reader](const evmc::address& address, uint64_t block_number) {
             return state_reader.read_account(address, block_number + 1);
         };
 
-        ego::EstimateGasOracle estimate_gas_oracle{block_header_provider, account_reader, executor};
+        ego::EstimateGasOracle estimate_gas_oracle{block_header_provider, account_reader, executor, batch_executor, estimate_gas_probes_};
 
         auto estimated_gas = co_await estimate_gas_oracle.estimate_gas(call, latest_block_number);
 
@@ -864,7 +922,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_balance(const nlohmann::jso
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
-        StateReader state_reader{tx_database};
+        auto state_reader{make_state_reader(tx_database, *tx)};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         std::optional<silkworm::Account> account{co_await state_reader.read_account(address, block_number + 1)};
@@ -899,7 +957,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_code(const nlohmann::json&
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
-        StateReader state_reader{tx_database};
+        auto state_reader{make_state_reader(tx_database, *tx)};
 
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         std::optional<silkworm::Account> account{co_await state_reader.read_account(address, block_number + 1)};
@@ -939,11 +997,19 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_transaction_count(const nlo
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
-        StateReader state_reader{tx_database};
+        auto state_reader{make_state_reader(tx_database, *tx)};
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         std::optional<silkworm::Account> account{co_await state_reader.read_account(address, block_number + 1)};
 
-        if (account) {
+        // The pending nonce also counts the transactions of the sender waiting in the pool
+        std::optional<uint64_t> pool_nonce;
+        if (block_id == core::kPendingBlockId) {
+            pool_nonce = context_.pool_mirror()->ready() ? context_.pool_mirror()->nonce(address) : co_await tx_pool_->nonce(address);
+        }
+
+        if (pool_nonce && (!account || *pool_nonce >= account->nonce)) {
+            reply = make_json_content(request["id"], to_quantity(*pool_nonce + 1));
+        } else if (account) {
             reply = make_json_content(request["id"], to_quantity(account->nonce));
         } else {
             reply = make_json_content(request["id"], "0x");
@@ -978,7 +1044,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_storage_at(const nlohmann::
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
-        StateReader state_reader{tx_database};
+        auto state_reader{make_state_reader(tx_database, *tx)};
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
         std::optional<silkworm::Account> account{co_await state_reader.read_account(address, block_number + 1)};
 
@@ -1022,10 +1088,11 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_call(const nlohmann::json& requ
         const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
         const auto block_number = co_await core::get_block_number(block_id, tx_database);
 
-        EVMExecutor executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, block_number};
+        EVMExecutor executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, block_number, context_.state_cache().get(), latest_view(*tx),
+            context_.code_cache().get()};
         const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
         silkworm::Transaction txn{call.to_transaction()};
-        const auto execution_result = co_await executor.call(block_with_hash.block, txn);
+        const auto execution_result = co_await executor.call(block_with_hash->block, txn);
 
         if (execution_result.pre_check_error) {
             reply = make_json_error(request["id"], -32000, execution_result.pre_check_error.value());
@@ -1074,7 +1141,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_create_access_list(const nlohma
         const auto chain_id = co_await core::rawdb::read_chain_id(tx_database);
         const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
 
-        StateReader state_reader{tx_database};
+        auto state_reader{make_state_reader(tx_database, *tx)};
 
         evmc::address to{};
         if (call.to) {
@@ -1082,10 +1149,11 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_create_access_list(const nlohma
         } else {
             uint64_t nonce = 0;
             if (!call.nonce) {
-                // Retrieve nonce by txpool
-                auto nonce_option = co_await tx_pool_->nonce(*call.from);
+                // Retrieve nonce by txpool, from the local mirror when ready
+                auto& pool_mirror = *context_.pool_mirror();
+                auto nonce_option = pool_mirror.ready() ? pool_mirror.nonce(*call.from) : co_await tx_pool_->nonce(*call.from);
                 if (!nonce_option) {
-                    std::optional<silkworm::Account> account{co_await state_reader.read_account(*call.from,  block_with_hash.block.header.number + 1)};
+                    std::optional<silkworm::Account> account{co_await state_reader.read_account(*call.from,  block_with_hash->block.header.number + 1)};
                     if (account) {
                         nonce = (*account).nonce;
                     }
@@ -1104,10 +1172,11 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_create_access_list(const nlohma
         Tracers tracers{tracer};
         bool access_lists_match{false};
         do {
-            EVMExecutor executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, block_with_hash.block.header.number};
+            EVMExecutor executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, block_with_hash->block.header.number, context_.state_cache().get(), latest_view(*tx),
+                context_.code_cache().get()};
             const auto txn = call.to_transaction();
             tracer->reset_access_list();
-            const auto execution_result = co_await executor.call(block_with_hash.block, txn, /* refund */true, /* gasBailout */false, tracers);
+            const auto execution_result = co_await executor.call(block_with_hash->block, txn, /* refund */true, /* gasBailout */false, tracers);
             if (execution_result.pre_check_error) {
                 reply = make_json_error(request["id"], -32000, execution_result.pre_check_error.value());
                 break;
@@ -1171,8 +1240,8 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohmann::jso
         const auto chain_id = co_await core::rawdb::read_chain_id(tx_database);
         const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
 
-        StateReader state_reader{tx_database};
-        auto block_number = block_with_hash.block.header.number + 1;
+        auto state_reader{make_state_reader(tx_database, *tx)};
+        auto block_number = block_with_hash->block.header.number + 1;
 
         const auto start_time = clock_time::now();
 
@@ -1191,8 +1260,9 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohmann::jso
                  break;
             }
 
-            EVMExecutor executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, block_number};
-            const auto execution_result = co_await executor.call(block_with_hash.block, tx_with_block->transaction);
+            EVMExecutor executor{*context_.io_context(), tx_database, *chain_config_ptr, workers_, block_number, context_.state_cache().get(), latest_view(*tx),
+                context_.code_cache().get()};
+            const auto execution_result = co_await executor.call(block_with_hash->block, tx_with_block->transaction);
             if (execution_result.pre_check_error) {
                  reply = make_json_error(request["id"], -32000, execution_result.pre_check_error.value());
                  error = true;
@@ -1207,7 +1277,7 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohmann::jso
                  break;
             }
             tx_info.gas_used = tx_with_block->transaction.gas_limit - execution_result.gas_left;
-            tx_info.hash = hash_of_transaction(tx_with_block->transaction);
+            tx_info.hash = tx_with_block->block_with_hash->transaction_hashes[tx_with_block->transaction.transaction_index];
 
             if (execution_result.error_code != evmc_status_code::EVMC_SUCCESS) {
                 const auto error_message = EVMExecutor<>::get_error_message(execution_result.error_code, execution_result.data, false /* full_error */);
@@ -1237,12 +1307,33 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohmann::jso
 
 // https://eth.wiki/json-rpc/API#eth_newfilter
 asio::awaitable<void> EthereumRpcApi::handle_eth_new_filter(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() != 1) {
+        auto error_msg = "invalid eth_newFilter params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    auto filter = params[0].get<Filter>();
+    SILKRPC_DEBUG << "filter: " << filter << "\n";
+    if (filter.block_hash) {
+        auto error_msg = "invalid eth_newFilter filter with blockHash: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+
     auto tx = co_await database_->begin();
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        reply = make_json_content(request["id"], to_quantity(0));
+        // Changes are reported starting from the block following the latest one
+        const auto latest_block_number = co_await core::get_latest_block_number(tx_database);
+        const auto filter_id = context_.filter_registry()->add({FilterRegistry::FilterType::kLogs, filter, latest_block_number});
+        SILKRPC_DEBUG << "filter_id: " << filter_id << " latest_block_number: " << latest_block_number << "\n";
+
+        reply = make_json_content(request["id"], filter_id);
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1262,7 +1353,12 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_new_block_filter(const nlohmann
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        reply = make_json_content(request["id"], to_quantity(0));
+        // Changes are reported starting from the block following the latest one
+        const auto latest_block_number = co_await core::get_latest_block_number(tx_database);
+        const auto filter_id = context_.filter_registry()->add({FilterRegistry::FilterType::kBlock, Filter{}, latest_block_number});
+        SILKRPC_DEBUG << "filter_id: " << filter_id << " latest_block_number: " << latest_block_number << "\n";
+
+        reply = make_json_content(request["id"], filter_id);
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1297,12 +1393,62 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_new_pending_transaction_filter(
 
 // https://eth.wiki/json-rpc/API#eth_getfilterchanges
 asio::awaitable<void> EthereumRpcApi::handle_eth_get_filter_changes(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() != 1) {
+        auto error_msg = "invalid eth_getFilterChanges params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    const auto filter_id = params[0].get<std::string>();
+    SILKRPC_DEBUG << "filter_id: " << filter_id << "\n";
+
+    auto& filter_registry = *context_.filter_registry();
+    const auto stored_filter = filter_registry.get(filter_id);
+    if (!stored_filter) {
+        reply = make_json_error(request["id"], 100, "filter not found");
+        co_return;
+    }
+
     auto tx = co_await database_->begin();
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        reply = make_json_content(request["id"], to_quantity(0));
+        // Evaluate just the blocks added since the last poll, at most kMaxFilterChangesBlocks at a time
+        const auto latest_block_number = co_await core::get_latest_block_number(tx_database);
+        const auto start = stored_filter->last_block + 1;
+        const auto end = std::min<uint64_t>(latest_block_number, stored_filter->last_block + kMaxFilterChangesBlocks);
+        SILKRPC_DEBUG << "start block: " << start << " end block: " << end << "\n";
+
+        if (stored_filter->type == FilterRegistry::FilterType::kBlock) {
+            std::vector<evmc::bytes32> block_hashes;
+            for (auto block_number = start; block_number <= end; ++block_number) {
+                block_hashes.push_back(co_await core::rawdb::read_canonical_block_hash(tx_database, block_number));
+            }
+            reply = make_json_content(request["id"], block_hashes);
+        } else {
+            std::vector<Log> logs;
+            Filter filter = stored_filter->filter;
+            filter.from_block = std::max(start, filter.from_block.value_or(0));
+            filter.to_block = std::min(end, filter.to_block.value_or(end));
+            if (*filter.from_block <= *filter.to_block) {
+                co_await get_logs(tx_database, tx->tx_id(), filter, [&](std::vector<Log>& block_logs) -> asio::awaitable<void> {
+                    logs.insert(logs.end(), block_logs.begin(), block_logs.end());
+                    co_return;
+                });
+            }
+            SILKRPC_INFO << "logs.size(): " << logs.size() << "\n";
+            reply = make_json_content(request["id"], logs);
+        }
+
+        // Blocks already reported by a concurrent poll must not be reported again
+        if (start <= end && !filter_registry.advance(filter_id, stored_filter->last_block, end)) {
+            reply = make_json_content(request["id"], nlohmann::json::array());
+        }
+    } catch (const std::invalid_argument& iv) {
+        SILKRPC_WARN << "invalid_argument: " << iv.what() << " processing request: " << request.dump() << "\n";
+        reply = make_json_content(request["id"], nlohmann::json::array());
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1317,12 +1463,50 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_get_filter_changes(const nlohma
 
 // https://eth.wiki/json-rpc/API#eth_uninstallfilter
 asio::awaitable<void> EthereumRpcApi::handle_eth_uninstall_filter(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() != 1) {
+        auto error_msg = "invalid eth_uninstallFilter params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    const auto filter_id = params[0].get<std::string>();
+    SILKRPC_DEBUG << "filter_id: " << filter_id << "\n";
+
+    const auto removed = context_.filter_registry()->remove(filter_id);
+    reply = make_json_content(request["id"], removed);
+    co_return;
+}
+
+// https://eth.wiki/json-rpc/API#eth_getlogs
+asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() != 1) {
+        auto error_msg = "invalid eth_getLogs params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    auto filter = params[0].get<Filter>();
+    SILKRPC_DEBUG << "filter: " << filter << "\n";
+
+    std::vector<Log> logs;
+
     auto tx = co_await database_->begin();
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        reply = make_json_content(request["id"], to_quantity(0));
+        co_await get_logs(tx_database, tx->tx_id(), filter, [&](std::vector<Log>& block_logs) -> asio::awaitable<void> {
+            logs.insert(logs.end(), block_logs.begin(), block_logs.end());
+            co_return;
+        });
+        SILKRPC_INFO << "logs.size(): " << logs.size() << "\n";
+
+        reply = make_json_content(request["id"], logs);
+    } catch (const std::invalid_argument& iv) {
+        SILKRPC_WARN << "invalid_argument: " << iv.what() << " processing request: " << request.dump() << "\n";
+        reply = make_json_content(request["id"], logs);
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -1336,136 +1520,231 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_uninstall_filter(const nlohmann
 }
 
 // https://eth.wiki/json-rpc/API#eth_getlogs
-asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann::json& request, nlohmann::json& reply) {
+asio::awaitable<void> EthereumRpcApi::handle_eth_get_logs(const nlohmann::json& request, Writer& writer) {
+    JsonReplyWriter reply_writer{request["id"], writer};
     auto params = request["params"];
     if (params.size() != 1) {
         auto error_msg = "invalid eth_getLogs params: " + params.dump();
         SILKRPC_ERROR << error_msg << "\n";
-        reply = make_json_error(request["id"], 100, error_msg);
+        co_await reply_writer.close(Error{100, error_msg});
         co_return;
     }
     auto filter = params[0].get<Filter>();
     SILKRPC_DEBUG << "filter: " << filter << "\n";
 
-    std::vector<Log> logs;
-
     auto tx = co_await database_->begin();
 
+    // The result is serialized block by block with no log DOM kept, the reply opening is deferred to the first matched log
+    std::size_t logs_count{0};
+    std::optional<Error> error;
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        uint64_t start{}, end{};
-        if (filter.block_hash.has_value()) {
-            auto block_hash_bytes = silkworm::from_hex(filter.block_hash.value());
-            if (!block_hash_bytes.has_value()) {
-                auto error_msg = "invalid eth_getLogs filter block_hash: " + filter.block_hash.value();
-                SILKRPC_ERROR << error_msg << "\n";
-                reply = make_json_error(request["id"], 100, error_msg);
-                co_await tx->close(); // RAII not (yet) available with coroutines
-                co_return;
+        co_await get_logs(tx_database, tx->tx_id(), filter, [&](std::vector<Log>& block_logs) -> asio::awaitable<void> {
+            std::string block_content;
+            for (const auto& log : block_logs) {
+                block_content.push_back(logs_count++ == 0 ? '[' : ',');
+                block_content.append(nlohmann::json(log).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
             }
-            auto block_hash = silkworm::to_bytes32(block_hash_bytes.value());
-            auto block_number = co_await core::rawdb::read_header_number(tx_database, block_hash);
-            start = end = block_number;
-        } else {
-            auto latest_block_number = co_await core::get_latest_block_number(tx_database);
-            start = filter.from_block.value_or(0);
-            end = filter.to_block.value_or(latest_block_number);
+            if (!block_content.empty()) {
+                co_await reply_writer.write(block_content);
+            }
+        });
+        SILKRPC_INFO << "logs.size(): " << logs_count << "\n";
+    } catch (const std::invalid_argument& iv) {
+        SILKRPC_WARN << "invalid_argument: " << iv.what() << " processing request: " << request.dump() << "\n";
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
+        error = Error{100, e.what()};
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
+        error = Error{100, "unexpected exception"};
+    }
+
+    // Writing the reply end may fail as well (e.g. connection closed), but the transaction must be closed anyway
+    std::exception_ptr write_error;
+    try {
+        if (reply_writer.started()) {
+            co_await reply_writer.write("]");
+        } else if (!error) {
+            co_await reply_writer.write("[]");
         }
-        SILKRPC_INFO << "start block: " << start << " end block: " << end << "\n";
+        co_await reply_writer.close(error);
+    } catch (...) {
+        write_error = std::current_exception();
+    }
 
-        roaring::Roaring block_numbers;
-        block_numbers.addRange(start, end + 1); // [min, max)
+    co_await tx->close(); // RAII not (yet) available with coroutines
+    if (write_error) {
+        std::rethrow_exception(write_error);
+    }
+    co_return;
+}
 
-        SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+StateReader EthereumRpcApi::make_state_reader(const ethdb::TransactionDatabase& tx_database, const ethdb::Transaction& tx) {
+    return StateReader{tx_database, context_.state_cache().get(), latest_view(tx)};
+}
 
-        if (filter.topics.has_value()) {
-            auto topics_bitmap = co_await get_topics_bitmap(tx_database, filter.topics.value(), start, end);
-            SILKRPC_TRACE << "topics_bitmap: " << topics_bitmap.toString() << "\n";
-            if (topics_bitmap.isEmpty()) {
-                block_numbers = topics_bitmap;
-            } else {
-                block_numbers &= topics_bitmap;
-            }
+CoherentStateView EthereumRpcApi::latest_view(const ethdb::Transaction& tx) {
+    return CoherentStateView{context_.coherent_state_cache().get(), tx.tx_id()};
+}
+
+asio::awaitable<void> EthereumRpcApi::get_logs(ethdb::TransactionDatabase& tx_database, uint64_t view_id, const Filter& filter, LogsConsumer consumer) {
+    uint64_t start{}, end{};
+    if (filter.block_hash.has_value()) {
+        auto block_hash_bytes = silkworm::from_hex(filter.block_hash.value());
+        if (!block_hash_bytes.has_value()) {
+            throw std::runtime_error{"invalid eth_getLogs filter block_hash: " + filter.block_hash.value()};
         }
-        SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
-        SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
+        auto block_hash = silkworm::to_bytes32(block_hash_bytes.value());
+        auto block_number = co_await core::rawdb::read_header_number(tx_database, block_hash);
+        start = end = block_number;
+    } else {
+        auto latest_block_number = co_await core::get_latest_block_number(tx_database);
+        start = filter.from_block.value_or(0);
+        end = filter.to_block.value_or(latest_block_number);
+    }
+    SILKRPC_INFO << "start block: " << start << " end block: " << end << "\n";
 
-        if (filter.addresses.has_value()) {
-            auto addresses_bitmap = co_await get_addresses_bitmap(tx_database, filter.addresses.value(), start, end);
-            if (addresses_bitmap.isEmpty()) {
-                block_numbers = addresses_bitmap;
-            } else {
-                block_numbers &= addresses_bitmap;
-            }
+    roaring::Roaring block_numbers;
+    block_numbers.addRange(start, end + 1); // [min, max)
+
+    SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+
+    if (filter.topics.has_value()) {
+        auto topics_bitmap = co_await get_topics_bitmap(tx_database, filter.topics.value(), start, end);
+        SILKRPC_TRACE << "topics_bitmap: " << topics_bitmap.toString() << "\n";
+        if (topics_bitmap.isEmpty()) {
+            block_numbers = topics_bitmap;
+        } else {
+            block_numbers &= topics_bitmap;
         }
-        SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
-        SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
+    }
+    SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+    SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
 
-        if (block_numbers.cardinality() == 0) {
-            reply = make_json_content(request["id"], logs);
-            co_await tx->close(); // RAII not (yet) available with coroutines
-            co_return;
+    if (filter.addresses.has_value()) {
+        auto addresses_bitmap = co_await get_addresses_bitmap(tx_database, filter.addresses.value(), start, end);
+        if (addresses_bitmap.isEmpty()) {
+            block_numbers = addresses_bitmap;
+        } else {
+            block_numbers &= addresses_bitmap;
         }
+    }
+    SILKRPC_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality() << "\n";
+    SILKRPC_TRACE << "block_numbers: " << block_numbers.toString() << "\n";
 
+    if (block_numbers.cardinality() <= kLogsScanChunkSize) {
         for (auto block_to_match : block_numbers) {
-            uint64_t log_index{0};
-
-            Logs filtered_block_logs{};
-            const auto block_key = silkworm::db::block_key(block_to_match);
-            SILKRPC_TRACE << "block_to_match: " << block_to_match << " block_key: " << silkworm::to_hex(block_key) << "\n";
-            co_await tx_database.for_prefix(db::table::kLogs, block_key, [&](const silkworm::Bytes& k, const silkworm::Bytes& v) {
-                Logs chunck_logs{};
-                const bool decoding_ok{cbor_decode(v, chunck_logs)};
-                if (!decoding_ok) {
-                    return false;
-                }
-                for (auto& log : chunck_logs) {
-                    log.index = log_index++;
-                }
-                SILKRPC_DEBUG << "chunck_logs.size(): " << chunck_logs.size() << "\n";
-                auto filtered_chunck_logs = filter_logs(chunck_logs, filter);
-                SILKRPC_DEBUG << "filtered_chunck_logs.size(): " << filtered_chunck_logs.size() << "\n";
-                if (filtered_chunck_logs.size() > 0) {
-                    const auto tx_id = boost::endian::load_big_u32(&k[sizeof(uint64_t)]);
-                    SILKRPC_DEBUG << "tx_id: " << tx_id << "\n";
-                    for (auto& log : filtered_chunck_logs) {
-                        log.tx_index = tx_id;
+            auto block_logs = co_await get_block_logs(tx_database, block_to_match, filter);
+            if (block_logs.size() > 0) {
+                co_await consumer(block_logs);
+            }
+        }
+        co_return;
+    }
+
+    co_await scan_logs(tx_database, view_id, block_numbers, filter, consumer);
+}
+
+asio::awaitable<void> EthereumRpcApi::scan_logs(ethdb::TransactionDatabase& tx_database, uint64_t view_id, const roaring::Roaring& block_numbers, const Filter& filter, LogsConsumer& consumer) {
+    const auto num_blocks = block_numbers.cardinality();
+    const auto num_chunks = (num_blocks + kLogsScanChunkSize - 1) / kLogsScanChunkSize;
+    SILKRPC_DEBUG << "scan_logs #blocks: " << num_blocks << " #chunks: " << num_chunks << "\n";
+
+    // Each scan executor picks the next chunk of blocks until exhausted. Completed chunks are delivered to the consumer in
+    // block order, executors not going further than max_chunks_ahead to bound memory. Cursors cannot be shared between
+    // concurrent executors, so only the first one scans on the request transaction and the others open their own: these
+    // take part in the scan only if they read the same view (i.e. no new block in the meantime), otherwise they step aside
+    // to never mix logs coming from different views
+    const std::size_t num_executors = std::min<std::size_t>(num_chunks, kMaxLogsScanInFlight);
+    const std::size_t max_chunks_ahead = 2 * num_executors;
+    std::size_t num_started_executors{0};
+    co_await ordered_scan<std::vector<Log>>(num_chunks, num_executors, max_chunks_ahead,
+        [&](const ScanLoop<std::vector<Log>>& scan_loop) -> asio::awaitable<void> {
+            const auto chunk_scanner = [&](ethdb::TransactionDatabase& scan_database) {
+                return [&, scan_db = &scan_database](std::size_t chunk_index) -> asio::awaitable<std::vector<Log>> {
+                    std::vector<Log> chunk_logs;
+                    const auto chunk_end = std::min<uint64_t>((chunk_index + 1) * kLogsScanChunkSize, num_blocks);
+                    for (auto rank = chunk_index * kLogsScanChunkSize; rank < chunk_end; ++rank) {
+                        uint32_t block_number{0};
+                        block_numbers.select(static_cast<uint32_t>(rank), &block_number);
+                        auto block_logs = co_await get_block_logs(*scan_db, block_number, filter);
+                        chunk_logs.insert(chunk_logs.end(), std::make_move_iterator(block_logs.begin()), std::make_move_iterator(block_logs.end()));
                     }
-                    filtered_block_logs.insert(filtered_block_logs.end(), filtered_chunck_logs.begin(), filtered_chunck_logs.end());
-                }
-                return true;
-            });
-            SILKRPC_DEBUG << "filtered_block_logs.size(): " << filtered_block_logs.size() << "\n";
-
-            if (filtered_block_logs.size() > 0) {
-                const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_to_match);
-                SILKRPC_DEBUG << "block_hash: " << silkworm::to_hex(block_with_hash.hash) << "\n";
-                for (auto& log : filtered_block_logs) {
-                    const auto tx_hash{hash_of_transaction(block_with_hash.block.transactions[log.tx_index])};
-                    log.block_number = block_to_match;
-                    log.block_hash = block_with_hash.hash;
-                    log.tx_hash = silkworm::to_bytes32({tx_hash.bytes, silkworm::kHashLength});
+                    co_return chunk_logs;
+                };
+            };
+            if (num_started_executors++ == 0) {
+                co_await scan_loop(chunk_scanner(tx_database));
+                co_return;
+            }
+
+            auto tx = co_await database_->begin();
+            std::exception_ptr eptr;
+            try {
+                if (tx->tx_id() == view_id) {
+                    ethdb::TransactionDatabase executor_database{*tx};
+                    co_await scan_loop(chunk_scanner(executor_database));
+                } else {
+                    SILKRPC_DEBUG << "scan_logs executor skipped view: " << tx->tx_id() << " request view: " << view_id << "\n";
                 }
-                logs.insert(logs.end(), filtered_block_logs.begin(), filtered_block_logs.end());
+            } catch (...) {
+                eptr = std::current_exception();
+            }
+            co_await tx->close(); // RAII not (yet) available with coroutines
+            if (eptr) {
+                std::rethrow_exception(eptr);
+            }
+        },
+        [&](std::vector<Log>& chunk_logs) -> asio::awaitable<void> {
+            if (chunk_logs.size() > 0) {
+                co_await consumer(chunk_logs);
+            }
+        });
+    SILKRPC_DEBUG << "scan_logs #chunks: " << num_chunks << " delivered\n";
+}
+
+asio::awaitable<std::vector<Log>> EthereumRpcApi::get_block_logs(ethdb::TransactionDatabase& tx_database, uint64_t block_number, const Filter& filter) {
+    uint64_t log_index{0};
+
+    Logs filtered_block_logs{};
+    const auto block_key = silkworm::db::block_key(block_number);
+    SILKRPC_TRACE << "block_to_match: " << block_number << " block_key: " << silkworm::to_hex(block_key) << "\n";
+    co_await tx_database.for_prefix(db::table::kLogs, block_key, [&](const silkworm::Bytes& k, const silkworm::Bytes& v) {
+        Logs chunck_logs{};
+        const bool decoding_ok{cbor_decode(v, chunck_logs)};
+        if (!decoding_ok) {
+            return false;
+        }
+        for (auto& log : chunck_logs) {
+            log.index = log_index++;
+        }
+        SILKRPC_DEBUG << "chunck_logs.size(): " << chunck_logs.size() << "\n";
+        auto filtered_chunck_logs = filter_logs(chunck_logs, filter);
+        SILKRPC_DEBUG << "filtered_chunck_logs.size(): " << filtered_chunck_logs.size() << "\n";
+        if (filtered_chunck_logs.size() > 0) {
+            const auto tx_id = boost::endian::load_big_u32(&k[sizeof(uint64_t)]);
+            SILKRPC_DEBUG << "tx_id: " << tx_id << "\n";
+            for (auto& log : filtered_chunck_logs) {
+                log.tx_index = tx_id;
             }
+            filtered_block_logs.insert(filtered_block_logs.end(), filtered_chunck_logs.begin(), filtered_chunck_logs.end());
         }
-        SILKRPC_INFO << "logs.size(): " << logs.size() << "\n";
+        return true;
+    });
+    SILKRPC_DEBUG << "filtered_block_logs.size(): " << filtered_block_logs.size() << "\n";
 
-        reply = make_json_content(request["id"], logs);
-    } catch (const std::invalid_argument& iv) {
-        SILKRPC_WARN << "invalid_argument: " << iv.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_content(request["id"], logs);
-    } catch (const std::exception& e) {
-        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, e.what());
-    } catch (...) {
-        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, "unexpected exception");
+    if (filtered_block_logs.size() > 0) {
+        const auto block_with_hash = co_await core::read_block_by_number(*context_.block_cache(), tx_database, block_number);
+        SILKRPC_DEBUG << "block_hash: " << silkworm::to_hex(block_with_hash->hash) << "\n";
+        for (auto& log : filtered_block_logs) {
+            log.block_number = block_number;
+            log.block_hash = block_with_hash->hash;
+            log.tx_hash = block_with_hash->transaction_hashes[log.tx_index];
+        }
     }
-
-    co_await tx->close(); // RAII not (yet) available with coroutines
-    co_return;
+    co_return filtered_block_logs;
 }
 
 // https://eth.wiki/json-rpc/API#eth_sendrawtransaction
@@ -1734,58 +2013,41 @@ asio::awaitable<void> EthereumRpcApi::handle_eth_submit_work(const nlohmann::jso
 
 // https://eth.wiki/json-rpc/API#eth_subscribe
 asio::awaitable<void> EthereumRpcApi::handle_eth_subscribe(const nlohmann::json& request, nlohmann::json& reply) {
-    auto tx = co_await database_->begin();
-
-    try {
-        ethdb::TransactionDatabase tx_database{*tx};
-
-        reply = make_json_content(request["id"], to_quantity(0));
-    } catch (const std::exception& e) {
-        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, e.what());
-    } catch (...) {
-        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, "unexpected exception");
-    }
-
-    co_await tx->close(); // RAII not (yet) available with coroutines
+    // Subscriptions are bound to a connection able to push notifications, so they are served by WebSocket sessions only
+    reply = make_json_error(request["id"], -32000, "notifications not supported");
     co_return;
 }
 
 // https://eth.wiki/json-rpc/API#eth_unsubscribe
 asio::awaitable<void> EthereumRpcApi::handle_eth_unsubscribe(const nlohmann::json& request, nlohmann::json& reply) {
-    auto tx = co_await database_->begin();
-
-    try {
-        ethdb::TransactionDatabase tx_database{*tx};
-
-        reply = make_json_content(request["id"], to_quantity(0));
-    } catch (const std::exception& e) {
-        SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, e.what());
-    } catch (...) {
-        SILKRPC_ERROR << "unexpected exception processing request: " << request.dump() << "\n";
-        reply = make_json_error(request["id"], 100, "unexpected exception");
-    }
-
-    co_await tx->close(); // RAII not (yet) available with coroutines
+    reply = make_json_error(request["id"], -32000, "notifications not supported");
     co_return;
 }
 
-asio::awaitable<roaring::Roaring> EthereumRpcApi::get_topics_bitmap(core::rawdb::DatabaseReader& db_reader, FilterTopics& topics, uint64_t start, uint64_t end) {
+asio::awaitable<roaring::Roaring> EthereumRpcApi::get_topics_bitmap(core::rawdb::DatabaseReader& db_reader, const FilterTopics& topics, uint64_t start, uint64_t end) {
     SILKRPC_DEBUG << "#topics: " << topics.size() << " start: " << start << " end: " << end << "\n";
+
+    // Look up all the topics at once, then rebuild the per-position OR groups
+    std::vector<silkworm::Bytes> topic_keys;
+    for (const auto& subtopics : topics) {
+        for (const auto& topic : subtopics) {
+            SILKRPC_TRACE << "topic: " << topic << "\n";
+            topic_keys.emplace_back(std::begin(topic.bytes), std::end(topic.bytes));
+        }
+    }
+    const auto topic_bitmaps = co_await ethdb::bitmap::get_batch(db_reader, db::table::kLogTopicIndex, topic_keys, start, end);
+
     roaring::Roaring result_bitmap;
-    for (auto subtopics : topics) {
+    std::size_t topic_index{0};
+    for (const auto& subtopics : topics) {
         SILKRPC_DEBUG << "#subtopics: " << subtopics.size() << "\n";
-        roaring::Roaring subtopic_bitmap;
-        for (auto topic : subtopics) {
-            silkworm::Bytes topic_key{std::begin(topic.bytes), std::end(topic.bytes)};
-            SILKRPC_TRACE << "topic: " << topic << " topic_key: " << silkworm::to_hex(topic) <<"\n";
-            auto bitmap = co_await ethdb::bitmap::get(db_reader, db::table::kLogTopicIndex, topic_key, start, end);
-            SILKRPC_TRACE << "bitmap: " << bitmap.toString() << "\n";
-            subtopic_bitmap |= bitmap;
-            SILKRPC_TRACE << "subtopic_bitmap: " << subtopic_bitmap.toString() << "\n";
+        std::vector<const roaring::Roaring*> subtopic_inputs;
+        subtopic_inputs.reserve(subtopics.size());
+        for (std::size_t i{0}; i < subtopics.size(); ++i) {
+            subtopic_inputs.push_back(&topic_bitmaps[topic_index++]);
         }
+        const auto subtopic_bitmap = roaring::Roaring::fastunion(subtopic_inputs.size(), subtopic_inputs.data());
+        SILKRPC_TRACE << "subtopic_bitmap: " << subtopic_bitmap.toString() << "\n";
         if (!subtopic_bitmap.isEmpty()) {
             if (result_bitmap.isEmpty()) {
                 result_bitmap = subtopic_bitmap;
@@ -1798,15 +2060,21 @@ asio::awaitable<roaring::Roaring> EthereumRpcApi::get_topics_bitmap(core::rawdb:
     co_return result_bitmap;
 }
 
-asio::awaitable<roaring::Roaring> EthereumRpcApi::get_addresses_bitmap(core::rawdb::DatabaseReader& db_reader, FilterAddresses& addresses, uint64_t start, uint64_t end) {
+asio::awaitable<roaring::Roaring> EthereumRpcApi::get_addresses_bitmap(core::rawdb::DatabaseReader& db_reader, const FilterAddresses& addresses, uint64_t start, uint64_t end) {
     SILKRPC_TRACE << "#addresses: " << addresses.size() << " start: " << start << " end: " << end << "\n";
-    roaring::Roaring result_bitmap;
-    for (auto address : addresses) {
-        silkworm::Bytes address_key{std::begin(address.bytes), std::end(address.bytes)};
-        auto bitmap = co_await ethdb::bitmap::get(db_reader, db::table::kLogAddressIndex, address_key, start, end);
-        SILKRPC_TRACE << "bitmap: " << bitmap.toString() << "\n";
-        result_bitmap |= bitmap;
+    std::vector<silkworm::Bytes> address_keys;
+    address_keys.reserve(addresses.size());
+    for (const auto& address : addresses) {
+        address_keys.emplace_back(std::begin(address.bytes), std::end(address.bytes));
+    }
+    const auto address_bitmaps = co_await ethdb::bitmap::get_batch(db_reader, db::table::kLogAddressIndex, address_keys, start, end);
+
+    std::vector<const roaring::Roaring*> inputs;
+    inputs.reserve(address_bitmaps.size());
+    for (const auto& bitmap : address_bitmaps) {
+        inputs.push_back(&bitmap);
     }
+    const auto result_bitmap = roaring::Roaring::fastunion(inputs.size(), inputs.data());
     SILKRPC_TRACE << "result_bitmap: " << result_bitmap.toString() << "\n";
     co_return result_bitmap;
 }
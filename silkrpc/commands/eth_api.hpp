@@ -17,7 +17,10 @@
 #ifndef SILKRPC_COMMANDS_ETH_API_HPP_
 #define SILKRPC_COMMANDS_ETH_API_HPP_
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <silkrpc/config.hpp> // NOLINT(build/include_order)
@@ -29,13 +32,18 @@
 
 #include <silkrpc/txpool/transaction_pool.hpp>
 #include <silkworm/types/receipt.hpp>
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/writer.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
+#include <silkrpc/core/state_reader.hpp>
 #include <silkrpc/croaring/roaring.hh>
 #include <silkrpc/json/types.hpp>
 #include <silkrpc/ethbackend/backend.hpp>
 #include <silkrpc/ethdb/database.hpp>
 #include <silkrpc/ethdb/transaction.hpp>
+#include <silkrpc/ethdb/transaction_database.hpp>
+#include <silkrpc/types/filter.hpp>
 #include <silkrpc/types/log.hpp>
 #include <silkrpc/types/receipt.hpp>
 
@@ -45,8 +53,9 @@ namespace silkrpc::commands {
 
 class EthereumRpcApi {
 public:
-    explicit EthereumRpcApi(Context& context, asio::thread_pool& workers)
-    : context_(context), database_(context.database()), backend_(context.backend()), miner_{context.miner()}, tx_pool_{context.tx_pool()}, workers_{workers} {}
+    explicit EthereumRpcApi(Context& context, asio::thread_pool& workers, std::size_t estimate_gas_probes = kDefaultEstimateGasProbes)
+    : context_(context), database_(context.database()), backend_(context.backend()), miner_{context.miner()}, tx_pool_{context.tx_pool()}, workers_{workers},
+      estimate_gas_probes_{estimate_gas_probes} {}
     virtual ~EthereumRpcApi() {}
 
     EthereumRpcApi(const EthereumRpcApi&) = delete;
@@ -58,6 +67,7 @@ protected:
     asio::awaitable<void> handle_eth_protocol_version(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_syncing(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_gas_price(const nlohmann::json& request, nlohmann::json& reply);
+    asio::awaitable<void> handle_eth_fee_history(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_get_block_by_hash(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_get_block_by_number(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_get_block_transaction_count_by_hash(const nlohmann::json& request, nlohmann::json& reply);
@@ -87,6 +97,7 @@ protected:
     asio::awaitable<void> handle_eth_get_filter_changes(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_uninstall_filter(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_get_logs(const nlohmann::json& request, nlohmann::json& reply);
+    asio::awaitable<void> handle_eth_get_logs(const nlohmann::json& request, Writer& writer);
     asio::awaitable<void> handle_eth_send_raw_transaction(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_send_transaction(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_sign_transaction(const nlohmann::json& request, nlohmann::json& reply);
@@ -99,17 +110,29 @@ protected:
     asio::awaitable<void> handle_eth_submit_work(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_subscribe(const nlohmann::json& request, nlohmann::json& reply);
     asio::awaitable<void> handle_eth_unsubscribe(const nlohmann::json& request, nlohmann::json& reply);
-    asio::awaitable<roaring::Roaring> get_topics_bitmap(core::rawdb::DatabaseReader& db_reader, FilterTopics& topics, uint64_t start, uint64_t end);
-    asio::awaitable<roaring::Roaring> get_addresses_bitmap(core::rawdb::DatabaseReader& db_reader, FilterAddresses& addresses, uint64_t start, uint64_t end);
+    using LogsConsumer = std::function<asio::awaitable<void>(std::vector<Log>&)>;
+
+    asio::awaitable<void> get_logs(ethdb::TransactionDatabase& tx_database, uint64_t view_id, const Filter& filter, LogsConsumer consumer);
+    asio::awaitable<void> scan_logs(ethdb::TransactionDatabase& tx_database, uint64_t view_id, const roaring::Roaring& block_numbers, const Filter& filter, LogsConsumer& consumer);
+    asio::awaitable<std::vector<Log>> get_block_logs(ethdb::TransactionDatabase& tx_database, uint64_t block_number, const Filter& filter);
+    asio::awaitable<roaring::Roaring> get_topics_bitmap(core::rawdb::DatabaseReader& db_reader, const FilterTopics& topics, uint64_t start, uint64_t end);
+    asio::awaitable<roaring::Roaring> get_addresses_bitmap(core::rawdb::DatabaseReader& db_reader, const FilterAddresses& addresses, uint64_t start, uint64_t end);
 
     std::vector<Log> filter_logs(std::vector<Log>& logs, const Filter& filter);
 
+    //! State reader of the given request transaction, served from the shared caches when possible
+    StateReader make_state_reader(const ethdb::TransactionDatabase& tx_database, const ethdb::Transaction& tx);
+
+    //! View of the coherent state cache matching the given request transaction
+    CoherentStateView latest_view(const ethdb::Transaction& tx);
+
     Context& context_;
     std::unique_ptr<ethdb::Database>& database_;
     std::unique_ptr<ethbackend::BackEnd>& backend_;
     std::unique_ptr<txpool::Miner>& miner_;
     std::unique_ptr<txpool::TransactionPool>& tx_pool_;
     asio::thread_pool& workers_;
+    std::size_t estimate_gas_probes_;
 
     friend class silkrpc::http::RequestHandler;
 };
@@ -17,10 +17,12 @@
 #ifndef SILKRPC_COMMANDS_RPC_API_HPP_
 #define SILKRPC_COMMANDS_RPC_API_HPP_
 
+#include <cstddef>
 #include <memory>
 
 #include <asio/thread_pool.hpp>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/commands/eth_api.hpp>
 #include <silkrpc/commands/debug_api.hpp>
 #include <silkrpc/commands/net_api.hpp>
@@ -39,8 +41,8 @@ class RpcApiTable;
 
 class RpcApi : protected EthereumRpcApi, NetRpcApi, Web3RpcApi, DebugRpcApi, ParityRpcApi, ErigonRpcApi, TraceRpcApi, EngineRpcApi, TxPoolRpcApi {
 public:
-    explicit RpcApi(Context& context, asio::thread_pool& workers) :
-        EthereumRpcApi{context, workers}, NetRpcApi{context.backend()}, Web3RpcApi{context}, DebugRpcApi{context, workers},
+    explicit RpcApi(Context& context, asio::thread_pool& workers, std::size_t estimate_gas_probes = kDefaultEstimateGasProbes) :
+        EthereumRpcApi{context, workers, estimate_gas_probes}, NetRpcApi{context.backend()}, Web3RpcApi{context}, DebugRpcApi{context, workers},
         ParityRpcApi{context}, ErigonRpcApi{context}, TraceRpcApi{context, workers},
         EngineRpcApi(context.database(), context.backend()),
         TxPoolRpcApi(context) {}
@@ -36,6 +36,14 @@ std::optional<RpcApiTable::HandleMethod> RpcApiTable::find_handler(const std::st
     return handle_method_pair->second;
 }
 
+std::optional<RpcApiTable::HandleStream> RpcApiTable::find_stream_handler(const std::string& method) const {
+    const auto handle_stream_pair = stream_handlers_.find(method);
+    if (handle_stream_pair == stream_handlers_.end()) {
+        return std::nullopt;
+    }
+    return handle_stream_pair->second;
+}
+
 void RpcApiTable::build_handlers(const std::string& api_spec) {
     auto start = 0u;
     auto end = api_spec.find(kApiSpecSeparator);
@@ -77,9 +85,12 @@ void RpcApiTable::add_debug_handlers() {
     handlers_[http::method::k_debug_getModifiedAccountsByHash] = &commands::RpcApi::handle_debug_get_modified_accounts_by_hash;
     handlers_[http::method::k_debug_storageRangeAt] = &commands::RpcApi::handle_debug_storage_range_at;
     handlers_[http::method::k_debug_traceTransaction] = &commands::RpcApi::handle_debug_trace_transaction;
+    stream_handlers_[http::method::k_debug_traceTransaction] = &commands::RpcApi::handle_debug_trace_transaction;
     handlers_[http::method::k_debug_traceCall] = &commands::RpcApi::handle_debug_trace_call;
     handlers_[http::method::k_debug_traceBlockByNumber] = &commands::RpcApi::handle_debug_trace_block_by_number;
+    stream_handlers_[http::method::k_debug_traceBlockByNumber] = &commands::RpcApi::handle_debug_trace_block_by_number;
     handlers_[http::method::k_debug_traceBlockByHash] = &commands::RpcApi::handle_debug_trace_block_by_hash;
+    stream_handlers_[http::method::k_debug_traceBlockByHash] = &commands::RpcApi::handle_debug_trace_block_by_hash;
 }
 
 void RpcApiTable::add_eth_handlers() {
@@ -88,6 +99,7 @@ void RpcApiTable::add_eth_handlers() {
     handlers_[http::method::k_eth_protocolVersion] = &commands::RpcApi::handle_eth_protocol_version;
     handlers_[http::method::k_eth_syncing] = &commands::RpcApi::handle_eth_syncing;
     handlers_[http::method::k_eth_gasPrice] = &commands::RpcApi::handle_eth_gas_price;
+    handlers_[http::method::k_eth_feeHistory] = &commands::RpcApi::handle_eth_fee_history;
     handlers_[http::method::k_eth_getBlockByHash] = &commands::RpcApi::handle_eth_get_block_by_hash;
     handlers_[http::method::k_eth_getBlockByNumber] = &commands::RpcApi::handle_eth_get_block_by_number;
     handlers_[http::method::k_eth_getBlockTransactionCountByHash] = &commands::RpcApi::handle_eth_get_block_transaction_count_by_hash;
@@ -117,6 +129,7 @@ void RpcApiTable::add_eth_handlers() {
     handlers_[http::method::k_eth_getFilterChanges] = &commands::RpcApi::handle_eth_get_filter_changes;
     handlers_[http::method::k_eth_uninstallFilter] = &commands::RpcApi::handle_eth_uninstall_filter;
     handlers_[http::method::k_eth_getLogs] = &commands::RpcApi::handle_eth_get_logs;
+    stream_handlers_[http::method::k_eth_getLogs] = &commands::RpcApi::handle_eth_get_logs;
     handlers_[http::method::k_eth_sendRawTransaction] = &commands::RpcApi::handle_eth_send_raw_transaction;
     handlers_[http::method::k_eth_sendTransaction] = &commands::RpcApi::handle_eth_send_transaction;
     handlers_[http::method::k_eth_signTransaction] = &commands::RpcApi::handle_eth_sign_transaction;
@@ -16,6 +16,7 @@
 
 #include "trace_api.hpp"
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -43,22 +44,9 @@ asio::awaitable<void> TraceRpcApi::handle_trace_call(const nlohmann::json& reque
         co_return;
     }
     const auto call = params[0].get<Call>();
-    const auto trace_type = params[1].get<std::vector<std::string>>();
+    const auto config = params[1].get<trace::TraceConfig>();
     const auto block_number_or_hash = params[2].get<BlockNumberOrHash>();
 
-    trace::TraceConfig config;
-    for (auto entry : trace_type) {
-        if (entry == "trace") {
-            config.trace = true;
-        }
-        if (entry == "vmTrace") {
-            config.vm_trace = true;
-        }
-        if (entry == "stateDiff") {
-            config.state_diff = true;
-        }
-    }
-
     SILKRPC_INFO << "call: " << call << " block_number_or_hash: " << block_number_or_hash << " config: " << config << "\n";
 
     auto tx = co_await database_->begin();
@@ -68,8 +56,9 @@ asio::awaitable<void> TraceRpcApi::handle_trace_call(const nlohmann::json& reque
 
         const auto block_with_hash = co_await core::read_block_by_number_or_hash(*context_.block_cache(), tx_database, block_number_or_hash);
 
-        trace::TraceCallExecutor executor{*context_.io_context(), tx_database, workers_, config};
-        auto result = co_await executor.execute(block_with_hash.block, call);
+        trace::TraceCallExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get(),
+            context_.code_cache().get()};
+        auto result = co_await executor.execute(block_with_hash->block, call);
 
         if (result.pre_check_error) {
             reply = make_json_error(request["id"], -32000, result.pre_check_error.value());
@@ -130,12 +119,47 @@ asio::awaitable<void> TraceRpcApi::handle_trace_raw_transaction(const nlohmann::
 
 // https://eth.wiki/json-rpc/API#trace_replayblocktransactions
 asio::awaitable<void> TraceRpcApi::handle_trace_replay_block_transactions(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() < 2) {
+        auto error_msg = "invalid trace_replayBlockTransactions params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    const auto block_number_or_hash = params[0].get<BlockNumberOrHash>();
+    const auto config = params[1].get<trace::TraceConfig>();
+
+    SILKRPC_INFO << "block_number_or_hash: " << block_number_or_hash << " config: " << config << "\n";
+
     auto tx = co_await database_->begin();
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        reply = make_json_error(request["id"], 500, "not yet implemented");
+        const auto block_with_hash = co_await core::read_block_by_number_or_hash(*context_.block_cache(), tx_database, block_number_or_hash);
+
+        trace::TraceCallExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get(),
+            context_.code_cache().get()};
+        const auto results = co_await executor.execute(block_with_hash->block);
+
+        nlohmann::json traces = nlohmann::json::array();
+        std::optional<std::string> pre_check_error;
+        for (std::size_t idx{0}; idx < results.size(); idx++) {
+            const auto& result = results[idx];
+            if (result.pre_check_error) {
+                pre_check_error = result.pre_check_error;
+                break;
+            }
+            nlohmann::json entry = result.traces;
+            entry["transactionHash"] = block_with_hash->transaction_hashes[idx];
+            traces.push_back(std::move(entry));
+        }
+
+        if (pre_check_error) {
+            reply = make_json_error(request["id"], -32000, pre_check_error.value());
+        } else {
+            reply = make_json_content(request["id"], traces);
+        }
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -170,12 +194,53 @@ asio::awaitable<void> TraceRpcApi::handle_trace_replay_transaction(const nlohman
 
 // https://eth.wiki/json-rpc/API#trace_block
 asio::awaitable<void> TraceRpcApi::handle_trace_block(const nlohmann::json& request, nlohmann::json& reply) {
+    auto params = request["params"];
+    if (params.size() < 1) {
+        auto error_msg = "invalid trace_block params: " + params.dump();
+        SILKRPC_ERROR << error_msg << "\n";
+        reply = make_json_error(request["id"], 100, error_msg);
+        co_return;
+    }
+    const auto block_number_or_hash = params[0].get<BlockNumberOrHash>();
+
+    SILKRPC_INFO << "block_number_or_hash: " << block_number_or_hash << "\n";
+
     auto tx = co_await database_->begin();
 
     try {
         ethdb::TransactionDatabase tx_database{*tx};
 
-        reply = make_json_error(request["id"], 500, "not yet implemented");
+        const auto block_with_hash = co_await core::read_block_by_number_or_hash(*context_.block_cache(), tx_database, block_number_or_hash);
+
+        trace::TraceConfig config{/*vm_trace=*/false, /*trace=*/true, /*state_diff=*/false};
+        trace::TraceCallExecutor executor{*context_.io_context(), tx_database, workers_, config, context_.state_checkpoint_cache().get(),
+            context_.code_cache().get()};
+        const auto results = co_await executor.execute(block_with_hash->block);
+
+        const auto block_number = block_with_hash->block.header.number;
+        nlohmann::json traces = nlohmann::json::array();
+        std::optional<std::string> pre_check_error;
+        for (std::size_t idx{0}; idx < results.size(); idx++) {
+            const auto& result = results[idx];
+            if (result.pre_check_error) {
+                pre_check_error = result.pre_check_error;
+                break;
+            }
+            for (const auto& trace : result.traces.trace) {
+                nlohmann::json entry = trace;
+                entry["blockHash"] = block_with_hash->hash;
+                entry["blockNumber"] = block_number;
+                entry["transactionHash"] = block_with_hash->transaction_hashes[idx];
+                entry["transactionPosition"] = idx;
+                traces.push_back(std::move(entry));
+            }
+        }
+
+        if (pre_check_error) {
+            reply = make_json_error(request["id"], -32000, pre_check_error.value());
+        } else {
+            reply = make_json_content(request["id"], traces);
+        }
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
         reply = make_json_error(request["id"], 100, e.what());
@@ -19,13 +19,18 @@
 #include <string>
 #include <utility>
 
+#include <silkrpc/txpool/pool_mirror.hpp>
+
 namespace silkrpc::commands {
 
 // https://eth.wiki/json-rpc/API#txpool_status
 asio::awaitable<void> TxPoolRpcApi::handle_txpool_status(const nlohmann::json& request, nlohmann::json& reply) {
     try {
-        const auto status = co_await tx_pool_->get_status();
-        TxPoolStatusInfo txpool_status{status.pending_count, status.queued_count, status.base_fee_count};
+        auto status = context_.pool_mirror()->status();
+        if (!status) {
+            status = co_await tx_pool_->get_status();
+        }
+        TxPoolStatusInfo txpool_status{status->pending_count, status->queued_count, status->base_fee_count};
         reply = make_json_content(request["id"], txpool_status);
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << " processing request: " << request.dump() << "\n";
@@ -41,6 +46,13 @@ asio::awaitable<void> TxPoolRpcApi::handle_txpool_status(const nlohmann::json& r
 // https://geth.ethereum.org/docs/rpc/ns-txpool
 asio::awaitable<void> TxPoolRpcApi::handle_txpool_content(const nlohmann::json& request, nlohmann::json& reply) {
     try {
+        // The local mirror has all the transactions already decoded, the remote pool is queried only when not ready
+        const auto mirror_content = context_.pool_mirror()->content();
+        if (mirror_content) {
+            reply = make_json_content(request["id"], *mirror_content);
+            co_return;
+        }
+
         const auto txpool_transactions = co_await tx_pool_->get_transactions();
 
         TransactionContent transactions_content;
@@ -0,0 +1,186 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_cache.hpp"
+
+#include <mutex>
+
+#include <silkworm/common/base.hpp>
+
+namespace silkrpc {
+
+BlockCache::BlockCache(std::size_t capacity_bytes, bool shared_cache)
+    : capacity_bytes_(capacity_bytes), shared_cache_(shared_cache) {
+    // Shard index is taken from one hash byte, so the shard count must be a power of 2 not greater than 256
+    static_assert(kBlockCacheShards > 0 && kBlockCacheShards <= 256 && (kBlockCacheShards & (kBlockCacheShards - 1)) == 0);
+    const std::size_t num_shards = shared_cache_ ? kBlockCacheShards : 1;
+    shard_capacity_bytes_ = capacity_bytes_ / num_shards;
+    shards_.reserve(num_shards);
+    for (std::size_t i{0}; i < num_shards; ++i) {
+        shards_.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+std::shared_ptr<const IndexedBlock> BlockCache::get(const evmc::bytes32& key) {
+    Shard& shard = shard_for(key);
+    std::shared_lock lock{shard.access, std::defer_lock};
+    if (shared_cache_) {
+        lock.lock();
+    }
+    const auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    const Entry& entry = *it->second;
+    entry.referenced.store(true, std::memory_order_relaxed);
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    return entry.block;
+}
+
+void BlockCache::insert(const evmc::bytes32& key, std::shared_ptr<const IndexedBlock> block) {
+    if (!block) {
+        return;
+    }
+    const auto size = estimate_size(*block);
+
+    Shard& shard = shard_for(key);
+    std::unique_lock lock{shard.access, std::defer_lock};
+    if (shared_cache_) {
+        lock.lock();
+    }
+    if (shard.index.find(key) != shard.index.end()) {
+        // Already inserted by a concurrent reader missing on the same block: blocks are immutable, keep the first one
+        return;
+    }
+    // New entries go just behind the hand with the reference bit set, so they are the last ones examined by eviction
+    const auto it = shard.ring.emplace(shard.hand, key, std::move(block), size);
+    shard.index.emplace(key, it);
+    shard.size_bytes += size;
+
+    evict(shard);
+}
+
+std::shared_ptr<const Receipts> BlockCache::get_receipts(const evmc::bytes32& key) {
+    Shard& shard = shard_for(key);
+    std::shared_lock lock{shard.access, std::defer_lock};
+    if (shared_cache_) {
+        lock.lock();
+    }
+    const auto it = shard.index.find(key);
+    if (it == shard.index.end() || !it->second->receipts) {
+        shard.receipts_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    const Entry& entry = *it->second;
+    entry.referenced.store(true, std::memory_order_relaxed);
+    shard.receipts_hits.fetch_add(1, std::memory_order_relaxed);
+    return entry.receipts;
+}
+
+void BlockCache::insert_receipts(const evmc::bytes32& key, std::shared_ptr<const Receipts> receipts) {
+    if (!receipts) {
+        return;
+    }
+    const auto size = estimate_size(*receipts);
+
+    Shard& shard = shard_for(key);
+    std::unique_lock lock{shard.access, std::defer_lock};
+    if (shared_cache_) {
+        lock.lock();
+    }
+    const auto it = shard.index.find(key);
+    if (it == shard.index.end() || it->second->receipts) {
+        return;
+    }
+    Entry& entry = *it->second;
+    entry.receipts = std::move(receipts);
+    entry.size += size;
+    entry.referenced.store(true, std::memory_order_relaxed);
+    shard.size_bytes += size;
+
+    evict(shard);
+}
+
+BlockCache::Stats BlockCache::stats() const {
+    Stats stats;
+    for (const auto& shard : shards_) {
+        std::shared_lock lock{shard->access, std::defer_lock};
+        if (shared_cache_) {
+            lock.lock();
+        }
+        stats.hits += shard->hits.load(std::memory_order_relaxed);
+        stats.misses += shard->misses.load(std::memory_order_relaxed);
+        stats.evictions += shard->evictions.load(std::memory_order_relaxed);
+        stats.receipts_hits += shard->receipts_hits.load(std::memory_order_relaxed);
+        stats.receipts_misses += shard->receipts_misses.load(std::memory_order_relaxed);
+        stats.entries += shard->index.size();
+        stats.size_bytes += shard->size_bytes;
+    }
+    return stats;
+}
+
+std::size_t BlockCache::estimate_size(const IndexedBlock& block_with_hash) {
+    const auto& block = block_with_hash.block;
+    std::size_t size = sizeof(IndexedBlock) + block.header.extra_data.size();
+    // Each transaction hash is stored once in the vector and once more as key of the index
+    size += block.transactions.size() * (3 * silkworm::kHashLength);
+    for (const auto& transaction : block.transactions) {
+        size += sizeof(silkworm::Transaction) + transaction.data.size();
+        for (const auto& entry : transaction.access_list) {
+            size += sizeof(silkworm::AccessListEntry) + entry.storage_keys.size() * silkworm::kHashLength;
+        }
+    }
+    for (const auto& ommer : block.ommers) {
+        size += sizeof(silkworm::BlockHeader) + ommer.extra_data.size();
+    }
+    return size;
+}
+
+std::size_t BlockCache::estimate_size(const Receipts& receipts) {
+    std::size_t size = sizeof(Receipts);
+    for (const auto& receipt : receipts) {
+        size += sizeof(Receipt);
+        for (const auto& log : receipt.logs) {
+            size += sizeof(Log) + log.topics.size() * silkworm::kHashLength + log.data.size();
+        }
+    }
+    return size;
+}
+
+BlockCache::Shard& BlockCache::shard_for(const evmc::bytes32& key) const {
+    // Block hashes are uniformly distributed, so any byte is good enough to pick the shard
+    return *shards_[key.bytes[silkworm::kHashLength - 1] & (shards_.size() - 1)];
+}
+
+void BlockCache::evict(Shard& shard) {
+    // The most recent entry is always kept, even when it alone exceeds the shard capacity
+    while (shard.size_bytes > shard_capacity_bytes_ && shard.ring.size() > 1) {
+        if (shard.hand == shard.ring.end()) {
+            shard.hand = shard.ring.begin();
+        }
+        if (shard.hand->referenced.exchange(false, std::memory_order_relaxed)) {
+            ++shard.hand;
+            continue;
+        }
+        shard.size_bytes -= shard.hand->size;
+        shard.index.erase(shard.hand->key);
+        shard.hand = shard.ring.erase(shard.hand);
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace silkrpc
@@ -17,47 +17,97 @@
 #ifndef SILKRPC_COMMON_BLOCK_CACHE_HPP_
 #define SILKRPC_COMMON_BLOCK_CACHE_HPP_
 
+#include <atomic>
 #include <cstddef>
-#include <mutex>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <evmc/evmc.hpp>
-#include <silkworm/chain/config.hpp>
-#include <silkworm/common/util.hpp>
-#include <silkworm/common/base.hpp>
-#include <silkworm/execution/address.hpp>
-#include <silkworm/db/util.hpp>
-#include <silkworm/types/receipt.hpp>
-#include <silkworm/types/transaction.hpp>
 
-#include <boost/compute/detail/lru_cache.hpp>
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/types/block.hpp>
+#include <silkrpc/types/receipt.hpp>
 
 namespace silkrpc {
 
+//! Concurrent cache of blocks keyed by block hash.
+//! Entries are split into shards by hash, each shard guarded by its own shared mutex so that lookups on different
+//! (or even the same) shards proceed in parallel. Capacity is expressed in bytes and eviction uses the CLOCK policy,
+//! which lets a lookup mark an entry as recently used without taking the exclusive lock.
+//! The fully derived receipts of a cached block can be attached to its entry: they count against the same capacity
+//! and are evicted together with the block.
 class BlockCache {
 public:
-    explicit BlockCache(std::size_t capacity = 1024, bool shared_cache = true)
-        : block_cache_(capacity), shared_cache_(shared_cache) {}
-
-    boost::optional <silkworm::BlockWithHash> get(const evmc::bytes32& key) {
-        if (shared_cache_) {
-            const std::lock_guard<std::mutex> lock(access_);
-            return block_cache_.get(key);
-        }
-        return block_cache_.get(key);
-    }
-
-    void insert(const evmc::bytes32 &key, const silkworm::BlockWithHash& block) {
-        if (shared_cache_) {
-            const std::lock_guard<std::mutex> lock(access_);
-            return block_cache_.insert(key, block);
-        }
-        block_cache_.insert(key, block);
-    }
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        uint64_t receipts_hits{0};
+        uint64_t receipts_misses{0};
+        std::size_t entries{0};
+        std::size_t size_bytes{0};
+    };
+
+    explicit BlockCache(std::size_t capacity_bytes = kDefaultBlockCacheSize, bool shared_cache = true);
+
+    BlockCache(const BlockCache&) = delete;
+    BlockCache& operator=(const BlockCache&) = delete;
+
+    std::shared_ptr<const IndexedBlock> get(const evmc::bytes32& key);
+
+    void insert(const evmc::bytes32& key, std::shared_ptr<const IndexedBlock> block);
+
+    std::shared_ptr<const Receipts> get_receipts(const evmc::bytes32& key);
+
+    //! Attach the receipts to the cached block with the given hash, if any (receipts of uncached blocks are dropped)
+    void insert_receipts(const evmc::bytes32& key, std::shared_ptr<const Receipts> receipts);
+
+    std::size_t capacity() const noexcept { return capacity_bytes_; }
+
+    Stats stats() const;
+
+    static std::size_t estimate_size(const IndexedBlock& block);
+
+    static std::size_t estimate_size(const Receipts& receipts);
 
 private:
-    mutable std::mutex access_;
-    boost::compute::detail::lru_cache<evmc::bytes32, silkworm::BlockWithHash> block_cache_;
+    struct Entry {
+        Entry(const evmc::bytes32& k, std::shared_ptr<const IndexedBlock> b, std::size_t s)
+            : key{k}, block{std::move(b)}, size{s} {}
+
+        evmc::bytes32 key;
+        std::shared_ptr<const IndexedBlock> block;
+        std::shared_ptr<const Receipts> receipts;
+        std::size_t size;
+        mutable std::atomic_bool referenced{true};
+    };
+
+    struct Shard {
+        mutable std::shared_mutex access;
+        std::list<Entry> ring;
+        std::list<Entry>::iterator hand{ring.end()};
+        std::unordered_map<evmc::bytes32, std::list<Entry>::iterator> index;
+        std::size_t size_bytes{0};
+        std::atomic_uint64_t hits{0};
+        std::atomic_uint64_t misses{0};
+        std::atomic_uint64_t evictions{0};
+        std::atomic_uint64_t receipts_hits{0};
+        std::atomic_uint64_t receipts_misses{0};
+    };
+
+    Shard& shard_for(const evmc::bytes32& key) const;
+
+    void evict(Shard& shard);
+
+    std::size_t capacity_bytes_;
+    std::size_t shard_capacity_bytes_;
     bool shared_cache_;
+    std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 } // namespace silkrpc
@@ -15,6 +15,10 @@
 */
 
 #include "block_cache.hpp"
+
+#include <memory>
+#include <utility>
+
 #include <catch2/catch.hpp>
 
 namespace silkrpc {
@@ -22,6 +26,13 @@ namespace silkrpc {
 using Catch::Matchers::Message;
 using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
 
+static std::shared_ptr<const IndexedBlock> make_block(const evmc::bytes32& hash, uint64_t number = 0) {
+    silkworm::BlockWithHash block_with_hash;
+    block_with_hash.block.header.number = number;
+    block_with_hash.hash = hash;
+    return std::make_shared<const IndexedBlock>(std::move(block_with_hash));
+}
+
 TEST_CASE("check get cache key not present(lock)", "[silkrpc][commands][block_cache]") {
     BlockCache block_cache(1, true);
     evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
@@ -41,27 +52,129 @@ TEST_CASE("check get cache key not present(no-lock)", "[silkrpc][commands][block
 TEST_CASE("insert entry in cache(lock)", "[silkrpc][commands][block_cache]") {
     evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
     BlockCache block_cache(1, true);
-    auto ret_block_option = block_cache.get(bh1);
-    CHECK(!ret_block_option);
+    auto ret_block = block_cache.get(bh1);
+    CHECK(!ret_block);
 
-    const silkworm::BlockWithHash block1 {};
+    const auto block1 = make_block(bh1);
     block_cache.insert(bh1, block1);
 
-    ret_block_option = block_cache.get(bh1);
-    CHECK((*ret_block_option).hash == block1.hash);
+    ret_block = block_cache.get(bh1);
+    CHECK(ret_block == block1);
+    CHECK(ret_block->hash == block1->hash);
 }
 
 TEST_CASE("insert entry in cache(no-lock)", "[silkrpc][commands][block_cache]") {
     evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
     BlockCache block_cache(1, false);
-    auto ret_block_option = block_cache.get(bh1);
-    CHECK(!ret_block_option);
+    auto ret_block = block_cache.get(bh1);
+    CHECK(!ret_block);
+
+    const auto block1 = make_block(bh1);
+    block_cache.insert(bh1, block1);
+
+    ret_block = block_cache.get(bh1);
+    CHECK(ret_block == block1);
+    CHECK(ret_block->hash == block1->hash);
+}
+
+TEST_CASE("insert same key twice keeps first entry", "[silkrpc][commands][block_cache]") {
+    evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    BlockCache block_cache(1024 * 1024, true);
 
-    const silkworm::BlockWithHash block1 {};
+    const auto block1 = make_block(bh1, 1);
+    const auto block2 = make_block(bh1, 2);
     block_cache.insert(bh1, block1);
+    block_cache.insert(bh1, block2);
 
-    ret_block_option = block_cache.get(bh1);
-    CHECK((*ret_block_option).hash == block1.hash);
+    CHECK(block_cache.get(bh1) == block1);
+    CHECK(block_cache.stats().entries == 1);
+    CHECK(block_cache.stats().size_bytes == BlockCache::estimate_size(*block1));
+}
+
+TEST_CASE("evict entries when capacity in bytes is exceeded", "[silkrpc][commands][block_cache]") {
+    evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    evmc::bytes32 bh2{0x474f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    evmc::bytes32 bh3{0x574f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    const auto block1 = make_block(bh1, 1);
+    const auto block2 = make_block(bh2, 2);
+    const auto block3 = make_block(bh3, 3);
+    const auto block_size = BlockCache::estimate_size(*block1);
+
+    BlockCache block_cache(2 * block_size, false);
+    block_cache.insert(bh1, block1);
+    block_cache.insert(bh2, block2);
+    CHECK(block_cache.stats().entries == 2);
+    CHECK(block_cache.stats().evictions == 0);
+
+    SECTION("least recently referenced entry is evicted") {
+        block_cache.insert(bh3, block3);
+        CHECK(block_cache.stats().entries == 2);
+        CHECK(block_cache.stats().evictions == 1);
+        CHECK(block_cache.stats().size_bytes <= block_cache.capacity());
+        CHECK(block_cache.get(bh3) == block3);
+    }
+
+    SECTION("entry evicted from cache is still valid for holders") {
+        const auto held_block = block_cache.get(bh1);
+        block_cache.insert(bh3, block3);
+        block_cache.insert(bh1, make_block(bh1, 1));
+        CHECK(held_block->block.header.number == 1);
+        CHECK(block_cache.stats().entries == 2);
+    }
+}
+
+TEST_CASE("receipts attached to cached blocks", "[silkrpc][commands][block_cache]") {
+    evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    evmc::bytes32 bh2{0x474f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    const auto receipts = std::make_shared<const Receipts>(Receipts{Receipt{true, 21000}});
+
+    SECTION("receipts of uncached block are dropped") {
+        BlockCache block_cache;
+        block_cache.insert_receipts(bh1, receipts);
+        CHECK(!block_cache.get_receipts(bh1));
+        CHECK(block_cache.stats().receipts_misses == 1);
+    }
+
+    SECTION("receipts of cached block are returned and accounted") {
+        BlockCache block_cache;
+        block_cache.insert(bh1, make_block(bh1, 1));
+        const auto block_only_size = block_cache.stats().size_bytes;
+        CHECK(!block_cache.get_receipts(bh1));
+        block_cache.insert_receipts(bh1, receipts);
+        CHECK(block_cache.get_receipts(bh1) == receipts);
+        CHECK(block_cache.stats().size_bytes == block_only_size + BlockCache::estimate_size(*receipts));
+        CHECK(block_cache.stats().receipts_hits == 1);
+        CHECK(block_cache.stats().receipts_misses == 1);
+    }
+
+    SECTION("receipts are evicted together with their block") {
+        const auto block1 = make_block(bh1, 1);
+        BlockCache block_cache(BlockCache::estimate_size(*block1) + BlockCache::estimate_size(*receipts), false);
+        block_cache.insert(bh1, block1);
+        block_cache.insert_receipts(bh1, receipts);
+        block_cache.insert(bh2, make_block(bh2, 2));
+        CHECK(!block_cache.get(bh1));
+        CHECK(!block_cache.get_receipts(bh1));
+        CHECK(block_cache.stats().entries == 1);
+    }
+}
+
+TEST_CASE("block cache stats", "[silkrpc][commands][block_cache]") {
+    evmc::bytes32 bh1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    evmc::bytes32 bh2{0x474f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+    BlockCache block_cache;
+    CHECK(block_cache.capacity() == kDefaultBlockCacheSize);
+
+    block_cache.insert(bh1, make_block(bh1));
+    CHECK(block_cache.get(bh1));
+    CHECK(block_cache.get(bh1));
+    CHECK(!block_cache.get(bh2));
+
+    const auto stats = block_cache.stats();
+    CHECK(stats.hits == 2);
+    CHECK(stats.misses == 1);
+    CHECK(stats.evictions == 0);
+    CHECK(stats.entries == 1);
 }
 
 } // namespace silkrpc
@@ -0,0 +1,99 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "code_cache.hpp"
+
+#include <mutex>
+
+namespace silkrpc {
+
+
+CodeCache::CodeCache(std::size_t capacity_bytes) : capacity_bytes_(capacity_bytes) {
+    // Shard index is taken from one hash byte, so the shard count must be a power of 2 not greater than 256
+    static_assert(kCodeCacheShards > 0 && kCodeCacheShards <= 256 && (kCodeCacheShards & (kCodeCacheShards - 1)) == 0);
+    shard_capacity_bytes_ = capacity_bytes_ / kCodeCacheShards;
+    shards_.reserve(kCodeCacheShards);
+    for (std::size_t i{0}; i < kCodeCacheShards; ++i) {
+        shards_.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+std::shared_ptr<const silkworm::Bytes> CodeCache::get(const evmc::bytes32& code_hash) {
+    Shard& shard = shard_for(code_hash);
+    std::shared_lock lock{shard.access};
+    const auto it = shard.index.find(code_hash);
+    if (it == shard.index.end()) {
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    const Entry& entry = *it->second;
+    entry.referenced.store(true, std::memory_order_relaxed);
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    return entry.code;
+}
+
+std::shared_ptr<const silkworm::Bytes> CodeCache::insert(const evmc::bytes32& code_hash, silkworm::Bytes code) {
+    Shard& shard = shard_for(code_hash);
+    std::unique_lock lock{shard.access};
+    const auto existing = shard.index.find(code_hash);
+    if (existing != shard.index.end()) {
+        return existing->second->code;
+    }
+    auto code_ptr = std::make_shared<const silkworm::Bytes>(std::move(code));
+    const auto it = shard.ring.emplace(shard.hand, code_hash, code_ptr);
+    shard.index.emplace(code_hash, it);
+    shard.size_bytes += it->size();
+
+    evict(shard);
+
+    return code_ptr;
+}
+
+CodeCache::Stats CodeCache::stats() const {
+    Stats stats;
+    for (const auto& shard : shards_) {
+        std::shared_lock lock{shard->access};
+        stats.hits += shard->hits.load(std::memory_order_relaxed);
+        stats.misses += shard->misses.load(std::memory_order_relaxed);
+        stats.evictions += shard->evictions.load(std::memory_order_relaxed);
+        stats.entries += shard->index.size();
+        stats.size_bytes += shard->size_bytes;
+    }
+    return stats;
+}
+
+CodeCache::Shard& CodeCache::shard_for(const evmc::bytes32& code_hash) const {
+    return *shards_[code_hash.bytes[silkworm::kHashLength - 1] & (shards_.size() - 1)];
+}
+
+void CodeCache::evict(Shard& shard) {
+    // The most recent entry is always kept, even when it alone exceeds the shard capacity
+    while (shard.size_bytes > shard_capacity_bytes_ && shard.ring.size() > 1) {
+        if (shard.hand == shard.ring.end()) {
+            shard.hand = shard.ring.begin();
+        }
+        if (shard.hand->referenced.exchange(false, std::memory_order_relaxed)) {
+            ++shard.hand;
+            continue;
+        }
+        shard.size_bytes -= shard.hand->size();
+        shard.index.erase(shard.hand->code_hash);
+        shard.hand = shard.ring.erase(shard.hand);
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,97 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_CODE_CACHE_HPP_
+#define SILKRPC_COMMON_CODE_CACHE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+#include <silkworm/common/base.hpp>
+
+#include <silkrpc/common/constants.hpp>
+
+namespace silkrpc {
+
+//! Concurrent cache of contract bytecode keyed by code hash.
+//! Code is immutable for a given hash, so entries never need invalidation: they are only evicted when the total
+//! code size exceeds the capacity. Sharding and CLOCK eviction work as in BlockCache.
+class CodeCache {
+public:
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        std::size_t entries{0};
+        std::size_t size_bytes{0};
+    };
+
+    explicit CodeCache(std::size_t capacity_bytes = kDefaultCodeCacheSize);
+
+    CodeCache(const CodeCache&) = delete;
+    CodeCache& operator=(const CodeCache&) = delete;
+
+    std::shared_ptr<const silkworm::Bytes> get(const evmc::bytes32& code_hash);
+
+    std::shared_ptr<const silkworm::Bytes> insert(const evmc::bytes32& code_hash, silkworm::Bytes code);
+
+    std::size_t capacity() const noexcept { return capacity_bytes_; }
+
+    Stats stats() const;
+
+private:
+    struct Entry {
+        Entry(const evmc::bytes32& h, std::shared_ptr<const silkworm::Bytes> c)
+            : code_hash{h}, code{std::move(c)} {}
+
+        std::size_t size() const noexcept { return sizeof(Entry) + code->size(); }
+
+        evmc::bytes32 code_hash;
+        std::shared_ptr<const silkworm::Bytes> code;
+        mutable std::atomic_bool referenced{true};
+    };
+
+    struct Shard {
+        mutable std::shared_mutex access;
+        std::list<Entry> ring;
+        std::list<Entry>::iterator hand{ring.end()};
+        std::unordered_map<evmc::bytes32, std::list<Entry>::iterator> index;
+        std::size_t size_bytes{0};
+        std::atomic_uint64_t hits{0};
+        std::atomic_uint64_t misses{0};
+        std::atomic_uint64_t evictions{0};
+    };
+
+    Shard& shard_for(const evmc::bytes32& code_hash) const;
+
+    void evict(Shard& shard);
+
+    std::size_t capacity_bytes_;
+    std::size_t shard_capacity_bytes_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_CODE_CACHE_HPP_
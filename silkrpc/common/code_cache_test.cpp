@@ -0,0 +1,69 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "code_cache.hpp"
+
+#include <catch2/catch.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_bytes32;
+
+TEST_CASE("CodeCache::get", "[silkrpc][common][code_cache]") {
+    const auto code_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    CodeCache code_cache;
+
+    SECTION("code hash not present") {
+        CHECK(!code_cache.get(code_hash));
+        CHECK(code_cache.stats().misses == 1);
+    }
+
+    SECTION("code hash present") {
+        const silkworm::Bytes code{*silkworm::from_hex("0x0608")};
+        const auto inserted_code = code_cache.insert(code_hash, code);
+        const auto cached_code = code_cache.get(code_hash);
+        CHECK(cached_code == inserted_code);
+        CHECK(*cached_code == code);
+        CHECK(code_cache.stats().hits == 1);
+    }
+}
+
+TEST_CASE("CodeCache::insert", "[silkrpc][common][code_cache]") {
+    const auto code_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    const auto other_hash{0x14491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    const silkworm::Bytes code{*silkworm::from_hex("0x0608")};
+
+    SECTION("same code hash twice keeps first entry") {
+        CodeCache code_cache;
+        const auto first = code_cache.insert(code_hash, code);
+        const auto second = code_cache.insert(code_hash, code);
+        CHECK(first == second);
+        CHECK(code_cache.stats().entries == 1);
+    }
+
+    SECTION("capacity exceeded evicts entries") {
+        CodeCache code_cache{0};
+        const auto held_code = code_cache.insert(code_hash, code);
+        code_cache.insert(other_hash, code);
+        CHECK(code_cache.stats().entries == 1);
+        CHECK(code_cache.stats().evictions == 1);
+        CHECK(!code_cache.get(code_hash));
+        CHECK(*held_code == code);
+    }
+}
+
+} // namespace silkrpc
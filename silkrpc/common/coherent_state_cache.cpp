@@ -0,0 +1,154 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "coherent_state_cache.hpp"
+
+#include <silkworm/common/util.hpp>
+
+namespace silkrpc {
+
+std::optional<std::optional<silkworm::Account>> CoherentStateCache::get_account(uint64_t view_id, uint64_t block_number,
+    const evmc::address& address) {
+    std::scoped_lock lock{access_};
+    if (!is_latest_locked(view_id, block_number)) {
+        return std::nullopt;
+    }
+    const auto account = accounts_.get(address);
+    if (!account) {
+        ++stats_.misses;
+        return std::nullopt;
+    }
+    ++stats_.hits;
+    return *account;
+}
+
+void CoherentStateCache::insert_account(uint64_t view_id, uint64_t block_number, const evmc::address& address,
+    const std::optional<silkworm::Account>& account) {
+    std::scoped_lock lock{access_};
+    // Values read in an older view may have been changed by the state diffs applied since then
+    if (is_latest_locked(view_id, block_number)) {
+        accounts_.insert(address, account);
+    }
+}
+
+std::optional<evmc::bytes32> CoherentStateCache::get_storage(uint64_t view_id, uint64_t block_number, const evmc::address& address,
+    uint64_t incarnation, const evmc::bytes32& location) {
+    std::scoped_lock lock{access_};
+    if (!is_latest_locked(view_id, block_number)) {
+        return std::nullopt;
+    }
+    const auto value = storage_.get(StorageKey{address, incarnation, location});
+    if (!value) {
+        ++stats_.misses;
+        return std::nullopt;
+    }
+    ++stats_.hits;
+    return *value;
+}
+
+void CoherentStateCache::insert_storage(uint64_t view_id, uint64_t block_number, const evmc::address& address, uint64_t incarnation,
+    const evmc::bytes32& location, const evmc::bytes32& value) {
+    std::scoped_lock lock{access_};
+    if (is_latest_locked(view_id, block_number)) {
+        storage_.insert(StorageKey{address, incarnation, location}, value);
+    }
+}
+
+void CoherentStateCache::on_new_view(uint64_t view_id, uint64_t block_number, const std::vector<BlockStateChanges>& changes) {
+    std::scoped_lock lock{access_};
+    for (const auto& block_changes : changes) {
+        apply(block_changes);
+    }
+    latest_view_id_ = view_id;
+    head_block_number_ = block_number;
+    ++stats_.views;
+}
+
+void CoherentStateCache::clear() {
+    std::scoped_lock lock{access_};
+    accounts_.clear();
+    storage_.clear();
+    latest_view_id_.reset();
+    head_block_number_ = 0;
+}
+
+std::optional<uint64_t> CoherentStateCache::latest_view_id() const {
+    std::scoped_lock lock{access_};
+    return latest_view_id_;
+}
+
+CoherentStateCache::Stats CoherentStateCache::stats() const {
+    std::scoped_lock lock{access_};
+    Stats stats{stats_};
+    stats.accounts = accounts_.size();
+    stats.storage_slots = storage_.size();
+    return stats;
+}
+
+bool CoherentStateCache::is_latest(uint64_t view_id, uint64_t block_number) const {
+    std::scoped_lock lock{access_};
+    return is_latest_locked(view_id, block_number);
+}
+
+bool CoherentStateCache::is_latest_locked(uint64_t view_id, uint64_t block_number) const noexcept {
+    return latest_view_id_ && *latest_view_id_ == view_id && block_number > head_block_number_;
+}
+
+void CoherentStateCache::apply(const BlockStateChanges& changes) {
+    // Only entries already cached are refreshed, so that the cache keeps holding the state recently read by requests
+    for (const auto& change : changes.accounts) {
+        if (!change.account) {
+            accounts_.erase(change.address);
+            continue;
+        }
+        const auto& account = *change.account;
+        if (!account) {
+            accounts_.update(change.address, std::nullopt);
+            erase_storage(change.address);
+            continue;
+        }
+        auto cached_account = accounts_.find(change.address);
+        if (!cached_account) {
+            continue;
+        }
+        if (account->incarnation > 0 && account->code_hash == silkworm::kEmptyHash) {
+            // Contract code hash is not encoded in plain state, restore it from the same incarnation if cached
+            if (*cached_account && (*cached_account)->incarnation == account->incarnation) {
+                const auto code_hash = (*cached_account)->code_hash;
+                *cached_account = account;
+                (*cached_account)->code_hash = code_hash;
+            } else {
+                accounts_.erase(change.address);
+            }
+            continue;
+        }
+        *cached_account = account;
+    }
+    for (const auto& change : changes.storage) {
+        const StorageKey key{change.address, change.incarnation, change.location};
+        if (change.value) {
+            storage_.update(key, *change.value);
+        } else {
+            storage_.erase(key);
+        }
+    }
+}
+
+void CoherentStateCache::erase_storage(const evmc::address& address) {
+    storage_.erase_range(StorageKey{address, 0, {}}, [&](const StorageKey& key) { return key.address == address; });
+}
+
+} // namespace silkrpc
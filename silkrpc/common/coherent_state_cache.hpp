@@ -0,0 +1,214 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_COHERENT_STATE_CACHE_HPP_
+#define SILKRPC_COMMON_COHERENT_STATE_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+#include <silkworm/types/account.hpp>
+
+#include <silkrpc/common/constants.hpp>
+
+namespace silkrpc {
+
+//! State diff of one block as notified by the KV StateChanges stream.
+struct BlockStateChanges {
+    struct AccountChange {
+        evmc::address address;
+        //! The new account value (std::nullopt if deleted) or unknown, in which case any cached value is dropped
+        std::optional<std::optional<silkworm::Account>> account;
+    };
+
+    struct StorageChange {
+        evmc::address address;
+        uint64_t incarnation{0};
+        evmc::bytes32 location;
+        //! The new storage value or unknown, in which case any cached value is dropped
+        std::optional<evmc::bytes32> value;
+    };
+
+    std::vector<AccountChange> accounts;
+    std::vector<StorageChange> storage;
+};
+
+//! Cache of recently read accounts and storage slots at the chain head, kept coherent with the latest KV database view
+//! by applying the state diffs notified by the StateChanges stream. Entries are served and inserted only for requests
+//! reading the head state in the latest view: requests on older views or historical blocks always go to the database.
+class CoherentStateCache {
+public:
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t views{0};
+        std::size_t accounts{0};
+        std::size_t storage_slots{0};
+    };
+
+    explicit CoherentStateCache(std::size_t max_accounts = kDefaultCoherentCacheAccounts,
+        std::size_t max_storage_slots = kDefaultCoherentCacheStorageSlots)
+        : accounts_(max_accounts), storage_(max_storage_slots) {}
+
+    CoherentStateCache(const CoherentStateCache&) = delete;
+    CoherentStateCache& operator=(const CoherentStateCache&) = delete;
+
+    //! Get the account read at block_number in view_id: empty if not cached, holding std::nullopt if cached as non-existent
+    std::optional<std::optional<silkworm::Account>> get_account(uint64_t view_id, uint64_t block_number, const evmc::address& address);
+
+    void insert_account(uint64_t view_id, uint64_t block_number, const evmc::address& address, const std::optional<silkworm::Account>& account);
+
+    std::optional<evmc::bytes32> get_storage(uint64_t view_id, uint64_t block_number, const evmc::address& address, uint64_t incarnation,
+        const evmc::bytes32& location);
+
+    void insert_storage(uint64_t view_id, uint64_t block_number, const evmc::address& address, uint64_t incarnation,
+        const evmc::bytes32& location, const evmc::bytes32& value);
+
+    //! Check if reading block_number in view_id means reading the head state of the latest view
+    bool is_latest(uint64_t view_id, uint64_t block_number) const;
+
+    //! Switch to the new latest view, whose head is block_number, after applying the given block diffs in order
+    void on_new_view(uint64_t view_id, uint64_t block_number, const std::vector<BlockStateChanges>& changes);
+
+    //! Drop all entries and the latest view, e.g. when some state changes may have been missed
+    void clear();
+
+    std::optional<uint64_t> latest_view_id() const;
+
+    Stats stats() const;
+
+private:
+    //! Ordered map with least-recently-used eviction
+    template <typename Key, typename Value>
+    class LruMap {
+    public:
+        explicit LruMap(std::size_t capacity) : capacity_(capacity) {}
+
+        const Value* get(const Key& key) {
+            const auto it = entries_.find(key);
+            if (it == entries_.end()) {
+                return nullptr;
+            }
+            recency_.splice(recency_.begin(), recency_, it->second.position);
+            return &it->second.value;
+        }
+
+        //! Find the value if present, leaving its recency untouched
+        Value* find(const Key& key) {
+            const auto it = entries_.find(key);
+            return it != entries_.end() ? &it->second.value : nullptr;
+        }
+
+        void insert(const Key& key, const Value& value) {
+            if (update(key, value) || capacity_ == 0) {
+                return;
+            }
+            if (entries_.size() == capacity_) {
+                entries_.erase(recency_.back());
+                recency_.pop_back();
+            }
+            recency_.push_front(key);
+            entries_.emplace(key, Entry{value, recency_.begin()});
+        }
+
+        //! Replace the value if present, leaving its recency untouched
+        bool update(const Key& key, const Value& value) {
+            const auto it = entries_.find(key);
+            if (it == entries_.end()) {
+                return false;
+            }
+            it->second.value = value;
+            return true;
+        }
+
+        void erase(const Key& key) {
+            const auto it = entries_.find(key);
+            if (it != entries_.end()) {
+                recency_.erase(it->second.position);
+                entries_.erase(it);
+            }
+        }
+
+        //! Erase the consecutive keys starting from the first one not less than lower while they satisfy in_range
+        template <typename Predicate>
+        void erase_range(const Key& lower, Predicate in_range) {
+            auto it = entries_.lower_bound(lower);
+            while (it != entries_.end() && in_range(it->first)) {
+                recency_.erase(it->second.position);
+                it = entries_.erase(it);
+            }
+        }
+
+        void clear() {
+            entries_.clear();
+            recency_.clear();
+        }
+
+        std::size_t size() const noexcept { return entries_.size(); }
+
+    private:
+        struct Entry {
+            Value value;
+            typename std::list<Key>::iterator position;
+        };
+
+        std::size_t capacity_;
+        std::list<Key> recency_;
+        std::map<Key, Entry> entries_;
+    };
+
+    struct StorageKey {
+        evmc::address address;
+        uint64_t incarnation;
+        evmc::bytes32 location;
+
+        friend bool operator<(const StorageKey& lhs, const StorageKey& rhs) {
+            return std::tie(lhs.address, lhs.incarnation, lhs.location) < std::tie(rhs.address, rhs.incarnation, rhs.location);
+        }
+    };
+
+    //! Same as is_latest but the lock must be held
+    bool is_latest_locked(uint64_t view_id, uint64_t block_number) const noexcept;
+
+    void apply(const BlockStateChanges& changes);
+
+    void erase_storage(const evmc::address& address);
+
+    mutable std::mutex access_;
+    std::optional<uint64_t> latest_view_id_;
+    uint64_t head_block_number_{0};
+    LruMap<evmc::address, std::optional<silkworm::Account>> accounts_;
+    LruMap<StorageKey, evmc::bytes32> storage_;
+    Stats stats_;
+};
+
+//! The coherent state cache as seen by requests reading one database view.
+struct CoherentStateView {
+    CoherentStateCache* cache{nullptr};
+    uint64_t view_id{0};
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_COHERENT_STATE_CACHE_HPP_
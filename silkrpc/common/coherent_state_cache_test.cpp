@@ -0,0 +1,182 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "coherent_state_cache.hpp"
+
+#include <catch2/catch.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
+
+TEST_CASE("CoherentStateCache accounts", "[silkrpc][common][coherent_state_cache]") {
+    const auto address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    CoherentStateCache cache;
+    silkworm::Account account;
+    account.nonce = 12;
+
+    SECTION("nothing served before first view") {
+        cache.insert_account(0, 1, address, account);
+        CHECK(!cache.get_account(0, 1, address));
+        CHECK(!cache.latest_view_id());
+    }
+
+    cache.on_new_view(5, 100, {});
+    CHECK(cache.latest_view_id() == 5);
+
+    SECTION("account present in latest view at head") {
+        cache.insert_account(5, 101, address, account);
+        const auto cached_account = cache.get_account(5, 101, address);
+        CHECK(cached_account);
+        CHECK(*cached_account);
+        CHECK((*cached_account)->nonce == 12);
+    }
+
+    SECTION("non-existent account present") {
+        cache.insert_account(5, 101, address, std::nullopt);
+        const auto cached_account = cache.get_account(5, 101, address);
+        CHECK(cached_account);
+        CHECK(!*cached_account);
+    }
+
+    SECTION("account not served in other views or below head") {
+        CHECK(cache.is_latest(5, 101));
+        CHECK(!cache.is_latest(4, 101));
+        CHECK(!cache.is_latest(5, 100));
+        cache.insert_account(5, 101, address, account);
+        CHECK(!cache.get_account(4, 101, address));
+        CHECK(!cache.get_account(5, 100, address));
+    }
+
+    SECTION("account not inserted from other views or below head") {
+        cache.insert_account(4, 101, address, account);
+        cache.insert_account(5, 100, address, account);
+        CHECK(!cache.get_account(5, 101, address));
+    }
+
+    SECTION("account updated by state changes") {
+        cache.insert_account(5, 101, address, account);
+        silkworm::Account updated_account;
+        updated_account.nonce = 13;
+        BlockStateChanges changes;
+        changes.accounts.push_back({address, updated_account});
+        cache.on_new_view(6, 101, {changes});
+        CHECK(!cache.get_account(5, 101, address));
+        const auto cached_account = cache.get_account(6, 102, address);
+        CHECK(cached_account);
+        CHECK((*cached_account)->nonce == 13);
+    }
+
+    SECTION("account not cached is not added by state changes") {
+        BlockStateChanges changes;
+        changes.accounts.push_back({address, account});
+        cache.on_new_view(6, 101, {changes});
+        CHECK(!cache.get_account(6, 102, address));
+    }
+
+    SECTION("account with unknown value dropped") {
+        cache.insert_account(5, 101, address, account);
+        BlockStateChanges changes;
+        changes.accounts.push_back({address, std::nullopt});
+        cache.on_new_view(6, 100, {changes});
+        CHECK(!cache.get_account(6, 101, address));
+    }
+
+    SECTION("contract code hash restored within same incarnation") {
+        const auto code_hash{0x00000000000000000000000000000000000000000000000000000000000000aa_bytes32};
+        account.incarnation = 1;
+        account.code_hash = code_hash;
+        cache.insert_account(5, 101, address, account);
+        silkworm::Account updated_account;
+        updated_account.incarnation = 1;
+        updated_account.balance = 1;
+        BlockStateChanges changes;
+        changes.accounts.push_back({address, updated_account});
+        cache.on_new_view(6, 101, {changes});
+        const auto cached_account = cache.get_account(6, 102, address);
+        CHECK(cached_account);
+        CHECK((*cached_account)->balance == 1);
+        CHECK((*cached_account)->code_hash == code_hash);
+
+        updated_account.incarnation = 2;
+        changes.accounts = {{address, updated_account}};
+        cache.on_new_view(7, 102, {changes});
+        CHECK(!cache.get_account(7, 103, address));
+    }
+
+    SECTION("clear") {
+        cache.insert_account(5, 101, address, account);
+        cache.clear();
+        CHECK(!cache.latest_view_id());
+        CHECK(!cache.get_account(5, 101, address));
+    }
+}
+
+TEST_CASE("CoherentStateCache storage", "[silkrpc][common][coherent_state_cache]") {
+    const auto address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    const auto location1{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto location2{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32};
+    const auto value{0x00000000000000000000000000000000000000000000000000000000000000ff_bytes32};
+    CoherentStateCache cache{2, 2};
+    cache.on_new_view(5, 100, {});
+
+    SECTION("storage present") {
+        cache.insert_storage(5, 101, address, 1, location1, value);
+        CHECK(cache.get_storage(5, 101, address, 1, location1) == value);
+        CHECK(!cache.get_storage(5, 101, address, 2, location1));
+        CHECK(!cache.get_storage(4, 101, address, 1, location1));
+        const auto stats = cache.stats();
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.storage_slots == 1);
+    }
+
+    SECTION("least recently used storage evicted") {
+        const auto address2{0x0000000000000000000000000000000000000002_address};
+        cache.insert_storage(5, 101, address, 1, location1, value);
+        cache.insert_storage(5, 101, address, 1, location2, value);
+        CHECK(cache.get_storage(5, 101, address, 1, location1));
+        cache.insert_storage(5, 101, address2, 1, location1, value);
+        CHECK(cache.get_storage(5, 101, address, 1, location1));
+        CHECK(!cache.get_storage(5, 101, address, 1, location2));
+        CHECK(cache.get_storage(5, 101, address2, 1, location1));
+    }
+
+    SECTION("storage updated and dropped by state changes") {
+        const auto new_value{0x00000000000000000000000000000000000000000000000000000000000000ee_bytes32};
+        cache.insert_storage(5, 101, address, 1, location1, value);
+        cache.insert_storage(5, 101, address, 1, location2, value);
+        BlockStateChanges changes;
+        changes.storage.push_back({address, 1, location1, new_value});
+        changes.storage.push_back({address, 1, location2, std::nullopt});
+        cache.on_new_view(6, 101, {changes});
+        CHECK(cache.get_storage(6, 102, address, 1, location1) == new_value);
+        CHECK(!cache.get_storage(6, 102, address, 1, location2));
+    }
+
+    SECTION("storage wiped by account deletion") {
+        cache.insert_storage(5, 101, address, 1, location1, value);
+        cache.insert_storage(5, 101, address, 2, location2, value);
+        BlockStateChanges changes;
+        changes.accounts.push_back({address, std::optional<silkworm::Account>{}});
+        cache.on_new_view(6, 101, {changes});
+        CHECK(!cache.get_storage(6, 102, address, 1, location1));
+        CHECK(!cache.get_storage(6, 102, address, 2, location2));
+    }
+}
+
+} // namespace silkrpc
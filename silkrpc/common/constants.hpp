@@ -44,12 +44,62 @@ constexpr const char* kDefaultEth2ApiSpec{"engine,eth"};
 constexpr const std::chrono::milliseconds kDefaultTimeout{10000};
 
 constexpr const std::size_t kHttpIncomingBufferSize{8192};
+constexpr const std::size_t kHttpChunkSize{65536};
 
 constexpr const std::size_t kRequestContentInitialCapacity{1024};
 constexpr const std::size_t kRequestHeadersInitialCapacity{8};
 constexpr const std::size_t kRequestMethodInitialCapacity{64};
 constexpr const std::size_t kRequestUriInitialCapacity{64};
 
+constexpr const std::size_t kDefaultMaxBatchInFlight{64};
+
+constexpr const std::size_t kDefaultEstimateGasProbes{1};
+
+constexpr const std::size_t kDefaultCursorMaxPrefetchSize{256};
+
+constexpr const std::size_t kDefaultBlockCacheSize{128 * 1024 * 1024};
+constexpr const std::size_t kBlockCacheShards{16};
+
+constexpr const std::size_t kDefaultCodeCacheSize{64 * 1024 * 1024};
+constexpr const std::size_t kCodeCacheShards{16};
+
+constexpr const std::size_t kDefaultStateCheckpointCacheSize{64 * 1024 * 1024};
+constexpr const std::size_t kStateCheckpointInterval{16};
+
+constexpr const std::size_t kMaxSpeculativeExecutions{8};
+
+constexpr const std::size_t kDefaultGasPriceCacheBlocks{256};
+
+constexpr const std::size_t kDefaultFeeHistoryCacheBlocks{1024};
+constexpr const std::size_t kMaxFeeHistoryBlocks{1024};
+constexpr const std::size_t kMaxFeeHistoryPercentiles{100};
+
+constexpr const std::size_t kDefaultStateCacheAccounts{65536};
+constexpr const std::size_t kDefaultStateCacheStorageSlots{262144};
+
+constexpr const std::size_t kDefaultCoherentCacheAccounts{65536};
+constexpr const std::size_t kDefaultCoherentCacheStorageSlots{262144};
+
+constexpr const std::chrono::milliseconds kServerStreamingRetryInterval{1000};
+
+constexpr const std::size_t kMaxLogsScanInFlight{8};
+constexpr const std::size_t kLogsScanChunkSize{32};
+
+constexpr const std::chrono::seconds kDefaultFilterTimeout{300};
+constexpr const std::chrono::seconds kFilterSweepInterval{60};
+constexpr const std::size_t kMaxFilters{4096};
+constexpr const std::size_t kMaxFilterCriteria{1024};
+constexpr const std::size_t kMaxFilterChangesBlocks{1024};
+
+constexpr const std::size_t kMaxWebSocketMessageSize{16 * 1024 * 1024};
+constexpr const std::size_t kMaxWebSocketPendingFrames{4096};
+constexpr const std::size_t kMaxSubscriptions{16384};
+
+constexpr const std::size_t kMaxTxPoolMirrorTransactions{262144};
+constexpr const std::chrono::seconds kTxPoolMirrorRefreshInterval{60};
+
+constexpr const std::size_t kMaxDebugTracePendingChunks{8};
+
 } // namespace silkrpc
 
 #endif  // SILKRPC_COMMON_CONSTANTS_HPP_
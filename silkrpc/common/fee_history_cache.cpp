@@ -0,0 +1,51 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "fee_history_cache.hpp"
+
+#include <utility>
+
+namespace silkrpc {
+
+
+std::shared_ptr<const FeeHistoryCache::BlockFees> FeeHistoryCache::find(uint64_t block_number, const evmc::bytes32& block_hash) {
+    std::scoped_lock lock{access_};
+    if (ring_.empty()) {
+        return nullptr;
+    }
+    const auto& entry = ring_[block_number % ring_.size()];
+    if (!entry || entry->block_number != block_number || entry->block_hash != block_hash) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    ++stats_.hits;
+    return entry;
+}
+
+void FeeHistoryCache::insert(std::shared_ptr<const BlockFees> block_fees) {
+    std::scoped_lock lock{access_};
+    if (ring_.empty()) {
+        return;
+    }
+    ring_[block_fees->block_number % ring_.size()] = std::move(block_fees);
+}
+
+FeeHistoryCache::Stats FeeHistoryCache::stats() const {
+    std::scoped_lock lock{access_};
+    return stats_;
+}
+
+} // namespace silkrpc
@@ -0,0 +1,80 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_FEE_HISTORY_CACHE_HPP_
+#define SILKRPC_COMMON_FEE_HISTORY_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+#include <intx/intx.hpp>
+
+#include <silkrpc/common/constants.hpp>
+
+namespace silkrpc {
+
+//! Rolling window of the fee statistics of the most recent blocks, used to answer eth_feeHistory.
+//! Blocks live in a ring buffer indexed by block number and are validated by block hash, so as the head advances
+//! only the new blocks need to be read and chain reorgs just result in cache misses.
+class FeeHistoryCache {
+public:
+    struct TransactionReward {
+        intx::uint256 priority_fee;
+        uint64_t gas_used{0};
+    };
+
+    struct BlockFees {
+        uint64_t block_number{0};
+        evmc::bytes32 block_hash;
+        evmc::bytes32 parent_hash;
+        intx::uint256 base_fee;
+        intx::uint256 next_base_fee;
+        uint64_t gas_used{0};
+        double gas_used_ratio{0};
+        std::vector<TransactionReward> rewards;  // sorted by priority fee in ascending order
+    };
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+    };
+
+    explicit FeeHistoryCache(std::size_t capacity = kDefaultFeeHistoryCacheBlocks) : ring_(capacity) {}
+
+    FeeHistoryCache(const FeeHistoryCache&) = delete;
+    FeeHistoryCache& operator=(const FeeHistoryCache&) = delete;
+
+    std::shared_ptr<const BlockFees> find(uint64_t block_number, const evmc::bytes32& block_hash);
+
+    void insert(std::shared_ptr<const BlockFees> block_fees);
+
+    std::size_t capacity() const noexcept { return ring_.size(); }
+
+    Stats stats() const;
+
+private:
+    mutable std::mutex access_;
+    std::vector<std::shared_ptr<const BlockFees>> ring_;
+    Stats stats_;
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_FEE_HISTORY_CACHE_HPP_
@@ -0,0 +1,62 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "fee_history_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_bytes32;
+
+static std::shared_ptr<const FeeHistoryCache::BlockFees> make_block_fees(uint64_t block_number, const evmc::bytes32& block_hash) {
+    auto block_fees = std::make_shared<FeeHistoryCache::BlockFees>();
+    block_fees->block_number = block_number;
+    block_fees->block_hash = block_hash;
+    return block_fees;
+}
+
+TEST_CASE("FeeHistoryCache::find", "[silkrpc][common][fee_history_cache]") {
+    const auto block_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    const auto other_hash{0x14491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    FeeHistoryCache cache{4};
+
+    SECTION("no block") {
+        CHECK(cache.find(10, block_hash) == nullptr);
+        CHECK(cache.stats().misses == 1);
+    }
+
+    SECTION("same block") {
+        const auto block_fees = make_block_fees(10, block_hash);
+        cache.insert(block_fees);
+        CHECK(cache.find(10, block_hash) == block_fees);
+        CHECK(cache.stats().hits == 1);
+    }
+
+    SECTION("different hash") {
+        cache.insert(make_block_fees(10, block_hash));
+        CHECK(cache.find(10, other_hash) == nullptr);
+    }
+
+    SECTION("overwritten slot") {
+        cache.insert(make_block_fees(10, block_hash));
+        cache.insert(make_block_fees(14, other_hash));
+        CHECK(cache.find(10, block_hash) == nullptr);
+        CHECK(cache.find(14, other_hash) != nullptr);
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,110 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "filter_registry.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace silkrpc {
+
+std::string FilterRegistry::add(StoredFilter filter) {
+    std::size_t criteria{0};
+    if (filter.filter.addresses) {
+        criteria += filter.filter.addresses->size();
+    }
+    if (filter.filter.topics) {
+        for (const auto& sub_topics : *filter.filter.topics) {
+            criteria += sub_topics.size();
+        }
+    }
+    if (criteria > kMaxFilterCriteria) {
+        throw std::invalid_argument{"too many filter criteria: " + std::to_string(criteria)};
+    }
+
+    const auto now = Clock::now();
+    expire(now);
+
+    std::scoped_lock lock{access_};
+    if (filters_.size() >= max_filters_) {
+        throw std::invalid_argument{"too many filters installed: " + std::to_string(filters_.size())};
+    }
+    auto filter_id = generate_id();
+    while (filters_.count(filter_id) != 0) {
+        filter_id = generate_id();
+    }
+    filters_.emplace(filter_id, Entry{std::move(filter), now});
+    return filter_id;
+}
+
+std::optional<FilterRegistry::StoredFilter> FilterRegistry::get(const std::string& filter_id) {
+    const auto now = Clock::now();
+    std::scoped_lock lock{access_};
+    const auto it = filters_.find(filter_id);
+    if (it == filters_.end()) {
+        return std::nullopt;
+    }
+    if (now - it->second.last_access > timeout_) {
+        filters_.erase(it);
+        return std::nullopt;
+    }
+    it->second.last_access = now;
+    return it->second.filter;
+}
+
+bool FilterRegistry::advance(const std::string& filter_id, uint64_t expected_last_block, uint64_t last_block) {
+    std::scoped_lock lock{access_};
+    const auto it = filters_.find(filter_id);
+    if (it == filters_.end() || it->second.filter.last_block != expected_last_block) {
+        return false;
+    }
+    it->second.filter.last_block = last_block;
+    return true;
+}
+
+bool FilterRegistry::remove(const std::string& filter_id) {
+    std::scoped_lock lock{access_};
+    return filters_.erase(filter_id) > 0;
+}
+
+std::size_t FilterRegistry::expire(Clock::time_point now) {
+    std::scoped_lock lock{access_};
+    std::size_t expired{0};
+    for (auto it = filters_.begin(); it != filters_.end();) {
+        if (now - it->second.last_access > timeout_) {
+            it = filters_.erase(it);
+            ++expired;
+        } else {
+            ++it;
+        }
+    }
+    return expired;
+}
+
+std::size_t FilterRegistry::size() const {
+    std::scoped_lock lock{access_};
+    return filters_.size();
+}
+
+std::string FilterRegistry::generate_id() {
+    std::ostringstream id;
+    id << "0x" << std::hex << std::setfill('0') << std::setw(16) << generator_() << std::setw(16) << generator_();
+    return id.str();
+}
+
+} // namespace silkrpc
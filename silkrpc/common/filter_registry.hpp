@@ -0,0 +1,92 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_FILTER_REGISTRY_HPP_
+#define SILKRPC_COMMON_FILTER_REGISTRY_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/types/filter.hpp>
+
+namespace silkrpc {
+
+//! Registry of the filters installed by eth_newFilter and eth_newBlockFilter.
+//! Each filter keeps a cursor to the last block already reported, so that polling its changes only evaluates the blocks
+//! added since. Filters not polled within the timeout expire and their number is bounded, as is the size of each one.
+class FilterRegistry {
+public:
+    enum class FilterType {
+        kLogs,
+        kBlock,
+    };
+
+    struct StoredFilter {
+        FilterType type{FilterType::kLogs};
+        Filter filter;        // the log criteria, used only by log filters
+        uint64_t last_block{0};  // the last block already reported
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    explicit FilterRegistry(std::chrono::seconds timeout = kDefaultFilterTimeout, std::size_t max_filters = kMaxFilters)
+        : timeout_(timeout), max_filters_(max_filters), generator_{std::random_device{}()} {}
+
+    FilterRegistry(const FilterRegistry&) = delete;
+    FilterRegistry& operator=(const FilterRegistry&) = delete;
+
+    //! Install the given filter and return its identifier, throwing std::invalid_argument if it is too large or too many are installed
+    std::string add(StoredFilter filter);
+
+    //! Get the filter with the given identifier, refreshing its expiration
+    std::optional<StoredFilter> get(const std::string& filter_id);
+
+    //! Move the cursor of the filter with the given identifier from the expected block to the given one, failing if
+    //! the filter is unknown or a concurrent poll has already moved it, so that no block is ever reported twice
+    bool advance(const std::string& filter_id, uint64_t expected_last_block, uint64_t last_block);
+
+    bool remove(const std::string& filter_id);
+
+    //! Remove the filters not accessed within the timeout at the given time, returning how many
+    std::size_t expire(Clock::time_point now);
+
+    std::size_t size() const;
+
+private:
+    struct Entry {
+        StoredFilter filter;
+        Clock::time_point last_access;
+    };
+
+    std::string generate_id();
+
+    std::chrono::seconds timeout_;
+    std::size_t max_filters_;
+    mutable std::mutex access_;
+    std::map<std::string, Entry> filters_;
+    std::mt19937_64 generator_;
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_FILTER_REGISTRY_HPP_
@@ -0,0 +1,108 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "filter_registry.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+using Catch::Matchers::Message;
+
+TEST_CASE("FilterRegistry::add", "[silkrpc][common][filter_registry]") {
+    FilterRegistry registry{std::chrono::seconds{60}, 2};
+
+    SECTION("unique identifiers") {
+        const auto id1 = registry.add({FilterRegistry::FilterType::kLogs, Filter{}, 10});
+        const auto id2 = registry.add({FilterRegistry::FilterType::kBlock, Filter{}, 10});
+        CHECK(id1 != id2);
+        CHECK(id1.size() == 34);
+        CHECK(registry.size() == 2);
+    }
+
+    SECTION("too many filters") {
+        registry.add({FilterRegistry::FilterType::kBlock, Filter{}, 10});
+        registry.add({FilterRegistry::FilterType::kBlock, Filter{}, 10});
+        CHECK_THROWS_MATCHES(registry.add({FilterRegistry::FilterType::kBlock, Filter{}, 10}), std::invalid_argument,
+            Message("too many filters installed: 2"));
+    }
+
+    SECTION("too many criteria") {
+        Filter filter;
+        filter.addresses = FilterAddresses(kMaxFilterCriteria + 1);
+        CHECK_THROWS_AS(registry.add({FilterRegistry::FilterType::kLogs, filter, 10}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("FilterRegistry::get", "[silkrpc][common][filter_registry]") {
+    FilterRegistry registry;
+
+    SECTION("unknown filter") {
+        CHECK(!registry.get("0x01"));
+    }
+
+    SECTION("installed filter") {
+        Filter filter;
+        filter.from_block = 5;
+        const auto id = registry.add({FilterRegistry::FilterType::kLogs, filter, 10});
+        const auto stored_filter = registry.get(id);
+        REQUIRE(stored_filter);
+        CHECK(stored_filter->type == FilterRegistry::FilterType::kLogs);
+        CHECK(stored_filter->filter.from_block == 5);
+        CHECK(stored_filter->last_block == 10);
+    }
+
+    SECTION("removed filter") {
+        const auto id = registry.add({FilterRegistry::FilterType::kBlock, Filter{}, 10});
+        CHECK(registry.remove(id));
+        CHECK(!registry.remove(id));
+        CHECK(!registry.get(id));
+    }
+}
+
+TEST_CASE("FilterRegistry::advance", "[silkrpc][common][filter_registry]") {
+    FilterRegistry registry;
+    const auto id = registry.add({FilterRegistry::FilterType::kBlock, Filter{}, 10});
+
+    SECTION("from expected block") {
+        CHECK(registry.advance(id, 10, 12));
+        CHECK(registry.get(id)->last_block == 12);
+        CHECK(registry.advance(id, 12, 15));
+        CHECK(registry.get(id)->last_block == 15);
+    }
+
+    SECTION("concurrent poll already advanced") {
+        CHECK(registry.advance(id, 10, 12));
+        CHECK(!registry.advance(id, 10, 11));
+        CHECK(!registry.advance(id, 10, 14));
+        CHECK(registry.get(id)->last_block == 12);
+    }
+
+    SECTION("unknown filter") {
+        CHECK(!registry.advance("0x01", 10, 12));
+    }
+}
+
+TEST_CASE("FilterRegistry::expire", "[silkrpc][common][filter_registry]") {
+    FilterRegistry registry{std::chrono::seconds{60}};
+    registry.add({FilterRegistry::FilterType::kBlock, Filter{}, 10});
+
+    CHECK(registry.expire(FilterRegistry::Clock::now()) == 0);
+    CHECK(registry.expire(FilterRegistry::Clock::now() + std::chrono::seconds{61}) == 1);
+    CHECK(registry.size() == 0);
+}
+
+} // namespace silkrpc
@@ -0,0 +1,100 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "gas_price_cache.hpp"
+
+namespace silkrpc {
+
+
+std::shared_ptr<const GasPriceCache::BlockPrices> GasPriceCache::find_block(uint64_t block_number, const evmc::bytes32& block_hash) {
+    std::scoped_lock lock{access_};
+    if (ring_.empty()) {
+        return nullptr;
+    }
+    const auto& entry = ring_[block_number % ring_.size()];
+    if (!entry || entry->block_number != block_number || entry->block_hash != block_hash) {
+        ++stats_.block_misses;
+        return nullptr;
+    }
+    ++stats_.block_hits;
+    return entry;
+}
+
+void GasPriceCache::insert_block(std::shared_ptr<const BlockPrices> block_prices) {
+    std::scoped_lock lock{access_};
+    if (ring_.empty()) {
+        return;
+    }
+    ring_[block_prices->block_number % ring_.size()] = std::move(block_prices);
+}
+
+std::optional<intx::uint256> GasPriceCache::find_price(const evmc::bytes32& block_hash) {
+    std::scoped_lock lock{access_};
+    if (latest_price_ && latest_price_->first == block_hash) {
+        ++stats_.price_hits;
+        return latest_price_->second;
+    }
+    ++stats_.price_misses;
+    return std::nullopt;
+}
+
+bool GasPriceCache::begin_price(const evmc::bytes32& block_hash) {
+    std::scoped_lock lock{access_};
+    if (latest_price_ && latest_price_->first == block_hash) {
+        return false;
+    }
+    return pending_.try_emplace(block_hash).second;
+}
+
+void GasPriceCache::wait_price(const evmc::bytes32& block_hash, PriceHandler handler) {
+    std::optional<intx::uint256> price;
+    {
+        std::scoped_lock lock{access_};
+        if (latest_price_ && latest_price_->first == block_hash) {
+            price = latest_price_->second;
+        } else if (auto it = pending_.find(block_hash); it != pending_.end()) {
+            ++stats_.coalesced;
+            it->second.push_back(std::move(handler));
+            return;
+        }
+    }
+    // Either the price is ready or the computation in flight has already failed
+    handler(price);
+}
+
+void GasPriceCache::end_price(const evmc::bytes32& block_hash, std::optional<intx::uint256> price) {
+    std::vector<PriceHandler> handlers;
+    {
+        std::scoped_lock lock{access_};
+        if (price) {
+            latest_price_ = std::make_pair(block_hash, *price);
+        }
+        if (auto it = pending_.find(block_hash); it != pending_.end()) {
+            handlers = std::move(it->second);
+            pending_.erase(it);
+        }
+    }
+    for (auto& handler : handlers) {
+        handler(price);
+    }
+}
+
+GasPriceCache::Stats GasPriceCache::stats() const {
+    std::scoped_lock lock{access_};
+    return stats_;
+}
+
+} // namespace silkrpc
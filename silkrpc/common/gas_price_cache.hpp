@@ -0,0 +1,94 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_GAS_PRICE_CACHE_HPP_
+#define SILKRPC_COMMON_GAS_PRICE_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+#include <intx/intx.hpp>
+
+#include <silkrpc/common/constants.hpp>
+
+namespace silkrpc {
+
+//! Cache of the gas price samples taken from each block plus the price suggested for the latest head.
+//! Samples live in a ring buffer indexed by block number and are validated by block hash, so chain reorgs just
+//! result in cache misses. Concurrent computations of the suggested price for the same head are coalesced.
+class GasPriceCache {
+public:
+    struct BlockPrices {
+        uint64_t block_number{0};
+        evmc::bytes32 block_hash;
+        evmc::bytes32 parent_hash;
+        std::vector<intx::uint256> prices; // the lowest sampled prices sorted in ascending order
+    };
+
+    //! Handler notified with the suggested price when the computation in flight completes (std::nullopt if it failed)
+    using PriceHandler = std::function<void(std::optional<intx::uint256>)>;
+
+    struct Stats {
+        uint64_t block_hits{0};
+        uint64_t block_misses{0};
+        uint64_t price_hits{0};
+        uint64_t price_misses{0};
+        uint64_t coalesced{0};
+    };
+
+    explicit GasPriceCache(std::size_t capacity = kDefaultGasPriceCacheBlocks) : ring_(capacity) {}
+
+    GasPriceCache(const GasPriceCache&) = delete;
+    GasPriceCache& operator=(const GasPriceCache&) = delete;
+
+    std::shared_ptr<const BlockPrices> find_block(uint64_t block_number, const evmc::bytes32& block_hash);
+
+    void insert_block(std::shared_ptr<const BlockPrices> block_prices);
+
+    std::optional<intx::uint256> find_price(const evmc::bytes32& block_hash);
+
+    //! Start the price computation for the given head: return false if the price is already cached or in flight
+    bool begin_price(const evmc::bytes32& block_hash);
+
+    //! Notify the handler when the price for the given head is available, immediately if it already is
+    void wait_price(const evmc::bytes32& block_hash, PriceHandler handler);
+
+    //! Complete the price computation for the given head, notifying any waiting handler
+    void end_price(const evmc::bytes32& block_hash, std::optional<intx::uint256> price);
+
+    std::size_t capacity() const noexcept { return ring_.size(); }
+
+    Stats stats() const;
+
+private:
+    mutable std::mutex access_;
+    std::vector<std::shared_ptr<const BlockPrices>> ring_;
+    std::optional<std::pair<evmc::bytes32, intx::uint256>> latest_price_;
+    std::map<evmc::bytes32, std::vector<PriceHandler>> pending_;
+    Stats stats_;
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_GAS_PRICE_CACHE_HPP_
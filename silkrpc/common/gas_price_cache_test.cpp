@@ -0,0 +1,122 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "gas_price_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_bytes32;
+
+static std::shared_ptr<const GasPriceCache::BlockPrices> make_block_prices(uint64_t block_number, const evmc::bytes32& block_hash) {
+    auto block_prices = std::make_shared<GasPriceCache::BlockPrices>();
+    block_prices->block_number = block_number;
+    block_prices->block_hash = block_hash;
+    block_prices->prices = {intx::uint256{1}, intx::uint256{2}};
+    return block_prices;
+}
+
+TEST_CASE("GasPriceCache::find_block", "[silkrpc][common][gas_price_cache]") {
+    const auto block_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    const auto other_hash{0x14491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    GasPriceCache cache{4};
+
+    SECTION("no block") {
+        CHECK(cache.find_block(10, block_hash) == nullptr);
+        CHECK(cache.stats().block_misses == 1);
+    }
+
+    SECTION("same block") {
+        const auto block_prices = make_block_prices(10, block_hash);
+        cache.insert_block(block_prices);
+        CHECK(cache.find_block(10, block_hash) == block_prices);
+        CHECK(cache.stats().block_hits == 1);
+    }
+
+    SECTION("different hash") {
+        cache.insert_block(make_block_prices(10, block_hash));
+        CHECK(cache.find_block(10, other_hash) == nullptr);
+    }
+
+    SECTION("overwritten slot") {
+        cache.insert_block(make_block_prices(10, block_hash));
+        cache.insert_block(make_block_prices(14, other_hash));
+        CHECK(cache.find_block(10, block_hash) == nullptr);
+        CHECK(cache.find_block(14, other_hash) != nullptr);
+    }
+}
+
+TEST_CASE("GasPriceCache::begin_price", "[silkrpc][common][gas_price_cache]") {
+    const auto block_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    GasPriceCache cache;
+
+    SECTION("first computation") {
+        CHECK(cache.begin_price(block_hash));
+        CHECK(!cache.begin_price(block_hash));
+    }
+
+    SECTION("completed computation") {
+        CHECK(cache.begin_price(block_hash));
+        cache.end_price(block_hash, intx::uint256{7});
+        CHECK(!cache.begin_price(block_hash));
+        CHECK(cache.find_price(block_hash) == intx::uint256{7});
+    }
+
+    SECTION("failed computation") {
+        CHECK(cache.begin_price(block_hash));
+        cache.end_price(block_hash, std::nullopt);
+        CHECK(!cache.find_price(block_hash));
+        CHECK(cache.begin_price(block_hash));
+    }
+}
+
+TEST_CASE("GasPriceCache::wait_price", "[silkrpc][common][gas_price_cache]") {
+    const auto block_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    GasPriceCache cache;
+    std::vector<std::optional<intx::uint256>> notified;
+    auto handler = [&](std::optional<intx::uint256> price) { notified.push_back(price); };
+
+    SECTION("price already available") {
+        cache.begin_price(block_hash);
+        cache.end_price(block_hash, intx::uint256{7});
+        cache.wait_price(block_hash, handler);
+        REQUIRE(notified.size() == 1);
+        CHECK(notified[0] == intx::uint256{7});
+    }
+
+    SECTION("computation in flight") {
+        cache.begin_price(block_hash);
+        cache.wait_price(block_hash, handler);
+        cache.wait_price(block_hash, handler);
+        CHECK(notified.empty());
+        CHECK(cache.stats().coalesced == 2);
+        cache.end_price(block_hash, intx::uint256{7});
+        REQUIRE(notified.size() == 2);
+        CHECK(notified[0] == intx::uint256{7});
+        CHECK(notified[1] == intx::uint256{7});
+    }
+
+    SECTION("computation failed") {
+        cache.begin_price(block_hash);
+        cache.wait_price(block_hash, handler);
+        cache.end_price(block_hash, std::nullopt);
+        REQUIRE(notified.size() == 1);
+        CHECK(!notified[0]);
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,137 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_STATE_CACHE_HPP_
+#define SILKRPC_COMMON_STATE_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
+#include <evmc/evmc.hpp>
+#include <silkworm/types/account.hpp>
+
+#include <boost/compute/detail/lru_cache.hpp>
+
+#include <silkrpc/common/constants.hpp>
+
+namespace silkrpc {
+
+//! LRU cache of historical account and storage values shared among requests.
+//! Values are keyed by the block number they refer to, so only values resolved from history (i.e. later changed)
+//! must be inserted: those never change unless the chain is unwound past their block, in which case invalidate() must be
+//! used. Values are inserted along with the database view they were read from, so that those read from views preceding
+//! the unwind are dropped even if they complete afterwards.
+class StateCache {
+public:
+    explicit StateCache(std::size_t max_accounts = kDefaultStateCacheAccounts, std::size_t max_storage_slots = kDefaultStateCacheStorageSlots)
+        : accounts_(max_accounts), storage_(max_storage_slots) {}
+
+    StateCache(const StateCache&) = delete;
+    StateCache& operator=(const StateCache&) = delete;
+
+    //! Get the account at the given block: empty if not cached, holding std::nullopt if cached as non-existent
+    std::optional<std::optional<silkworm::Account>> get_account(const evmc::address& address, uint64_t block_number) {
+        const std::lock_guard<std::mutex> lock(accounts_access_);
+        const auto account = accounts_.get(AccountKey{block_number, address});
+        if (!account) {
+            return std::nullopt;
+        }
+        return *account;
+    }
+
+    void insert_account(const evmc::address& address, uint64_t block_number, const std::optional<silkworm::Account>& account,
+        uint64_t view_id = 0) {
+        const std::lock_guard<std::mutex> lock(accounts_access_);
+        if (view_id < min_view_id_) {
+            return;
+        }
+        accounts_.insert(AccountKey{block_number, address}, account);
+    }
+
+    std::optional<evmc::bytes32> get_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location, uint64_t block_number) {
+        const std::lock_guard<std::mutex> lock(storage_access_);
+        const auto value = storage_.get(StorageKey{block_number, address, incarnation, location});
+        if (!value) {
+            return std::nullopt;
+        }
+        return *value;
+    }
+
+    void insert_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location, uint64_t block_number, const evmc::bytes32& value,
+        uint64_t view_id = 0) {
+        const std::lock_guard<std::mutex> lock(storage_access_);
+        if (view_id < min_view_id_) {
+            return;
+        }
+        storage_.insert(StorageKey{block_number, address, incarnation, location}, value);
+    }
+
+    void clear() {
+        {
+            const std::lock_guard<std::mutex> lock(accounts_access_);
+            accounts_.clear();
+        }
+        const std::lock_guard<std::mutex> lock(storage_access_);
+        storage_.clear();
+    }
+
+    //! Drop all the values because the chain has been unwound in the given view, rejecting those read from older views
+    void invalidate(uint64_t view_id) {
+        const std::scoped_lock lock(accounts_access_, storage_access_);
+        accounts_.clear();
+        storage_.clear();
+        if (view_id > min_view_id_) {
+            min_view_id_ = view_id;
+        }
+    }
+
+private:
+    struct AccountKey {
+        uint64_t block_number;
+        evmc::address address;
+
+        friend bool operator<(const AccountKey& lhs, const AccountKey& rhs) {
+            return std::tie(lhs.block_number, lhs.address) < std::tie(rhs.block_number, rhs.address);
+        }
+    };
+
+    struct StorageKey {
+        uint64_t block_number;
+        evmc::address address;
+        uint64_t incarnation;
+        evmc::bytes32 location;
+
+        friend bool operator<(const StorageKey& lhs, const StorageKey& rhs) {
+            return std::tie(lhs.block_number, lhs.address, lhs.incarnation, lhs.location) <
+                std::tie(rhs.block_number, rhs.address, rhs.incarnation, rhs.location);
+        }
+    };
+
+    std::mutex accounts_access_;
+    boost::compute::detail::lru_cache<AccountKey, std::optional<silkworm::Account>> accounts_;
+    std::mutex storage_access_;
+    boost::compute::detail::lru_cache<StorageKey, evmc::bytes32> storage_;
+
+    //! The oldest view whose values can be inserted, guarded by both mutexes
+    uint64_t min_view_id_{0};
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_STATE_CACHE_HPP_
@@ -0,0 +1,94 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
+
+TEST_CASE("StateCache accounts", "[silkrpc][common][state_cache]") {
+    const auto address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    StateCache state_cache;
+
+    SECTION("account not present") {
+        CHECK(!state_cache.get_account(address, 1'000'000));
+    }
+
+    SECTION("existing account present") {
+        silkworm::Account account;
+        account.nonce = 12;
+        state_cache.insert_account(address, 1'000'000, account);
+        const auto cached_account = state_cache.get_account(address, 1'000'000);
+        CHECK(cached_account);
+        CHECK(*cached_account);
+        CHECK((*cached_account)->nonce == 12);
+        CHECK(!state_cache.get_account(address, 1'000'001));
+    }
+
+    SECTION("non-existent account present") {
+        state_cache.insert_account(address, 1'000'000, std::nullopt);
+        const auto cached_account = state_cache.get_account(address, 1'000'000);
+        CHECK(cached_account);
+        CHECK(!*cached_account);
+    }
+}
+
+TEST_CASE("StateCache storage", "[silkrpc][common][state_cache]") {
+    const auto address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto value{0x00000000000000000000000000000000000000000000000000000000000000ff_bytes32};
+    StateCache state_cache{1, 1};
+
+    SECTION("storage not present") {
+        CHECK(!state_cache.get_storage(address, 1, location, 1'000'000));
+    }
+
+    SECTION("storage present") {
+        state_cache.insert_storage(address, 1, location, 1'000'000, value);
+        CHECK(state_cache.get_storage(address, 1, location, 1'000'000) == value);
+        CHECK(!state_cache.get_storage(address, 2, location, 1'000'000));
+    }
+
+    SECTION("least recently used storage evicted") {
+        state_cache.insert_storage(address, 1, location, 1'000'000, value);
+        state_cache.insert_storage(address, 1, location, 1'000'001, value);
+        CHECK(!state_cache.get_storage(address, 1, location, 1'000'000));
+        CHECK(state_cache.get_storage(address, 1, location, 1'000'001) == value);
+    }
+
+    SECTION("clear") {
+        state_cache.insert_storage(address, 1, location, 1'000'000, value);
+        state_cache.clear();
+        CHECK(!state_cache.get_storage(address, 1, location, 1'000'000));
+    }
+
+    SECTION("invalidate drops values and rejects those read from older views") {
+        state_cache.insert_storage(address, 1, location, 1'000'000, value, 10);
+        state_cache.invalidate(20);
+        CHECK(!state_cache.get_storage(address, 1, location, 1'000'000));
+
+        state_cache.insert_storage(address, 1, location, 1'000'000, value, 19);
+        CHECK(!state_cache.get_storage(address, 1, location, 1'000'000));
+
+        state_cache.insert_storage(address, 1, location, 1'000'000, value, 20);
+        CHECK(state_cache.get_storage(address, 1, location, 1'000'000) == value);
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,69 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_checkpoint_cache.hpp"
+
+#include <iterator>
+
+namespace silkrpc {
+
+
+std::optional<StateCheckpointCache::Checkpoint> StateCheckpointCache::find(const evmc::bytes32& block_hash, std::size_t transaction_index) {
+    std::scoped_lock lock{access_};
+    auto it = index_.upper_bound(Key{block_hash, transaction_index});
+    if (it == index_.begin() || std::prev(it)->first.first != block_hash) {
+        ++misses_;
+        return std::nullopt;
+    }
+    --it;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    ++hits_;
+    return Checkpoint{it->first.second, it->second->delta};
+}
+
+void StateCheckpointCache::insert(const evmc::bytes32& block_hash, std::size_t transaction_index, std::shared_ptr<const state::StateDelta> delta) {
+    const auto size = delta->size();
+    std::scoped_lock lock{access_};
+    const Key key{block_hash, transaction_index};
+    const auto existing = index_.find(key);
+    if (existing != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, existing->second);
+        return;
+    }
+    lru_.push_front(Entry{key, std::move(delta), size});
+    index_.emplace(key, lru_.begin());
+    size_bytes_ += size;
+
+    evict();
+}
+
+StateCheckpointCache::Stats StateCheckpointCache::stats() const {
+    std::scoped_lock lock{access_};
+    return Stats{hits_, misses_, evictions_, index_.size(), size_bytes_};
+}
+
+void StateCheckpointCache::evict() {
+    // The most recent entry is always kept, even when it alone exceeds the capacity
+    while (size_bytes_ > capacity_bytes_ && lru_.size() > 1) {
+        const Entry& entry = lru_.back();
+        size_bytes_ -= entry.size;
+        index_.erase(entry.key);
+        lru_.pop_back();
+        ++evictions_;
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,91 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_STATE_CHECKPOINT_CACHE_HPP_
+#define SILKRPC_COMMON_STATE_CHECKPOINT_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <evmc/evmc.hpp>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/core/state_delta.hpp>
+
+namespace silkrpc {
+
+//! LRU cache of intra-block state checkpoints keyed by (block hash, transaction index).
+//! The checkpoint at index i holds the state changes of transactions [0, i) of the block, so that replaying the block
+//! up to any later transaction can resume from the nearest checkpoint instead of the block start.
+class StateCheckpointCache {
+public:
+    struct Checkpoint {
+        std::size_t transaction_index;
+        std::shared_ptr<const state::StateDelta> delta;
+    };
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        std::size_t entries{0};
+        std::size_t size_bytes{0};
+    };
+
+    explicit StateCheckpointCache(std::size_t capacity_bytes = kDefaultStateCheckpointCacheSize) : capacity_bytes_(capacity_bytes) {}
+
+    StateCheckpointCache(const StateCheckpointCache&) = delete;
+    StateCheckpointCache& operator=(const StateCheckpointCache&) = delete;
+
+    //! Get the checkpoint of the given block with the greatest index not greater than the given transaction index
+    std::optional<Checkpoint> find(const evmc::bytes32& block_hash, std::size_t transaction_index);
+
+    void insert(const evmc::bytes32& block_hash, std::size_t transaction_index, std::shared_ptr<const state::StateDelta> delta);
+
+    std::size_t capacity() const noexcept { return capacity_bytes_; }
+
+    Stats stats() const;
+
+private:
+    using Key = std::pair<evmc::bytes32, std::size_t>;
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<const state::StateDelta> delta;
+        std::size_t size;
+    };
+
+    void evict();
+
+    std::size_t capacity_bytes_;
+    mutable std::mutex access_;
+    std::list<Entry> lru_;
+    std::map<Key, std::list<Entry>::iterator> index_;
+    std::size_t size_bytes_{0};
+    uint64_t hits_{0};
+    uint64_t misses_{0};
+    uint64_t evictions_{0};
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_STATE_CHECKPOINT_CACHE_HPP_
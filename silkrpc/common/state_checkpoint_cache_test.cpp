@@ -0,0 +1,106 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_checkpoint_cache.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+using evmc::literals::operator""_bytes32;
+
+static std::shared_ptr<const state::StateDelta> make_delta(std::size_t num_accounts) {
+    auto delta = std::make_shared<state::StateDelta>();
+    for (std::size_t i{0}; i < num_accounts; ++i) {
+        evmc::address address{};
+        address.bytes[0] = static_cast<uint8_t>(i);
+        delta->accounts.emplace(address, silkworm::Account{});
+    }
+    return delta;
+}
+
+TEST_CASE("StateCheckpointCache::find", "[silkrpc][common][state_checkpoint_cache]") {
+    const auto block_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    const auto other_hash{0x14491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    StateCheckpointCache checkpoint_cache;
+
+    SECTION("no checkpoint") {
+        CHECK(!checkpoint_cache.find(block_hash, 10));
+        CHECK(checkpoint_cache.stats().misses == 1);
+    }
+
+    SECTION("exact checkpoint") {
+        const auto delta = make_delta(1);
+        checkpoint_cache.insert(block_hash, 10, delta);
+        const auto checkpoint = checkpoint_cache.find(block_hash, 10);
+        REQUIRE(checkpoint);
+        CHECK(checkpoint->transaction_index == 10);
+        CHECK(checkpoint->delta == delta);
+        CHECK(checkpoint_cache.stats().hits == 1);
+    }
+
+    SECTION("nearest preceding checkpoint") {
+        checkpoint_cache.insert(block_hash, 16, make_delta(1));
+        checkpoint_cache.insert(block_hash, 32, make_delta(2));
+        checkpoint_cache.insert(block_hash, 48, make_delta(3));
+        const auto checkpoint = checkpoint_cache.find(block_hash, 40);
+        REQUIRE(checkpoint);
+        CHECK(checkpoint->transaction_index == 32);
+        CHECK(!checkpoint_cache.find(block_hash, 15));
+    }
+
+    SECTION("checkpoints of other blocks are ignored") {
+        checkpoint_cache.insert(block_hash, 16, make_delta(1));
+        CHECK(!checkpoint_cache.find(other_hash, 20));
+        checkpoint_cache.insert(other_hash, 32, make_delta(1));
+        const auto checkpoint = checkpoint_cache.find(block_hash, 40);
+        REQUIRE(checkpoint);
+        CHECK(checkpoint->transaction_index == 16);
+    }
+}
+
+TEST_CASE("StateCheckpointCache::insert", "[silkrpc][common][state_checkpoint_cache]") {
+    const auto block_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+
+    SECTION("same key twice keeps first entry") {
+        StateCheckpointCache checkpoint_cache;
+        const auto first = make_delta(1);
+        checkpoint_cache.insert(block_hash, 16, first);
+        checkpoint_cache.insert(block_hash, 16, make_delta(2));
+        CHECK(checkpoint_cache.find(block_hash, 16)->delta == first);
+        CHECK(checkpoint_cache.stats().entries == 1);
+    }
+
+    SECTION("capacity exceeded evicts least recently used entries") {
+        const auto delta = make_delta(4);
+        StateCheckpointCache checkpoint_cache{2 * delta->size()};
+        checkpoint_cache.insert(block_hash, 16, delta);
+        checkpoint_cache.insert(block_hash, 32, make_delta(4));
+        CHECK(checkpoint_cache.find(block_hash, 16));
+        checkpoint_cache.insert(block_hash, 48, make_delta(4));
+        CHECK(checkpoint_cache.stats().evictions == 1);
+        CHECK(checkpoint_cache.stats().entries == 2);
+        CHECK(checkpoint_cache.find(block_hash, 40)->transaction_index == 16);
+    }
+
+    SECTION("most recent entry is kept even if larger than capacity") {
+        StateCheckpointCache checkpoint_cache{0};
+        checkpoint_cache.insert(block_hash, 16, make_delta(4));
+        CHECK(checkpoint_cache.stats().entries == 1);
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,165 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "subscription_hub.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <silkrpc/json/types.hpp>
+
+namespace silkrpc {
+
+
+std::string SubscriptionHub::subscribe(SubscriptionKind kind, Notifier notifier, std::optional<Filter> filter) {
+    if (filter) {
+        std::size_t criteria{filter->addresses ? filter->addresses->size() : 0};
+        if (filter->topics) {
+            for (const auto& sub_topics : *filter->topics) {
+                criteria += sub_topics.size();
+            }
+        }
+        if (criteria > kMaxFilterCriteria) {
+            throw std::invalid_argument{"too many filter criteria: " + std::to_string(criteria)};
+        }
+    }
+
+    std::scoped_lock lock{access_};
+    if (subscriptions_.size() >= max_subscriptions_) {
+        throw std::invalid_argument{"too many subscriptions: " + std::to_string(subscriptions_.size())};
+    }
+    auto subscription_id = generate_id();
+    while (subscriptions_.count(subscription_id) != 0) {
+        subscription_id = generate_id();
+    }
+    subscriptions_.emplace(subscription_id, Subscription{kind, std::move(notifier), std::move(filter)});
+    ++counts_[static_cast<std::size_t>(kind)];
+    return subscription_id;
+}
+
+bool SubscriptionHub::unsubscribe(const std::string& subscription_id) {
+    std::scoped_lock lock{access_};
+    const auto it = subscriptions_.find(subscription_id);
+    if (it == subscriptions_.end()) {
+        return false;
+    }
+    --counts_[static_cast<std::size_t>(it->second.kind)];
+    subscriptions_.erase(it);
+    return true;
+}
+
+bool SubscriptionHub::has_subscribers(SubscriptionKind kind) const {
+    std::scoped_lock lock{access_};
+    return counts_[static_cast<std::size_t>(kind)] > 0;
+}
+
+std::size_t SubscriptionHub::size() const {
+    std::scoped_lock lock{access_};
+    return subscriptions_.size();
+}
+
+void SubscriptionHub::publish_header(const nlohmann::json& header) {
+    if (!has_subscribers(SubscriptionKind::kNewHeads)) {
+        return;
+    }
+    publish(SubscriptionKind::kNewHeads, header.dump());
+}
+
+void SubscriptionHub::publish_logs(const std::vector<Log>& logs) {
+    const auto subscriptions = targets(SubscriptionKind::kLogs);
+    if (subscriptions.empty()) {
+        return;
+    }
+    for (const auto& log : logs) {
+        std::optional<std::string> result;
+        for (const auto& target : subscriptions) {
+            if (target.filter && !matches(*target.filter, log)) {
+                continue;
+            }
+            if (!result) {
+                result = nlohmann::json(log).dump();
+            }
+            target.notifier(make_notification(target.subscription_id, *result));
+        }
+    }
+}
+
+void SubscriptionHub::publish_pending_transaction(const evmc::bytes32& tx_hash) {
+    if (!has_subscribers(SubscriptionKind::kNewPendingTransactions)) {
+        return;
+    }
+    publish(SubscriptionKind::kNewPendingTransactions, nlohmann::json(tx_hash).dump());
+}
+
+bool SubscriptionHub::matches(const Filter& filter, const Log& log) {
+    if (filter.addresses && !filter.addresses->empty() &&
+        std::find(filter.addresses->begin(), filter.addresses->end(), log.address) == filter.addresses->end()) {
+        return false;
+    }
+    if (filter.topics) {
+        if (filter.topics->size() > log.topics.size()) {
+            return false;
+        }
+        for (std::size_t i{0}; i < filter.topics->size(); ++i) {
+            const auto& sub_topics = (*filter.topics)[i];
+            // empty rule set == wildcard
+            if (!sub_topics.empty() && std::find(sub_topics.begin(), sub_topics.end(), log.topics[i]) == sub_topics.end()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string SubscriptionHub::make_notification(const std::string& subscription_id, const std::string& result) {
+    std::string notification;
+    notification.reserve(result.size() + subscription_id.size() + 80);
+    notification.append(R"({"jsonrpc":"2.0","method":"eth_subscription","params":{"subscription":")");
+    notification.append(subscription_id);
+    notification.append(R"(","result":)");
+    notification.append(result);
+    notification.append("}}");
+    return notification;
+}
+
+std::vector<SubscriptionHub::Target> SubscriptionHub::targets(SubscriptionKind kind) const {
+    std::vector<Target> targets;
+    std::scoped_lock lock{access_};
+    targets.reserve(counts_[static_cast<std::size_t>(kind)]);
+    for (const auto& [subscription_id, subscription] : subscriptions_) {
+        if (subscription.kind == kind) {
+            targets.push_back(Target{subscription_id, subscription.notifier, subscription.filter});
+        }
+    }
+    return targets;
+}
+
+void SubscriptionHub::publish(SubscriptionKind kind, const std::string& result) {
+    for (const auto& target : targets(kind)) {
+        target.notifier(make_notification(target.subscription_id, result));
+    }
+}
+
+std::string SubscriptionHub::generate_id() {
+    std::ostringstream id;
+    id << "0x" << std::hex << std::setfill('0') << std::setw(16) << generator_() << std::setw(16) << generator_();
+    return id.str();
+}
+
+} // namespace silkrpc
@@ -0,0 +1,111 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_SUBSCRIPTION_HUB_HPP_
+#define SILKRPC_COMMON_SUBSCRIPTION_HUB_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/types/filter.hpp>
+#include <silkrpc/types/log.hpp>
+
+namespace silkrpc {
+
+//! Fan-out of the chain events pushed to eth_subscribe subscribers.
+//! Each event is serialized once and then delivered to every matching subscription as a ready-to-send eth_subscription
+//! notification. Notifiers are invoked outside the internal lock from the publishing thread, so they must just hand off
+//! the notification (e.g. post it to the connection executor) and never block.
+class SubscriptionHub {
+public:
+    enum class SubscriptionKind {
+        kNewHeads,
+        kLogs,
+        kNewPendingTransactions,
+    };
+
+    using Notifier = std::function<void(const std::string&)>;
+
+    explicit SubscriptionHub(std::size_t max_subscriptions = kMaxSubscriptions)
+        : max_subscriptions_(max_subscriptions), generator_{std::random_device{}()} {}
+
+    SubscriptionHub(const SubscriptionHub&) = delete;
+    SubscriptionHub& operator=(const SubscriptionHub&) = delete;
+
+    //! Register a subscription and return its identifier, throwing std::invalid_argument if its filter is too large or too many are registered
+    std::string subscribe(SubscriptionKind kind, Notifier notifier, std::optional<Filter> filter = std::nullopt);
+
+    bool unsubscribe(const std::string& subscription_id);
+
+    //! Whether any subscription of the given kind is registered, so that publishers can skip building unwanted events
+    bool has_subscribers(SubscriptionKind kind) const;
+
+    std::size_t size() const;
+
+    //! Notify the given block header to newHeads subscriptions
+    void publish_header(const nlohmann::json& header);
+
+    //! Notify each given log to the logs subscriptions whose filter matches it
+    void publish_logs(const std::vector<Log>& logs);
+
+    //! Notify the given transaction hash to newPendingTransactions subscriptions
+    void publish_pending_transaction(const evmc::bytes32& tx_hash);
+
+    //! Whether the given log matches the addresses and topics of the given filter
+    static bool matches(const Filter& filter, const Log& log);
+
+    //! Build the eth_subscription notification carrying the given already serialized result
+    static std::string make_notification(const std::string& subscription_id, const std::string& result);
+
+private:
+    struct Subscription {
+        SubscriptionKind kind;
+        Notifier notifier;
+        std::optional<Filter> filter;
+    };
+
+    struct Target {
+        std::string subscription_id;
+        Notifier notifier;
+        std::optional<Filter> filter;
+    };
+
+    std::vector<Target> targets(SubscriptionKind kind) const;
+
+    void publish(SubscriptionKind kind, const std::string& result);
+
+    std::string generate_id();
+
+    std::size_t max_subscriptions_;
+    mutable std::mutex access_;
+    std::map<std::string, Subscription> subscriptions_;
+    std::size_t counts_[3]{0, 0, 0};
+    std::mt19937_64 generator_;
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_SUBSCRIPTION_HUB_HPP_
@@ -0,0 +1,137 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "subscription_hub.hpp"
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+
+namespace silkrpc {
+
+using Catch::Matchers::Message;
+using evmc::literals::operator""_address;
+using evmc::literals::operator""_bytes32;
+
+TEST_CASE("SubscriptionHub::subscribe", "[silkrpc][common][subscription_hub]") {
+    SubscriptionHub hub{2};
+
+    SECTION("unique identifiers") {
+        const auto id1 = hub.subscribe(SubscriptionHub::SubscriptionKind::kNewHeads, [](const std::string&) {});
+        const auto id2 = hub.subscribe(SubscriptionHub::SubscriptionKind::kLogs, [](const std::string&) {}, Filter{});
+        CHECK(id1 != id2);
+        CHECK(id1.size() == 34);
+        CHECK(hub.size() == 2);
+        CHECK(hub.has_subscribers(SubscriptionHub::SubscriptionKind::kNewHeads));
+        CHECK(hub.has_subscribers(SubscriptionHub::SubscriptionKind::kLogs));
+        CHECK(!hub.has_subscribers(SubscriptionHub::SubscriptionKind::kNewPendingTransactions));
+    }
+
+    SECTION("too many subscriptions") {
+        hub.subscribe(SubscriptionHub::SubscriptionKind::kNewHeads, [](const std::string&) {});
+        hub.subscribe(SubscriptionHub::SubscriptionKind::kNewHeads, [](const std::string&) {});
+        CHECK_THROWS_MATCHES(hub.subscribe(SubscriptionHub::SubscriptionKind::kNewHeads, [](const std::string&) {}),
+            std::invalid_argument, Message("too many subscriptions: 2"));
+    }
+
+    SECTION("too many criteria") {
+        Filter filter;
+        filter.addresses = FilterAddresses(kMaxFilterCriteria + 1);
+        CHECK_THROWS_AS(hub.subscribe(SubscriptionHub::SubscriptionKind::kLogs, [](const std::string&) {}, filter),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("SubscriptionHub::unsubscribe", "[silkrpc][common][subscription_hub]") {
+    SubscriptionHub hub;
+    std::vector<std::string> notifications;
+    const auto id = hub.subscribe(SubscriptionHub::SubscriptionKind::kNewPendingTransactions,
+        [&](const std::string& n) { notifications.push_back(n); });
+
+    CHECK(hub.unsubscribe(id));
+    CHECK(!hub.unsubscribe(id));
+    CHECK(hub.size() == 0);
+    CHECK(!hub.has_subscribers(SubscriptionHub::SubscriptionKind::kNewPendingTransactions));
+    CHECK(notifications.empty());
+}
+
+TEST_CASE("SubscriptionHub::make_notification", "[silkrpc][common][subscription_hub]") {
+    CHECK(SubscriptionHub::make_notification("0x01", R"({"number":"0x1"})") ==
+        R"({"jsonrpc":"2.0","method":"eth_subscription","params":{"subscription":"0x01","result":{"number":"0x1"}}})");
+}
+
+TEST_CASE("SubscriptionHub::publish_header", "[silkrpc][common][subscription_hub]") {
+    SubscriptionHub hub;
+    std::vector<std::string> heads, txs;
+    const auto id = hub.subscribe(SubscriptionHub::SubscriptionKind::kNewHeads, [&](const std::string& n) { heads.push_back(n); });
+    hub.subscribe(SubscriptionHub::SubscriptionKind::kNewPendingTransactions, [&](const std::string& n) { txs.push_back(n); });
+
+    hub.publish_header(nlohmann::json{{"number", "0x1"}});
+    REQUIRE(heads.size() == 1);
+    const auto notification = nlohmann::json::parse(heads[0]);
+    CHECK(notification["method"] == "eth_subscription");
+    CHECK(notification["params"]["subscription"] == id);
+    CHECK(notification["params"]["result"] == R"({"number":"0x1"})"_json);
+    CHECK(txs.empty());
+}
+
+TEST_CASE("SubscriptionHub::publish_logs", "[silkrpc][common][subscription_hub]") {
+    SubscriptionHub hub;
+    std::vector<std::string> all_logs, filtered_logs;
+    hub.subscribe(SubscriptionHub::SubscriptionKind::kLogs, [&](const std::string& n) { all_logs.push_back(n); });
+    Filter filter;
+    filter.addresses = FilterAddresses{0x0000000000000000000000000000000000000002_address};
+    hub.subscribe(SubscriptionHub::SubscriptionKind::kLogs, [&](const std::string& n) { filtered_logs.push_back(n); }, filter);
+
+    std::vector<Log> logs(2);
+    logs[0].address = 0x0000000000000000000000000000000000000001_address;
+    logs[1].address = 0x0000000000000000000000000000000000000002_address;
+    hub.publish_logs(logs);
+    CHECK(all_logs.size() == 2);
+    CHECK(filtered_logs.size() == 1);
+}
+
+TEST_CASE("SubscriptionHub::matches", "[silkrpc][common][subscription_hub]") {
+    Log log{0x0000000000000000000000000000000000000001_address,
+        {0x0000000000000000000000000000000000000000000000000000000000000001_bytes32,
+         0x0000000000000000000000000000000000000000000000000000000000000002_bytes32}};
+
+    SECTION("empty filter") {
+        CHECK(SubscriptionHub::matches(Filter{}, log));
+    }
+
+    SECTION("address") {
+        Filter filter;
+        filter.addresses = FilterAddresses{0x0000000000000000000000000000000000000001_address};
+        CHECK(SubscriptionHub::matches(filter, log));
+        filter.addresses = FilterAddresses{0x0000000000000000000000000000000000000002_address};
+        CHECK(!SubscriptionHub::matches(filter, log));
+    }
+
+    SECTION("topics") {
+        Filter filter;
+        filter.topics = FilterTopics{{}, {0x0000000000000000000000000000000000000000000000000000000000000002_bytes32}};
+        CHECK(SubscriptionHub::matches(filter, log));
+        filter.topics = FilterTopics{{0x0000000000000000000000000000000000000000000000000000000000000002_bytes32}};
+        CHECK(!SubscriptionHub::matches(filter, log));
+        filter.topics = FilterTopics{{}, {}, {}};
+        CHECK(!SubscriptionHub::matches(filter, log));
+    }
+}
+
+} // namespace silkrpc
@@ -0,0 +1,63 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_COMMON_WRITER_HPP_
+#define SILKRPC_COMMON_WRITER_HPP_
+
+#include <string>
+#include <string_view>
+
+#include <silkrpc/config.hpp>
+
+#include <asio/awaitable.hpp>
+
+namespace silkrpc {
+
+//! Sink of content produced incrementally by streaming handlers.
+class Writer {
+public:
+    virtual ~Writer() = default;
+
+    //! Write the given content, possibly buffering it.
+    virtual asio::awaitable<void> write(std::string_view content) = 0;
+
+    //! Complete the content, flushing any buffered data.
+    virtual asio::awaitable<void> close() = 0;
+};
+
+//! Writer accumulating all the content in memory.
+class StringWriter : public Writer {
+public:
+    StringWriter() = default;
+
+    asio::awaitable<void> write(std::string_view content) override {
+        content_.append(content);
+        co_return;
+    }
+
+    asio::awaitable<void> close() override {
+        co_return;
+    }
+
+    const std::string& content() const noexcept { return content_; }
+
+private:
+    std::string content_;
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_COMMON_WRITER_HPP_
@@ -20,7 +20,10 @@
 #include <thread>
 #include <utility>
 
+#include <asio/post.hpp>
+
 #include <silkrpc/common/log.hpp>
+#include <silkrpc/ethdb/file/local_database.hpp>
 #include <silkrpc/ethdb/kv/remote_database.hpp>
 #include <silkrpc/ethbackend/remote_backend.hpp>
 
@@ -31,15 +34,37 @@ std::ostream& operator<<(std::ostream& out, Context& c) {
     return out;
 }
 
-Context::Context(ChannelFactory create_channel, std::shared_ptr<BlockCache> block_cache, WaitMode wait_mode)
+Context::Context(ChannelFactory create_channel, std::shared_ptr<BlockCache> block_cache, WaitMode wait_mode,
+    std::shared_ptr<mdbx::env_managed> chaindata_env, SharedServices shared_services)
     : io_context_{std::make_shared<asio::io_context>()},
       work_{asio::require(io_context_->get_executor(), asio::execution::outstanding_work.tracked)},
       queue_{std::make_unique<grpc::CompletionQueue>()},
       block_cache_(block_cache),
+      shared_services_(std::move(shared_services)),
       wait_mode_(wait_mode) {
+    if (!shared_services_.gas_price_cache) {
+        shared_services_.gas_price_cache = std::make_shared<GasPriceCache>();
+    }
+    if (!shared_services_.fee_history_cache) {
+        shared_services_.fee_history_cache = std::make_shared<FeeHistoryCache>();
+    }
+    if (!shared_services_.filter_registry) {
+        shared_services_.filter_registry = std::make_shared<FilterRegistry>();
+    }
+    if (!shared_services_.subscription_hub) {
+        shared_services_.subscription_hub = std::make_shared<SubscriptionHub>();
+    }
+    if (!shared_services_.pool_mirror) {
+        shared_services_.pool_mirror = std::make_shared<txpool::PoolMirror>();
+    }
     std::shared_ptr<grpc::Channel> channel = create_channel();
     rpc_end_point_ = std::make_unique<silkworm::rpc::CompletionEndPoint>(*queue_);
-    database_ = std::make_unique<ethdb::kv::RemoteDatabase<>>(*io_context_, channel, queue_.get());
+    if (chaindata_env) {
+        // Co-located deployment: read the chain database directly, no KV gRPC round trips
+        database_ = std::make_unique<ethdb::file::LocalDatabase>(chaindata_env);
+    } else {
+        database_ = std::make_unique<ethdb::kv::RemoteDatabase<>>(*io_context_, channel, queue_.get());
+    }
     backend_ = std::make_unique<ethbackend::RemoteBackEnd>(*io_context_, channel, queue_.get());
     miner_ = std::make_unique<txpool::Miner>(*io_context_, channel, queue_.get());
     tx_pool_ = std::make_unique<txpool::TransactionPool>(*io_context_, channel, queue_.get());
@@ -96,7 +121,8 @@ void Context::stop() {
     SILKRPC_DEBUG << "Context::stop io_context " << io_context_ << " [" << this << "]\n";
 }
 
-ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, WaitMode wait_mode) : next_index_{0} {
+ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, WaitMode wait_mode,
+    std::shared_ptr<mdbx::env_managed> chaindata_env) : next_index_{0} {
     if (pool_size == 0) {
         throw std::logic_error("ContextPool::ContextPool pool_size is 0");
     }
@@ -105,11 +131,37 @@ ContextPool::ContextPool(std::size_t pool_size, ChannelFactory create_channel, W
     // Create the unique block cache to be shared among the execution contexts.
     auto block_cache = std::make_shared<silkrpc::BlockCache>();
 
+    // Create the unique caches and registries to be shared among the execution contexts.
+    SharedServices shared_services{
+        std::make_shared<silkrpc::StateCache>(),
+        std::make_shared<silkrpc::CoherentStateCache>(),
+        std::make_shared<silkrpc::CodeCache>(),
+        std::make_shared<silkrpc::StateCheckpointCache>(),
+        std::make_shared<silkrpc::GasPriceCache>(),
+        std::make_shared<silkrpc::FeeHistoryCache>(),
+        std::make_shared<silkrpc::FilterRegistry>(),
+        std::make_shared<silkrpc::SubscriptionHub>(),
+        std::make_shared<silkrpc::txpool::PoolMirror>(),
+    };
+
     // Create as many execution contexts according as required by the pool size.
     for (std::size_t i{0}; i < pool_size; ++i) {
-        contexts_.emplace_back(Context{create_channel, block_cache, wait_mode});
+        contexts_.emplace_back(Context{create_channel, block_cache, wait_mode, chaindata_env, shared_services});
         SILKRPC_DEBUG << "ContextPool::ContextPool context[" << i << "] " << contexts_[i] << "\n";
     }
+
+    // Follow the state changes on the first context, both local and remote database views are KV view identifiers.
+    auto& context = contexts_[0];
+    state_changes_stream_ = std::make_unique<ethdb::kv::StateChangesStream>(*context.io_context(), create_channel(),
+        context.grpc_queue(), *shared_services.coherent_state_cache, *shared_services.code_cache, *shared_services.state_cache);
+
+    // Feed the eth_subscribe subscriptions and the txpool mirror on the first context as well, events are read once for all of them.
+    subscription_feeder_ = std::make_unique<core::SubscriptionFeeder>(*context.io_context(), create_channel(),
+        context.grpc_queue(), *context.database(), *block_cache, *context.tx_pool(), *shared_services.subscription_hub,
+        *shared_services.pool_mirror);
+
+    // Sweep the expired filters on the first context as well, the registry is shared by all of them.
+    filter_sweep_timer_ = std::make_unique<asio::steady_timer>(*context.io_context());
 }
 
 ContextPool::~ContextPool() {
@@ -132,6 +184,12 @@ void ContextPool::start() {
             });
             SILKRPC_DEBUG << "ContextPool::start context[" << i << "].io_context started: " << &*context.io_context() << "\n";
         }
+
+        auto state_changes_stream = state_changes_stream_.get();
+        asio::post(*contexts_[0].io_context(), [state_changes_stream]() { state_changes_stream->open(); });
+        auto subscription_feeder = subscription_feeder_.get();
+        asio::post(*contexts_[0].io_context(), [subscription_feeder]() { subscription_feeder->open(); });
+        asio::post(*contexts_[0].io_context(), [this]() { sweep_filters(); });
     }
 
     SILKRPC_TRACE << "ContextPool::start completed\n";
@@ -151,6 +209,10 @@ void ContextPool::stop() {
     // Explicitly stop all scheduler runnable components
     SILKRPC_TRACE << "ContextPool::stop started\n";
 
+    // Cancel the pending stream reads, otherwise the completion queue cannot be drained
+    state_changes_stream_->close();
+    subscription_feeder_->close();
+
     for (std::size_t i{0}; i < contexts_.size(); ++i) {
         contexts_[i].stop();
         SILKRPC_DEBUG << "ContextPool::stop context[" << i << "].io_context stopped: " << &*contexts_[i].io_context() << "\n";
@@ -163,6 +225,18 @@ void ContextPool::run() {
     join();
 }
 
+void ContextPool::sweep_filters() {
+    filter_sweep_timer_->expires_after(kFilterSweepInterval);
+    filter_sweep_timer_->async_wait([this](const asio::error_code& ec) {
+        if (ec == asio::error::operation_aborted) {
+            return;
+        }
+        const auto expired = contexts_[0].filter_registry()->expire(FilterRegistry::Clock::now());
+        SILKRPC_DEBUG << "ContextPool::sweep_filters expired filters: " << expired << "\n";
+        sweep_filters();
+    });
+}
+
 Context& ContextPool::next_context() {
     // Use a round-robin scheme to choose the next context to use
     auto& context = contexts_[next_index_];
@@ -26,14 +26,27 @@
 #include <vector>
 
 #include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
 #include <grpcpp/grpcpp.h>
+#include <silkworm/db/mdbx.hpp>
 
 #include <silkrpc/common/block_cache.hpp>
+#include <silkrpc/common/code_cache.hpp>
+#include <silkrpc/common/coherent_state_cache.hpp>
+#include <silkrpc/common/fee_history_cache.hpp>
+#include <silkrpc/common/filter_registry.hpp>
+#include <silkrpc/common/gas_price_cache.hpp>
 #include <silkrpc/common/log.hpp>
+#include <silkrpc/common/state_cache.hpp>
+#include <silkrpc/common/state_checkpoint_cache.hpp>
+#include <silkrpc/common/subscription_hub.hpp>
 #include <silkrpc/concurrency/wait_strategy.hpp>
+#include <silkrpc/core/subscription_feeder.hpp>
 #include <silkrpc/ethbackend/backend.hpp>
 #include <silkrpc/ethdb/database.hpp>
+#include <silkrpc/ethdb/kv/state_changes_stream.hpp>
 #include <silkrpc/txpool/miner.hpp>
+#include <silkrpc/txpool/pool_mirror.hpp>
 #include <silkrpc/txpool/transaction_pool.hpp>
 //#include <silkworm/rpc/completion_end_point.hpp>
 
@@ -110,10 +123,25 @@ namespace silkrpc {
 
 using ChannelFactory = std::function<std::shared_ptr<grpc::Channel>()>;
 
+//! The caches and registries shared by all the execution contexts of one pool.
+//! Missing state caches are just disabled, whilst each context creates its own instance of any other missing one.
+struct SharedServices {
+    std::shared_ptr<StateCache> state_cache;
+    std::shared_ptr<CoherentStateCache> coherent_state_cache;
+    std::shared_ptr<CodeCache> code_cache;
+    std::shared_ptr<StateCheckpointCache> state_checkpoint_cache;
+    std::shared_ptr<GasPriceCache> gas_price_cache;
+    std::shared_ptr<FeeHistoryCache> fee_history_cache;
+    std::shared_ptr<FilterRegistry> filter_registry;
+    std::shared_ptr<SubscriptionHub> subscription_hub;
+    std::shared_ptr<txpool::PoolMirror> pool_mirror;
+};
+
 //! Asynchronous client scheduler running an execution loop.
 class Context {
   public:
-    explicit Context(ChannelFactory create_channel, std::shared_ptr<BlockCache> block_cache, WaitMode wait_mode = WaitMode::blocking);
+    explicit Context(ChannelFactory create_channel, std::shared_ptr<BlockCache> block_cache, WaitMode wait_mode = WaitMode::blocking,
+        std::shared_ptr<mdbx::env_managed> chaindata_env = {}, SharedServices shared_services = {});
 
     asio::io_context* io_context() const noexcept { return io_context_.get(); }
     grpc::CompletionQueue* grpc_queue() const noexcept { return queue_.get(); }
@@ -123,6 +151,15 @@ class Context {
     std::unique_ptr<txpool::Miner>& miner() noexcept { return miner_; }
     std::unique_ptr<txpool::TransactionPool>& tx_pool() noexcept { return tx_pool_; }
     std::shared_ptr<BlockCache>& block_cache() noexcept { return block_cache_; }
+    std::shared_ptr<StateCache>& state_cache() noexcept { return shared_services_.state_cache; }
+    std::shared_ptr<CoherentStateCache>& coherent_state_cache() noexcept { return shared_services_.coherent_state_cache; }
+    std::shared_ptr<CodeCache>& code_cache() noexcept { return shared_services_.code_cache; }
+    std::shared_ptr<StateCheckpointCache>& state_checkpoint_cache() noexcept { return shared_services_.state_checkpoint_cache; }
+    std::shared_ptr<GasPriceCache>& gas_price_cache() noexcept { return shared_services_.gas_price_cache; }
+    std::shared_ptr<FeeHistoryCache>& fee_history_cache() noexcept { return shared_services_.fee_history_cache; }
+    std::shared_ptr<FilterRegistry>& filter_registry() noexcept { return shared_services_.filter_registry; }
+    std::shared_ptr<SubscriptionHub>& subscription_hub() noexcept { return shared_services_.subscription_hub; }
+    std::shared_ptr<txpool::PoolMirror>& pool_mirror() noexcept { return shared_services_.pool_mirror; }
 
     //! Execute the scheduler loop until stopped.
     void execute_loop();
@@ -151,6 +188,7 @@ class Context {
     std::unique_ptr<txpool::Miner> miner_;
     std::unique_ptr<txpool::TransactionPool> tx_pool_;
     std::shared_ptr<BlockCache> block_cache_;
+    SharedServices shared_services_;
     WaitMode wait_mode_;
 };
 
@@ -158,7 +196,8 @@ std::ostream& operator<<(std::ostream& out, Context& c);
 
 class ContextPool {
 public:
-    explicit ContextPool(std::size_t pool_size, ChannelFactory create_channel, WaitMode wait_mode = WaitMode::blocking);
+    explicit ContextPool(std::size_t pool_size, ChannelFactory create_channel, WaitMode wait_mode = WaitMode::blocking,
+        std::shared_ptr<mdbx::env_managed> chaindata_env = {});
     ~ContextPool();
 
     ContextPool(const ContextPool&) = delete;
@@ -177,9 +216,21 @@ public:
     asio::io_context& next_io_context();
 
 private:
+    //! Remove the filters not polled within their timeout every kFilterSweepInterval, also when no new filter is installed.
+    void sweep_filters();
+
     // The pool of contexts
     std::vector<Context> contexts_;
 
+    //! The subscription to state changes keeping the state caches up-to-date, run by the first context.
+    std::unique_ptr<ethdb::kv::StateChangesStream> state_changes_stream_;
+
+    //! The source of the events pushed to eth_subscribe subscribers, run by the first context.
+    std::unique_ptr<core::SubscriptionFeeder> subscription_feeder_;
+
+    //! The timer scheduling the periodic sweep of the expired filters, run by the first context.
+    std::unique_ptr<asio::steady_timer> filter_sweep_timer_;
+
     //! The pool of threads running the execution contexts.
     asio::detail::thread_group context_threads_;
 
@@ -185,6 +185,9 @@ TEST_CASE("Context", "[silkrpc][context_pool]") {
             CHECK_NOTHROW(context.backend() != nullptr);
             CHECK_NOTHROW(context.miner() != nullptr);
             CHECK_NOTHROW(context.block_cache() != nullptr);
+            CHECK(context.filter_registry() != nullptr);
+            CHECK(context.subscription_hub() != nullptr);
+            CHECK(context.pool_mirror() != nullptr);
         }
 
         SECTION(std::string("Context::execute_loop wait_mode=") + std::to_string(static_cast<int>(wait_mode))) {
@@ -253,6 +256,24 @@ TEST_CASE("create context pool", "[silkrpc][context_pool]") {
         CHECK(&io_context2 == &io_context5);
         CHECK(&io_context3 == &io_context6);
     }
+
+    SECTION("share caches and registries among contexts") {
+        ContextPool cp{2, create_channel};
+
+        auto& context1 = cp.next_context();
+        auto& context2 = cp.next_context();
+
+        CHECK(context1.block_cache() == context2.block_cache());
+        CHECK(context1.state_cache() == context2.state_cache());
+        CHECK(context1.coherent_state_cache() == context2.coherent_state_cache());
+        CHECK(context1.code_cache() == context2.code_cache());
+        CHECK(context1.state_checkpoint_cache() == context2.state_checkpoint_cache());
+        CHECK(context1.gas_price_cache() == context2.gas_price_cache());
+        CHECK(context1.fee_history_cache() == context2.fee_history_cache());
+        CHECK(context1.filter_registry() == context2.filter_registry());
+        CHECK(context1.subscription_hub() == context2.subscription_hub());
+        CHECK(context1.pool_mirror() == context2.pool_mirror());
+    }
 }
 
 TEST_CASE("start context pool", "[silkrpc][context_pool]") {
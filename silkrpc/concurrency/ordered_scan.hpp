@@ -0,0 +1,120 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_CONCURRENCY_ORDERED_SCAN_HPP_
+#define SILKRPC_CONCURRENCY_ORDERED_SCAN_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <utility>
+
+#include <silkrpc/config.hpp>
+
+#include <asio/awaitable.hpp>
+#include <asio/co_spawn.hpp>
+#include <asio/redirect_error.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/this_coro.hpp>
+#include <asio/use_awaitable.hpp>
+
+namespace silkrpc {
+
+//! Scan of the chunk having the given index.
+template<typename Chunk>
+using ChunkScanner = std::function<asio::awaitable<Chunk>(std::size_t chunk_index)>;
+
+//! Loop picking the next chunk to scan with the given scanner until exhausted.
+template<typename Chunk>
+using ScanLoop = std::function<asio::awaitable<void>(const ChunkScanner<Chunk>& scanner)>;
+
+//! Scan the chunks [0, num_chunks) with up to num_executors coroutines running concurrently on the current executor and
+//! deliver them to consumer in chunk order. Each coroutine runs executor_body, which sets up the resources of its own (e.g.
+//! a database transaction) and then runs the given scan loop. Chunks cannot be picked more than max_chunks_ahead beyond
+//! the next chunk to deliver, so that at most max_chunks_ahead chunks are held in memory. The first error stops the scan
+//! and is rethrown.
+template<typename Chunk>
+asio::awaitable<void> ordered_scan(std::size_t num_chunks, std::size_t num_executors, std::size_t max_chunks_ahead,
+        const std::function<asio::awaitable<void>(const ScanLoop<Chunk>&)>& executor_body,
+        const std::function<asio::awaitable<void>(Chunk&)>& consumer) {
+    num_executors = std::min(num_executors, num_chunks);
+    if (num_executors == 0) {
+        co_return;
+    }
+    max_chunks_ahead = std::max(max_chunks_ahead, std::size_t{1});
+
+    auto executor = co_await asio::this_coro::executor;
+    asio::steady_timer scan_completion{executor, asio::steady_timer::time_point::max()};
+    asio::steady_timer delivery_progress{executor, asio::steady_timer::time_point::max()};
+    std::size_t next_chunk{0};
+    std::size_t next_delivery{0};
+    std::map<std::size_t, Chunk> completed_chunks;
+    bool delivering{false};
+    std::size_t running_executors{num_executors};
+    std::exception_ptr scan_error;
+
+    const ScanLoop<Chunk> scan_loop = [&](const ChunkScanner<Chunk>& scanner) -> asio::awaitable<void> {
+        while (next_chunk < num_chunks && !scan_error) {
+            if (next_chunk >= next_delivery + max_chunks_ahead) {
+                asio::error_code ec;
+                co_await delivery_progress.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+                continue;
+            }
+            const auto chunk_index = next_chunk++;
+            completed_chunks.emplace(chunk_index, co_await scanner(chunk_index));
+
+            if (delivering) {
+                continue; // the coroutine already delivering will pick this chunk up when its turn comes
+            }
+            delivering = true;
+            auto chunk_it = completed_chunks.find(next_delivery);
+            while (chunk_it != completed_chunks.end() && !scan_error) {
+                auto chunk = std::move(chunk_it->second);
+                completed_chunks.erase(chunk_it);
+                co_await consumer(chunk);
+                ++next_delivery;
+                delivery_progress.cancel();
+                chunk_it = completed_chunks.find(next_delivery);
+            }
+            delivering = false;
+        }
+    };
+
+    for (std::size_t i{0}; i < num_executors; ++i) {
+        asio::co_spawn(executor, executor_body(scan_loop), [&](std::exception_ptr eptr) {
+            if (eptr && !scan_error) {
+                scan_error = eptr;
+                delivery_progress.cancel();
+            }
+            if (--running_executors == 0) {
+                scan_completion.cancel();
+            }
+        });
+    }
+
+    // Wait for all the coroutines to complete: completion is signalled by cancelling the timer
+    asio::error_code ec;
+    co_await scan_completion.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    if (scan_error) {
+        std::rethrow_exception(scan_error);
+    }
+}
+
+} // namespace silkrpc
+
+#endif  // SILKRPC_CONCURRENCY_ORDERED_SCAN_HPP_
@@ -0,0 +1,113 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "ordered_scan.hpp"
+
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include <asio/co_spawn.hpp>
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/use_awaitable.hpp>
+#include <asio/use_future.hpp>
+#include <catch2/catch.hpp>
+
+namespace silkrpc {
+
+using Catch::Matchers::Message;
+
+//! Run ordered_scan on a single-threaded io_context, later chunks completing faster to deliver them out of order
+static void run_scan(std::size_t num_chunks, std::size_t num_executors, std::size_t max_chunks_ahead, std::vector<std::size_t>& delivered,
+        std::size_t& executors, std::size_t& max_in_flight, std::size_t& max_ahead, std::size_t failing_chunk = SIZE_MAX) {
+    asio::io_context io_context;
+    std::size_t in_flight{0};
+    const std::function<asio::awaitable<void>(const ScanLoop<std::size_t>&)> executor_body =
+        [&](const ScanLoop<std::size_t>& scan_loop) -> asio::awaitable<void> {
+            ++executors;
+            co_await scan_loop([&](std::size_t chunk_index) -> asio::awaitable<std::size_t> {
+                max_in_flight = std::max(max_in_flight, ++in_flight);
+                max_ahead = std::max(max_ahead, chunk_index + 1 - delivered.size());
+                asio::steady_timer timer{io_context, std::chrono::milliseconds((num_chunks - chunk_index) % 4)};
+                co_await timer.async_wait(asio::use_awaitable);
+                --in_flight;
+                if (chunk_index == failing_chunk) {
+                    throw std::runtime_error{"scan failed"};
+                }
+                co_return chunk_index;
+            });
+        };
+    const std::function<asio::awaitable<void>(std::size_t&)> consumer = [&](std::size_t& chunk) -> asio::awaitable<void> {
+        delivered.push_back(chunk);
+        co_return;
+    };
+    auto result = asio::co_spawn(io_context, ordered_scan<std::size_t>(num_chunks, num_executors, max_chunks_ahead, executor_body, consumer),
+        asio::use_future);
+    io_context.run();
+    result.get();
+}
+
+TEST_CASE("ordered_scan", "[silkrpc][concurrency][ordered_scan]") {
+    std::vector<std::size_t> delivered;
+    std::size_t executors{0};
+    std::size_t max_in_flight{0};
+    std::size_t max_ahead{0};
+
+    SECTION("no chunks") {
+        run_scan(0, 4, 8, delivered, executors, max_in_flight, max_ahead);
+        CHECK(delivered.empty());
+        CHECK(executors == 0);
+    }
+
+    SECTION("fewer chunks than executors") {
+        run_scan(2, 4, 8, delivered, executors, max_in_flight, max_ahead);
+        CHECK(delivered == std::vector<std::size_t>{0, 1});
+        CHECK(executors == 2);
+    }
+
+    SECTION("chunks completed out of order are delivered in order") {
+        run_scan(50, 4, 8, delivered, executors, max_in_flight, max_ahead);
+        std::vector<std::size_t> expected(50);
+        for (std::size_t i{0}; i < expected.size(); ++i) {
+            expected[i] = i;
+        }
+        CHECK(delivered == expected);
+        CHECK(executors == 4);
+        CHECK(max_in_flight == 4);
+    }
+
+    SECTION("chunks are not picked beyond the look-ahead bound") {
+        run_scan(50, 8, 3, delivered, executors, max_in_flight, max_ahead);
+        CHECK(delivered.size() == 50);
+        CHECK(max_ahead <= 3);
+        CHECK(max_in_flight <= 3);
+    }
+
+    SECTION("scan error is rethrown and stops delivery") {
+        CHECK_THROWS_MATCHES(run_scan(50, 4, 8, delivered, executors, max_in_flight, max_ahead, 10), std::runtime_error, Message("scan failed"));
+        CHECK(delivered.size() <= 10);
+        for (std::size_t i{0}; i < delivered.size(); ++i) {
+            CHECK(delivered[i] == i);
+        }
+    }
+}
+
+} // namespace silkrpc
@@ -45,9 +45,9 @@ asio::awaitable<DumpAccounts> AccountDumper::dump_accounts(BlockCache& cache, co
     ethdb::TransactionDatabase tx_database{transaction_};
 
     const auto block_with_hash = co_await core::read_block_by_number_or_hash(cache, tx_database, bnoh);
-    const auto block_number = block_with_hash.block.header.number;
+    const auto block_number = block_with_hash->block.header.number;
 
-    dump_accounts.root = block_with_hash.block.header.state_root;
+    dump_accounts.root = block_with_hash->block.header.state_root;
 
     std::vector<silkrpc::KeyValue> collected_data;
 
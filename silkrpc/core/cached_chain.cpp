@@ -16,33 +16,35 @@
 
 #include "cached_chain.hpp"
 
+#include <memory>
+
 #include <silkrpc/core/blocks.hpp>
 #include <silkrpc/core/rawdb/chain.hpp>
 
 namespace silkrpc::core  {
 
-asio::awaitable<silkworm::BlockWithHash> read_block_by_number(BlockCache& cache, const rawdb::DatabaseReader& reader, uint64_t block_number) {
+asio::awaitable<std::shared_ptr<const IndexedBlock>> read_block_by_number(BlockCache& cache, const rawdb::DatabaseReader& reader, uint64_t block_number) {
     const auto block_hash = co_await rawdb::read_canonical_block_hash(reader, block_number);
-    auto option_block = cache.get(block_hash);
-    if (option_block) {
-        co_return *option_block;
+    auto cached_block = cache.get(block_hash);
+    if (cached_block) {
+        co_return cached_block;
     }
-    auto block_with_hash = co_await rawdb::read_block(reader, block_hash, block_number);
+    auto block_with_hash = std::make_shared<const IndexedBlock>(co_await rawdb::read_block(reader, block_hash, block_number));
     cache.insert(block_hash, block_with_hash);
     co_return block_with_hash;
 }
 
-asio::awaitable<silkworm::BlockWithHash> read_block_by_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& block_hash) {
-    auto option_block = cache.get(block_hash);
-    if (option_block) {
-        co_return *option_block;
+asio::awaitable<std::shared_ptr<const IndexedBlock>> read_block_by_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& block_hash) {
+    auto cached_block = cache.get(block_hash);
+    if (cached_block) {
+        co_return cached_block;
     }
-    auto block_with_hash = co_await rawdb::read_block_by_hash(reader, block_hash);
+    auto block_with_hash = std::make_shared<const IndexedBlock>(co_await rawdb::read_block_by_hash(reader, block_hash));
     cache.insert(block_hash, block_with_hash);
     co_return block_with_hash;
 }
 
-asio::awaitable<silkworm::BlockWithHash> read_block_by_number_or_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const silkrpc::BlockNumberOrHash& bnoh) {
+asio::awaitable<std::shared_ptr<const IndexedBlock>> read_block_by_number_or_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const silkrpc::BlockNumberOrHash& bnoh) {
     if (bnoh.is_number()) {
         co_return co_await read_block_by_number(cache, reader, bnoh.number());
     } else if (bnoh.is_hash()) {
@@ -54,7 +56,7 @@ asio::awaitable<silkworm::BlockWithHash> read_block_by_number_or_hash(BlockCache
     throw std::runtime_error{"invalid block_number_or_hash value"};
 }
 
-asio::awaitable<silkworm::BlockWithHash> read_block_by_transaction_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& transaction_hash) {
+asio::awaitable<std::shared_ptr<const IndexedBlock>> read_block_by_transaction_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& transaction_hash) {
     auto block_number = co_await rawdb::read_block_number_by_transaction_hash(reader, transaction_hash);
     co_return co_await read_block_by_number(cache, reader, block_number);
 }
@@ -62,18 +64,13 @@ asio::awaitable<silkworm::BlockWithHash> read_block_by_transaction_hash(BlockCac
 asio::awaitable<std::optional<silkrpc::TransactionWithBlock>> read_transaction_by_hash(BlockCache& cache, const rawdb::DatabaseReader& reader, const evmc::bytes32& transaction_hash) {
     auto block_number = co_await rawdb::read_block_number_by_transaction_hash(reader, transaction_hash);
     auto block_with_hash = co_await read_block_by_number(cache, reader, block_number);
-    const silkworm::ByteView tx_hash{transaction_hash.bytes, silkworm::kHashLength};
-
-    const auto transactions = block_with_hash.block.transactions;
-    for (std::size_t idx{0}; idx < transactions.size(); idx++) {
-        auto ethash_hash{hash_of_transaction(transactions[idx])};
-        silkworm::ByteView hash_view{ethash_hash.bytes, silkworm::kHashLength};
-        if (tx_hash == hash_view) {
-            const auto block_header = block_with_hash.block.header;
-            co_return TransactionWithBlock{block_with_hash, transactions[idx], block_with_hash.hash, block_header.number, block_header.base_fee_per_gas, idx};
-        }
+    const auto idx = block_with_hash->transaction_index(transaction_hash);
+    if (!idx) {
+        co_return std::nullopt;
     }
-    co_return std::nullopt;
+    const auto& block_header = block_with_hash->block.header;
+    const auto& transaction = block_with_hash->block.transactions[*idx];
+    co_return TransactionWithBlock{block_with_hash, transaction, block_with_hash->hash, block_header.number, block_header.base_fee_per_gas, *idx};
 }
 
 } // namespace silkrpc::core
@@ -140,12 +140,15 @@ TEST_CASE("read_block_by_number_or_hash") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
         auto result = asio::co_spawn(pool, read_block_by_number_or_hash(cache, db_reader, bnoh), asio::use_future);
-        const silkworm::BlockWithHash bwh = result.get();
-        check_expected_block_with_hash(bwh);
+        const auto bwh = result.get();
+        check_expected_block_with_hash(*bwh);
     }
 
     SECTION("using valid hash") {
@@ -161,12 +164,15 @@ TEST_CASE("read_block_by_number_or_hash") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
         auto result = asio::co_spawn(pool, read_block_by_number_or_hash(cache, db_reader, bnoh), asio::use_future);
-        const silkworm::BlockWithHash bwh = result.get();
-        check_expected_block_with_hash(bwh);
+        const auto bwh = result.get();
+        check_expected_block_with_hash(*bwh);
     }
 
     SECTION("using tag kEarliestBlockId") {
@@ -182,12 +188,15 @@ TEST_CASE("read_block_by_number_or_hash") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
         auto result = asio::co_spawn(pool, read_block_by_number_or_hash(cache, db_reader, bnoh), asio::use_future);
-        const silkworm::BlockWithHash bwh = result.get();
-        check_expected_block_with_hash(bwh);
+        const auto bwh = result.get();
+        check_expected_block_with_hash(*bwh);
     }
 }
 
@@ -207,12 +216,15 @@ TEST_CASE("silkrpc::core::read_block_by_number") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
         auto result = asio::co_spawn(pool, silkrpc::core::read_block_by_number(cache, db_reader, bn), asio::use_future);
-        const silkworm::BlockWithHash bwh = result.get();
-        check_expected_block_with_hash(bwh);
+        const auto bwh = result.get();
+        check_expected_block_with_hash(*bwh);
     }
 
     SECTION("using valid block_number and hit cache") {
@@ -226,18 +238,22 @@ TEST_CASE("silkrpc::core::read_block_by_number") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
         auto result = asio::co_spawn(pool, silkrpc::core::read_block_by_number(cache, db_reader, bn), asio::use_future);
-        const silkworm::BlockWithHash bwh = result.get();
-        check_expected_block_with_hash(bwh);
+        const auto bwh = result.get();
+        check_expected_block_with_hash(*bwh);
 
         EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<silkworm::Bytes> { co_return kBlockHash; }
         ));
         auto result1 = asio::co_spawn(pool, silkrpc::core::read_block_by_number(cache, db_reader, bn), asio::use_future);
-        const silkworm::BlockWithHash bwh1 = result1.get();
+        const auto bwh1 = result1.get();
+        CHECK(bwh1 == bwh);
     }
 }
 
@@ -257,12 +273,15 @@ TEST_CASE("silkrpc::core::read_block_by_hash") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
         auto result = asio::co_spawn(pool, silkrpc::core::read_block_by_hash(cache, db_reader, bh), asio::use_future);
-        const silkworm::BlockWithHash bwh = result.get();
-        check_expected_block_with_hash(bwh);
+        const auto bwh = result.get();
+        check_expected_block_with_hash(*bwh);
     }
 
     SECTION("using valid block_hash and hit cache") {
@@ -275,14 +294,18 @@ TEST_CASE("silkrpc::core::read_block_by_hash") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
         auto result = asio::co_spawn(pool, silkrpc::core::read_block_by_hash(cache, db_reader, bh), asio::use_future);
-        const silkworm::BlockWithHash bwh = result.get();
-        check_expected_block_with_hash(bwh);
+        const auto bwh = result.get();
+        check_expected_block_with_hash(*bwh);
         auto result1 = asio::co_spawn(pool, silkrpc::core::read_block_by_hash(cache, db_reader, bh), asio::use_future);
-        const silkworm::BlockWithHash bwh1 = result1.get();
+        const auto bwh1 = result1.get();
+        CHECK(bwh1 == bwh);
     }
 }
 
@@ -332,6 +355,12 @@ TEST_CASE("read_block_by_transaction_hash") {
         EXPECT_CALL(db_reader, get(db::table::kHeaders, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         auto result = asio::co_spawn(pool, read_block_by_transaction_hash(cache, db_reader, transaction_hash), asio::use_future);
         CHECK_THROWS_MATCHES(result.get(), std::runtime_error, Message("empty block header RLP in read_header"));
     }
@@ -350,6 +379,9 @@ TEST_CASE("read_block_by_transaction_hash") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         auto result = asio::co_spawn(pool, read_block_by_transaction_hash(cache, db_reader, transaction_hash), asio::use_future);
         CHECK_THROWS_MATCHES(result.get(), std::runtime_error, Message("empty block body RLP in read_body"));
     }
@@ -368,12 +400,15 @@ TEST_CASE("read_block_by_transaction_hash") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
         auto result = asio::co_spawn(pool, read_block_by_transaction_hash(cache, db_reader, transaction_hash), asio::use_future);
-        const silkworm::BlockWithHash bwh = result.get();
-        check_expected_block_with_hash(bwh);
+        const auto bwh = result.get();
+        check_expected_block_with_hash(*bwh);
     }
 }
 
@@ -414,6 +449,9 @@ TEST_CASE("read_transaction_by_hash") {
         EXPECT_CALL(db_reader, get(db::table::kBlockBodies, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, kBody}; }
         ));
+        EXPECT_CALL(db_reader, get(db::table::kSenders, _)).WillOnce(InvokeWithoutArgs(
+            []() -> asio::awaitable<KeyValue> { co_return KeyValue{silkworm::Bytes{}, silkworm::Bytes{}}; }
+        ));
         EXPECT_CALL(db_reader, walk(db::table::kEthTx, _, _, _)).WillOnce(InvokeWithoutArgs(
             []() -> asio::awaitable<void> { co_return; }
         ));
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <asio/compose.hpp>
 #include <asio/post.hpp>
@@ -80,6 +81,9 @@ asio::awaitable<intx::uint256> EstimateGasOracle::estimate_gas(const Call& call,
     SILKRPC_DEBUG << "hi: " << hi << ", lo: " << lo << ", cap: " << cap << "\n";
 
     silkworm::Transaction transaction{call.to_transaction()};
+    if (batch_executor_ && num_probes_ > 1) {
+        co_await search_with_probes(transaction, lo, hi);
+    }
     while (lo + 1 < hi) {
         auto mid = (hi + lo) / 2;
         transaction.gas_limit = mid;
@@ -107,9 +111,42 @@ asio::awaitable<intx::uint256> EstimateGasOracle::estimate_gas(const Call& call,
     co_return hi;
 }
 
+asio::awaitable<void> EstimateGasOracle::search_with_probes(const silkworm::Transaction& transaction, std::uint64_t& lo, std::uint64_t& hi) {
+    // Once (lo, hi) holds no more gas limits than probes, a probing step would execute all of them: bisection finishes
+    // the last few steps
+    while (lo + num_probes_ + 1 < hi) {
+        // Split (lo, hi) evenly by up to num_probes_ gas limits, then narrow it between the highest failing and the lowest
+        // succeeding one: for a monotonic outcome the result is the same as bisection in about log2(num_probes_ + 1) fewer steps
+        std::vector<silkworm::Transaction> probes;
+        probes.reserve(num_probes_);
+        const auto gap = hi - lo;
+        for (std::size_t i{1}; i <= num_probes_; ++i) {
+            const auto gas_limit = lo + gap * i / (num_probes_ + 1);
+            if (gas_limit > lo && (probes.empty() || probes.back().gas_limit != gas_limit)) {
+                probes.push_back(transaction);
+                probes.back().gas_limit = gas_limit;
+            }
+        }
+        SILKRPC_DEBUG << "hi: " << hi << ", lo: " << lo << ", #probes: " << probes.size() << "\n";
+
+        const auto results = co_await (*batch_executor_)(probes);
+        for (std::size_t i{0}; i < probes.size(); ++i) {
+            if (is_failed(results[i])) {
+                lo = probes[i].gas_limit;
+            } else {
+                hi = probes[i].gas_limit;
+                break;
+            }
+        }
+    }
+}
+
 asio::awaitable<bool> EstimateGasOracle::try_execution(const silkworm::Transaction& transaction) {
     const auto result = co_await executor_(transaction);
+    co_return is_failed(result);
+}
 
+bool EstimateGasOracle::is_failed(const silkrpc::ExecutionResult& result) {
     bool failed = true;
     if (result.pre_check_error) {
         SILKRPC_DEBUG << "result error " << result.pre_check_error.value() << "\n";
@@ -128,7 +165,7 @@ asio::awaitable<bool> EstimateGasOracle::try_execution(const silkworm::Transacti
         }
     }
 
-    co_return failed;
+    return failed;
 }
 
 } // namespace silkrpc::ego
@@ -17,6 +17,7 @@
 #ifndef SILKRPC_CORE_ESTIMATE_GAS_ORACLE_HPP_
 #define SILKRPC_CORE_ESTIMATE_GAS_ORACLE_HPP_
 
+#include <cstddef>
 #include <functional>
 #include <optional>
 #include <string>
@@ -43,6 +44,7 @@ const std::uint64_t kGasCap = 25'000'000;
 using BlockHeaderProvider = std::function<asio::awaitable<silkworm::BlockHeader>(uint64_t)>;
 using AccountReader = std::function<asio::awaitable<std::optional<silkworm::Account>>(const evmc::address&, uint64_t)>;
 using Executor = std::function<asio::awaitable<silkrpc::ExecutionResult>(const silkworm::Transaction &)>;
+using BatchExecutor = std::function<asio::awaitable<std::vector<silkrpc::ExecutionResult>>(const std::vector<silkworm::Transaction>&)>;
 
 struct EstimateGasException : public std::exception {
 public:
@@ -80,6 +82,12 @@ class EstimateGasOracle {
 public:
     explicit EstimateGasOracle(const BlockHeaderProvider& block_header_provider, const AccountReader& account_reader, const Executor& executor)
         : block_header_provider_(block_header_provider), account_reader_{account_reader}, executor_(executor) {}
+
+    //! Search the gas limit probing up to num_probes gas limits at each step using the batch executor, which runs them concurrently
+    explicit EstimateGasOracle(const BlockHeaderProvider& block_header_provider, const AccountReader& account_reader, const Executor& executor,
+        const BatchExecutor& batch_executor, std::size_t num_probes)
+        : block_header_provider_(block_header_provider), account_reader_{account_reader}, executor_(executor),
+          batch_executor_{&batch_executor}, num_probes_{num_probes} {}
     virtual ~EstimateGasOracle() {}
 
     EstimateGasOracle(const EstimateGasOracle&) = delete;
@@ -90,9 +98,15 @@ public:
 private:
     asio::awaitable<bool> try_execution(const silkworm::Transaction& transaction);
 
+    asio::awaitable<void> search_with_probes(const silkworm::Transaction& transaction, std::uint64_t& lo, std::uint64_t& hi);
+
+    bool is_failed(const silkrpc::ExecutionResult& result);
+
     const BlockHeaderProvider& block_header_provider_;
     const AccountReader& account_reader_;
     const Executor& executor_;
+    const BatchExecutor* batch_executor_{nullptr};
+    std::size_t num_probes_{1};
 };
 
 } // namespace silkrpc::ego
@@ -219,4 +219,75 @@ TEST_CASE("estimate gas") {
     }
 }
 
+TEST_CASE("estimate gas with probes") {
+    asio::thread_pool pool{1};
+
+    uint64_t threshold{0};
+    uint64_t executions{0};
+    uint64_t batches{0};
+    uint64_t single_executions{0};
+
+    silkworm::BlockHeader kBlockHeader;
+    kBlockHeader.gas_limit = kGasCap;
+
+    auto execute = [&threshold, &executions](const silkworm::Transaction& transaction) {
+        ++executions;
+        const bool success = transaction.gas_limit >= threshold;
+        return silkrpc::ExecutionResult{success ? evmc_status_code::EVMC_SUCCESS : evmc_status_code::EVMC_INSUFFICIENT_BALANCE};
+    };
+
+    Executor executor = [&execute, &single_executions](const silkworm::Transaction& transaction) -> asio::awaitable<silkrpc::ExecutionResult> {
+        ++single_executions;
+        co_return execute(transaction);
+    };
+
+    BatchExecutor batch_executor = [&execute, &batches](const std::vector<silkworm::Transaction>& transactions)
+        -> asio::awaitable<std::vector<silkrpc::ExecutionResult>> {
+        ++batches;
+        std::vector<silkrpc::ExecutionResult> results;
+        for (const auto& transaction : transactions) {
+            results.push_back(execute(transaction));
+        }
+        co_return results;
+    };
+
+    BlockHeaderProvider block_header_provider = [&kBlockHeader](uint64_t block_number) -> asio::awaitable<silkworm::BlockHeader> {
+        co_return kBlockHeader;
+    };
+
+    AccountReader account_reader = [](const evmc::address& address, uint64_t block_number) -> asio::awaitable<std::optional<silkworm::Account>> {
+        co_return silkworm::Account{};
+    };
+
+    Call call;
+
+    SECTION("same result as bisection") {
+        for (const auto t : {kTxGas, kTxGas + 1, uint64_t{53'000}, uint64_t{1'234'567}, kGasCap - 1, kGasCap}) {
+            threshold = t;
+            EstimateGasOracle bisection_oracle{block_header_provider, account_reader, executor};
+            auto bisection_result = asio::co_spawn(pool, bisection_oracle.estimate_gas(call, 0), asio::use_future);
+            const auto bisection_estimate = bisection_result.get();
+            const auto bisection_steps = executions;
+
+            executions = 0;
+            batches = 0;
+            single_executions = 0;
+            EstimateGasOracle probing_oracle{block_header_provider, account_reader, executor, batch_executor, 7};
+            auto probing_result = asio::co_spawn(pool, probing_oracle.estimate_gas(call, 0), asio::use_future);
+            CHECK(probing_result.get() == bisection_estimate);
+            CHECK(bisection_estimate == t);
+            CHECK(batches + single_executions < bisection_steps);
+            CHECK(single_executions <= 4); // the last few bisection steps plus the cap check
+            executions = 0;
+        }
+    }
+
+    SECTION("gas required exceeds allowance") {
+        threshold = kGasCap + 1;
+        EstimateGasOracle probing_oracle{block_header_provider, account_reader, executor, batch_executor, 4};
+        auto result = asio::co_spawn(pool, probing_oracle.estimate_gas(call, 0), asio::use_future);
+        CHECK_THROWS_AS(result.get(), EstimateGasException);
+    }
+}
+
 } // namespace silkrpc::ego
@@ -16,10 +16,16 @@
 
 #include "evm_debug.hpp"
 
+#include <charconv>
 #include <memory>
 #include <stack>
 #include <string>
+#include <string_view>
 
+#include <asio/co_spawn.hpp>
+#include <asio/post.hpp>
+#include <asio/redirect_error.hpp>
+#include <asio/use_awaitable.hpp>
 #include <evmc/hex.hpp>
 #include <evmc/instructions.h>
 #include <intx/intx.hpp>
@@ -27,7 +33,9 @@
 #include <silkworm/third_party/evmone/lib/evmone/instructions.hpp>
 
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
+#include <silkrpc/common/state_checkpoint_cache.hpp>
 #include <silkrpc/common/util.hpp>
 #include <silkrpc/core/evm_executor.hpp>
 #include <silkrpc/core/rawdb/chain.hpp>
@@ -105,19 +113,21 @@ void output_memory(std::vector<std::string>& vect, const evmone::Memory& memory)
     }
 }
 
-void insert_error(DebugLog& log, evmc_status_code status_code) {
+bool is_error(evmc_status_code status_code) {
     switch(status_code) {
     case evmc_status_code::EVMC_FAILURE:
     case evmc_status_code::EVMC_UNDEFINED_INSTRUCTION:
     case evmc_status_code::EVMC_OUT_OF_GAS:
-        log.error = true;
-        break;
+        return true;
     default:
-        log.error = false;
-        break;
+        return false;
     }
 }
 
+void insert_error(DebugLog& log, evmc_status_code status_code) {
+    log.error = is_error(status_code);
+}
+
 void DebugTracer::on_execution_start(evmc_revision rev, const evmc_message& msg, evmone::bytes_view code) noexcept {
     if (opcode_names_ == nullptr) {
         opcode_names_ = evmc_get_instruction_names_table(rev);
@@ -241,6 +251,343 @@ void DebugTracer::on_execution_end(const evmc_result& result, const silkworm::In
         << "\n";
 }
 
+static const char* kHexDigits{"0123456789abcdef"};
+
+template<typename T>
+void append_number(std::string& out, T value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void append_hex(std::string& out, const uint8_t* data, std::size_t size) {
+    for (std::size_t i{0}; i < size; ++i) {
+        out.push_back(kHexDigits[data[i] >> 4]);
+        out.push_back(kHexDigits[data[i] & 0x0f]);
+    }
+}
+
+void append_quoted_hex(std::string& out, const evmc::bytes32& value) {
+    out.push_back('"');
+    append_hex(out, value.bytes, sizeof(value.bytes));
+    out.push_back('"');
+}
+
+// Same output as "0x" + intx::to_string(value, 16) without any temporary string
+void append_quantity(std::string& out, const intx::uint256& value) {
+    const auto bytes = intx::be::store<evmc::bytes32>(value);
+    const auto nibble = [&](std::size_t n) { return n % 2 == 0 ? bytes.bytes[n / 2] >> 4 : bytes.bytes[n / 2] & 0x0f; };
+    std::size_t n{0};
+    while (n < 2 * sizeof(bytes.bytes) - 1 && nibble(n) == 0) {
+        ++n;
+    }
+    out.append("\"0x");
+    for (; n < 2 * sizeof(bytes.bytes); ++n) {
+        out.push_back(kHexDigits[nibble(n)]);
+    }
+    out.push_back('"');
+}
+
+TraceStream::TraceStream(asio::io_context& io_context, Writer& writer, std::size_t chunk_size, std::size_t max_pending_chunks)
+    : io_context_(io_context), writer_(writer), chunk_size_(chunk_size), max_pending_chunks_(max_pending_chunks),
+      wakeup_{io_context, asio::steady_timer::time_point::max()}, drained_{io_context, asio::steady_timer::time_point::max()} {
+    buffer_.reserve(chunk_size_);
+    asio::co_spawn(io_context_, drain(), [&](std::exception_ptr eptr) {
+        {
+            std::lock_guard lock{mutex_};
+            error_ = eptr;
+            failed_ = eptr != nullptr;
+            pending_.clear();
+        }
+        capacity_.notify_all();
+        running_ = false;
+        drained_.cancel();
+    });
+}
+
+void TraceStream::write(std::string_view content) {
+    buffer_.append(content);
+    if (buffer_.size() >= chunk_size_) {
+        flush_buffer();
+    }
+}
+
+void TraceStream::throttle() {
+    std::unique_lock lock{mutex_};
+    capacity_.wait(lock, [&]() { return pending_.size() < max_pending_chunks_ || failed_; });
+}
+
+asio::awaitable<void> TraceStream::close() {
+    if (!buffer_.empty()) {
+        flush_buffer();
+    }
+    {
+        std::lock_guard lock{mutex_};
+        closed_ = true;
+    }
+    wakeup_.cancel();
+    if (running_) {
+        asio::error_code ec;
+        co_await drained_.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+asio::awaitable<void> TraceStream::drain() {
+    std::string chunk;
+    while (true) {
+        {
+            std::lock_guard lock{mutex_};
+            if (!pending_.empty()) {
+                chunk.swap(pending_.front());
+                pending_.pop_front();
+            } else if (closed_) {
+                break;
+            }
+        }
+        if (chunk.empty()) {
+            // Producers always notify on this same io_context, so no wake-up can be lost before waiting here
+            asio::error_code ec;
+            co_await wakeup_.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+            continue;
+        }
+        capacity_.notify_one();
+        co_await writer_.write(chunk);
+        chunk.clear();
+        {
+            std::lock_guard lock{mutex_};
+            spare_.push_back(std::move(chunk));
+        }
+        chunk = std::string{};
+    }
+}
+
+void TraceStream::flush_buffer() {
+    std::string next;
+    {
+        std::lock_guard lock{mutex_};
+        if (failed_) {
+            // The writer is gone, so the content is just dropped
+            buffer_.clear();
+            return;
+        }
+        pending_.push_back(std::move(buffer_));
+        if (!spare_.empty()) {
+            next = std::move(spare_.back());
+            spare_.pop_back();
+        }
+    }
+    buffer_ = std::move(next);
+    notify_writer();
+}
+
+void TraceStream::notify_writer() {
+    if (io_context_.get_executor().running_in_this_thread()) {
+        wakeup_.cancel();
+    } else {
+        asio::post(io_context_, [this]() { wakeup_.cancel(); });
+    }
+}
+
+void StreamDebugTracer::on_execution_start(evmc_revision rev, const evmc_message& msg, evmone::bytes_view code) noexcept {
+    if (opcode_names_ == nullptr) {
+        opcode_names_ = evmc_get_instruction_names_table(rev);
+    }
+    start_gas_ = msg.gas;
+}
+
+void StreamDebugTracer::on_instruction_start(uint32_t pc , const intx::uint256 *stack_top, const int stack_height,
+              const evmone::ExecutionState& execution_state, const silkworm::IntraBlockState& intra_block_state) noexcept {
+    assert(execution_state.msg);
+    evmc::address recipient(execution_state.msg->recipient);
+
+    const auto opcode = execution_state.code[pc];
+    const auto opcode_name = opcode_names_[opcode];
+    const std::string_view op{opcode_name != nullptr ? opcode_name : ""};
+
+    bool output_storage = false;
+    if (!config_.disableStorage) {
+        if (op == "SLOAD" && stack_height >= 1) {
+            const auto address = intx::be::store<evmc::bytes32>(stack_top[0]);
+            storage_[recipient][address] = intra_block_state.get_current_storage(recipient, address);
+            output_storage = true;
+        } else if (op == "SSTORE" && stack_height >= 2) {
+            const auto address = intx::be::store<evmc::bytes32>(stack_top[0]);
+            storage_[recipient][address] = intx::be::store<evmc::bytes32>(stack_top[-1]);
+            output_storage = true;
+        }
+    }
+
+    const std::size_t memory_words = execution_state.memory.size() / 32;
+    if (pending_) {
+        if (depth_ == execution_state.msg->depth + 1) {
+            gas_cost_ = gas_ - execution_state.gas_left;
+            if (!config_.disableMemory) {
+                for (; memory_words_ < memory_words; ++memory_words_) {
+                    if (memory_words_ > 0) {
+                        memory_.push_back(',');
+                    }
+                    memory_.append("\"").append(EMPTY_MEMORY).append("\"");
+                }
+            }
+        } else if (depth_ == execution_state.msg->depth) {
+            gas_cost_ = gas_ - execution_state.gas_left;
+        }
+        write_step();
+        stream_.throttle();
+    }
+
+    pending_ = true;
+    pc_ = pc;
+    if (opcode_name == nullptr) {
+        op_ = get_opcode_name(opcode_names_, opcode);
+    } else {
+        op_.assign(op == "KECCAK256" ? "SHA3" : op); // TODO(sixtysixter) for RPCDAEMON compatibility
+    }
+    gas_ = execution_state.gas_left;
+    gas_cost_ = 0;
+    depth_ = execution_state.msg->depth + 1;
+    error_ = is_error(execution_state.status);
+
+    stack_.clear();
+    if (!config_.disableStack) {
+        for (int i = stack_height - 1; i >= 0; --i) {
+            if (i < stack_height - 1) {
+                stack_.push_back(',');
+            }
+            append_quantity(stack_, stack_top[-i]);
+        }
+    }
+
+    memory_.clear();
+    memory_words_ = 0;
+    if (!config_.disableMemory) {
+        const auto data = execution_state.memory.data();
+        for (; memory_words_ < memory_words; ++memory_words_) {
+            if (memory_words_ > 0) {
+                memory_.push_back(',');
+            }
+            memory_.push_back('"');
+            append_hex(memory_, data + memory_words_ * 32, 32);
+            memory_.push_back('"');
+        }
+    }
+
+    storage_json_.clear();
+    if (output_storage) {
+        for (const auto& [location, value] : storage_[recipient]) {
+            storage_json_.push_back(storage_json_.empty() ? '{' : ',');
+            append_quoted_hex(storage_json_, location);
+            storage_json_.push_back(':');
+            append_quoted_hex(storage_json_, value);
+        }
+        storage_json_.push_back('}');
+    }
+}
+
+void StreamDebugTracer::on_execution_end(const evmc_result& result, const silkworm::IntraBlockState& intra_block_state) noexcept {
+    if (pending_) {
+        error_ = is_error(result.status_code);
+
+        switch (result.status_code) {
+        case evmc_status_code::EVMC_REVERT:
+        case evmc_status_code::EVMC_OUT_OF_GAS:
+            gas_cost_ = 0;
+            break;
+
+        case evmc_status_code::EVMC_UNDEFINED_INSTRUCTION:
+            gas_cost_ = start_gas_ - gas_;
+            break;
+
+        default:
+            gas_cost_ = gas_ - result.gas_left;
+            break;
+        }
+    }
+}
+
+void StreamDebugTracer::flush() {
+    if (pending_) {
+        write_step();
+        pending_ = false;
+    }
+}
+
+void StreamDebugTracer::write_step() {
+    step_.clear();
+    if (steps_++ > 0) {
+        step_.push_back(',');
+    } else {
+        step_.append(opening_);
+    }
+    // Members are in the same (alphabetical) order as to_json(DebugTrace)
+    step_.append(R"({"depth":)");
+    append_number(step_, depth_);
+    if (error_) {
+        step_.append(R"(,"error":{})");
+    }
+    step_.append(R"(,"gas":)");
+    append_number(step_, gas_);
+    step_.append(R"(,"gasCost":)");
+    append_number(step_, gas_cost_);
+    if (!config_.disableMemory) {
+        step_.append(R"(,"memory":[)").append(memory_).push_back(']');
+    }
+    step_.append(R"(,"op":")").append(op_).append(R"(","pc":)");
+    append_number(step_, pc_);
+    if (!config_.disableStack) {
+        step_.append(R"(,"stack":[)").append(stack_).push_back(']');
+    }
+    if (!config_.disableStorage && !storage_json_.empty()) {
+        step_.append(R"(,"storage":)").append(storage_json_);
+    }
+    step_.push_back('}');
+    stream_.write(step_);
+}
+
+// Stream the trace of one transaction as {"structLogs":[...],"failed":...,"gas":...,"returnValue":...} preceded by the
+// separator: the opening is written along with the first step, so nothing at all is written when the pre-check fails
+// (its error is returned) or the execution throws before any step
+template<typename WorldState, typename VM>
+asio::awaitable<std::optional<std::string>> stream_trace(EVMExecutor<WorldState, VM>& executor, const silkworm::Block& block,
+        const silkrpc::Transaction& transaction, const DebugConfig& config, TraceStream& stream, std::string_view separator) {
+    const auto opening{std::string{separator} + R"({"structLogs":[)"};
+    auto debug_tracer = std::make_shared<debug::StreamDebugTracer>(stream, config, opening);
+    silkrpc::Tracers tracers{debug_tracer};
+    std::optional<ExecutionResult> execution_result;
+    std::exception_ptr eptr;
+    try {
+        execution_result = co_await executor.call(block, transaction, /* refund */ false, /* gasBailout */ false, tracers);
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    debug_tracer->flush();
+    if (!debug_tracer->started()) {
+        if (eptr) {
+            std::rethrow_exception(eptr);
+        }
+        if (execution_result->pre_check_error) {
+            co_return execution_result->pre_check_error;
+        }
+        stream.write(opening);
+    }
+    stream.write("]");
+
+    if (eptr) {
+        // Keep the content well-formed, the error is reported by the caller
+        stream.write("}");
+        std::rethrow_exception(eptr);
+    }
+
+    const bool failed = execution_result->error_code != evmc_status_code::EVMC_SUCCESS;
+    const std::int64_t gas = transaction.gas_limit - execution_result->gas_left;
+    stream.write(std::string{R"(,"failed":)"} + (failed ? "true" : "false") + R"(,"gas":)" + std::to_string(gas)
+        + R"(,"returnValue":")" + silkworm::to_hex(execution_result->data) + R"("})");
+    co_return std::nullopt;
+}
+
 template<typename WorldState, typename VM>
 asio::awaitable<std::vector<DebugTrace>> DebugExecutor<WorldState, VM>::execute(const silkworm::Block& block) {
     auto block_number = block.header.number;
@@ -251,7 +598,8 @@ asio::awaitable<std::vector<DebugTrace>> DebugExecutor<WorldState, VM>::execute(
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
 
-    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number-1};
+    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number-1, nullptr, {}, code_cache_};
+    const auto block_hash{block.header.hash()};
 
     std::vector<DebugTrace> debug_traces(transactions.size());
     for (std::uint64_t idx = 0; idx < transactions.size(); idx++) {
@@ -269,6 +617,11 @@ asio::awaitable<std::vector<DebugTrace>> DebugExecutor<WorldState, VM>::execute(
         silkrpc::Tracers tracers{debug_tracer};
         const auto execution_result = co_await executor.call(block, txn, /* refund */false, /* gasBailout */false, tracers);
 
+        // Leave checkpoints behind so that tracing single transactions of this block later resumes close to them
+        if (checkpoint_cache_ && (idx + 1) % kStateCheckpointInterval == 0 && idx + 1 < transactions.size()) {
+            checkpoint_cache_->insert(block_hash, idx + 1, executor.checkpoint(block_number));
+        }
+
         if (execution_result.pre_check_error) {
             SILKRPC_DEBUG << "debug failed: " << execution_result.pre_check_error.value() << "\n";
             debug_trace.failed = true;
@@ -300,17 +653,11 @@ asio::awaitable<DebugExecutorResult> DebugExecutor<WorldState, VM>::execute(std:
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
-    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number};
+    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number, nullptr, {}, code_cache_};
 
-    for (auto idx = 0; idx < index; idx++) {
-        silkrpc::Transaction txn{block.transactions[idx]};
-
-        if (!txn.from) {
-            txn.recover_sender();
-        }
-        const auto execution_result = co_await executor.call(block, txn);
+    if (index > 0) {
+        co_await executor.replay(block, block.header.hash(), static_cast<std::size_t>(index), checkpoint_cache_);
     }
-    executor.reset();
 
     DebugExecutorResult result;
     auto& debug_trace = result.debug_trace;
@@ -333,6 +680,96 @@ asio::awaitable<DebugExecutorResult> DebugExecutor<WorldState, VM>::execute(std:
     co_return result;
 }
 
+template<typename WorldState, typename VM>
+asio::awaitable<void> DebugExecutor<WorldState, VM>::execute(const silkworm::Block& block, Writer& writer) {
+    auto block_number = block.header.number;
+    const auto& transactions = block.transactions;
+
+    SILKRPC_DEBUG << "execute: block_number: " << block_number << " #txns: " << transactions.size() << " config: " << config_ << "\n";
+
+    // Whatever happens, the content written is a well-formed JSON array
+    TraceStream stream{io_context_, writer};
+    std::exception_ptr eptr;
+    stream.write("[");
+    try {
+        const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
+        const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
+
+        EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number-1, nullptr, {}, code_cache_};
+        const auto block_hash{block.header.hash()};
+
+        for (std::uint64_t idx = 0; idx < transactions.size(); idx++) {
+            silkrpc::Transaction txn{block.transactions[idx]};
+            if (!txn.from) {
+                txn.recover_sender();
+            }
+            SILKRPC_DEBUG << "processing transaction: idx: " << idx << " txn: " << txn << "\n";
+
+            const std::string_view separator{idx > 0 ? "," : ""};
+            const auto pre_check_error = co_await stream_trace(executor, block, txn, config_, stream, separator);
+
+            // Leave checkpoints behind so that tracing single transactions of this block later resumes close to them
+            if (checkpoint_cache_ && (idx + 1) % kStateCheckpointInterval == 0 && idx + 1 < transactions.size()) {
+                checkpoint_cache_->insert(block_hash, idx + 1, executor.checkpoint(block_number));
+            }
+
+            if (pre_check_error) {
+                SILKRPC_DEBUG << "debug failed: " << pre_check_error.value() << "\n";
+                stream.write(std::string{separator} + R"({"structLogs":[],"failed":true,"gas":0,"returnValue":""})");
+            }
+        }
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    stream.write("]");
+    co_await stream.close();
+
+    if (eptr) {
+        std::rethrow_exception(eptr);
+    }
+}
+
+template<typename WorldState, typename VM>
+asio::awaitable<std::optional<std::string>> DebugExecutor<WorldState, VM>::execute(const silkworm::Block& block,
+        const silkrpc::Transaction& transaction, Writer& writer) {
+    const auto block_number = block.header.number - 1;
+    const auto index = transaction.transaction_index;
+    SILKRPC_INFO << "DebugExecutor::execute: "
+        << " block_number: " << block_number
+        << " transaction: {" << transaction << "}"
+        << " index: " << std::dec << index
+        << " config: " << config_
+        << "\n";
+
+    // Whatever happens, the content written is either a well-formed JSON value or nothing at all, when the transaction
+    // fails the pre-check or the execution throws before any content, so that the caller can reply with a plain error
+    TraceStream stream{io_context_, writer};
+    std::optional<std::string> pre_check_error;
+    std::exception_ptr eptr;
+    try {
+        const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
+        const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
+        EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number, nullptr, {}, code_cache_};
+
+        if (index > 0) {
+            co_await executor.replay(block, block.header.hash(), static_cast<std::size_t>(index), checkpoint_cache_);
+        }
+
+        pre_check_error = co_await stream_trace(executor, block, transaction, config_, stream, "");
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    if (pre_check_error) {
+        pre_check_error = "tracing failed: " + pre_check_error.value();
+    }
+    co_await stream.close();
+
+    if (eptr) {
+        std::rethrow_exception(eptr);
+    }
+    co_return pre_check_error;
+}
+
 template class DebugExecutor<>;
 
 } // namespace silkrpc::debug
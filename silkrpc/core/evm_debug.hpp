@@ -17,13 +17,20 @@
 #ifndef SILKRPC_CORE_EVM_DEBUG_HPP_
 #define SILKRPC_CORE_EVM_DEBUG_HPP_
 
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <stack>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <asio/awaitable.hpp>
 #include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
 #include <asio/thread_pool.hpp>
 #include <nlohmann/json.hpp>
 
@@ -33,6 +40,10 @@
 #pragma GCC diagnostic pop
 #include <silkworm/state/intra_block_state.hpp>
 
+#include <silkrpc/common/code_cache.hpp>
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/state_checkpoint_cache.hpp>
+#include <silkrpc/common/writer.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
 #include <silkrpc/types/block.hpp>
@@ -90,6 +101,97 @@ private:
     std::int64_t start_gas_{0};
 };
 
+//! Bounded buffer of trace content produced on worker threads and written to a Writer running on io_context.
+//! Content is handed over in chunks: producers can be throttled until the writer catches up, so that memory stays
+//! bounded regardless of the trace length. The stream must always be closed before being destroyed.
+class TraceStream {
+public:
+    explicit TraceStream(asio::io_context& io_context, Writer& writer,
+        std::size_t chunk_size = kHttpChunkSize, std::size_t max_pending_chunks = kMaxDebugTracePendingChunks);
+
+    TraceStream(const TraceStream&) = delete;
+    TraceStream& operator=(const TraceStream&) = delete;
+
+    //! Append the given content, never blocking the caller.
+    void write(std::string_view content);
+
+    //! Block the caller until the content waiting to be written falls below the limit.
+    void throttle();
+
+    //! Write all the remaining content, rethrowing any error raised by the writer.
+    asio::awaitable<void> close();
+
+private:
+    asio::awaitable<void> drain();
+    void flush_buffer();
+    void notify_writer();
+
+    asio::io_context& io_context_;
+    Writer& writer_;
+    std::size_t chunk_size_;
+    std::size_t max_pending_chunks_;
+    std::string buffer_;
+    asio::steady_timer wakeup_;
+    asio::steady_timer drained_;
+    bool running_{true};
+    std::mutex mutex_;
+    std::condition_variable capacity_;
+    std::deque<std::string> pending_;
+    std::vector<std::string> spare_;
+    bool closed_{false};
+    bool failed_{false};
+    std::exception_ptr error_;
+};
+
+//! Tracer serializing each step as JSON directly into a TraceStream, using the same format as to_json(DebugTrace).
+//! The last step is held back until its gas cost is known: call flush() when the execution is complete.
+class StreamDebugTracer : public silkworm::EvmTracer {
+public:
+    explicit StreamDebugTracer(TraceStream& stream, const DebugConfig& config = {}, std::string opening = {})
+        : stream_(stream), config_(config), opening_(std::move(opening)) {}
+
+    StreamDebugTracer(const StreamDebugTracer&) = delete;
+    StreamDebugTracer& operator=(const StreamDebugTracer&) = delete;
+
+    void on_execution_start(evmc_revision rev, const evmc_message& msg, evmone::bytes_view code) noexcept override;
+    void on_instruction_start(uint32_t pc , const intx::uint256 *stack_top, const int stack_height,
+            const evmone::ExecutionState& execution_state, const silkworm::IntraBlockState& intra_block_state) noexcept override;
+    void on_execution_end(const evmc_result& result, const silkworm::IntraBlockState& intra_block_state) noexcept override;
+    void on_precompiled_run(const evmc::result& result, int64_t gas, const silkworm::IntraBlockState& intra_block_state) noexcept override {};
+    void on_reward_granted(const silkworm::CallResult& result, const silkworm::IntraBlockState& intra_block_state) noexcept override {};
+
+    //! Serialize the pending step, if any.
+    void flush();
+
+    //! Whether some step has been serialized, preceded by the opening.
+    bool started() const noexcept { return steps_ > 0; }
+
+private:
+    void write_step();
+
+    TraceStream& stream_;
+    const DebugConfig& config_;
+    std::string opening_;
+    std::map<evmc::address, std::map<evmc::bytes32, evmc::bytes32>> storage_;
+    const char* const* opcode_names_ = nullptr;
+    std::int64_t start_gas_{0};
+    std::size_t steps_{0};
+
+    // The pending step, whose buffers are reused to avoid allocations
+    bool pending_{false};
+    std::uint32_t pc_{0};
+    std::string op_;
+    std::int64_t gas_{0};
+    std::int64_t gas_cost_{0};
+    std::uint32_t depth_{0};
+    bool error_{false};
+    std::string memory_;
+    std::size_t memory_words_{0};
+    std::string stack_;
+    std::string storage_json_;
+    std::string step_;
+};
+
 class NullTracer : public silkworm::EvmTracer {
 public:
     NullTracer() {}
@@ -126,8 +228,10 @@ struct DebugExecutorResult {
 template<typename WorldState = silkworm::IntraBlockState, typename VM = silkworm::EVM>
 class DebugExecutor {
 public:
-    explicit DebugExecutor(asio::io_context& io_context, const core::rawdb::DatabaseReader& database_reader, asio::thread_pool& workers, const DebugConfig& config = DEFAULT_DEBUG_CONFIG)
-    : io_context_(io_context), database_reader_(database_reader), workers_{workers}, config_{config} {}
+    explicit DebugExecutor(asio::io_context& io_context, const core::rawdb::DatabaseReader& database_reader, asio::thread_pool& workers, const DebugConfig& config = DEFAULT_DEBUG_CONFIG,
+        StateCheckpointCache* checkpoint_cache = nullptr, CodeCache* code_cache = nullptr)
+    : io_context_(io_context), database_reader_(database_reader), workers_{workers}, config_{config}, checkpoint_cache_(checkpoint_cache),
+      code_cache_(code_cache) {}
     virtual ~DebugExecutor() {}
 
     DebugExecutor(const DebugExecutor&) = delete;
@@ -139,6 +243,12 @@ public:
         return execute(block.header.number-1, block, transaction, transaction.transaction_index);
     }
 
+    //! Stream the traces of all the block transactions as a JSON array to the given writer.
+    asio::awaitable<void> execute(const silkworm::Block& block, Writer& writer);
+
+    //! Stream the trace of the given transaction as a JSON object to the given writer, returning the pre-check error if any.
+    asio::awaitable<std::optional<std::string>> execute(const silkworm::Block& block, const silkrpc::Transaction& transaction, Writer& writer);
+
 private:
     asio::awaitable<DebugExecutorResult> execute(std::uint64_t block_number, const silkworm::Block& block, const silkrpc::Transaction& transaction, std::int32_t = -1);
 
@@ -146,6 +256,8 @@ private:
     const core::rawdb::DatabaseReader& database_reader_;
     asio::thread_pool& workers_;
     const DebugConfig& config_;
+    StateCheckpointCache* checkpoint_cache_;
+    CodeCache* code_cache_;
 };
 } // namespace silkrpc::debug
 
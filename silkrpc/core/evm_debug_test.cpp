@@ -16,9 +16,14 @@
 
 #include "evm_debug.hpp"
 
+#include <stdexcept>
 #include <string>
+#include <thread>
 
+#include <asio/compose.hpp>
 #include <asio/co_spawn.hpp>
+#include <asio/executor_work_guard.hpp>
+#include <asio/post.hpp>
 #include <asio/thread_pool.hpp>
 #include <asio/use_future.hpp>
 #include <catch2/catch.hpp>
@@ -26,6 +31,7 @@
 
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/common/util.hpp>
+#include <silkrpc/common/writer.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
 #include <silkrpc/core/rawdb/chain.hpp>
 #include <silkrpc/ethdb/tables.hpp>
@@ -212,6 +218,55 @@ TEST_CASE("DebugExecutor::execute call 1") {
         CHECK(result.pre_check_error.value() == "tracing failed: intrinsic gas too low: have 50000, want 53072");
     }
 
+    SECTION("Transaction: streamed failed with intrinsic gas too low writes nothing") {
+        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kZeroKey}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return kZeroHeader;
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kConfig, silkworm::ByteView{kConfigKey}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kConfigKey, kConfigValue};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey1}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey1, kAccountHistoryValue1};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey2}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey2, kAccountHistoryValue2};
+            }));
+        EXPECT_CALL(db_reader, get_one(db::table::kPlainState, silkworm::ByteView{kPlainStateKey1}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return silkworm::Bytes{};
+            }));
+
+        const auto block_number = 5'405'095; // 0x5279A7
+        silkrpc::Call call;
+        call.from = 0xe0a2Bd4258D2768837BAa26A28fE71Dc079f84c7_address;
+        call.gas = 50'000;
+        call.gas_price = 7;
+        call.data = *silkworm::from_hex("602a60005500");
+
+        silkworm::Block block{};
+        block.header.number = block_number + 1;
+        silkrpc::Transaction transaction{call.to_transaction()};
+
+        StringWriter writer;
+        asio::io_context& io_context = context_pool.next_io_context();
+        DebugExecutor executor{context_pool.next_io_context(), db_reader, workers};
+        auto execution_result = asio::co_spawn(io_context, executor.execute(block, transaction, writer), asio::use_future);
+        auto pre_check_error = execution_result.get();
+
+        context_pool.stop();
+        io_context.stop();
+        pool_thread.join();
+
+        // Nothing is written, so that the caller can reply with a plain error
+        CHECK(pre_check_error.has_value() == true);
+        CHECK(pre_check_error.value() == "tracing failed: intrinsic gas too low: have 50000, want 53072");
+        CHECK(writer.content().empty());
+    }
+
     SECTION("Call: full output") {
         EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kZeroKey}))
             .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
@@ -320,6 +375,116 @@ TEST_CASE("DebugExecutor::execute call 1") {
         })"_json);
     }
 
+    SECTION("Transaction: streamed full output") {
+        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kZeroKey}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return kZeroHeader;
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kConfig, silkworm::ByteView{kConfigKey}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kConfigKey, kConfigValue};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey1}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey1, kAccountHistoryValue1};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey3}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey3, kAccountHistoryValue3};
+            }));
+        EXPECT_CALL(db_reader, get_both_range(db::table::kPlainAccountChangeSet, silkworm::ByteView{kAccountChangeSetKey1}, silkworm::ByteView{kAccountChangeSetSubkey1}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<std::optional<silkworm::Bytes>> {
+                co_return kAccountChangeSetValue1;
+            }));
+        EXPECT_CALL(db_reader, get_both_range(db::table::kPlainAccountChangeSet, silkworm::ByteView{kAccountChangeSetKey2}, silkworm::ByteView{kAccountChangeSetSubKey2}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<std::optional<silkworm::Bytes>> {
+                co_return kAccountChangeSetValue2;
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey2}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey2, kAccountHistoryValue2};
+            }));
+        EXPECT_CALL(db_reader, get_one(db::table::kPlainState, silkworm::ByteView{kPlainStateKey2}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return silkworm::Bytes{};
+            }));
+
+        const auto block_number = 5'405'095; // 0x5279A7
+        silkrpc::Call call;
+        call.from = 0xe0a2Bd4258D2768837BAa26A28fE71Dc079f84c7_address;
+        call.gas = 118'936;
+        call.gas_price = 7;
+        call.data = *silkworm::from_hex("602a60005500");
+
+        silkworm::Block block{};
+        block.header.number = block_number + 1;
+        silkrpc::Transaction transaction{call.to_transaction()};
+
+        StringWriter writer;
+        DebugExecutor executor{context_pool.next_io_context(), db_reader, workers};
+        asio::io_context& io_context = context_pool.next_io_context();
+        auto execution_result = asio::co_spawn(io_context.get_executor(), executor.execute(block, transaction, writer), asio::use_future);
+        auto pre_check_error = execution_result.get();
+
+        context_pool.stop();
+        io_context.stop();
+        pool_thread.join();
+
+        CHECK(pre_check_error.has_value() == false);
+
+        CHECK(nlohmann::json::parse(writer.content()) == R"({
+            "failed": false,
+            "gas": 75178,
+            "returnValue": "",
+            "structLogs": [
+                {
+                    "depth": 1,
+                    "gas": 65864,
+                    "gasCost": 3,
+                    "memory": [],
+                    "op": "PUSH1",
+                    "pc": 0,
+                    "stack": []
+                },
+                {
+                    "depth": 1,
+                    "gas": 65861,
+                    "gasCost": 3,
+                    "memory": [],
+                    "op": "PUSH1",
+                    "pc": 2,
+                    "stack": [
+                        "0x2a"
+                    ]
+                },
+                {
+                    "depth": 1,
+                    "gas": 65858,
+                    "gasCost": 22100,
+                    "memory": [],
+                    "op": "SSTORE",
+                    "pc": 4,
+                    "stack": [
+                        "0x2a",
+                        "0x0"
+                    ],
+                    "storage": {
+                        "0000000000000000000000000000000000000000000000000000000000000000": "000000000000000000000000000000000000000000000000000000000000002a"
+                    }
+                },
+                {
+                    "depth": 1,
+                    "gas": 43758,
+                    "gasCost": 0,
+                    "memory": [],
+                    "op": "STOP",
+                    "pc": 5,
+                    "stack": []
+                }
+            ]
+        })"_json);
+    }
+
     SECTION("Call: no stack") {
         EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kZeroKey}))
             .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
@@ -1686,6 +1851,87 @@ TEST_CASE("DebugExecutor::execute block") {
 }
 
 
+TEST_CASE("TraceStream") {
+    SILKRPC_LOG_STREAMS(null_stream(), null_stream());
+    SILKRPC_LOG_VERBOSITY(LogLevel::None);
+
+    asio::io_context io_context;
+    auto work = asio::make_work_guard(io_context);
+    std::thread io_thread{[&]() { io_context.run(); }};
+    asio::thread_pool workers{1};
+
+    // Write the given number of items from one worker thread, throttling as the tracer does
+    const auto produce = [&](TraceStream& stream, int count) {
+        return asio::async_compose<decltype(asio::use_awaitable), void()>(
+            [&, count](auto&& self) {
+                asio::post(workers, [&, count, self = std::move(self)]() mutable {
+                    for (int i{0}; i < count; ++i) {
+                        stream.write(std::to_string(i) + ",");
+                        stream.throttle();
+                    }
+                    asio::post(io_context, [self = std::move(self)]() mutable {
+                        self.complete();
+                    });
+                });
+            },
+            asio::use_awaitable);
+    };
+
+    SECTION("content is written in order") {
+        StringWriter writer;
+        auto result = asio::co_spawn(io_context, [&]() -> asio::awaitable<void> {
+            TraceStream stream{io_context, writer, /*chunk_size=*/16, /*max_pending_chunks=*/2};
+            stream.write("[");
+            co_await produce(stream, 1000);
+            stream.write("]");
+            co_await stream.close();
+        }, asio::use_future);
+        result.get();
+
+        std::string expected{"["};
+        for (int i{0}; i < 1000; ++i) {
+            expected.append(std::to_string(i) + ",");
+        }
+        expected.append("]");
+        CHECK(writer.content() == expected);
+    }
+
+    SECTION("content smaller than one chunk is written on close") {
+        StringWriter writer;
+        auto result = asio::co_spawn(io_context, [&]() -> asio::awaitable<void> {
+            TraceStream stream{io_context, writer};
+            stream.write("[]");
+            CHECK(writer.content().empty());
+            co_await stream.close();
+        }, asio::use_future);
+        result.get();
+        CHECK(writer.content() == "[]");
+    }
+
+    SECTION("writer error does not block producer and is rethrown on close") {
+        class FailingWriter : public Writer {
+        public:
+            asio::awaitable<void> write(std::string_view content) override {
+                throw std::runtime_error{"connection reset"};
+                co_return;
+            }
+            asio::awaitable<void> close() override {
+                co_return;
+            }
+        };
+        FailingWriter writer;
+        auto result = asio::co_spawn(io_context, [&]() -> asio::awaitable<void> {
+            TraceStream stream{io_context, writer, /*chunk_size=*/16, /*max_pending_chunks=*/2};
+            co_await produce(stream, 1000);
+            co_await stream.close();
+        }, asio::use_future);
+        CHECK_THROWS_MATCHES(result.get(), std::runtime_error, Message("connection reset"));
+    }
+
+    work.reset();
+    io_thread.join();
+}
+
 TEST_CASE("DebugTrace json serialization") {
     SILKRPC_LOG_STREAMS(null_stream(), null_stream());
     SILKRPC_LOG_VERBOSITY(LogLevel::None);
@@ -17,9 +17,13 @@
 #include "evm_executor.hpp"
 
 #include <array>
+#include <atomic>
+#include <memory>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 
 #include <asio/compose.hpp>
@@ -31,7 +35,9 @@
 #include <silkworm/chain/protocol_param.hpp>
 #include <silkworm/common/util.hpp>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
+#include <silkrpc/common/state_checkpoint_cache.hpp>
 #include <silkrpc/common/util.hpp>
 #include <silkrpc/types/transaction.hpp>
 
@@ -156,11 +162,11 @@ std::string EVMExecutor<WorldState, VM>::get_error_message(int64_t error_code, c
 }
 
 template<typename WorldState, typename VM>
-uint64_t EVMExecutor<WorldState, VM>::refund_gas(const VM& evm, const silkworm::Transaction& txn, uint64_t gas_left) {
+uint64_t EVMExecutor<WorldState, VM>::refund_gas(WorldState& state, const VM& evm, const silkworm::Transaction& txn, uint64_t gas_left) {
     const evmc_revision rev{evm.revision()};
-    uint64_t refund{state_.get_refund()};
+    uint64_t refund{state.get_refund()};
     if (rev < EVMC_LONDON) {
-        refund += silkworm::fee::kRSelfDestruct * state_.number_of_self_destructs();
+        refund += silkworm::fee::kRSelfDestruct * state.number_of_self_destructs();
     }
     const uint64_t max_refund_quotient{rev >= EVMC_LONDON ? silkworm::param::kMaxRefundQuotientLondon
                                                           : silkworm::param::kMaxRefundQuotientFrontier};
@@ -173,13 +179,66 @@ uint64_t EVMExecutor<WorldState, VM>::refund_gas(const VM& evm, const silkworm::
     const intx::uint256 effective_gas_price{txn.max_fee_per_gas >= base_fee_per_gas ? txn.effective_gas_price(base_fee_per_gas)
                                                                                     : txn.max_priority_fee_per_gas};
     SILKRPC_DEBUG << "EVMExecutor::refund_gas effective_gas_price: " << effective_gas_price << "\n";
-    state_.add_to_balance(*txn.from, gas_left * effective_gas_price);
+    state.add_to_balance(*txn.from, gas_left * effective_gas_price);
     return gas_left;
 }
 
 template<typename WorldState, typename VM>
 void EVMExecutor<WorldState, VM>::reset() {
-    state_.clear_journal_and_substate();
+    state_->clear_journal_and_substate();
+}
+
+template<typename WorldState, typename VM>
+void EVMExecutor<WorldState, VM>::reset_state() {
+    state_.emplace(overlay_state_);
+    state_changed_ = false;
+}
+
+template<typename WorldState, typename VM>
+asio::awaitable<void> EVMExecutor<WorldState, VM>::replay(const silkworm::Block& block, const evmc::bytes32& block_hash, std::size_t transaction_index,
+    StateCheckpointCache* checkpoint_cache) {
+    std::size_t start_index{0};
+    const auto checkpoint_found = checkpoint_cache ? checkpoint_cache->find(block_hash, transaction_index) : std::nullopt;
+    if (checkpoint_found) {
+        overlay_state_.set_base(checkpoint_found->delta);
+        start_index = checkpoint_found->transaction_index;
+    }
+    SILKRPC_DEBUG << "EVMExecutor::replay block: " << block.header.number << " transaction_index: " << transaction_index
+        << " start_index: " << start_index << "\n";
+
+    for (auto idx{start_index}; idx < transaction_index; idx++) {
+        silkrpc::Transaction txn{block.transactions[idx]};
+        if (!txn.from) {
+            txn.recover_sender();
+        }
+        co_await call(block, txn);
+
+        const auto next_index{idx + 1};
+        if (checkpoint_cache && (next_index == transaction_index || next_index % kStateCheckpointInterval == 0)) {
+            checkpoint_cache->insert(block_hash, next_index, checkpoint(block.header.number));
+        }
+    }
+    reset();
+}
+
+template<typename WorldState, typename VM>
+std::shared_ptr<const state::StateDelta> EVMExecutor<WorldState, VM>::checkpoint(uint64_t block_number) {
+    overlay_state_.begin_capture();
+    state_->write_to_db(block_number);
+    return state::flatten(overlay_state_.end_capture());
+}
+
+template<typename WorldState, typename VM>
+std::shared_ptr<const state::StateDelta> EVMExecutor<WorldState, VM>::rebase(uint64_t block_number, bool flatten) {
+    overlay_state_.begin_capture();
+    state_->write_to_db(block_number);
+    auto delta = overlay_state_.end_capture();
+    if (flatten) {
+        delta = state::flatten(delta);
+    }
+    overlay_state_.set_base(delta);
+    reset_state();
+    return delta;
 }
 template<typename WorldState, typename VM>
 std::optional<std::string> EVMExecutor<WorldState, VM>::pre_check(const VM& evm, const silkworm::Transaction& txn, const intx::uint256 base_fee_per_gas, const intx::uint128 g0) {
@@ -211,101 +270,250 @@ std::optional<std::string> EVMExecutor<WorldState, VM>::pre_check(const VM& evm,
 }
 
 template<typename WorldState, typename VM>
-asio::awaitable<ExecutionResult> EVMExecutor<WorldState, VM>::call(const silkworm::Block& block, const silkworm::Transaction& txn, bool refund, bool gas_bailout, const Tracers& tracers) {
-    SILKRPC_DEBUG << "EVMExecutor::call: " << block.header.number << " gasLimit: " << txn.gas_limit << " refund: " << refund << " gasBailout: " << gas_bailout << "\n";
-    SILKRPC_DEBUG << "EVMExecutor::call:Transaction: " << &txn << "Txn: " << txn << "\n";
+ExecutionResult EVMExecutor<WorldState, VM>::execute(WorldState& state, const silkworm::Block& block, const silkworm::Transaction& txn, bool refund, bool gas_bailout,
+    const Tracers& tracers) {
+    VM evm{block, state, config_};
+    for (auto& tracer : tracers) {
+        evm.add_tracer(*tracer);
+    }
 
-    const auto exec_result = co_await asio::async_compose<decltype(asio::use_awaitable), void(ExecutionResult)>(
-        [this, &block, &txn, &tracers, &refund, &gas_bailout](auto&& self) {
-            SILKRPC_TRACE << "EVMExecutor::call post block: " << block.header.number << " txn: " << &txn << "\n";
-            asio::post(workers_, [this, &block, &txn, &tracers, &refund, &gas_bailout, self = std::move(self)]() mutable {
-                VM evm{block, state_, config_};
-                for (auto& tracer : tracers) {
-                    evm.add_tracer(*tracer);
-                }
+    assert(txn.from.has_value());
+    state.access_account(*txn.from);
 
-                assert(txn.from.has_value());
-                state_.access_account(*txn.from);
+    const evmc_revision rev{evm.revision()};
+    const intx::uint256 base_fee_per_gas{evm.block().header.base_fee_per_gas.value_or(0)};
+    const intx::uint128 g0{silkworm::intrinsic_gas(txn, rev >= EVMC_HOMESTEAD, rev >= EVMC_ISTANBUL)};
+    assert(g0 <= UINT64_MAX); // true due to the precondition (transaction must be valid)
 
-                const evmc_revision rev{evm.revision()};
-                const intx::uint256 base_fee_per_gas{evm.block().header.base_fee_per_gas.value_or(0)};
-                const intx::uint128 g0{silkworm::intrinsic_gas(txn, rev >= EVMC_HOMESTEAD, rev >= EVMC_ISTANBUL)};
-                assert(g0 <= UINT64_MAX); // true due to the precondition (transaction must be valid)
+    const auto error = pre_check(evm, txn, base_fee_per_gas, g0);
+    if (error) {
+        silkworm::Bytes data{};
+        return ExecutionResult{1000, txn.gas_limit, data, *error};
+    }
 
-                const auto error = pre_check(evm, txn, base_fee_per_gas, g0);
-                if (error) {
-                    silkworm::Bytes data{};
-                    ExecutionResult exec_result{1000, txn.gas_limit, data, *error};
-                    asio::post(io_context_, [exec_result, self = std::move(self)]() mutable {
-                        self.complete(exec_result);
-                    });
-                    return;
-                }
+    intx::uint256 want;
+    if (txn.max_fee_per_gas > 0 || txn.max_priority_fee_per_gas > 0) {
+       // this method should be called after check (max_fee and base_fee) present in pre_check() method
+       const intx::uint256 effective_gas_price{txn.effective_gas_price(base_fee_per_gas)};
+       want = txn.gas_limit * effective_gas_price;
+    } else {
+       want = 0;
+    }
+    const auto have = state.get_balance(*txn.from);
+    if (have < want + txn.value && !gas_bailout) {
+       silkworm::Bytes data{};
+       std::string from = silkworm::to_hex(*txn.from);
+       std::string error = "insufficient funds for gas * price + value: address 0x" + from + " have " + intx::to_string(have) + " want " + intx::to_string(want+txn.value);
+       return ExecutionResult{1000, txn.gas_limit, data, error};
+    }
+    state.subtract_from_balance(*txn.from, want);
 
-                intx::uint256 want;
-                if (txn.max_fee_per_gas > 0 || txn.max_priority_fee_per_gas > 0) {
-                   // this method should be called after check (max_fee and base_fee) present in pre_check() method
-                   const intx::uint256 effective_gas_price{txn.effective_gas_price(base_fee_per_gas)};
-                   want = txn.gas_limit * effective_gas_price;
-                } else {
-                   want = 0;
-                }
-                const auto have = state_.get_balance(*txn.from);
-                if (have < want + txn.value && !gas_bailout) {
-                   silkworm::Bytes data{};
-                   std::string from = silkworm::to_hex(*txn.from);
-                   std::string error = "insufficient funds for gas * price + value: address 0x" + from + " have " + intx::to_string(have) + " want " + intx::to_string(want+txn.value);
-                   ExecutionResult exec_result{1000, txn.gas_limit, data, error};
-                   asio::post(io_context_, [exec_result, self = std::move(self)]() mutable {
-                       self.complete(exec_result);
-                   });
-                   return;
-                }
-                state_.subtract_from_balance(*txn.from, want);
+    if (txn.to.has_value()) {
+        state.access_account(*txn.to);
+        // EVM itself increments the nonce for contract creation
+        state.set_nonce(*txn.from, state.get_nonce(*txn.from) + 1);
+    }
+    for (const silkworm::AccessListEntry& ae : txn.access_list) {
+        state.access_account(ae.account);
+        for (const evmc::bytes32& key : ae.storage_keys) {
+            state.access_storage(ae.account, key);
+        }
+    }
 
-                if (txn.to.has_value()) {
-                    state_.access_account(*txn.to);
-                    // EVM itself increments the nonce for contract creation
-                    state_.set_nonce(*txn.from, state_.get_nonce(*txn.from) + 1);
-                }
-                for (const silkworm::AccessListEntry& ae : txn.access_list) {
-                    state_.access_account(ae.account);
-                    for (const evmc::bytes32& key : ae.storage_keys) {
-                        state_.access_storage(ae.account, key);
-                    }
-                }
+    SILKRPC_DEBUG << "EVMExecutor::execute on EVM txn: " << &txn << " g0: " << static_cast<uint64_t>(g0) << " start\n";
+    const auto result{evm.execute(txn, txn.gas_limit - static_cast<uint64_t>(g0))};
+    SILKRPC_DEBUG << "EVMExecutor::execute on EVM txn: " << &txn << " gas_left: " << result.gas_left << " end\n";
 
-                SILKRPC_DEBUG << "EVMExecutor::call execute on EVM txn: " << &txn << " g0: " << static_cast<uint64_t>(g0) << " start\n";
-                const auto result{evm.execute(txn, txn.gas_limit - static_cast<uint64_t>(g0))};
-                SILKRPC_DEBUG << "EVMExecutor::call execute on EVM txn: " << &txn << " gas_left: " << result.gas_left << " end\n";
+    uint64_t gas_left = result.gas_left;
+    const uint64_t gas_used{txn.gas_limit - refund_gas(state, evm, txn, result.gas_left)};
+    if (refund) {
+        gas_left = txn.gas_limit - gas_used;
+    }
+    state.finalize_transaction();
 
-                uint64_t gas_left = result.gas_left;
-                const uint64_t gas_used{txn.gas_limit - refund_gas(evm, txn, result.gas_left)};
-                if (refund) {
-                    gas_left = txn.gas_limit - gas_used;
-                }
-                state_.finalize_transaction();
+    // reward the fee recipient
+    const intx::uint256 priority_fee_per_gas{txn.priority_fee_per_gas(base_fee_per_gas)};
+    SILKRPC_DEBUG << "EVMExecutor::execute evm.beneficiary: " << evm.beneficiary << " balance: " << priority_fee_per_gas * gas_used << "\n";
+    state.add_to_balance(evm.beneficiary, priority_fee_per_gas * gas_used);
 
-                // reward the fee recipient
-                const intx::uint256 priority_fee_per_gas{txn.priority_fee_per_gas(base_fee_per_gas)};
-                SILKRPC_DEBUG << "EVMExecutor::call evm.beneficiary: " << evm.beneficiary << " balance: " << priority_fee_per_gas * gas_used << "\n";
-                state_.add_to_balance(evm.beneficiary, priority_fee_per_gas * gas_used);
+    for (auto tracer : evm.tracers()) {
+        tracer.get().on_reward_granted(result, evm.state());
+    }
 
-                for (auto tracer : evm.tracers()) {
-                    tracer.get().on_reward_granted(result, evm.state());
-                }
+    return ExecutionResult{result.status, gas_left, result.data};
+}
 
-                ExecutionResult exec_result{result.status, gas_left, result.data};
+template<typename WorldState, typename VM>
+asio::awaitable<void> EVMExecutor<WorldState, VM>::prefetch_declared(const silkworm::Block& block, const silkworm::Transaction& txn) {
+    state::ReadMisses declared_accounts;
+    if (txn.from) {
+        declared_accounts.accounts.push_back(*txn.from);
+    }
+    if (txn.to) {
+        declared_accounts.accounts.push_back(*txn.to);
+    }
+    declared_accounts.accounts.push_back(block.header.beneficiary);
+    for (const silkworm::AccessListEntry& ae : txn.access_list) {
+        declared_accounts.accounts.push_back(ae.account);
+    }
+    co_await remote_state_.prefetch(declared_accounts);
+
+    // Storage is keyed by incarnation and code by hash, both known only once the accounts have been read
+    state::ReadMisses declared_storage_and_code;
+    for (const auto& address : declared_accounts.accounts) {
+        const auto account = remote_state_.find_account(address);
+        if (account && *account && (*account)->code_hash != silkworm::kEmptyHash) {
+            declared_storage_and_code.code.push_back((*account)->code_hash);
+        }
+    }
+    for (const silkworm::AccessListEntry& ae : txn.access_list) {
+        const auto account = remote_state_.find_account(ae.account);
+        if (!account || !*account) {
+            continue;
+        }
+        for (const evmc::bytes32& key : ae.storage_keys) {
+            declared_storage_and_code.storage.push_back(state::StorageLocation{ae.account, (*account)->incarnation, key});
+        }
+    }
+    co_await remote_state_.prefetch(declared_storage_and_code);
+}
+
+template<typename WorldState, typename VM>
+asio::awaitable<ExecutionResult> EVMExecutor<WorldState, VM>::execute_on_worker(const silkworm::Block& block, const silkworm::Transaction& txn,
+    bool refund, bool gas_bailout, const Tracers& tracers) {
+    const auto exec_result = co_await asio::async_compose<decltype(asio::use_awaitable), void(ExecutionResult)>(
+        [this, &block, &txn, &tracers, &refund, &gas_bailout](auto&& self) {
+            SILKRPC_TRACE << "EVMExecutor::call post block: " << block.header.number << " txn: " << &txn << "\n";
+            asio::post(workers_, [this, &block, &txn, &tracers, &refund, &gas_bailout, self = std::move(self)]() mutable {
+                auto exec_result = execute(*state_, block, txn, refund, gas_bailout, tracers);
                 asio::post(io_context_, [exec_result, self = std::move(self)]() mutable {
                     self.complete(exec_result);
                 });
             });
         },
         asio::use_awaitable);
+    co_return exec_result;
+}
 
-    SILKRPC_DEBUG << "EVMExecutor::call exec_result: " << exec_result.error_code << " #data: " << exec_result.data.size() << " end\n";
+template<typename WorldState, typename VM>
+asio::awaitable<ExecutionResult> EVMExecutor<WorldState, VM>::call(const silkworm::Block& block, const silkworm::Transaction& txn, bool refund, bool gas_bailout, const Tracers& tracers) {
+    SILKRPC_DEBUG << "EVMExecutor::call: " << block.header.number << " gasLimit: " << txn.gas_limit << " refund: " << refund << " gasBailout: " << gas_bailout << "\n";
+    SILKRPC_DEBUG << "EVMExecutor::call:Transaction: " << &txn << "Txn: " << txn << "\n";
 
-    co_return exec_result;
+    // Read the state accessed by the transaction without pinning any worker thread, so that execution rarely blocks.
+    // Repeating a call whose previous execution did not block (e.g. when estimating gas) needs no prefetch at all.
+    const bool repeated_call{last_call_ && last_call_->from == txn.from && last_call_->to == txn.to && last_call_->data == txn.data};
+    if (!repeated_call) {
+        co_await prefetch_declared(block, txn);
+    }
+    const auto blocking_reads{remote_state_.blocking_reads()};
+
+    // An untraced execution on a pristine world state runs speculatively on the world state itself: entries not read yet
+    // are recorded as misses instead of blocking, and if there are none the speculative result is the actual one. Otherwise
+    // the world state is discarded and the misses are read before trying again. Traced executions and executions on top
+    // of previous ones cannot be discarded, so they run once reading the entries still missing by blocking.
+    std::optional<ExecutionResult> exec_result;
+    if (!repeated_call && tracers.empty() && !state_changed_) {
+        for (std::size_t round{0}; round < kMaxSpeculativeExecutions && !exec_result; ++round) {
+            state::ReadMisses misses;
+            remote_state_.set_speculation(&misses);
+            auto speculative_result = co_await execute_on_worker(block, txn, refund, gas_bailout, tracers);
+            remote_state_.set_speculation(nullptr);
+
+            SILKRPC_DEBUG << "EVMExecutor::call speculation round: " << round << " #accounts: " << misses.accounts.size()
+                << " #storage: " << misses.storage.size() << " #code: " << misses.code.size() << "\n";
+            if (misses.empty()) {
+                exec_result = std::move(speculative_result);
+            } else {
+                state_.emplace(overlay_state_);
+                co_await remote_state_.prefetch(misses);
+            }
+        }
+    }
+    if (!exec_result) {
+        exec_result = co_await execute_on_worker(block, txn, refund, gas_bailout, tracers);
+    }
+    state_changed_ = true;
+
+    if (remote_state_.blocking_reads() == blocking_reads) {
+        last_call_ = CallKey{txn.from, txn.to, txn.data};
+    } else {
+        last_call_.reset();
+    }
+
+    SILKRPC_DEBUG << "EVMExecutor::call exec_result: " << exec_result->error_code << " #data: " << exec_result->data.size() << " end\n";
+
+    co_return *exec_result;
+}
+
+template<typename WorldState, typename VM>
+asio::awaitable<std::vector<ExecutionResult>> EVMExecutor<WorldState, VM>::call_many(const silkworm::Block& block, const std::vector<silkworm::Transaction>& txns,
+    bool refund, bool gas_bailout) {
+    SILKRPC_DEBUG << "EVMExecutor::call_many: " << block.header.number << " #txns: " << txns.size() << "\n";
+
+    std::vector<ExecutionResult> results(txns.size());
+    std::vector<std::size_t> pending(txns.size());
+    std::iota(pending.begin(), pending.end(), 0);
+
+    // Execute concurrently on the state read so far, which is read-only until all the executions are done
+    for (std::size_t round{0}; round < kMaxSpeculativeExecutions && !pending.empty(); ++round) {
+        std::vector<state::ReadMisses> misses(pending.size());
+        co_await asio::async_compose<decltype(asio::use_awaitable), void()>(
+            [this, &block, &txns, &refund, &gas_bailout, &pending, &results, &misses](auto&& self) {
+                auto completion = std::make_shared<std::decay_t<decltype(self)>>(std::move(self));
+                auto remaining = std::make_shared<std::atomic_size_t>(pending.size());
+                for (std::size_t i{0}; i < pending.size(); ++i) {
+                    asio::post(workers_, [this, &block, &txns, &refund, &gas_bailout, &pending, &results, &misses, i, completion, remaining]() {
+                        state::SpeculativeState speculative_state{remote_state_};
+                        state::OverlayState speculative_overlay{speculative_state};
+                        speculative_overlay.set_base(overlay_state_.base());
+                        WorldState world_state{speculative_overlay};
+                        results[pending[i]] = execute(world_state, block, txns[pending[i]], refund, gas_bailout, {});
+                        misses[i] = speculative_state.misses();
+                        if (remaining->fetch_sub(1) == 1) {
+                            asio::post(io_context_, [completion]() {
+                                completion->complete();
+                            });
+                        }
+                    });
+                }
+            },
+            asio::use_awaitable);
+
+        // Read the entries missed by all the executions at once before repeating them
+        std::vector<std::size_t> still_pending;
+        state::ReadMisses all_misses;
+        for (std::size_t i{0}; i < pending.size(); ++i) {
+            if (!misses[i].empty()) {
+                all_misses.accounts.insert(all_misses.accounts.end(), misses[i].accounts.begin(), misses[i].accounts.end());
+                all_misses.storage.insert(all_misses.storage.end(), misses[i].storage.begin(), misses[i].storage.end());
+                all_misses.code.insert(all_misses.code.end(), misses[i].code.begin(), misses[i].code.end());
+                still_pending.push_back(pending[i]);
+            }
+        }
+        if (!all_misses.empty()) {
+            co_await remote_state_.prefetch(all_misses);
+        }
+        SILKRPC_DEBUG << "EVMExecutor::call_many round: " << round << " #repeated: " << still_pending.size() << "\n";
+        pending = std::move(still_pending);
+    }
+
+    // Executions still reading missing entries run one at a time, blocking on the reads
+    for (const auto index : pending) {
+        results[index] = co_await asio::async_compose<decltype(asio::use_awaitable), void(ExecutionResult)>(
+            [this, &block, &txns, &refund, &gas_bailout, index](auto&& self) {
+                asio::post(workers_, [this, &block, &txns, &refund, &gas_bailout, index, self = std::move(self)]() mutable {
+                    WorldState world_state{overlay_state_};
+                    auto exec_result = execute(world_state, block, txns[index], refund, gas_bailout, {});
+                    asio::post(io_context_, [exec_result, self = std::move(self)]() mutable {
+                        self.complete(exec_result);
+                    });
+                });
+            },
+            asio::use_awaitable);
+    }
+
+    co_return results;
 }
 
 template class EVMExecutor<silkworm::IntraBlockState, silkworm::EVM>;
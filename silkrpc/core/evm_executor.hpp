@@ -17,8 +17,11 @@
 #ifndef SILKRPC_CORE_EVM_EXECUTOR_HPP_
 #define SILKRPC_CORE_EVM_EXECUTOR_HPP_
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <silkrpc/config.hpp> // NOLINT(build/include_order)
@@ -37,6 +40,7 @@
 
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/core/remote_state.hpp>
+#include <silkrpc/core/state_delta.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
 
 namespace silkrpc {
@@ -55,25 +59,68 @@ class EVMExecutor {
 public:
     static std::string get_error_message(int64_t error_code, const silkworm::Bytes& error_data, const bool full_error = true);
 
-    explicit EVMExecutor(asio::io_context& io_context, const core::rawdb::DatabaseReader& db_reader, const silkworm::ChainConfig& config, asio::thread_pool& workers, uint64_t block_number)
-    : io_context_(io_context), db_reader_(db_reader), config_(config), workers_{workers}, remote_state_{io_context_, db_reader, block_number}, state_{remote_state_} {}
+    explicit EVMExecutor(asio::io_context& io_context, const core::rawdb::DatabaseReader& db_reader, const silkworm::ChainConfig& config, asio::thread_pool& workers, uint64_t block_number,
+        StateCache* state_cache = nullptr, CoherentStateView latest_view = {}, CodeCache* code_cache = nullptr)
+    : io_context_(io_context), db_reader_(db_reader), config_(config), workers_{workers},
+      remote_state_{io_context_, db_reader, block_number, state_cache, latest_view, code_cache},
+      overlay_state_{remote_state_}, state_{std::in_place, overlay_state_} {}
     virtual ~EVMExecutor() {}
 
     EVMExecutor(const EVMExecutor&) = delete;
     EVMExecutor& operator=(const EVMExecutor&) = delete;
 
     asio::awaitable<ExecutionResult> call(const silkworm::Block& block, const silkworm::Transaction& txn, bool refund = true, bool gas_bailout = false, const Tracers& tracers = {});
+
+    //! Execute the transactions concurrently on the workers, each one independently on top of the block state regardless
+    //! of previous calls. Executions share the state read so far: those reading missing entries are repeated after
+    //! reading them, so that results are the same as executing each transaction alone.
+    asio::awaitable<std::vector<ExecutionResult>> call_many(const silkworm::Block& block, const std::vector<silkworm::Transaction>& txns,
+        bool refund = true, bool gas_bailout = false);
     void reset();
+
+    //! Discard the state changes of the previous calls, keeping the state read so far for the next ones
+    void reset_state();
+
+    //! Execute the transactions of the block preceding the given index on top of the parent state, resuming from the
+    //! nearest checkpoint in the given cache (if any) and caching new ones along the way. Must be called before any other execution.
+    asio::awaitable<void> replay(const silkworm::Block& block, const evmc::bytes32& block_hash, std::size_t transaction_index,
+        StateCheckpointCache* checkpoint_cache);
+
+    //! Snapshot the state changes executed so far, including those of the checkpoint replay resumed from
+    std::shared_ptr<const state::StateDelta> checkpoint(uint64_t block_number);
+
+    //! Move the state changes executed since the previous rebase into a delta on top of the current base, which the next
+    //! executions read through, and return it. Unlike checkpoint, just the new changes are copied unless flattening is requested.
+    std::shared_ptr<const state::StateDelta> rebase(uint64_t block_number, bool flatten = false);
 private:
     std::optional<std::string> pre_check(const VM& evm, const silkworm::Transaction& txn, const intx::uint256 base_fee_per_gas, const intx::uint128 g0);
-    uint64_t refund_gas(const VM& evm, const silkworm::Transaction& txn, uint64_t gas_left);
+    uint64_t refund_gas(WorldState& state, const VM& evm, const silkworm::Transaction& txn, uint64_t gas_left);
+    ExecutionResult execute(WorldState& state, const silkworm::Block& block, const silkworm::Transaction& txn, bool refund, bool gas_bailout, const Tracers& tracers);
+
+    //! Execute the transaction on the world state of this executor using one worker thread
+    asio::awaitable<ExecutionResult> execute_on_worker(const silkworm::Block& block, const silkworm::Transaction& txn, bool refund, bool gas_bailout,
+        const Tracers& tracers);
+
+    //! Read the accounts, code and storage declared by the transaction and its access list
+    asio::awaitable<void> prefetch_declared(const silkworm::Block& block, const silkworm::Transaction& txn);
+
+    //! Call executed without blocking state reads, used to skip speculation when the same call is repeated
+    struct CallKey {
+        std::optional<evmc::address> from;
+        std::optional<evmc::address> to;
+        silkworm::Bytes data;
+    };
 
     asio::io_context& io_context_;
     const core::rawdb::DatabaseReader& db_reader_;
     const silkworm::ChainConfig& config_;
     asio::thread_pool& workers_;
     state::RemoteState remote_state_;
-    WorldState state_;
+    state::OverlayState overlay_state_;
+    std::optional<WorldState> state_;
+    //! Whether state_ holds the changes of some previous execution, so that it cannot be discarded
+    bool state_changed_{false};
+    std::optional<CallKey> last_call_;
 };
 
 } // namespace silkrpc
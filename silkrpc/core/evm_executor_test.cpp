@@ -228,6 +228,112 @@ TEST_CASE("EVMexecutor") {
         CHECK(result.error_code == 0);
     }
 
+    SECTION("call repeated after reset_state returns SUCCESS") {
+        StubDatabase tx_database;
+        const uint64_t chain_id = 5;
+        const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
+
+        ChannelFactory my_channel = []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); };
+        ContextPool my_pool{1, my_channel};
+        asio::thread_pool workers{1};
+        auto pool_thread = std::thread([&]() { my_pool.run(); });
+
+        const auto block_number = 6000000;
+        silkworm::Block block{};
+        block.header.number = block_number;
+        silkworm::Transaction txn{};
+        txn.gas_limit = 600000;
+        txn.from = 0xa872626373628737383927236382161739290870_address;
+        txn.access_list = access_list;
+
+        EVMExecutor executor{my_pool.next_io_context(), tx_database, *chain_config_ptr, workers, block_number};
+        auto execution_result1 = asio::co_spawn(my_pool.next_io_context().get_executor(), executor.call(block, txn, true, true, {}), asio::use_future);
+        auto result1 = execution_result1.get();
+        executor.reset_state();
+        txn.gas_limit = 300000;
+        auto execution_result2 = asio::co_spawn(my_pool.next_io_context().get_executor(), executor.call(block, txn, true, true, {}), asio::use_future);
+        auto result2 = execution_result2.get();
+        my_pool.stop();
+        pool_thread.join();
+        CHECK(result1.error_code == 0);
+        CHECK(result2.error_code == 0);
+    }
+
+    SECTION("call repeated on top of previous call returns SUCCESS") {
+        StubDatabase tx_database;
+        const uint64_t chain_id = 5;
+        const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
+
+        ChannelFactory my_channel = []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); };
+        ContextPool my_pool{1, my_channel};
+        asio::thread_pool workers{1};
+        auto pool_thread = std::thread([&]() { my_pool.run(); });
+
+        const auto block_number = 6000000;
+        silkworm::Block block{};
+        block.header.number = block_number;
+        silkworm::Transaction txn{};
+        txn.gas_limit = 600000;
+        txn.from = 0xa872626373628737383927236382161739290870_address;
+        txn.access_list = access_list;
+
+        EVMExecutor executor{my_pool.next_io_context(), tx_database, *chain_config_ptr, workers, block_number};
+        auto execution_result1 = asio::co_spawn(my_pool.next_io_context().get_executor(), executor.call(block, txn, true, true, {}), asio::use_future);
+        auto result1 = execution_result1.get();
+        txn.to = 0xbb9bc244d798123fde783fcc1c72d3bb8c189413_address;
+        auto execution_result2 = asio::co_spawn(my_pool.next_io_context().get_executor(), executor.call(block, txn, true, true, {}), asio::use_future);
+        auto result2 = execution_result2.get();
+        my_pool.stop();
+        pool_thread.join();
+        CHECK(result1.error_code == 0);
+        CHECK(result2.error_code == 0);
+    }
+
+    SECTION("call_many returns the same results as call") {
+        StubDatabase tx_database;
+        const uint64_t chain_id = 5;
+        const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
+
+        ChannelFactory my_channel = []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); };
+        ContextPool my_pool{1, my_channel};
+        asio::thread_pool workers{2};
+        auto pool_thread = std::thread([&]() { my_pool.run(); });
+
+        const auto block_number = 6000000;
+        silkworm::Block block{};
+        block.header.number = block_number;
+        std::vector<silkworm::Transaction> txns(3);
+        for (auto& txn : txns) {
+            txn.from = 0xa872626373628737383927236382161739290870_address;
+            txn.to = 0xbb9bc244d798123fde783fcc1c72d3bb8c189413_address;
+            txn.access_list = access_list;
+        }
+        txns[0].gas_limit = 600000;
+        txns[1].gas_limit = 1000;
+        txns[2].gas_limit = 300000;
+
+        EVMExecutor executor{my_pool.next_io_context(), tx_database, *chain_config_ptr, workers, block_number};
+        auto execution_results = asio::co_spawn(my_pool.next_io_context().get_executor(), executor.call_many(block, txns), asio::use_future);
+        auto results = execution_results.get();
+        std::vector<ExecutionResult> expected_results;
+        for (const auto& txn : txns) {
+            EVMExecutor single_executor{my_pool.next_io_context(), tx_database, *chain_config_ptr, workers, block_number};
+            auto execution_result = asio::co_spawn(my_pool.next_io_context().get_executor(), single_executor.call(block, txn), asio::use_future);
+            expected_results.push_back(execution_result.get());
+        }
+        my_pool.stop();
+        pool_thread.join();
+        REQUIRE(results.size() == txns.size());
+        CHECK(results[0].error_code == 0);
+        CHECK(results[1].error_code == 1000);
+        CHECK(results[2].error_code == 0);
+        for (std::size_t i{0}; i < txns.size(); ++i) {
+            CHECK(results[i].error_code == expected_results[i].error_code);
+            CHECK(results[i].gas_left == expected_results[i].gas_left);
+            CHECK(results[i].pre_check_error == expected_results[i].pre_check_error);
+        }
+    }
+
     static silkworm::Bytes error_data{
                                0x08, 0xc3, 0x79, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -28,7 +28,9 @@
 #include <silkworm/third_party/evmone/lib/evmone/execution_state.hpp>
 #include <silkworm/third_party/evmone/lib/evmone/instructions.hpp>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
+#include <silkrpc/common/state_checkpoint_cache.hpp>
 #include <silkrpc/common/util.hpp>
 #include <silkrpc/core/evm_executor.hpp>
 #include <silkrpc/core/rawdb/chain.hpp>
@@ -41,6 +43,19 @@ using evmc::literals::operator""_address;
 const std::uint8_t CODE_PUSH1 = evmc_opcode::OP_PUSH1;
 const std::uint8_t CODE_DUP1 = evmc_opcode::OP_DUP1;
 
+void from_json(const nlohmann::json& json, TraceConfig& tc) {
+    for (const auto& entry : json) {
+        const auto trace_type = entry.get<std::string>();
+        if (trace_type == "trace") {
+            tc.trace = true;
+        } else if (trace_type == "vmTrace") {
+            tc.vm_trace = true;
+        } else if (trace_type == "stateDiff") {
+            tc.state_diff = true;
+        }
+    }
+}
+
 std::ostream& operator<<(std::ostream& out, const TraceConfig& tc) {
     out << "vmTrace: " << std::boolalpha << tc.vm_trace;
     out << " Trace: " << std::boolalpha << tc.trace;
@@ -887,19 +902,13 @@ asio::awaitable<TraceCallResult> TraceCallExecutor<WorldState, VM>::execute(std:
 
     const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
 
-    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number};
+    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number, nullptr, {}, code_cache_};
 
-    for (auto idx = 0; idx < index; idx++) {
-        silkrpc::Transaction txn{block.transactions[idx]};
-
-        if (!txn.from) {
-           txn.recover_sender();
-        }
-        const auto execution_result = co_await executor.call(block, txn);
+    if (index > 0) {
+        co_await executor.replay(block, block.header.hash(), static_cast<std::size_t>(index), checkpoint_cache_);
     }
-    executor.reset();
 
-    state::RemoteState remote_state{io_context_, database_reader_, block_number};
+    state::RemoteState remote_state{io_context_, database_reader_, block_number, nullptr, {}, code_cache_};
     silkworm::IntraBlockState initial_ibs{remote_state};
 
     Tracers tracers;
@@ -931,6 +940,76 @@ asio::awaitable<TraceCallResult> TraceCallExecutor<WorldState, VM>::execute(std:
     co_return result;
 }
 
+template<typename WorldState, typename VM>
+asio::awaitable<std::vector<TraceCallResult>> TraceCallExecutor<WorldState, VM>::execute(const silkworm::Block& block) {
+    const auto block_number = block.header.number;
+    const auto& transactions = block.transactions;
+
+    SILKRPC_INFO << "execute: block_number: " << block_number << " #txns: " << transactions.size() << " config: " << config_ << "\n";
+
+    const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
+    const auto chain_config_ptr = silkworm::lookup_chain_config(chain_id);
+
+    EVMExecutor<WorldState, VM> executor{io_context_, database_reader_, *chain_config_ptr, workers_, block_number-1, nullptr, {}, code_cache_};
+    const auto block_hash{block.header.hash()};
+
+    // The initial state of each transaction is the parent state seen through the changes of the previous transactions
+    state::RemoteState remote_state{io_context_, database_reader_, block_number-1, nullptr, {}, code_cache_};
+    const bool initial_state_needed = config_.trace || config_.state_diff;
+
+    std::vector<TraceCallResult> results(transactions.size());
+    for (std::uint64_t idx = 0; idx < transactions.size(); idx++) {
+        silkrpc::Transaction txn{transactions[idx]};
+        if (!txn.from) {
+            txn.recover_sender();
+        }
+        SILKRPC_DEBUG << "processing transaction: idx: " << idx << " txn: " << txn << "\n";
+
+        // Only the changes of the transactions since the previous rebase are copied, the chain of deltas being flattened
+        // at each checkpoint interval, so that it neither grows unbounded nor gets copied whole for every transaction
+        std::shared_ptr<const state::StateDelta> delta;
+        const bool checkpoint_due = idx % kStateCheckpointInterval == 0;
+        if (idx > 0 && (initial_state_needed || checkpoint_due)) {
+            delta = executor.rebase(block_number, /*flatten=*/checkpoint_due);
+            // Leave checkpoints behind so that tracing single transactions of this block later resumes close to them
+            if (checkpoint_cache_ && checkpoint_due) {
+                checkpoint_cache_->insert(block_hash, idx, delta);
+            }
+        }
+        state::OverlayState initial_state{remote_state};
+        initial_state.set_base(delta);
+        silkworm::IntraBlockState initial_ibs{initial_state};
+
+        Tracers tracers;
+        auto& result = results.at(idx);
+        TraceCallTraces& traces = result.traces;
+        if (config_.vm_trace) {
+            traces.vm_trace.emplace();
+            std::shared_ptr<silkworm::EvmTracer> tracer = std::make_shared<trace::VmTraceTracer>(traces.vm_trace.value(), static_cast<std::int32_t>(idx));
+            tracers.push_back(tracer);
+        }
+        if (config_.trace) {
+            std::shared_ptr<silkworm::EvmTracer> tracer = std::make_shared<trace::TraceTracer>(traces.trace, initial_ibs);
+            tracers.push_back(tracer);
+        }
+        if (config_.state_diff) {
+            traces.state_diff.emplace();
+
+            std::shared_ptr<silkworm::EvmTracer> tracer = std::make_shared<trace::StateDiffTracer>(traces.state_diff.value(), initial_ibs);
+            tracers.push_back(tracer);
+        }
+        const auto execution_result = co_await executor.call(block, txn, /*refund=*/true, /*gas_bailout=*/false, tracers);
+
+        if (execution_result.pre_check_error) {
+            result.pre_check_error = execution_result.pre_check_error.value();
+        } else {
+            traces.output = "0x" + silkworm::to_hex(execution_result.data);
+        }
+    }
+
+    co_return results;
+}
+
 template class TraceCallExecutor<>;
 
 } // namespace silkrpc::trace
@@ -36,6 +36,8 @@
 #pragma GCC diagnostic pop
 #include <silkworm/state/intra_block_state.hpp>
 
+#include <silkrpc/common/code_cache.hpp>
+#include <silkrpc/common/state_checkpoint_cache.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
 #include <silkrpc/types/block.hpp>
@@ -54,6 +56,7 @@ static const TraceConfig DEFAULT_TRACE_CONFIG{false, false, false};
 
 std::string get_op_name(const char* const* names, std::uint8_t opcode);
 std::string to_string(intx::uint256 value);
+void from_json(const nlohmann::json& json, TraceConfig& tc);
 std::ostream& operator<<(std::ostream& out, const TraceConfig& tc);
 
 struct TraceStorage {
@@ -254,8 +257,10 @@ void to_json(nlohmann::json& json, const TraceCallTraces& result);
 template<typename WorldState = silkworm::IntraBlockState, typename VM = silkworm::EVM>
 class TraceCallExecutor {
 public:
-    explicit TraceCallExecutor(asio::io_context& io_context, const core::rawdb::DatabaseReader& database_reader, asio::thread_pool& workers, const TraceConfig& config = DEFAULT_TRACE_CONFIG)
-    : io_context_(io_context), database_reader_(database_reader), workers_{workers}, config_{config} {}
+    explicit TraceCallExecutor(asio::io_context& io_context, const core::rawdb::DatabaseReader& database_reader, asio::thread_pool& workers, const TraceConfig& config = DEFAULT_TRACE_CONFIG,
+        StateCheckpointCache* checkpoint_cache = nullptr, CodeCache* code_cache = nullptr)
+    : io_context_(io_context), database_reader_(database_reader), workers_{workers}, config_{config}, checkpoint_cache_(checkpoint_cache),
+      code_cache_(code_cache) {}
     virtual ~TraceCallExecutor() {}
 
     TraceCallExecutor(const TraceCallExecutor&) = delete;
@@ -263,6 +268,9 @@ public:
 
     asio::awaitable<TraceCallResult> execute(const silkworm::Block& block, const silkrpc::Call& call);
 
+    //! Trace all the block transactions, executing each one just once on top of the state changes of the previous ones
+    asio::awaitable<std::vector<TraceCallResult>> execute(const silkworm::Block& block);
+
 private:
     asio::awaitable<TraceCallResult> execute(std::uint64_t block_number, const silkworm::Block& block, const silkrpc::Transaction& transaction, std::int32_t = -1);
 
@@ -270,6 +278,8 @@ private:
     const core::rawdb::DatabaseReader& database_reader_;
     asio::thread_pool& workers_;
     const TraceConfig& config_;
+    StateCheckpointCache* checkpoint_cache_;
+    CodeCache* code_cache_;
 };
 } // namespace silkrpc::trace
 
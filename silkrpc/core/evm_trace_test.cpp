@@ -212,6 +212,207 @@ TEST_CASE("TraceCallExecutor::execute call 1") {
         CHECK(result.pre_check_error.value() == "intrinsic gas too low: have 50000, want 53072");
     }
 
+    SECTION("Block: no transactions") {
+        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kZeroKey}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return kZeroHeader;
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kConfig, silkworm::ByteView{kConfigKey}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kConfigKey, kConfigValue};
+            }));
+
+        silkworm::Block block{};
+        block.header.number = 5'405'096;
+
+        asio::io_context& io_context = context_pool.next_io_context();
+        TraceCallExecutor executor{context_pool.next_io_context(), db_reader, workers};
+        auto execution_result = asio::co_spawn(io_context, executor.execute(block), asio::use_future);
+        auto results = execution_result.get();
+
+        context_pool.stop();
+        io_context.stop();
+        pool_thread.join();
+
+        CHECK(results.empty());
+    }
+
+    SECTION("Block: failed with intrinsic gas too low") {
+        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kZeroKey}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return kZeroHeader;
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kConfig, silkworm::ByteView{kConfigKey}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kConfigKey, kConfigValue};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey1}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey1, kAccountHistoryValue1};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey2}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey2, kAccountHistoryValue2};
+            }));
+        EXPECT_CALL(db_reader, get_one(db::table::kPlainState, silkworm::ByteView{kPlainStateKey1}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return silkworm::Bytes{};
+            }));
+
+        silkrpc::Call call;
+        call.from = 0xe0a2Bd4258D2768837BAa26A28fE71Dc079f84c7_address;
+        call.gas = 50'000;
+        call.gas_price = 7;
+        call.data = *silkworm::from_hex("602a60005500");
+
+        silkworm::Block block{};
+        block.header.number = 5'405'096;
+        block.transactions.push_back(call.to_transaction());
+
+        asio::io_context& io_context = context_pool.next_io_context();
+        TraceConfig config{/*vm_trace=*/true, /*trace=*/true, /*state_diff=*/true};
+        TraceCallExecutor executor{context_pool.next_io_context(), db_reader, workers, config};
+        auto execution_result = asio::co_spawn(io_context, executor.execute(block), asio::use_future);
+        auto results = execution_result.get();
+
+        context_pool.stop();
+        io_context.stop();
+        pool_thread.join();
+
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].pre_check_error.has_value() == true);
+        CHECK(results[0].pre_check_error.value() == "intrinsic gas too low: have 50000, want 53072");
+    }
+
+    SECTION("Block: state carried over between transactions") {
+        static silkworm::Bytes kAccountHistoryKey4{*silkworm::from_hex("aed05efdf19d479c87d470c1136b843e5cd5959800000000005279a8")};
+        static silkworm::Bytes kPlainStateKey4{*silkworm::from_hex("aed05efdf19d479c87d470c1136b843e5cd59598")};
+
+        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kZeroKey}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return kZeroHeader;
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kConfig, silkworm::ByteView{kConfigKey}))
+            .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kConfigKey, kConfigValue};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey1}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey1, kAccountHistoryValue1};
+            }));
+        EXPECT_CALL(db_reader, get_both_range(db::table::kPlainAccountChangeSet, silkworm::ByteView{kAccountChangeSetKey}, silkworm::ByteView{kAccountChangeSetSubkey}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<std::optional<silkworm::Bytes>> {
+                co_return kAccountChangeSetValue;
+            }));
+        EXPECT_CALL(db_reader, get_both_range(db::table::kPlainAccountChangeSet, silkworm::ByteView{kAccountChangeSetKey1}, silkworm::ByteView{kAccountChangeSetSubkey1}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<std::optional<silkworm::Bytes>> {
+                co_return kAccountChangeSetValue1;
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey2}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey2, kAccountHistoryValue2};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey3}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{kAccountHistoryKey3, kAccountHistoryValue3};
+            }));
+        EXPECT_CALL(db_reader, get(db::table::kAccountHistory, silkworm::ByteView{kAccountHistoryKey4}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<KeyValue> {
+                co_return KeyValue{};
+            }));
+        EXPECT_CALL(db_reader, get_one(db::table::kPlainState, silkworm::ByteView{kPlainStateKey2}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return silkworm::Bytes{};
+            }));
+        EXPECT_CALL(db_reader, get_one(db::table::kPlainState, silkworm::ByteView{kPlainStateKey4}))
+            .WillRepeatedly(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
+                co_return silkworm::Bytes{};
+            }));
+
+        // The same contract creation twice: the second one starts from the nonce and balances left by the first one
+        silkrpc::Call call;
+        call.from = 0xe0a2Bd4258D2768837BAa26A28fE71Dc079f84c7_address;
+        call.gas = 118'936;
+        call.gas_price = 7;
+        call.data = *silkworm::from_hex("602a60005500");
+
+        silkworm::Block block{};
+        block.header.number = 5'405'096;
+        block.transactions.push_back(call.to_transaction());
+        block.transactions.push_back(call.to_transaction());
+
+        TraceConfig config{/*vm_trace=*/false, /*trace=*/true, /*state_diff=*/true};
+        TraceCallExecutor executor{context_pool.next_io_context(), db_reader, workers, config};
+        asio::io_context& io_context = context_pool.next_io_context();
+        auto execution_result = asio::co_spawn(io_context.get_executor(), executor.execute(block), asio::use_future);
+        auto results = execution_result.get();
+
+        context_pool.stop();
+        io_context.stop();
+        pool_thread.join();
+
+        REQUIRE(results.size() == 2);
+        CHECK(results[0].pre_check_error.has_value() == false);
+        CHECK(results[1].pre_check_error.has_value() == false);
+
+        const nlohmann::json first_traces = results[0].traces;
+        CHECK(first_traces["stateDiff"]["0xe0a2bd4258d2768837baa26a28fe71dc079f84c7"]["nonce"] == R"({
+            "*": {
+            "from": "0x343",
+            "to": "0x344"
+            }
+        })"_json);
+        CHECK(first_traces["trace"][0]["result"]["address"] == "0x52728289eba496b6080d57d0250a90663a07e556");
+
+        const nlohmann::json second_traces = results[1].traces;
+        CHECK(second_traces["stateDiff"] == R"({
+            "0x0000000000000000000000000000000000000000": {
+            "balance": {
+                "*": {
+                "from": "0x44ed67f28fd513c08f",
+                "to": "0x44ed67f28fd51bc835"
+                }
+            },
+            "code": "=",
+            "nonce": "=",
+            "storage": {}
+            },
+            "0xaed05efdf19d479c87d470c1136b843e5cd59598": {
+            "balance": {
+                "+": "0x0"
+            },
+            "code": {
+                "+": "0x"
+            },
+            "nonce": {
+                "+": "0x1"
+            },
+            "storage": {
+                "0x0000000000000000000000000000000000000000000000000000000000000000": {
+                "+": "0x000000000000000000000000000000000000000000000000000000000000002a"
+                }
+            }
+            },
+            "0xe0a2bd4258d2768837baa26a28fe71dc079f84c7": {
+            "balance": {
+                "*": {
+                "from": "0x141e903194951083bc1d57",
+                "to": "0x141e903194951083b415b1"
+                }
+            },
+            "code": "=",
+            "nonce": {
+                "*": {
+                "from": "0x344",
+                "to": "0x345"
+                }
+            },
+            "storage": {}
+            }
+        })"_json);
+        CHECK(second_traces["trace"][0]["result"]["address"] == "0xaed05efdf19d479c87d470c1136b843e5cd59598");
+    }
+
     SECTION("Call: full output") {
         EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashes, silkworm::ByteView{kZeroKey}))
             .WillOnce(InvokeWithoutArgs([]() -> asio::awaitable<silkworm::Bytes> {
@@ -1754,6 +1955,17 @@ TEST_CASE("TraceConfig") {
         os << config;
         CHECK(os.str() == "vmTrace: true Trace: false stateDiff: true");
     }
+
+    SECTION("json deserialization") {
+        nlohmann::json json = R"(["vmTrace", "stateDiff"])"_json;
+
+        TraceConfig config;
+        from_json(json, config);
+
+        CHECK(config.vm_trace == true);
+        CHECK(config.trace == false);
+        CHECK(config.state_diff == true);
+    }
 }
 
 TEST_CASE("copy_stack") {
@@ -0,0 +1,166 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "fee_history_oracle.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/log.hpp>
+
+namespace silkrpc {
+
+// EIP-1559 parameters
+constexpr uint64_t kElasticityMultiplier{2};
+constexpr uint64_t kBaseFeeMaxChangeDenominator{8};
+
+intx::uint256 next_base_fee(const silkworm::BlockHeader& header) {
+    if (!header.base_fee_per_gas) {
+        return 0;
+    }
+    const intx::uint256 base_fee{*header.base_fee_per_gas};
+    const uint64_t gas_target{header.gas_limit / kElasticityMultiplier};
+    if (gas_target == 0 || header.gas_used == gas_target) {
+        return base_fee;
+    }
+    const intx::uint256 denominator{intx::uint256{gas_target} * kBaseFeeMaxChangeDenominator};
+    if (header.gas_used > gas_target) {
+        const intx::uint256 gas_used_delta{header.gas_used - gas_target};
+        const intx::uint256 base_fee_delta{std::max(base_fee * gas_used_delta / denominator, intx::uint256{1})};
+        return base_fee + base_fee_delta;
+    } else {
+        const intx::uint256 gas_used_delta{gas_target - header.gas_used};
+        const intx::uint256 base_fee_delta{base_fee * gas_used_delta / denominator};
+        return base_fee > base_fee_delta ? base_fee - base_fee_delta : intx::uint256{0};
+    }
+}
+
+asio::awaitable<FeeHistory> FeeHistoryOracle::fee_history(uint64_t newest_block, uint64_t block_count, const std::vector<double>& reward_percentiles) {
+    SILKRPC_DEBUG << "FeeHistoryOracle::fee_history newest_block: " << newest_block << " block_count: " << block_count
+        << " #reward_percentiles: " << reward_percentiles.size() << "\n";
+
+    if (reward_percentiles.size() > kMaxFeeHistoryPercentiles) {
+        throw std::invalid_argument{"too many reward percentiles: " + std::to_string(reward_percentiles.size())};
+    }
+    for (std::size_t i{0}; i < reward_percentiles.size(); ++i) {
+        if (reward_percentiles[i] < 0 || reward_percentiles[i] > 100 || (i > 0 && reward_percentiles[i] < reward_percentiles[i - 1])) {
+            throw std::invalid_argument{"invalid reward percentile: " + std::to_string(reward_percentiles[i])};
+        }
+    }
+
+    FeeHistory fee_history;
+    block_count = std::min({block_count, newest_block + 1, uint64_t{kMaxFeeHistoryBlocks}});
+    if (block_count == 0) {
+        co_return fee_history;
+    }
+
+    // Walk back from the newest block following the parent hashes, so that cached blocks are checked against the same chain
+    std::vector<std::shared_ptr<const FeeHistoryCache::BlockFees>> blocks_fees(block_count);
+    auto block_hash = co_await block_hash_provider_(newest_block);
+    for (uint64_t i{0}; i < block_count; ++i) {
+        const auto block_fees_ptr = co_await block_fees(newest_block - i, block_hash);
+        blocks_fees[block_count - 1 - i] = block_fees_ptr;
+        block_hash = block_fees_ptr->parent_hash;
+    }
+
+    fee_history.oldest_block = newest_block + 1 - block_count;
+    fee_history.base_fees.reserve(block_count + 1);
+    fee_history.gas_used_ratios.reserve(block_count);
+    if (!reward_percentiles.empty()) {
+        fee_history.rewards.reserve(block_count);
+    }
+    for (const auto& block_fees_ptr : blocks_fees) {
+        fee_history.base_fees.push_back(block_fees_ptr->base_fee);
+        fee_history.gas_used_ratios.push_back(block_fees_ptr->gas_used_ratio);
+        if (!reward_percentiles.empty()) {
+            fee_history.rewards.push_back(rewards(*block_fees_ptr, reward_percentiles));
+        }
+    }
+    fee_history.base_fees.push_back(blocks_fees.back()->next_base_fee);
+
+    co_return fee_history;
+}
+
+asio::awaitable<std::shared_ptr<const FeeHistoryCache::BlockFees>> FeeHistoryOracle::block_fees(uint64_t block_number, const evmc::bytes32& block_hash) {
+    if (auto block_fees_ptr = cache_.find(block_number, block_hash)) {
+        co_return block_fees_ptr;
+    }
+
+    auto block_fees_ptr = co_await load_block_fees(block_number);
+    cache_.insert(block_fees_ptr);
+    co_return block_fees_ptr;
+}
+
+asio::awaitable<std::shared_ptr<const FeeHistoryCache::BlockFees>> FeeHistoryOracle::load_block_fees(uint64_t block_number) {
+    SILKRPC_TRACE << "FeeHistoryOracle::load_block_fees processing block: " << block_number << "\n";
+
+    const auto block_with_hash = co_await block_provider_(block_number);
+    const auto& header = block_with_hash->block.header;
+
+    auto block_fees_ptr = std::make_shared<FeeHistoryCache::BlockFees>();
+    block_fees_ptr->block_number = block_number;
+    block_fees_ptr->block_hash = block_with_hash->hash;
+    block_fees_ptr->parent_hash = header.parent_hash;
+    block_fees_ptr->base_fee = header.base_fee_per_gas.value_or(0);
+    block_fees_ptr->next_base_fee = next_base_fee(header);
+    block_fees_ptr->gas_used = header.gas_used;
+    block_fees_ptr->gas_used_ratio = header.gas_limit > 0 ? static_cast<double>(header.gas_used) / static_cast<double>(header.gas_limit) : 0;
+
+    const auto& transactions = block_with_hash->block.transactions;
+    if (!transactions.empty()) {
+        const auto receipts = co_await receipts_provider_(*block_with_hash);
+        if (receipts->size() != transactions.size()) {
+            throw std::runtime_error{"#receipts " + std::to_string(receipts->size()) + " differs from #transactions in block " + std::to_string(block_number)};
+        }
+        auto& rewards = block_fees_ptr->rewards;
+        rewards.reserve(transactions.size());
+        for (std::size_t i{0}; i < transactions.size(); ++i) {
+            rewards.push_back({transactions[i].priority_fee_per_gas(block_fees_ptr->base_fee), (*receipts)[i].gas_used});
+        }
+        std::stable_sort(rewards.begin(), rewards.end(), [](const auto& r1, const auto& r2) { return r1.priority_fee < r2.priority_fee; });
+    }
+
+    SILKRPC_TRACE << "FeeHistoryOracle::load_block_fees block: " << block_number << " base_fee: 0x" << intx::hex(block_fees_ptr->base_fee)
+        << " gas_used_ratio: " << block_fees_ptr->gas_used_ratio << " #rewards: " << block_fees_ptr->rewards.size() << "\n";
+
+    co_return block_fees_ptr;
+}
+
+std::vector<intx::uint256> FeeHistoryOracle::rewards(const FeeHistoryCache::BlockFees& block_fees, const std::vector<double>& reward_percentiles) {
+    std::vector<intx::uint256> rewards(reward_percentiles.size());
+    const auto& transaction_rewards = block_fees.rewards;
+    if (transaction_rewards.empty()) {
+        return rewards;
+    }
+
+    // Each reward is the priority fee of the transaction reaching the percentile of the block gas used, cheapest first
+    std::size_t index{0};
+    uint64_t cumulative_gas_used{transaction_rewards[0].gas_used};
+    for (std::size_t i{0}; i < reward_percentiles.size(); ++i) {
+        const auto threshold_gas_used = static_cast<uint64_t>(static_cast<double>(block_fees.gas_used) * reward_percentiles[i] / 100);
+        while (cumulative_gas_used < threshold_gas_used && index < transaction_rewards.size() - 1) {
+            ++index;
+            cumulative_gas_used += transaction_rewards[index].gas_used;
+        }
+        rewards[i] = transaction_rewards[index].priority_fee;
+    }
+    return rewards;
+}
+
+} // namespace silkrpc
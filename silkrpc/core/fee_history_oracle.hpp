@@ -0,0 +1,71 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_CORE_FEE_HISTORY_ORACLE_HPP_
+#define SILKRPC_CORE_FEE_HISTORY_ORACLE_HPP_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <silkrpc/config.hpp> // NOLINT(build/include_order)
+
+#include <asio/awaitable.hpp>
+#include <evmc/evmc.hpp>
+#include <intx/intx.hpp>
+
+#include <silkrpc/common/fee_history_cache.hpp>
+#include <silkrpc/core/gas_price_oracle.hpp>
+#include <silkrpc/types/block.hpp>
+#include <silkrpc/types/fee_history.hpp>
+#include <silkrpc/types/receipt.hpp>
+
+namespace silkrpc {
+
+typedef std::function<asio::awaitable<std::shared_ptr<const Receipts>>(const IndexedBlock&)> ReceiptsProvider;
+
+//! Compute the base fee of the block following the given one according to EIP-1559
+intx::uint256 next_base_fee(const silkworm::BlockHeader& header);
+
+class FeeHistoryOracle {
+public:
+    explicit FeeHistoryOracle(const BlockProvider& block_provider, const ReceiptsProvider& receipts_provider,
+        const BlockHashProvider& block_hash_provider, FeeHistoryCache& cache)
+        : block_provider_(block_provider), receipts_provider_(receipts_provider), block_hash_provider_(block_hash_provider), cache_(cache) {}
+    virtual ~FeeHistoryOracle() {}
+
+    FeeHistoryOracle(const FeeHistoryOracle&) = delete;
+    FeeHistoryOracle& operator=(const FeeHistoryOracle&) = delete;
+
+    //! Get the fee history of at most block_count blocks up to newest_block, rewards at the given ascending percentiles included
+    asio::awaitable<FeeHistory> fee_history(uint64_t newest_block, uint64_t block_count, const std::vector<double>& reward_percentiles);
+
+private:
+    asio::awaitable<std::shared_ptr<const FeeHistoryCache::BlockFees>> block_fees(uint64_t block_number, const evmc::bytes32& block_hash);
+
+    asio::awaitable<std::shared_ptr<const FeeHistoryCache::BlockFees>> load_block_fees(uint64_t block_number);
+
+    static std::vector<intx::uint256> rewards(const FeeHistoryCache::BlockFees& block_fees, const std::vector<double>& reward_percentiles);
+
+    const BlockProvider& block_provider_;
+    const ReceiptsProvider& receipts_provider_;
+    const BlockHashProvider& block_hash_provider_;
+    FeeHistoryCache& cache_;
+};
+
+} // namespace silkrpc
+
+#endif  // SILKRPC_CORE_FEE_HISTORY_ORACLE_HPP_
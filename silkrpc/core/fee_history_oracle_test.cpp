@@ -0,0 +1,152 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "fee_history_oracle.hpp"
+
+#include <memory>
+#include <vector>
+
+#include <asio/co_spawn.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/use_future.hpp>
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+
+namespace silkrpc {
+
+using Catch::Matchers::Message;
+
+TEST_CASE("next base fee", "[silkrpc][core][fee_history_oracle]") {
+    silkworm::BlockHeader header;
+    header.gas_limit = 30'000'000;
+
+    SECTION("no base fee") {
+        header.gas_used = 30'000'000;
+        CHECK(next_base_fee(header) == 0);
+    }
+
+    SECTION("gas used equal to target") {
+        header.base_fee_per_gas = 1'000'000'000;
+        header.gas_used = 15'000'000;
+        CHECK(next_base_fee(header) == 1'000'000'000);
+    }
+
+    SECTION("full block") {
+        header.base_fee_per_gas = 1'000'000'000;
+        header.gas_used = 30'000'000;
+        CHECK(next_base_fee(header) == 1'125'000'000);
+    }
+
+    SECTION("empty block") {
+        header.base_fee_per_gas = 1'000'000'000;
+        header.gas_used = 0;
+        CHECK(next_base_fee(header) == 875'000'000);
+    }
+
+    SECTION("minimum increase") {
+        header.base_fee_per_gas = 7;
+        header.gas_used = 15'000'001;
+        CHECK(next_base_fee(header) == 8);
+    }
+}
+
+TEST_CASE("fee history", "[silkrpc][core][fee_history_oracle]") {
+    asio::thread_pool pool{1};
+
+    // Each block has 3 transactions with priority fees 1, 2, 3 per idx and gas used 21000, 42000, 63000
+    std::vector<silkworm::BlockWithHash> blocks;
+    for (uint64_t idx = 0; idx < 10; idx++) {
+        silkworm::BlockWithHash block_with_hash;
+        block_with_hash.block.header.number = idx;
+        block_with_hash.block.header.base_fee_per_gas = 100;
+        block_with_hash.block.header.gas_limit = 252'000;
+        block_with_hash.block.header.gas_used = 126'000;
+        if (idx > 0) {
+            block_with_hash.block.header.parent_hash = blocks[idx - 1].hash;
+        }
+        block_with_hash.hash.bytes[0] = static_cast<uint8_t>(idx + 1);
+        block_with_hash.block.transactions.resize(3);
+        for (uint64_t i = 0; i < 3; i++) {
+            // Transactions in reverse fee order, so that they need sorting
+            block_with_hash.block.transactions[i].max_priority_fee_per_gas = (3 - i) * (idx + 1);
+            block_with_hash.block.transactions[i].max_fee_per_gas = 1000;
+        }
+        blocks.push_back(block_with_hash);
+    }
+
+    std::size_t loaded_blocks{0};
+    BlockProvider block_provider = [&](uint64_t block_number) -> asio::awaitable<std::shared_ptr<const IndexedBlock>> {
+        ++loaded_blocks;
+        co_return std::make_shared<const IndexedBlock>(blocks[block_number]);
+    };
+    ReceiptsProvider receipts_provider = [&](const IndexedBlock& block) -> asio::awaitable<std::shared_ptr<const Receipts>> {
+        auto receipts = std::make_shared<Receipts>(block.block.transactions.size());
+        for (std::size_t i = 0; i < receipts->size(); i++) {
+            (*receipts)[i].gas_used = 63'000 - i * 21'000;
+        }
+        co_return receipts;
+    };
+    BlockHashProvider block_hash_provider = [&](uint64_t block_number) -> asio::awaitable<evmc::bytes32> {
+        co_return blocks[block_number].hash;
+    };
+    FeeHistoryCache cache;
+    FeeHistoryOracle oracle{block_provider, receipts_provider, block_hash_provider, cache};
+
+    SECTION("without percentiles") {
+        const auto fee_history = asio::co_spawn(pool, oracle.fee_history(9, 4, {}), asio::use_future).get();
+        CHECK(fee_history.oldest_block == 6);
+        CHECK(fee_history.base_fees == std::vector<intx::uint256>{100, 100, 100, 100, 100});
+        CHECK(fee_history.gas_used_ratios == std::vector<double>{0.5, 0.5, 0.5, 0.5});
+        CHECK(fee_history.rewards.empty());
+    }
+
+    SECTION("with percentiles") {
+        const auto fee_history = asio::co_spawn(pool, oracle.fee_history(9, 2, {0, 10, 20, 50, 100}), asio::use_future).get();
+        CHECK(fee_history.oldest_block == 8);
+        REQUIRE(fee_history.rewards.size() == 2);
+        // Cheapest transaction uses 21000 gas: up to 1/6 of the block, then 1/3 of the block for the 2nd one
+        CHECK(fee_history.rewards[0] == std::vector<intx::uint256>{9, 9, 18, 18, 27});
+        CHECK(fee_history.rewards[1] == std::vector<intx::uint256>{10, 10, 20, 20, 30});
+    }
+
+    SECTION("block count greater than chain length") {
+        const auto fee_history = asio::co_spawn(pool, oracle.fee_history(2, 10, {}), asio::use_future).get();
+        CHECK(fee_history.oldest_block == 0);
+        CHECK(fee_history.gas_used_ratios.size() == 3);
+        CHECK(fee_history.base_fees.size() == 4);
+    }
+
+    SECTION("zero block count") {
+        const auto fee_history = asio::co_spawn(pool, oracle.fee_history(9, 0, {}), asio::use_future).get();
+        CHECK(fee_history.base_fees.empty());
+        CHECK(fee_history.gas_used_ratios.empty());
+    }
+
+    SECTION("new head loads just the new block") {
+        asio::co_spawn(pool, oracle.fee_history(8, 4, {50}), asio::use_future).get();
+        loaded_blocks = 0;
+        asio::co_spawn(pool, oracle.fee_history(9, 4, {25, 75}), asio::use_future).get();
+        CHECK(loaded_blocks == 1);
+    }
+
+    SECTION("invalid percentiles") {
+        CHECK_THROWS_MATCHES(asio::co_spawn(pool, oracle.fee_history(9, 4, {50, 10}), asio::use_future).get(),
+            std::invalid_argument, Message("invalid reward percentile: 10.000000"));
+        CHECK_THROWS_AS(asio::co_spawn(pool, oracle.fee_history(9, 4, {101}), asio::use_future).get(), std::invalid_argument);
+    }
+}
+
+} // namespace silkrpc
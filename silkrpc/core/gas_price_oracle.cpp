@@ -17,10 +17,13 @@
 #include "gas_price_oracle.hpp"
 
 #include <algorithm>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 #include <asio/compose.hpp>
 #include <asio/post.hpp>
+#include <asio/this_coro.hpp>
 #include <asio/use_awaitable.hpp>
 #include <silkrpc/core/blocks.hpp>
 #include <silkrpc/core/rawdb/chain.hpp>
@@ -36,11 +39,45 @@ struct PriceComparator {
 };
 
 asio::awaitable<intx::uint256> GasPriceOracle::suggested_price(uint64_t block_number) {
+    if (!cache_) {
+        co_return co_await compute_price(block_number, std::nullopt);
+    }
+
+    const auto block_hash = co_await (*block_hash_provider_)(block_number);
+    if (const auto price = cache_->find_price(block_hash)) {
+        SILKRPC_DEBUG << "GasPriceOracle::suggested_price block: " << block_number << " cached price: 0x" << intx::hex(*price) << "\n";
+        co_return *price;
+    }
+    if (!cache_->begin_price(block_hash)) {
+        co_return co_await wait_price(block_number, block_hash);
+    }
+
+    intx::uint256 price;
+    try {
+        price = co_await compute_price(block_number, block_hash);
+    } catch (...) {
+        cache_->end_price(block_hash, std::nullopt);
+        throw;
+    }
+    cache_->end_price(block_hash, price);
+
+    co_return price;
+}
+
+asio::awaitable<intx::uint256> GasPriceOracle::compute_price(uint64_t block_number, std::optional<evmc::bytes32> block_hash) {
     SILKRPC_INFO << "GasPriceOracle::suggested_price starting block: " << block_number << "\n";
     std::vector<intx::uint256> tx_prices;
     tx_prices.reserve(kMaxSamples);
     while (tx_prices.size() < kMaxSamples && block_number > 0) {
-        co_await load_block_prices(block_number--, kSamples, tx_prices);
+        const auto block_prices_ptr = co_await block_prices(block_number--, block_hash);
+        for (const auto& effective_gas_price : block_prices_ptr->prices) {
+            SILKRPC_TRACE << " effective_gas_price: 0x" <<  intx::hex(effective_gas_price) << "\n";
+            tx_prices.push_back(effective_gas_price);
+            if (tx_prices.size() >= kSamples) {
+                break;
+            }
+        }
+        block_hash = block_prices_ptr->parent_hash;
     }
     SILKRPC_INFO << "GasPriceOracle::suggested_price ending block: " << block_number << "\n";
 
@@ -66,29 +103,72 @@ asio::awaitable<intx::uint256> GasPriceOracle::suggested_price(uint64_t block_nu
     co_return price;
 }
 
-asio::awaitable<void> GasPriceOracle::load_block_prices(uint64_t block_number, uint64_t limit, std::vector<intx::uint256>& tx_prices) {
+asio::awaitable<intx::uint256> GasPriceOracle::wait_price(uint64_t block_number, const evmc::bytes32& block_hash) {
+    SILKRPC_DEBUG << "GasPriceOracle::wait_price block: " << block_number << " waiting for computation in flight\n";
+
+    const auto executor = co_await asio::this_coro::executor;
+    const auto price = co_await asio::async_compose<decltype(asio::use_awaitable), void(std::optional<intx::uint256>)>(
+        [this, &block_hash, executor](auto&& self) {
+            auto completion = std::make_shared<std::decay_t<decltype(self)>>(std::move(self));
+            cache_->wait_price(block_hash, [completion, executor](std::optional<intx::uint256> price) {
+                asio::post(executor, [completion, price]() {
+                    completion->complete(price);
+                });
+            });
+        },
+        asio::use_awaitable);
+    if (price) {
+        co_return *price;
+    }
+
+    // The computation in flight has failed, so try on our own without publishing the result
+    co_return co_await compute_price(block_number, block_hash);
+}
+
+asio::awaitable<std::shared_ptr<const GasPriceCache::BlockPrices>> GasPriceOracle::block_prices(uint64_t block_number,
+    std::optional<evmc::bytes32> block_hash) {
+    if (cache_ && block_hash) {
+        if (auto block_prices_ptr = cache_->find_block(block_number, *block_hash)) {
+            co_return block_prices_ptr;
+        }
+    }
+
+    auto block_prices_ptr = co_await load_block_prices(block_number);
+    if (cache_) {
+        cache_->insert_block(block_prices_ptr);
+    }
+    co_return block_prices_ptr;
+}
+
+asio::awaitable<std::shared_ptr<const GasPriceCache::BlockPrices>> GasPriceOracle::load_block_prices(uint64_t block_number) {
     SILKRPC_TRACE << "GasPriceOracle::load_block_prices processing block: " << block_number << "\n";
 
     const auto block_with_hash = co_await block_provider_(block_number);
-    const auto &base_fee = block_with_hash.block.header.base_fee_per_gas.value_or(0);
-    const auto &coinbase = block_with_hash.block.header.beneficiary;
+    const auto &base_fee = block_with_hash->block.header.base_fee_per_gas.value_or(0);
+    const auto &coinbase = block_with_hash->block.header.beneficiary;
 
-    SILKRPC_TRACE << "GasPriceOracle::load_block_prices # transactions in block: " << block_with_hash.block.transactions.size() << "\n";
+    SILKRPC_TRACE << "GasPriceOracle::load_block_prices # transactions in block: " << block_with_hash->block.transactions.size() << "\n";
     SILKRPC_TRACE << "GasPriceOracle::load_block_prices # block base_fee: 0x" << intx::hex(base_fee) << "\n";
     SILKRPC_TRACE << "GasPriceOracle::load_block_prices # block beneficiary: 0x" << coinbase << "\n";
 
-    std::vector<intx::uint256> block_prices;
+    auto block_prices_ptr = std::make_shared<GasPriceCache::BlockPrices>();
+    block_prices_ptr->block_number = block_number;
+    block_prices_ptr->block_hash = block_with_hash->hash;
+    block_prices_ptr->parent_hash = block_with_hash->block.header.parent_hash;
+
+    auto& block_prices = block_prices_ptr->prices;
     int idx = 0;
-    block_prices.reserve(block_with_hash.block.transactions.size());
-    for (const auto& transaction : block_with_hash.block.transactions) {
+    block_prices.reserve(block_with_hash->block.transactions.size());
+    for (const auto& transaction : block_with_hash->block.transactions) {
         const auto effective_gas_price = transaction.effective_gas_price(base_fee);
-        SILKRPC_TRACE << "idx: " << idx++
-            << " hash: " <<  silkworm::to_hex({hash_of_transaction(transaction).bytes, silkworm::kHashLength})
+        SILKRPC_TRACE << "idx: " << idx
+            << " hash: " <<  block_with_hash->transaction_hashes[idx]
             << " effective_gas_price: 0x" <<  intx::hex(effective_gas_price)
             << " priority_fee_per_gas: 0x" <<  intx::hex(transaction.priority_fee_per_gas(base_fee))
             << " max_fee_per_gas: 0x" <<  intx::hex(transaction.max_fee_per_gas)
             << " max_priority_fee_per_gas: 0x" <<  intx::hex(transaction.max_priority_fee_per_gas)
             << "\n";
+        ++idx;
         if (effective_gas_price < kDefaultMinPrice) {
             continue;
         }
@@ -100,14 +180,14 @@ asio::awaitable<void> GasPriceOracle::load_block_prices(uint64_t block_number, u
         block_prices.push_back(effective_gas_price);
     }
 
+    // No block contributes more than kSamples prices, so keeping just the lowest ones is enough
     std::sort(block_prices.begin(), block_prices.end(), PriceComparator());
-
-    for (const auto& effective_gas_price : block_prices) {
-        SILKRPC_TRACE << " effective_gas_price: 0x" <<  intx::hex(effective_gas_price) << "\n";
-        tx_prices.push_back(effective_gas_price);
-        if (tx_prices.size() >= limit) {
-            break;
-        }
+    if (block_prices.size() > kSamples) {
+        block_prices.resize(kSamples);
     }
+    block_prices.shrink_to_fit();
+
+    co_return block_prices_ptr;
 }
+
 } // namespace silkrpc
@@ -18,19 +18,24 @@
 #define SILKRPC_CORE_GAS_PRICE_ORACLE_HPP_
 
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include <silkrpc/config.hpp> // NOLINT(build/include_order)
 
 #include <asio/awaitable.hpp>
+#include <evmc/evmc.hpp>
 #include <silkworm/chain/config.hpp>
 #include <silkworm/common/util.hpp>
 #include <silkworm/types/block.hpp>
 #include <silkworm/types/transaction.hpp>
 
+#include <silkrpc/common/gas_price_cache.hpp>
 #include <silkrpc/core/blocks.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
+#include <silkrpc/types/block.hpp>
 
 namespace silkrpc {
 
@@ -46,11 +51,16 @@ const std::uint8_t kSamples = 3;
 const std::uint8_t kMaxSamples = kCheckBlocks * kSamples;
 const std::uint8_t kPercentile = 60;
 
-typedef std::function<asio::awaitable<silkworm::BlockWithHash>(uint64_t)> BlockProvider;
+typedef std::function<asio::awaitable<std::shared_ptr<const IndexedBlock>>(uint64_t)> BlockProvider;
+typedef std::function<asio::awaitable<evmc::bytes32>(uint64_t)> BlockHashProvider;
 
 class GasPriceOracle {
 public:
     explicit GasPriceOracle(const BlockProvider& block_provider) : block_provider_(block_provider) {}
+
+    //! Suggest the price reusing the block samples and the price computed for the same head from the given cache
+    explicit GasPriceOracle(const BlockProvider& block_provider, const BlockHashProvider& block_hash_provider, GasPriceCache& cache)
+        : block_provider_(block_provider), block_hash_provider_{&block_hash_provider}, cache_{&cache} {}
     virtual ~GasPriceOracle() {}
 
     GasPriceOracle(const GasPriceOracle&) = delete;
@@ -59,9 +69,17 @@ public:
     asio::awaitable<intx::uint256> suggested_price(uint64_t block_number);
 
 private:
-    asio::awaitable<void> load_block_prices(uint64_t block_number, uint64_t limit, std::vector<intx::uint256>& tx_prices);
+    asio::awaitable<intx::uint256> compute_price(uint64_t block_number, std::optional<evmc::bytes32> block_hash);
+
+    asio::awaitable<intx::uint256> wait_price(uint64_t block_number, const evmc::bytes32& block_hash);
+
+    asio::awaitable<std::shared_ptr<const GasPriceCache::BlockPrices>> block_prices(uint64_t block_number, std::optional<evmc::bytes32> block_hash);
+
+    asio::awaitable<std::shared_ptr<const GasPriceCache::BlockPrices>> load_block_prices(uint64_t block_number);
 
     const BlockProvider& block_provider_;
+    const BlockHashProvider* block_hash_provider_{nullptr};
+    GasPriceCache* cache_{nullptr};
 };
 
 } // namespace silkrpc
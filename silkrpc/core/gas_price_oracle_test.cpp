@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 
 #include <asio/co_spawn.hpp>
 #include <asio/thread_pool.hpp>
@@ -115,9 +116,8 @@ TEST_CASE("suggested price") {
 
     std::vector<silkworm::BlockWithHash> blocks;
 
-    BlockProvider block_provider = [&](uint64_t block_number) -> asio::awaitable<silkworm::BlockWithHash> {
-        silkworm::BlockWithHash block_with_hash = blocks[block_number];
-        co_return block_with_hash;
+    BlockProvider block_provider = [&](uint64_t block_number) -> asio::awaitable<std::shared_ptr<const IndexedBlock>> {
+        co_return std::make_shared<const IndexedBlock>(blocks[block_number]);
     };
     GasPriceOracle gas_price_oracle{block_provider};
 
@@ -473,4 +473,79 @@ TEST_CASE("suggested price") {
     }
 }
 
+TEST_CASE("suggested price with cache") {
+    asio::thread_pool pool{1};
+
+    std::vector<silkworm::BlockWithHash> blocks;
+    auto append_block = [&]() {
+        const auto idx = blocks.size();
+        const intx::uint256 fee{0x10 + idx * 0x3};
+        FixedBlockData data = {0x7, fee, fee + 0x5, fee + 0x1, fee + 0x9};
+        auto block_with_hash = allocate_block(idx, kBeneficiary, data);
+        block_with_hash.hash.bytes[0] = static_cast<uint8_t>(idx + 1);
+        if (idx > 0) {
+            block_with_hash.block.header.parent_hash = blocks[idx - 1].hash;
+        }
+        blocks.push_back(block_with_hash);
+    };
+    for (auto idx = 0; idx < 30; idx++) {
+        append_block();
+    }
+
+    std::size_t loaded_blocks{0};
+    BlockProvider block_provider = [&](uint64_t block_number) -> asio::awaitable<std::shared_ptr<const IndexedBlock>> {
+        ++loaded_blocks;
+        co_return std::make_shared<const IndexedBlock>(blocks[block_number]);
+    };
+    BlockHashProvider block_hash_provider = [&](uint64_t block_number) -> asio::awaitable<evmc::bytes32> {
+        co_return blocks[block_number].hash;
+    };
+    GasPriceCache cache;
+    GasPriceOracle cached_oracle{block_provider, block_hash_provider, cache};
+
+    auto uncached_price = [&](uint64_t block_number) {
+        GasPriceOracle oracle{block_provider};
+        return asio::co_spawn(pool, oracle.suggested_price(block_number), asio::use_future).get();
+    };
+
+    SECTION("same price as without cache") {
+        const auto price = asio::co_spawn(pool, cached_oracle.suggested_price(29), asio::use_future).get();
+        CHECK(price == uncached_price(29));
+    }
+
+    SECTION("same head is not loaded again") {
+        asio::co_spawn(pool, cached_oracle.suggested_price(29), asio::use_future).get();
+        loaded_blocks = 0;
+        asio::co_spawn(pool, cached_oracle.suggested_price(29), asio::use_future).get();
+        CHECK(loaded_blocks == 0);
+        CHECK(cache.stats().price_hits == 1);
+    }
+
+    SECTION("new head loads just the new block") {
+        asio::co_spawn(pool, cached_oracle.suggested_price(29), asio::use_future).get();
+        append_block();
+        loaded_blocks = 0;
+        const auto price = asio::co_spawn(pool, cached_oracle.suggested_price(30), asio::use_future).get();
+        CHECK(loaded_blocks == 1);
+        CHECK(price == uncached_price(30));
+    }
+
+    SECTION("reorg invalidates replaced blocks") {
+        asio::co_spawn(pool, cached_oracle.suggested_price(29), asio::use_future).get();
+        blocks.resize(28);
+        append_block();
+        blocks[28].hash.bytes[1] = 0xFF;
+        blocks[28].block.transactions[0].max_priority_fee_per_gas = 0x1000;
+        blocks[28].block.transactions[0].max_fee_per_gas = 0x1000;
+        blocks[28].block.transactions[1].max_priority_fee_per_gas = 0x1000;
+        blocks[28].block.transactions[1].max_fee_per_gas = 0x1000;
+        append_block();
+        blocks[29].hash.bytes[1] = 0xFF;
+        loaded_blocks = 0;
+        const auto price = asio::co_spawn(pool, cached_oracle.suggested_price(29), asio::use_future).get();
+        CHECK(loaded_blocks == 2);
+        CHECK(price == uncached_price(29));
+    }
+}
+
 } // namespace silkrpc
@@ -22,6 +22,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <asio/awaitable.hpp>
 
@@ -44,6 +45,16 @@ public:
     virtual asio::awaitable<void> walk(const std::string& table, const silkworm::ByteView& start_key, uint32_t fixed_bits, Walker w) const = 0;
 
     virtual asio::awaitable<void> for_prefix(const std::string& table, const silkworm::ByteView& prefix, Walker w) const = 0;
+
+    //! Get the pair for each key in its table in the same order, implementations may issue the lookups all at once
+    virtual asio::awaitable<std::vector<KeyValue>> get_batch(const std::vector<TableKey>& table_keys) const {
+        std::vector<KeyValue> kv_pairs;
+        kv_pairs.reserve(table_keys.size());
+        for (const auto& table_key : table_keys) {
+            kv_pairs.push_back(co_await get(table_key.table, table_key.key));
+        }
+        co_return kv_pairs;
+    }
 };
 
 } // namespace silkrpc::core::rawdb
@@ -42,6 +42,50 @@
 
 namespace silkrpc::core::rawdb {
 
+namespace {
+
+silkworm::BlockHeader decode_header(const silkworm::Bytes& data) {
+    if (data.empty()) {
+        throw std::runtime_error{"empty block header RLP in read_header"};
+    }
+    SILKRPC_TRACE << "data: " << silkworm::to_hex(data) << "\n";
+    silkworm::ByteView data_view{data};
+    silkworm::BlockHeader header{};
+    const auto error = silkworm::rlp::decode(data_view, header);
+    if (error != silkworm::DecodingResult::kOk) {
+        throw std::runtime_error{"invalid RLP decoding for block header"};
+    }
+    return header;
+}
+
+Addresses decode_senders(const silkworm::Bytes& block_key, const KeyValue& kv_pair, uint64_t block_number) {
+    if (kv_pair.key != block_key) {
+        SILKRPC_WARN << "senders not found for block: " << block_number << "\n";
+        return Addresses{};
+    }
+    const auto& data = kv_pair.value;
+    SILKRPC_TRACE << "read_senders data: " << silkworm::to_hex(data) << "\n";
+    Addresses senders{data.size() / silkworm::kAddressLength};
+    for (size_t i{0}; i < senders.size(); i++) {
+        senders[i] = silkworm::to_evmc_address(silkworm::ByteView{&data[i * silkworm::kAddressLength], silkworm::kAddressLength});
+    }
+    return senders;
+}
+
+void fill_senders(Transactions& transactions, const Addresses& senders) {
+    if (senders.size() == transactions.size()) {
+        // Fill sender in transactions
+        for (size_t i{0}; i < transactions.size(); i++) {
+            transactions[i].from = senders[i];
+        }
+    } else {
+        // Transaction sender will be recovered on-the-fly (performance penalty)
+        SILKRPC_WARN << "#senders: " << senders.size() << " and #txns " << transactions.size() << " do not match\n";
+    }
+}
+
+} // namespace
+
 asio::awaitable<uint64_t> read_header_number(const DatabaseReader& reader, const evmc::bytes32& block_hash) {
     const silkworm::ByteView block_hash_bytes{block_hash.bytes, silkworm::kHashLength};
     const auto kv_pair{co_await reader.get(db::table::kHeaderNumbers, block_hash_bytes)};
@@ -125,12 +169,37 @@ asio::awaitable<uint64_t> read_block_number_by_transaction_hash(const DatabaseRe
 }
 
 asio::awaitable<silkworm::BlockWithHash> read_block(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number) {
-    auto header = co_await read_header(reader, block_hash, block_number);
+    // Header, body and senders do not depend on each other: look them up all at once, only transactions need the body
+    const auto block_key = silkworm::db::block_key(block_number, block_hash.bytes);
+    const auto kv_pairs = co_await reader.get_batch({
+        {db::table::kHeaders, block_key},
+        {db::table::kBlockBodies, block_key},
+        {db::table::kSenders, block_key},
+    });
+
+    auto header = decode_header(kv_pairs[0].value);
     SILKRPC_INFO << "header: number=" << header.number << "\n";
-    auto body = co_await read_body(reader, block_hash, block_number);
-    SILKRPC_INFO << "body: #txn=" << body.transactions.size() << " #ommers=" << body.ommers.size() << "\n";
-    silkworm::BlockWithHash block{silkworm::Block{body.transactions, body.ommers, header}, block_hash};
-    co_return block;
+
+    const auto& body_data = kv_pairs[1].value;
+    if (body_data.empty()) {
+        throw std::runtime_error{"empty block body RLP in read_body"};
+    }
+    try {
+        silkworm::ByteView data_view{body_data};
+        auto stored_body{silkworm::db::detail::decode_stored_block_body(data_view)};
+        SILKRPC_DEBUG << "base_txn_id: " << stored_body.base_txn_id << " txn_count: " << stored_body.txn_count << "\n";
+        auto transactions = co_await read_transactions(reader, stored_body.base_txn_id, stored_body.txn_count);
+        if (transactions.size() != 0) {
+            const auto senders = decode_senders(block_key, kv_pairs[2], block_number);
+            fill_senders(transactions, senders);
+        }
+        SILKRPC_INFO << "body: #txn=" << transactions.size() << " #ommers=" << stored_body.ommers.size() << "\n";
+        silkworm::BlockWithHash block{silkworm::Block{std::move(transactions), std::move(stored_body.ommers), std::move(header)}, block_hash};
+        co_return block;
+    } catch (silkworm::rlp::DecodingError error) {
+        SILKRPC_ERROR << "RLP decoding error for block body #" << block_number << " [" << error.what() << "]\n";
+        throw std::runtime_error{"RLP decoding error for block body [" + std::string(error.what()) + "]"};
+    }
 }
 
 asio::awaitable<silkworm::BlockHeader> read_header_by_hash(const DatabaseReader& reader, const evmc::bytes32& block_hash) {
@@ -144,18 +213,8 @@ asio::awaitable<silkworm::BlockHeader> read_header_by_number(const DatabaseReade
 }
 
 asio::awaitable<silkworm::BlockHeader> read_header(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number) {
-    auto data = co_await read_header_rlp(reader, block_hash, block_number);
-    if (data.empty()) {
-        throw std::runtime_error{"empty block header RLP in read_header"};
-    }
-    SILKRPC_TRACE << "data: " << silkworm::to_hex(data) << "\n";
-    silkworm::ByteView data_view{data};
-    silkworm::BlockHeader header{};
-    const auto error = silkworm::rlp::decode(data_view, header);
-    if (error != silkworm::DecodingResult::kOk) {
-        throw std::runtime_error{"invalid RLP decoding for block header"};
-    }
-    co_return header;
+    const auto data = co_await read_header_rlp(reader, block_hash, block_number);
+    co_return decode_header(data);
 }
 
 asio::awaitable<silkworm::BlockBody> read_body(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number) {
@@ -172,15 +231,7 @@ asio::awaitable<silkworm::BlockBody> read_body(const DatabaseReader& reader, con
         auto transactions = co_await read_transactions(reader, stored_body.base_txn_id, stored_body.txn_count);
         if (transactions.size() != 0) {
             const auto senders = co_await read_senders(reader, block_hash, block_number);
-            if (senders.size() == transactions.size()) {
-                // Fill sender in transactions
-                for (size_t i{0}; i < transactions.size(); i++) {
-                    transactions[i].from = senders[i];
-                }
-            } else {
-                // Transaction sender will be recovered on-the-fly (performance penalty)
-                SILKRPC_WARN << "#senders: " << senders.size() << " and #txns " << transactions.size() << " do not match\n";
-            }
+            fill_senders(transactions, senders);
         }
         silkworm::BlockBody body{transactions, stored_body.ommers};
         co_return body;
@@ -207,17 +258,7 @@ asio::awaitable<silkworm::Bytes> read_body_rlp(const DatabaseReader& reader, con
 asio::awaitable<Addresses> read_senders(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number) {
     const auto block_key = silkworm::db::block_key(block_number, block_hash.bytes);
     const auto kv_pair = co_await reader.get(db::table::kSenders, block_key);
-    if (kv_pair.key != block_key) {
-        SILKRPC_WARN << "senders not found for block: " << block_number << "\n";
-        co_return Addresses{};
-    }
-    const auto data = kv_pair.value;
-    SILKRPC_TRACE << "read_senders data: " << silkworm::to_hex(data) << "\n";
-    Addresses senders{data.size() / silkworm::kAddressLength};
-    for (size_t i{0}; i < senders.size(); i++) {
-        senders[i] = silkworm::to_evmc_address(silkworm::ByteView{&data[i * silkworm::kAddressLength], silkworm::kAddressLength});
-    }
-    co_return senders;
+    co_return decode_senders(block_key, kv_pair, block_number);
 }
 
 asio::awaitable<Receipts> read_raw_receipts(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number) {
@@ -257,13 +298,14 @@ asio::awaitable<Receipts> read_raw_receipts(const DatabaseReader& reader, const
     co_return receipts;
 }
 
-asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silkworm::BlockWithHash& block_with_hash) {
+asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silkworm::BlockWithHash& block_with_hash,
+    const std::vector<evmc::bytes32>& transaction_hashes) {
     const evmc::bytes32 block_hash = block_with_hash.hash;
     uint64_t block_number = block_with_hash.block.header.number;
     auto receipts = co_await read_raw_receipts(reader, block_hash, block_number);
 
     // Add derived fields to the receipts
-    auto transactions = block_with_hash.block.transactions;
+    const auto& transactions = block_with_hash.block.transactions;
     SILKRPC_DEBUG << "#transactions=" << block_with_hash.block.transactions.size() << " #receipts=" << receipts.size() << "\n";
     if (transactions.size() != receipts.size()) {
         throw std::runtime_error{"#transactions and #receipts do not match in read_receipts"};
@@ -271,8 +313,12 @@ asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silk
     size_t log_index{0};
     for (size_t i{0}; i < receipts.size(); i++) {
         // The tx hash can be calculated by the tx content itself
-        auto tx_hash{hash_of_transaction(transactions[i])};
-        receipts[i].tx_hash = silkworm::to_bytes32(full_view(tx_hash.bytes));
+        if (transaction_hashes.size() == transactions.size()) {
+            receipts[i].tx_hash = transaction_hashes[i];
+        } else {
+            auto tx_hash{hash_of_transaction(transactions[i])};
+            receipts[i].tx_hash = silkworm::to_bytes32(full_view(tx_hash.bytes));
+        }
         receipts[i].tx_index = uint32_t(i);
 
         receipts[i].block_hash = block_hash;
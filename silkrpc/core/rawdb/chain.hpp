@@ -72,7 +72,9 @@ asio::awaitable<Addresses> read_senders(const DatabaseReader& reader, const evmc
 
 asio::awaitable<Receipts> read_raw_receipts(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number);
 
-asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silkworm::BlockWithHash& block_with_hash);
+//! Read the receipts of the given block, using the precomputed transaction hashes to fill the derived fields if provided
+asio::awaitable<Receipts> read_receipts(const DatabaseReader& reader, const silkworm::BlockWithHash& block_with_hash,
+    const std::vector<evmc::bytes32>& transaction_hashes = {});
 
 asio::awaitable<Transactions> read_transactions(const DatabaseReader& reader, uint64_t base_txn_id, uint64_t txn_count);
 
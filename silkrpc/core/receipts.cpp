@@ -16,13 +16,16 @@
 
 #include "receipts.hpp"
 
+#include <memory>
+
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/core/rawdb/chain.hpp>
 
 namespace silkrpc::core {
 
-asio::awaitable<Receipts> get_receipts(const core::rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash) {
-    const auto cached_receipts = co_await core::rawdb::read_receipts(db_reader, block_with_hash);
+asio::awaitable<Receipts> get_receipts(const core::rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash,
+    const std::vector<evmc::bytes32>& transaction_hashes) {
+    const auto cached_receipts = co_await core::rawdb::read_receipts(db_reader, block_with_hash, transaction_hashes);
     if (!cached_receipts.empty()) {
         co_return cached_receipts;
     }
@@ -34,4 +37,16 @@ asio::awaitable<Receipts> get_receipts(const core::rawdb::DatabaseReader& db_rea
     co_return Receipts{};
 }
 
+asio::awaitable<std::shared_ptr<const Receipts>> get_receipts(BlockCache& cache, const core::rawdb::DatabaseReader& db_reader, const IndexedBlock& block_with_hash) {
+    auto cached_receipts = cache.get_receipts(block_with_hash.hash);
+    if (cached_receipts) {
+        co_return cached_receipts;
+    }
+    auto receipts = std::make_shared<const Receipts>(co_await get_receipts(db_reader, block_with_hash, block_with_hash.transaction_hashes));
+    if (!receipts->empty()) {
+        cache.insert_receipts(block_with_hash.hash, receipts);
+    }
+    co_return receipts;
+}
+
 } // namespace silkrpc::core
@@ -19,17 +19,26 @@
 
 #include <silkrpc/config.hpp>
 
+#include <memory>
+#include <vector>
+
 #include <asio/awaitable.hpp>
 #include <evmc/evmc.hpp>
 
+#include <silkrpc/common/block_cache.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
+#include <silkrpc/types/block.hpp>
 #include <silkrpc/types/receipt.hpp>
 
 #include <silkworm/types/block.hpp>
 
 namespace silkrpc::core {
 
-asio::awaitable<Receipts> get_receipts(const rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash);
+asio::awaitable<Receipts> get_receipts(const rawdb::DatabaseReader& db_reader, const silkworm::BlockWithHash& block_with_hash,
+    const std::vector<evmc::bytes32>& transaction_hashes = {});
+
+//! Get the receipts from the block cache if present, otherwise read and derive them once and attach them to the cached block
+asio::awaitable<std::shared_ptr<const Receipts>> get_receipts(BlockCache& cache, const rawdb::DatabaseReader& db_reader, const IndexedBlock& block_with_hash);
 
 } // namespace silkrpc::core
 
@@ -17,6 +17,7 @@
 #include "remote_state.hpp"
 
 #include <future>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 
@@ -30,19 +31,29 @@
 
 namespace silkrpc::state {
 
-static std::unordered_map<evmc::bytes32, silkworm::Bytes> code;
-
 asio::awaitable<std::optional<silkworm::Account>> AsyncRemoteState::read_account(const evmc::address& address) const noexcept {
     co_return co_await state_reader_.read_account(address, block_number_ + 1);
 }
 
 asio::awaitable<silkworm::ByteView> AsyncRemoteState::read_code(const evmc::bytes32& code_hash) const noexcept {
-    const auto optional_code{co_await state_reader_.read_code(code_hash)};
-    if (optional_code) {
-        code[code_hash] = std::move(*optional_code);
-        co_return code[code_hash]; // NOLINT(runtime/arrays)
+    const auto pinned_code{code_.find(code_hash)};
+    if (pinned_code != code_.end()) {
+        co_return *pinned_code->second;
+    }
+    auto cached_code{code_cache_ ? code_cache_->get(code_hash) : nullptr};
+    if (!cached_code) {
+        auto optional_code{co_await state_reader_.read_code(code_hash)};
+        if (!optional_code || optional_code->empty()) {
+            co_return silkworm::ByteView{};
+        }
+        if (code_cache_) {
+            cached_code = code_cache_->insert(code_hash, std::move(*optional_code));
+        } else {
+            cached_code = std::make_shared<const silkworm::Bytes>(std::move(*optional_code));
+        }
     }
-    co_return silkworm::ByteView{};
+    const auto& code = code_.emplace(code_hash, std::move(cached_code)).first->second;
+    co_return *code;
 }
 
 asio::awaitable<evmc::bytes32> AsyncRemoteState::read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept {
@@ -80,12 +91,64 @@ asio::awaitable<std::optional<evmc::bytes32>> AsyncRemoteState::canonical_hash(u
     co_return co_await core::rawdb::read_canonical_block_hash(db_reader_, block_number);
 }
 
+asio::awaitable<void> RemoteState::prefetch(const ReadMisses& misses) {
+    SILKRPC_DEBUG << "RemoteState::prefetch #accounts=" << misses.accounts.size() << " #storage=" << misses.storage.size()
+        << " #code=" << misses.code.size() << "\n";
+    for (const auto& address : misses.accounts) {
+        if (!find_account(address)) {
+            read_set_.accounts.emplace(address, co_await async_state_.read_account(address));
+        }
+    }
+    for (const auto& [address, incarnation, location] : misses.storage) {
+        if (!find_storage(address, incarnation, location)) {
+            read_set_.storage[address][incarnation].emplace(location, co_await async_state_.read_storage(address, incarnation, location));
+        }
+    }
+    for (const auto& code_hash : misses.code) {
+        if (!find_code(code_hash)) {
+            read_set_.code.emplace(code_hash, co_await async_state_.read_code(code_hash));
+        }
+    }
+}
+
+const std::optional<silkworm::Account>* RemoteState::find_account(const evmc::address& address) const noexcept {
+    const auto it = read_set_.accounts.find(address);
+    return it != read_set_.accounts.end() ? &it->second : nullptr;
+}
+
+const silkworm::ByteView* RemoteState::find_code(const evmc::bytes32& code_hash) const noexcept {
+    const auto it = read_set_.code.find(code_hash);
+    return it != read_set_.code.end() ? &it->second : nullptr;
+}
+
+const evmc::bytes32* RemoteState::find_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept {
+    const auto account_it = read_set_.storage.find(address);
+    if (account_it == read_set_.storage.end()) {
+        return nullptr;
+    }
+    const auto incarnation_it = account_it->second.find(incarnation);
+    if (incarnation_it == account_it->second.end()) {
+        return nullptr;
+    }
+    const auto slot_it = incarnation_it->second.find(location);
+    return slot_it != incarnation_it->second.end() ? &slot_it->second : nullptr;
+}
+
 std::optional<silkworm::Account> RemoteState::read_account(const evmc::address& address) const noexcept {
     SILKRPC_DEBUG << "RemoteState::read_account address=" << address << " start\n";
+    if (const auto account = find_account(address)) {
+        return *account;
+    }
+    if (speculation_misses_) {
+        speculation_misses_->accounts.push_back(address);
+        return std::nullopt;
+    }
+    ++blocking_reads_;
     try {
         std::future<std::optional<silkworm::Account>> result{asio::co_spawn(io_context_, async_state_.read_account(address), asio::use_future)};
         const auto optional_account{result.get()};
         SILKRPC_DEBUG << "RemoteState::read_account account.nonce=" << (optional_account ? optional_account->nonce : 0) << " end\n";
+        read_set_.accounts.emplace(address, optional_account);
         return optional_account;
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "RemoteState::read_account exception: " << e.what() << "\n";
@@ -95,9 +158,18 @@ std::optional<silkworm::Account> RemoteState::read_account(const evmc::address&
 
 silkworm::ByteView RemoteState::read_code(const evmc::bytes32& code_hash) const noexcept {
     SILKRPC_DEBUG << "RemoteState::read_code code_hash=" << code_hash << " start\n";
+    if (const auto code = find_code(code_hash)) {
+        return *code;
+    }
+    if (speculation_misses_) {
+        speculation_misses_->code.push_back(code_hash);
+        return silkworm::ByteView{};
+    }
+    ++blocking_reads_;
     try {
         std::future<silkworm::ByteView> result{asio::co_spawn(io_context_, async_state_.read_code(code_hash), asio::use_future)};
         const auto code{result.get()};
+        read_set_.code.emplace(code_hash, code);
         return code;
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "RemoteState::read_code exception: " << e.what() << "\n";
@@ -107,10 +179,19 @@ silkworm::ByteView RemoteState::read_code(const evmc::bytes32& code_hash) const
 
 evmc::bytes32 RemoteState::read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept {
     SILKRPC_DEBUG << "RemoteState::read_storage address=" << address << " incarnation=" << incarnation << " location=" << location << " start\n";
+    if (const auto storage_value = find_storage(address, incarnation, location)) {
+        return *storage_value;
+    }
+    if (speculation_misses_) {
+        speculation_misses_->storage.push_back(StorageLocation{address, incarnation, location});
+        return evmc::bytes32{};
+    }
+    ++blocking_reads_;
     try {
         std::future<evmc::bytes32> result{asio::co_spawn(io_context_, async_state_.read_storage(address, incarnation, location), asio::use_future)};
         const auto storage_value{result.get()};
         SILKRPC_DEBUG << "RemoteState::read_storage storage_value=" << storage_value << " end\n";
+        read_set_.storage[address][incarnation].emplace(location, storage_value);
         return storage_value;
     } catch (const std::exception& e) {
        SILKRPC_ERROR << "RemoteState::read_storage exception: " << e.what() << "\n";
@@ -125,6 +206,7 @@ uint64_t RemoteState::previous_incarnation(const evmc::address& address) const n
 
 std::optional<silkworm::BlockHeader> RemoteState::read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept {
     SILKRPC_DEBUG << "RemoteState::read_header block_number=" << block_number << " block_hash=" << block_hash << "\n";
+    std::scoped_lock lock{header_access_};
     try {
         std::future<std::optional<silkworm::BlockHeader>> result{asio::co_spawn(io_context_, async_state_.read_header(block_number, block_hash), asio::use_future)};
         const auto optional_header{result.get()};
@@ -138,6 +220,7 @@ std::optional<silkworm::BlockHeader> RemoteState::read_header(uint64_t block_num
 
 bool RemoteState::read_body(uint64_t block_number, const evmc::bytes32& block_hash, silkworm::BlockBody& filled_body) const noexcept {
     SILKRPC_DEBUG << "RemoteState::read_body block_number=" << block_number << " block_hash=" << block_hash << "\n";
+    std::scoped_lock lock{header_access_};
     try {
         auto result{asio::co_spawn(io_context_, async_state_.read_body(block_number, block_hash, filled_body), asio::use_future)};
         SILKRPC_DEBUG << "RemoteState::read_body block_number=" << block_number << " block_hash=" << block_hash << "\n";
@@ -150,6 +233,7 @@ bool RemoteState::read_body(uint64_t block_number, const evmc::bytes32& block_ha
 
 std::optional<intx::uint256> RemoteState::total_difficulty(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept {
     SILKRPC_DEBUG << "RemoteState::total_difficulty block_number=" << block_number << " block_hash=" << block_hash << "\n";
+    std::scoped_lock lock{header_access_};
     try {
         std::future<std::optional<intx::uint256>> result{asio::co_spawn(io_context_, async_state_.total_difficulty(block_number, block_hash), asio::use_future)};
         const auto optional_total_difficulty{result.get()};
@@ -176,4 +260,28 @@ std::optional<evmc::bytes32> RemoteState::canonical_hash(uint64_t block_number)
     return std::nullopt;
 }
 
+std::optional<silkworm::Account> SpeculativeState::read_account(const evmc::address& address) const noexcept {
+    if (const auto account = remote_state_.find_account(address)) {
+        return *account;
+    }
+    misses_.accounts.push_back(address);
+    return std::nullopt;
+}
+
+silkworm::ByteView SpeculativeState::read_code(const evmc::bytes32& code_hash) const noexcept {
+    if (const auto code = remote_state_.find_code(code_hash)) {
+        return *code;
+    }
+    misses_.code.push_back(code_hash);
+    return silkworm::ByteView{};
+}
+
+evmc::bytes32 SpeculativeState::read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept {
+    if (const auto storage_value = remote_state_.find_storage(address, incarnation, location)) {
+        return *storage_value;
+    }
+    misses_.storage.push_back(StorageLocation{address, incarnation, location});
+    return evmc::bytes32{};
+}
+
 } // namespace silkrpc::state
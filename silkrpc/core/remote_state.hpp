@@ -17,9 +17,13 @@
 #ifndef SILKRPC_CORE_REMOTE_STATE_HPP_
 #define SILKRPC_CORE_REMOTE_STATE_HPP_
 
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <silkrpc/config.hpp> // NOLINT(build/include_order)
@@ -29,6 +33,9 @@
 #include <evmc/evmc.hpp>
 #include <silkworm/common/util.hpp>
 
+#include <silkrpc/common/code_cache.hpp>
+#include <silkrpc/common/coherent_state_cache.hpp>
+#include <silkrpc/common/state_cache.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
 #include <silkrpc/core/state_reader.hpp>
 #include <silkworm/state/state.hpp>
@@ -37,8 +44,10 @@ namespace silkrpc::state {
 
 class AsyncRemoteState {
 public:
-    explicit AsyncRemoteState(asio::io_context& io_context, const core::rawdb::DatabaseReader& db_reader, uint64_t block_number)
-    : io_context_(io_context), db_reader_(db_reader), block_number_(block_number), state_reader_{db_reader} {}
+    explicit AsyncRemoteState(asio::io_context& io_context, const core::rawdb::DatabaseReader& db_reader, uint64_t block_number,
+        StateCache* state_cache = nullptr, CoherentStateView latest_view = {}, CodeCache* code_cache = nullptr)
+    : io_context_(io_context), db_reader_(db_reader), block_number_(block_number), state_reader_{db_reader, state_cache, latest_view},
+      code_cache_(code_cache) {}
 
     asio::awaitable<std::optional<silkworm::Account>> read_account(const evmc::address& address) const noexcept;
 
@@ -65,12 +74,56 @@ private:
     const core::rawdb::DatabaseReader& db_reader_;
     uint64_t block_number_;
     StateReader state_reader_;
+    CodeCache* code_cache_;
+    //! Code returned to the EVM as views, kept alive here even if evicted from the shared code cache
+    mutable std::unordered_map<evmc::bytes32, std::shared_ptr<const silkworm::Bytes>> code_;
 };
 
+struct StorageLocation {
+    evmc::address address;
+    uint64_t incarnation;
+    evmc::bytes32 location;
+};
+
+//! State entries already read from the remote database
+struct ReadSet {
+    std::unordered_map<evmc::address, std::optional<silkworm::Account>> accounts;
+    std::unordered_map<evmc::address, std::unordered_map<uint64_t, std::unordered_map<evmc::bytes32, evmc::bytes32>>> storage;
+    std::unordered_map<evmc::bytes32, silkworm::ByteView> code;
+};
+
+//! State entries requested but not read yet, possibly with duplicates
+struct ReadMisses {
+    bool empty() const noexcept { return accounts.empty() && storage.empty() && code.empty(); }
+
+    std::vector<evmc::address> accounts;
+    std::vector<StorageLocation> storage;
+    std::vector<evmc::bytes32> code;
+};
+
+//! Synchronous adapter of AsyncRemoteState for the EVM. Entries already read are served from memory, the others are read
+//! by blocking the calling thread on the I/O context unless they have been prefetched asynchronously.
 class RemoteState : public silkworm::State {
 public:
-    explicit RemoteState(asio::io_context& io_context, const core::rawdb::DatabaseReader& db_reader, uint64_t block_number)
-    : io_context_(io_context), async_state_{io_context, db_reader, block_number} {}
+    explicit RemoteState(asio::io_context& io_context, const core::rawdb::DatabaseReader& db_reader, uint64_t block_number,
+        StateCache* state_cache = nullptr, CoherentStateView latest_view = {}, CodeCache* code_cache = nullptr)
+    : io_context_(io_context), async_state_{io_context, db_reader, block_number, state_cache, latest_view, code_cache} {}
+
+    //! Read the given entries without blocking any thread, so that subsequent reads of them are served from memory
+    asio::awaitable<void> prefetch(const ReadMisses& misses);
+
+    const std::optional<silkworm::Account>* find_account(const evmc::address& address) const noexcept;
+
+    const silkworm::ByteView* find_code(const evmc::bytes32& code_hash) const noexcept;
+
+    const evmc::bytes32* find_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept;
+
+    //! Number of state reads so far that had to block the calling thread
+    std::size_t blocking_reads() const noexcept { return blocking_reads_; }
+
+    //! Record the reads of entries not read yet into misses and serve them as empty instead of blocking, until called
+    //! with nullptr: used to execute speculatively on a world state that can be discarded
+    void set_speculation(ReadMisses* misses) noexcept { speculation_misses_ = misses; }
 
     std::optional<silkworm::Account> read_account(const evmc::address& address) const noexcept override;
 
@@ -125,10 +178,87 @@ public:
 private:
     asio::io_context& io_context_;
     AsyncRemoteState async_state_;
+    mutable ReadSet read_set_;
+    mutable std::size_t blocking_reads_{0};
+    ReadMisses* speculation_misses_{nullptr};
+    //! Serialize the chain reads that concurrent speculative executions forward here
+    mutable std::mutex header_access_;
 };
 
 std::ostream& operator<<(std::ostream& out, const RemoteState& s);
 
+//! State for speculative EVM execution: entries already read by the RemoteState are served from memory, the others are
+//! recorded as misses and read as empty. Executing speculatively until no misses are left lets the real execution
+//! run without blocking on remote reads.
+class SpeculativeState : public silkworm::State {
+public:
+    explicit SpeculativeState(const RemoteState& remote_state) : remote_state_(remote_state) {}
+
+    const ReadMisses& misses() const noexcept { return misses_; }
+
+    std::optional<silkworm::Account> read_account(const evmc::address& address) const noexcept override;
+
+    silkworm::ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override {
+        return remote_state_.previous_incarnation(address);
+    }
+
+    std::optional<silkworm::BlockHeader> read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        return remote_state_.read_header(block_number, block_hash);
+    }
+
+    bool read_body(uint64_t block_number, const evmc::bytes32& block_hash, silkworm::BlockBody& out) const noexcept override {
+        return remote_state_.read_body(block_number, block_hash, out);
+    }
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        return remote_state_.total_difficulty(block_number, block_hash);
+    }
+
+    evmc::bytes32 state_root_hash() const override { return remote_state_.state_root_hash(); }
+
+    uint64_t current_canonical_block() const override { return remote_state_.current_canonical_block(); }
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override { return remote_state_.canonical_hash(block_number); }
+
+    void insert_block(const silkworm::Block& block, const evmc::bytes32& hash) override {}
+
+    void canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) override {}
+
+    void decanonize_block(uint64_t block_number) override {}
+
+    void insert_receipts(uint64_t block_number, const std::vector<silkworm::Receipt>& receipts) override {}
+
+    void begin_block(uint64_t block_number) override {}
+
+    void update_account(
+        const evmc::address& address,
+        std::optional<silkworm::Account> initial,
+        std::optional<silkworm::Account> current) override {}
+
+    void update_account_code(
+        const evmc::address& address,
+        uint64_t incarnation,
+        const evmc::bytes32& code_hash,
+        silkworm::ByteView code) override {}
+
+    void update_storage(
+        const evmc::address& address,
+        uint64_t incarnation,
+        const evmc::bytes32& location,
+        const evmc::bytes32& initial,
+        const evmc::bytes32& current) override {}
+
+    void unwind_state_changes(uint64_t block_number) override {}
+
+private:
+    const RemoteState& remote_state_;
+    mutable ReadMisses misses_;
+};
+
 } // namespace silkrpc::state
 
 #endif  // SILKRPC_CORE_REMOTE_STATE_HPP_
@@ -420,7 +420,63 @@ TEST_CASE("async remote buffer", "[silkrpc][core][remote_buffer]") {
         io_context.run();
         CHECK_THROWS_AS(future_code.get(), std::exception);
     }
+
+    SECTION("RemoteState in speculation records misses instead of blocking") {
+        asio::io_context io_context;
+        silkworm::Bytes storage{*silkworm::from_hex("0x0608")};
+        MockDatabaseReader db_reader{storage};
+        const uint64_t block_number = 1'000'000;
+        evmc::address address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+        const auto location{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+        RemoteState remote_state(io_context, db_reader, block_number);
+
+        ReadMisses misses;
+        remote_state.set_speculation(&misses);
+        CHECK(remote_state.read_storage(address, 0, location) == evmc::bytes32{});
+        remote_state.set_speculation(nullptr);
+        REQUIRE(misses.storage.size() == 1);
+        CHECK(remote_state.blocking_reads() == 0);
+        CHECK(!remote_state.find_storage(address, 0, location));
+
+        auto result{asio::co_spawn(io_context, remote_state.prefetch(misses), asio::use_future)};
+        io_context.run();
+        result.get();
+
+        ReadMisses next_misses;
+        remote_state.set_speculation(&next_misses);
+        CHECK(remote_state.read_storage(address, 0, location) == 0x0000000000000000000000000000000000000000000000000000000000000608_bytes32);
+        remote_state.set_speculation(nullptr);
+        CHECK(next_misses.empty());
+        CHECK(remote_state.blocking_reads() == 0);
+    }
+
+    SECTION("SpeculativeState records misses until prefetched") {
+        asio::io_context io_context;
+        silkworm::Bytes storage{*silkworm::from_hex("0x0608")};
+        MockDatabaseReader db_reader{storage};
+        const uint64_t block_number = 1'000'000;
+        evmc::address address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+        const auto location{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+        RemoteState remote_state(io_context, db_reader, block_number);
+
+        SpeculativeState speculative_state{remote_state};
+        CHECK(speculative_state.read_storage(address, 0, location) == evmc::bytes32{});
+        REQUIRE(speculative_state.misses().storage.size() == 1);
+        CHECK(!remote_state.find_storage(address, 0, location));
+
+        auto result{asio::co_spawn(io_context, remote_state.prefetch(speculative_state.misses()), asio::use_future)};
+        io_context.run();
+        result.get();
+
+        const auto storage_value = remote_state.find_storage(address, 0, location);
+        REQUIRE(storage_value);
+        CHECK(*storage_value == 0x0000000000000000000000000000000000000000000000000000000000000608_bytes32);
+
+        SpeculativeState next_speculative_state{remote_state};
+        CHECK(next_speculative_state.read_storage(address, 0, location) == *storage_value);
+        CHECK(next_speculative_state.misses().empty());
+        CHECK(remote_state.read_storage(address, 0, location) == *storage_value);
+    }
 }
 
 } // namespace silkrpc::state
-
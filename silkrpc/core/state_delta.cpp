@@ -0,0 +1,153 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_delta.hpp"
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace silkrpc::state {
+
+std::size_t StateDelta::size() const noexcept {
+    std::size_t size{sizeof(StateDelta)};
+    size += accounts.size() * (sizeof(evmc::address) + sizeof(std::optional<silkworm::Account>));
+    for (const auto& [address, incarnation_storage] : storage) {
+        for (const auto& [incarnation, slots] : incarnation_storage) {
+            size += slots.size() * 2 * sizeof(evmc::bytes32);
+        }
+    }
+    for (const auto& [code_hash, bytecode] : code) {
+        size += sizeof(evmc::bytes32) + bytecode.size();
+    }
+    size += incarnations.size() * (sizeof(evmc::address) + sizeof(uint64_t));
+    return size;
+}
+
+std::shared_ptr<const StateDelta> flatten(const std::shared_ptr<const StateDelta>& delta) {
+    if (!delta || !delta->parent) {
+        return delta;
+    }
+    std::vector<const StateDelta*> chain;
+    for (auto it = delta.get(); it != nullptr; it = it->parent.get()) {
+        chain.push_back(it);
+    }
+
+    // Apply the changes from the oldest delta to the newest one, so that the latest value of each entry wins
+    auto flat = std::make_shared<StateDelta>(*chain.back());
+    for (auto it = std::next(chain.rbegin()); it != chain.rend(); ++it) {
+        const StateDelta& changes = **it;
+        for (const auto& [address, account] : changes.accounts) {
+            flat->accounts[address] = account;
+        }
+        for (const auto& [address, incarnation_storage] : changes.storage) {
+            auto& flat_incarnation_storage = flat->storage[address];
+            for (const auto& [incarnation, slots] : incarnation_storage) {
+                auto& flat_slots = flat_incarnation_storage[incarnation];
+                for (const auto& [location, value] : slots) {
+                    flat_slots[location] = value;
+                }
+            }
+        }
+        flat->code.insert(changes.code.begin(), changes.code.end());
+        for (const auto& [address, incarnation] : changes.incarnations) {
+            flat->incarnations[address] = incarnation;
+        }
+    }
+    return flat;
+}
+
+void OverlayState::begin_capture() {
+    capture_ = std::make_shared<StateDelta>();
+    capture_->parent = base_;
+}
+
+std::shared_ptr<const StateDelta> OverlayState::end_capture() {
+    return std::exchange(capture_, nullptr);
+}
+
+std::optional<silkworm::Account> OverlayState::read_account(const evmc::address& address) const noexcept {
+    for (auto delta = base_.get(); delta != nullptr; delta = delta->parent.get()) {
+        const auto it = delta->accounts.find(address);
+        if (it != delta->accounts.end()) {
+            return it->second;
+        }
+    }
+    return state_.read_account(address);
+}
+
+silkworm::ByteView OverlayState::read_code(const evmc::bytes32& code_hash) const noexcept {
+    for (auto delta = base_.get(); delta != nullptr; delta = delta->parent.get()) {
+        const auto it = delta->code.find(code_hash);
+        if (it != delta->code.end()) {
+            return it->second;
+        }
+    }
+    return state_.read_code(code_hash);
+}
+
+evmc::bytes32 OverlayState::read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept {
+    for (auto delta = base_.get(); delta != nullptr; delta = delta->parent.get()) {
+        const auto account_it = delta->storage.find(address);
+        if (account_it != delta->storage.end()) {
+            const auto incarnation_it = account_it->second.find(incarnation);
+            if (incarnation_it != account_it->second.end()) {
+                const auto slot_it = incarnation_it->second.find(location);
+                if (slot_it != incarnation_it->second.end()) {
+                    return slot_it->second;
+                }
+            }
+        }
+    }
+    return state_.read_storage(address, incarnation, location);
+}
+
+uint64_t OverlayState::previous_incarnation(const evmc::address& address) const noexcept {
+    for (auto delta = base_.get(); delta != nullptr; delta = delta->parent.get()) {
+        const auto it = delta->incarnations.find(address);
+        if (it != delta->incarnations.end()) {
+            return it->second;
+        }
+    }
+    return state_.previous_incarnation(address);
+}
+
+void OverlayState::update_account(const evmc::address& address, std::optional<silkworm::Account> initial, std::optional<silkworm::Account> current) {
+    if (!capture_ || initial == current) {
+        return;
+    }
+    if (initial && !current) {
+        capture_->incarnations[address] = initial->incarnation;
+    }
+    capture_->accounts[address] = std::move(current);
+}
+
+void OverlayState::update_account_code(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& code_hash, silkworm::ByteView code) {
+    if (!capture_) {
+        return;
+    }
+    capture_->code.emplace(code_hash, code);
+}
+
+void OverlayState::update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+    const evmc::bytes32& initial, const evmc::bytes32& current) {
+    if (!capture_) {
+        return;
+    }
+    capture_->storage[address][incarnation][location] = current;
+}
+
+} // namespace silkrpc::state
@@ -0,0 +1,135 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_CORE_STATE_DELTA_HPP_
+#define SILKRPC_CORE_STATE_DELTA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+#include <silkworm/common/base.hpp>
+#include <silkworm/state/state.hpp>
+#include <silkworm/types/account.hpp>
+
+namespace silkrpc::state {
+
+//! State changes accumulated by executing the first transactions of a block on top of its parent state.
+//! A delta may hold just the changes made on top of a parent delta, which is read through for anything not changed here.
+struct StateDelta {
+    using Storage = std::unordered_map<evmc::bytes32, evmc::bytes32>;
+
+    //! Estimated memory footprint in bytes, excluding the parent delta
+    std::size_t size() const noexcept;
+
+    std::shared_ptr<const StateDelta> parent;
+
+    std::unordered_map<evmc::address, std::optional<silkworm::Account>> accounts;
+    std::unordered_map<evmc::address, std::unordered_map<uint64_t, Storage>> storage;
+    std::unordered_map<evmc::bytes32, silkworm::Bytes> code;
+    //! Incarnations of the accounts destroyed in the delta, needed to recreate them with a fresh incarnation
+    std::unordered_map<evmc::address, uint64_t> incarnations;
+};
+
+//! Merge the given delta and all its parents into a single delta without parent
+std::shared_ptr<const StateDelta> flatten(const std::shared_ptr<const StateDelta>& delta);
+
+//! State reading through an optional base StateDelta before falling back to the underlying state.
+//! Writes are discarded unless a capture is in progress, in which case they are recorded in a new delta whose parent is
+//! the base, so that the changes of a world state can be snapshotted by writing it to the overlay.
+class OverlayState : public silkworm::State {
+public:
+    explicit OverlayState(silkworm::State& state) : state_(state) {}
+
+    //! Set the delta to read through, must be called before the state is read
+    void set_base(std::shared_ptr<const StateDelta> base) { base_ = std::move(base); }
+
+    const std::shared_ptr<const StateDelta>& base() const noexcept { return base_; }
+
+    void begin_capture();
+
+    std::shared_ptr<const StateDelta> end_capture();
+
+    std::optional<silkworm::Account> read_account(const evmc::address& address) const noexcept override;
+
+    silkworm::ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override;
+
+    std::optional<silkworm::BlockHeader> read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        return state_.read_header(block_number, block_hash);
+    }
+
+    bool read_body(uint64_t block_number, const evmc::bytes32& block_hash, silkworm::BlockBody& out) const noexcept override {
+        return state_.read_body(block_number, block_hash, out);
+    }
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        return state_.total_difficulty(block_number, block_hash);
+    }
+
+    evmc::bytes32 state_root_hash() const override { return state_.state_root_hash(); }
+
+    uint64_t current_canonical_block() const override { return state_.current_canonical_block(); }
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override { return state_.canonical_hash(block_number); }
+
+    void insert_block(const silkworm::Block& block, const evmc::bytes32& hash) override {}
+
+    void canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) override {}
+
+    void decanonize_block(uint64_t block_number) override {}
+
+    void insert_receipts(uint64_t block_number, const std::vector<silkworm::Receipt>& receipts) override {}
+
+    void begin_block(uint64_t block_number) override {}
+
+    void update_account(
+        const evmc::address& address,
+        std::optional<silkworm::Account> initial,
+        std::optional<silkworm::Account> current) override;
+
+    void update_account_code(
+        const evmc::address& address,
+        uint64_t incarnation,
+        const evmc::bytes32& code_hash,
+        silkworm::ByteView code) override;
+
+    void update_storage(
+        const evmc::address& address,
+        uint64_t incarnation,
+        const evmc::bytes32& location,
+        const evmc::bytes32& initial,
+        const evmc::bytes32& current) override;
+
+    void unwind_state_changes(uint64_t block_number) override {}
+
+private:
+    silkworm::State& state_;
+    std::shared_ptr<const StateDelta> base_;
+    std::shared_ptr<StateDelta> capture_;
+};
+
+} // namespace silkrpc::state
+
+#endif  // SILKRPC_CORE_STATE_DELTA_HPP_
@@ -0,0 +1,184 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_delta.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc::state {
+
+using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
+
+static silkworm::Account make_account(uint64_t nonce, uint64_t incarnation = 0) {
+    silkworm::Account account;
+    account.nonce = nonce;
+    account.incarnation = incarnation;
+    return account;
+}
+
+class MockState : public silkworm::State {
+public:
+    std::optional<silkworm::Account> read_account(const evmc::address& address) const noexcept override {
+        return make_account(1);
+    }
+    silkworm::ByteView read_code(const evmc::bytes32& code_hash) const noexcept override { return {}; }
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept override {
+        return 0x01_bytes32;
+    }
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override { return 0; }
+    std::optional<silkworm::BlockHeader> read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        return std::nullopt;
+    }
+    bool read_body(uint64_t block_number, const evmc::bytes32& block_hash, silkworm::BlockBody& out) const noexcept override {
+        return false;
+    }
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        return std::nullopt;
+    }
+    evmc::bytes32 state_root_hash() const override { return {}; }
+    uint64_t current_canonical_block() const override { return 0; }
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override { return std::nullopt; }
+    void insert_block(const silkworm::Block& block, const evmc::bytes32& hash) override {}
+    void canonize_block(uint64_t block_number, const evmc::bytes32& block_hash) override {}
+    void decanonize_block(uint64_t block_number) override {}
+    void insert_receipts(uint64_t block_number, const std::vector<silkworm::Receipt>& receipts) override {}
+    void begin_block(uint64_t block_number) override {}
+    void update_account(const evmc::address& address, std::optional<silkworm::Account> initial, std::optional<silkworm::Account> current) override {}
+    void update_account_code(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& code_hash, silkworm::ByteView code) override {}
+    void update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location, const evmc::bytes32& initial,
+        const evmc::bytes32& current) override {}
+    void unwind_state_changes(uint64_t block_number) override {}
+};
+
+TEST_CASE("OverlayState without base", "[silkrpc][core][state_delta]") {
+    const auto address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    MockState state;
+    OverlayState overlay{state};
+
+    CHECK(overlay.read_account(address)->nonce == 1);
+    CHECK(overlay.read_storage(address, 1, 0x00_bytes32) == 0x01_bytes32);
+
+    SECTION("writes outside capture are discarded") {
+        overlay.update_account(address, make_account(1), make_account(2));
+        CHECK(overlay.read_account(address)->nonce == 1);
+        CHECK(!overlay.end_capture());
+    }
+}
+
+TEST_CASE("OverlayState capture", "[silkrpc][core][state_delta]") {
+    const auto address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    const auto other_address{0x0000000000000000000000000000000000000001_address};
+    const auto code_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+    const silkworm::Bytes code{0x60, 0x08};
+    MockState state;
+    OverlayState overlay{state};
+
+    overlay.begin_capture();
+    overlay.update_account(address, make_account(1), make_account(2, 1));
+    overlay.update_account(other_address, make_account(1), make_account(1));
+    overlay.update_account_code(address, 1, code_hash, code);
+    overlay.update_storage(address, 1, 0x00_bytes32, 0x01_bytes32, 0x02_bytes32);
+    const auto delta = overlay.end_capture();
+    REQUIRE(delta);
+    CHECK(delta->accounts.size() == 1);
+    CHECK(delta->size() > sizeof(StateDelta));
+
+    SECTION("reads go through the base") {
+        OverlayState resumed{state};
+        resumed.set_base(delta);
+        CHECK(resumed.read_account(address)->nonce == 2);
+        CHECK(resumed.read_account(other_address)->nonce == 1);
+        CHECK(resumed.read_code(code_hash) == silkworm::ByteView{code});
+        CHECK(resumed.read_storage(address, 1, 0x00_bytes32) == 0x02_bytes32);
+        CHECK(resumed.read_storage(address, 2, 0x00_bytes32) == 0x01_bytes32);
+        CHECK(resumed.read_storage(address, 1, 0x01_bytes32) == 0x01_bytes32);
+    }
+
+    SECTION("capture extends the base") {
+        OverlayState resumed{state};
+        resumed.set_base(delta);
+        resumed.begin_capture();
+        resumed.update_account(address, make_account(2, 1), std::nullopt);
+        const auto extended = resumed.end_capture();
+        REQUIRE(extended);
+        CHECK(extended->parent == delta);
+        CHECK(extended->accounts.size() == 1);
+        CHECK(!extended->accounts.at(address));
+        CHECK(extended->incarnations.at(address) == 1);
+        CHECK(extended->storage.empty());
+        CHECK(delta->accounts.at(address)->nonce == 2);
+
+        OverlayState destroyed{state};
+        destroyed.set_base(extended);
+        CHECK(!destroyed.read_account(address));
+        CHECK(destroyed.previous_incarnation(address) == 1);
+        CHECK(destroyed.read_code(code_hash) == silkworm::ByteView{code});
+        CHECK(destroyed.read_storage(address, 1, 0x00_bytes32) == 0x02_bytes32);
+    }
+}
+
+TEST_CASE("flatten", "[silkrpc][core][state_delta]") {
+    const auto address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    const auto other_address{0x0000000000000000000000000000000000000001_address};
+    MockState state;
+    OverlayState overlay{state};
+
+    SECTION("no delta") {
+        CHECK(!flatten(nullptr));
+    }
+
+    overlay.begin_capture();
+    overlay.update_account(address, make_account(1), make_account(2, 1));
+    overlay.update_storage(address, 1, 0x00_bytes32, 0x01_bytes32, 0x02_bytes32);
+    overlay.update_storage(address, 1, 0x01_bytes32, 0x01_bytes32, 0x03_bytes32);
+    const auto first = overlay.end_capture();
+    REQUIRE(first);
+
+    SECTION("delta without parent") {
+        CHECK(flatten(first) == first);
+    }
+
+    SECTION("chain of deltas") {
+        overlay.set_base(first);
+        overlay.begin_capture();
+        overlay.update_account(address, make_account(2, 1), make_account(3, 1));
+        overlay.update_account(other_address, make_account(1), make_account(5));
+        overlay.update_storage(address, 1, 0x00_bytes32, 0x02_bytes32, 0x04_bytes32);
+        const auto second = overlay.end_capture();
+        overlay.set_base(second);
+        overlay.begin_capture();
+        overlay.update_account(other_address, make_account(5), std::nullopt);
+        const auto third = overlay.end_capture();
+
+        const auto flat = flatten(third);
+        REQUIRE(flat);
+        CHECK(!flat->parent);
+        CHECK(flat->accounts.size() == 2);
+        CHECK(flat->accounts.at(address)->nonce == 3);
+        CHECK(!flat->accounts.at(other_address));
+        CHECK(flat->incarnations.at(other_address) == 0);
+        CHECK(flat->storage.at(address).at(1).at(0x00_bytes32) == 0x04_bytes32);
+        CHECK(flat->storage.at(address).at(1).at(0x01_bytes32) == 0x03_bytes32);
+
+        // The deltas of the chain are left untouched
+        CHECK(first->accounts.at(address)->nonce == 2);
+        CHECK(second->accounts.at(address)->nonce == 3);
+        CHECK(second->parent == first);
+        CHECK(third->parent == second);
+    }
+}
+
+} // namespace silkrpc::state
@@ -30,44 +30,93 @@
 namespace silkrpc {
 
 asio::awaitable<std::optional<silkworm::Account>> StateReader::read_account(const evmc::address& address, uint64_t block_number) const {
-    std::optional<silkworm::Bytes> encoded{co_await read_historical_account(address, block_number)};
-    if (!encoded) {
-        encoded = co_await db_reader_.get_one(db::table::kPlainState, full_view(address));
+    if (state_cache_) {
+        const auto cached_account{state_cache_->get_account(address, block_number)};
+        if (cached_account) {
+            co_return *cached_account;
+        }
     }
-    if (!encoded || encoded->empty()) {
-        co_return std::nullopt;
+
+    const bool latest{is_latest(block_number)};
+    if (latest) {
+        const auto cached_account{latest_view_.cache->get_account(latest_view_.view_id, block_number, address)};
+        if (cached_account) {
+            co_return *cached_account;
+        }
     }
 
-    auto [account, err]{silkworm::Account::from_encoded_storage(*encoded)};
-    silkworm::rlp::success_or_throw(err); // TODO(canepat) suggest rename as throw_if_error or better throw_if(err != kOk)
+    std::optional<silkworm::Bytes> encoded;
+    if (!latest) {
+        encoded = co_await read_historical_account(address, block_number);
+    }
+    const bool historical{encoded.has_value()};
+    if (!encoded) {
+        encoded = co_await db_reader_.get_one(db::table::kPlainState, full_view(address));
+    }
 
-    if (account.incarnation > 0 && account.code_hash == silkworm::kEmptyHash) {
-        // Restore code hash
-        const auto storage_key{silkworm::db::storage_prefix(full_view(address), account.incarnation)};
-        auto code_hash{co_await db_reader_.get_one(db::table::kPlainContractCode, storage_key)};
-        if (code_hash.length() == silkworm::kHashLength) {
-            std::memcpy(account.code_hash.bytes, code_hash.data(), silkworm::kHashLength);
+    std::optional<silkworm::Account> optional_account;
+    if (encoded && !encoded->empty()) {
+        auto [account, err]{silkworm::Account::from_encoded_storage(*encoded)};
+        silkworm::rlp::success_or_throw(err); // TODO(canepat) suggest rename as throw_if_error or better throw_if(err != kOk)
+
+        if (account.incarnation > 0 && account.code_hash == silkworm::kEmptyHash) {
+            // Restore code hash
+            const auto storage_key{silkworm::db::storage_prefix(full_view(address), account.incarnation)};
+            auto code_hash{co_await db_reader_.get_one(db::table::kPlainContractCode, storage_key)};
+            if (code_hash.length() == silkworm::kHashLength) {
+                std::memcpy(account.code_hash.bytes, code_hash.data(), silkworm::kHashLength);
+            }
         }
+        optional_account = account;
     }
 
-    co_return account;
+    // Only values found in history are bound to the block, plain state ones may change as the chain grows
+    if (historical && state_cache_) {
+        state_cache_->insert_account(address, block_number, optional_account, latest_view_.view_id);
+    } else if (latest) {
+        latest_view_.cache->insert_account(latest_view_.view_id, block_number, address, optional_account);
+    }
+
+    co_return optional_account;
 }
 
 asio::awaitable<evmc::bytes32> StateReader::read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location_hash,
     uint64_t block_number) const {
-    std::optional<silkworm::Bytes> value{co_await read_historical_storage(address, incarnation, location_hash, block_number)};
+    if (state_cache_) {
+        const auto cached_value{state_cache_->get_storage(address, incarnation, location_hash, block_number)};
+        if (cached_value) {
+            co_return *cached_value;
+        }
+    }
+
+    const bool latest{is_latest(block_number)};
+    if (latest) {
+        const auto cached_value{latest_view_.cache->get_storage(latest_view_.view_id, block_number, address, incarnation, location_hash)};
+        if (cached_value) {
+            co_return *cached_value;
+        }
+    }
+
+    std::optional<silkworm::Bytes> value;
+    if (!latest) {
+        value = co_await read_historical_storage(address, incarnation, location_hash, block_number);
+    }
+    const bool historical{value.has_value()};
     if (!value) {
         auto composite_key{silkrpc::composite_storage_key(address, incarnation, location_hash.bytes)};
         SILKRPC_DEBUG << "StateReader::read_storage composite_key: " << composite_key << "\n";
         value = co_await db_reader_.get_one(db::table::kPlainState, composite_key);
         SILKRPC_DEBUG << "StateReader::read_storage value: " << (value ? *value : silkworm::Bytes{}) << "\n";
     }
-    if (!value) {
-        co_return evmc::bytes32{};
-    }
-
     evmc::bytes32 storage_value{};
-    std::memcpy(storage_value.bytes + silkworm::kHashLength - value->length(), value->data(), value->length());
+    if (value) {
+        std::memcpy(storage_value.bytes + silkworm::kHashLength - value->length(), value->data(), value->length());
+    }
+    if (historical && state_cache_) {
+        state_cache_->insert_storage(address, incarnation, location_hash, block_number, storage_value, latest_view_.view_id);
+    } else if (latest) {
+        latest_view_.cache->insert_storage(latest_view_.view_id, block_number, address, incarnation, location_hash, storage_value);
+    }
     co_return storage_value;
 }
 
@@ -79,6 +128,10 @@ asio::awaitable<std::optional<silkworm::Bytes>> StateReader::read_code(const evm
     co_return code;
 }
 
+bool StateReader::is_latest(uint64_t block_number) const {
+    return latest_view_.cache && latest_view_.cache->is_latest(latest_view_.view_id, block_number);
+}
+
 asio::awaitable<std::optional<silkworm::Bytes>> StateReader::read_historical_account(const evmc::address& address, uint64_t block_number) const {
     const auto account_history_key{silkworm::db::account_history_key(address, block_number)};
     SILKRPC_DEBUG << "StateReader::read_historical_account account_history_key: " << account_history_key << "\n";
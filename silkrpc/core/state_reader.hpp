@@ -26,6 +26,8 @@
 #include <silkworm/common/util.hpp>
 #include <silkworm/types/account.hpp>
 
+#include <silkrpc/common/coherent_state_cache.hpp>
+#include <silkrpc/common/state_cache.hpp>
 #include <silkrpc/common/util.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
 
@@ -33,7 +35,8 @@ namespace silkrpc {
 
 class StateReader {
 public:
-    explicit StateReader(const core::rawdb::DatabaseReader& db_reader) : db_reader_(db_reader) {}
+    explicit StateReader(const core::rawdb::DatabaseReader& db_reader, StateCache* state_cache = nullptr, CoherentStateView latest_view = {})
+        : db_reader_(db_reader), state_cache_(state_cache), latest_view_(latest_view) {}
 
     StateReader(const StateReader&) = delete;
     StateReader& operator=(const StateReader&) = delete;
@@ -51,7 +54,12 @@ public:
         const evmc::bytes32& location_hash, uint64_t block_number) const;
 
 private:
+    //! Check if block_number refers to the head state of the latest view, which has no history and may be cached
+    bool is_latest(uint64_t block_number) const;
+
     const core::rawdb::DatabaseReader& db_reader_;
+    StateCache* state_cache_;
+    CoherentStateView latest_view_;
 };
 
 } // namespace silkrpc
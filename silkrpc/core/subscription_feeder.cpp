@@ -0,0 +1,174 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "subscription_feeder.hpp"
+
+#include <cstring>
+#include <exception>
+#include <vector>
+
+#include <asio/co_spawn.hpp>
+#include <asio/post.hpp>
+#include <asio/redirect_error.hpp>
+#include <asio/use_awaitable.hpp>
+#include <nlohmann/json.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/decode.hpp>
+#include <silkworm/types/block.hpp>
+
+#include <silkrpc/common/log.hpp>
+#include <silkrpc/common/util.hpp>
+#include <silkrpc/core/cached_chain.hpp>
+#include <silkrpc/core/receipts.hpp>
+#include <silkrpc/ethdb/transaction_database.hpp>
+#include <silkrpc/json/types.hpp>
+#include <silkrpc/types/log.hpp>
+
+namespace silkrpc::core {
+
+SubscriptionFeeder::SubscriptionFeeder(asio::io_context& io_context, std::shared_ptr<grpc::Channel> channel, grpc::CompletionQueue* queue,
+    ethdb::Database& database, BlockCache& block_cache, txpool::TransactionPool& tx_pool, SubscriptionHub& hub,
+    txpool::PoolMirror& pool_mirror)
+    : io_context_(io_context), database_(database), block_cache_(block_cache), tx_pool_(tx_pool), hub_(hub), pool_mirror_(pool_mirror),
+      refresh_timer_{io_context},
+      header_client_{io_context, ::remote::ETHBACKEND::NewStub(channel), queue},
+      pending_transactions_client_{io_context, ::txpool::Txpool::NewStub(channel), queue} {}
+
+void SubscriptionFeeder::open() {
+    ::remote::SubscribeRequest header_request;
+    header_request.set_type(::remote::Event::HEADER);
+    header_client_.open(header_request, [&](const ::remote::SubscribeReply& reply) { on_header(reply); });
+
+    pending_transactions_client_.open(::txpool::OnAddRequest{}, [&](const ::txpool::OnAddReply& reply) { on_pending_transactions(reply); }, [&]() {
+        // Transactions announced meanwhile would be missing, so wait for the next refresh to serve the mirror again
+        pool_mirror_.invalidate();
+    });
+
+    closed_ = false;
+    asio::co_spawn(io_context_, refresh_pool_mirror(), [](std::exception_ptr eptr) {
+        if (eptr) {
+            SILKRPC_ERROR << "SubscriptionFeeder::refresh_pool_mirror unexpected exception\n";
+        }
+    });
+}
+
+void SubscriptionFeeder::close() {
+    closed_ = true;
+    asio::post(io_context_, [&]() { refresh_timer_.cancel(); });
+    header_client_.close();
+    pending_transactions_client_.close();
+}
+
+void SubscriptionFeeder::on_header(const ::remote::SubscribeReply& reply) {
+    const bool heads_wanted{hub_.has_subscribers(SubscriptionHub::SubscriptionKind::kNewHeads)};
+    const bool logs_wanted{hub_.has_subscribers(SubscriptionHub::SubscriptionKind::kLogs)};
+    const bool prune_wanted{pool_mirror_.ready()};
+    if (reply.type() != ::remote::Event::HEADER || (!heads_wanted && !logs_wanted && !prune_wanted)) {
+        return;
+    }
+
+    const auto header_rlp{silkworm::bytes_of_string(reply.data())};
+    silkworm::ByteView header_view{header_rlp};
+    silkworm::BlockHeader header;
+    if (silkworm::rlp::decode(header_view, header) != silkworm::DecodingResult::kOk) {
+        SILKRPC_WARN << "SubscriptionFeeder::on_header invalid RLP header: " << silkworm::to_hex(header_rlp) << "\n";
+        return;
+    }
+    const auto hash{silkworm::keccak256(header_rlp)};
+    evmc::bytes32 block_hash;
+    std::memcpy(block_hash.bytes, hash.bytes, silkworm::kHashLength);
+    SILKRPC_DEBUG << "SubscriptionFeeder::on_header number: " << header.number << " hash: " << block_hash << "\n";
+
+    if (heads_wanted) {
+        nlohmann::json header_json = header;
+        header_json["hash"] = block_hash;
+        hub_.publish_header(header_json);
+    }
+    if (logs_wanted || prune_wanted) {
+        asio::co_spawn(io_context_, process_block(block_hash, logs_wanted), [](std::exception_ptr eptr) {
+            if (eptr) {
+                SILKRPC_ERROR << "SubscriptionFeeder::process_block unexpected exception\n";
+            }
+        });
+    }
+}
+
+void SubscriptionFeeder::on_pending_transactions(const ::txpool::OnAddReply& reply) {
+    const bool hashes_wanted{hub_.has_subscribers(SubscriptionHub::SubscriptionKind::kNewPendingTransactions)};
+    const bool mirror_wanted{pool_mirror_.accepts_additions()};
+    if (!hashes_wanted && !mirror_wanted) {
+        return;
+    }
+    for (const auto& rlp_tx : reply.rpltxs()) {
+        const auto rlp_bytes{silkworm::bytes_of_string(rlp_tx)};
+        if (mirror_wanted) {
+            pool_mirror_.add(rlp_bytes);
+        }
+        if (hashes_wanted) {
+            const auto hash{silkworm::keccak256(rlp_bytes)};
+            evmc::bytes32 tx_hash;
+            std::memcpy(tx_hash.bytes, hash.bytes, silkworm::kHashLength);
+            hub_.publish_pending_transaction(tx_hash);
+        }
+    }
+}
+
+asio::awaitable<void> SubscriptionFeeder::process_block(evmc::bytes32 block_hash, bool publish_logs) {
+    auto tx = co_await database_.begin();
+
+    try {
+        ethdb::TransactionDatabase tx_database{*tx};
+
+        const auto block_with_hash = co_await read_block_by_hash(block_cache_, tx_database, block_hash);
+        pool_mirror_.prune(block_with_hash->block.transactions);
+
+        if (publish_logs) {
+            // Receipts are attached to the cached block, so eth_getLogs and receipt queries on the new head find them ready
+            const auto receipts = co_await get_receipts(block_cache_, tx_database, *block_with_hash);
+
+            std::vector<Log> logs;
+            for (const auto& receipt : *receipts) {
+                logs.insert(logs.end(), receipt.logs.begin(), receipt.logs.end());
+            }
+            SILKRPC_DEBUG << "SubscriptionFeeder::process_block block: " << block_with_hash->block.header.number << " #logs: " << logs.size() << "\n";
+            hub_.publish_logs(logs);
+        }
+    } catch (const std::exception& e) {
+        SILKRPC_WARN << "SubscriptionFeeder::process_block cannot read block: " << block_hash << " error: " << e.what() << "\n";
+    }
+
+    co_await tx->close(); // RAII not (yet) available with coroutines
+}
+
+asio::awaitable<void> SubscriptionFeeder::refresh_pool_mirror() {
+    while (!closed_) {
+        try {
+            // The transactions announced while the content is being read are replayed on top of it
+            pool_mirror_.begin_seed();
+            const auto transactions = co_await tx_pool_.get_transactions();
+            pool_mirror_.seed(transactions);
+        } catch (const std::exception& e) {
+            pool_mirror_.abort_seed();
+            SILKRPC_WARN << "SubscriptionFeeder::refresh_pool_mirror cannot read the transaction pool: " << e.what() << "\n";
+        }
+
+        asio::error_code ec;
+        refresh_timer_.expires_after(kTxPoolMirrorRefreshInterval);
+        co_await refresh_timer_.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+}
+
+} // namespace silkrpc::core
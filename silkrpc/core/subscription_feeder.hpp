@@ -0,0 +1,99 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_CORE_SUBSCRIPTION_FEEDER_HPP_
+#define SILKRPC_CORE_SUBSCRIPTION_FEEDER_HPP_
+
+#include <atomic>
+#include <memory>
+
+#include <silkrpc/config.hpp>
+
+#include <asio/awaitable.hpp>
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+#include <evmc/evmc.hpp>
+#include <grpcpp/grpcpp.h>
+
+#include <silkrpc/common/block_cache.hpp>
+#include <silkrpc/common/subscription_hub.hpp>
+#include <silkrpc/ethdb/database.hpp>
+#include <silkrpc/grpc/async_server_streaming_client.hpp>
+#include <silkrpc/interfaces/remote/ethbackend.grpc.pb.h>
+#include <silkrpc/interfaces/txpool/txpool.grpc.pb.h>
+#include <silkrpc/txpool/pool_mirror.hpp>
+#include <silkrpc/txpool/transaction_pool.hpp>
+
+namespace silkrpc::core {
+
+using HeaderEventsClient = AsyncServerStreamingClient<
+    ::remote::ETHBACKEND::StubInterface,
+    ::remote::SubscribeRequest,
+    ::remote::SubscribeReply,
+    &::remote::ETHBACKEND::StubInterface::PrepareAsyncSubscribe
+>;
+
+using PendingTransactionsClient = AsyncServerStreamingClient<
+    ::txpool::Txpool::StubInterface,
+    ::txpool::OnAddRequest,
+    ::txpool::OnAddReply,
+    &::txpool::Txpool::StubInterface::PrepareAsyncOnAdd
+>;
+
+//! Source of the events published to eth_subscribe subscribers through SubscriptionHub and keeping PoolMirror current.
+//! New headers come from the ETHBACKEND Subscribe stream and trigger the publication of the block logs, if anyone is
+//! interested, and the pruning of the included transactions from the pool mirror; new pending transactions come from
+//! the Txpool OnAdd stream. Each event is read once for all consumers. The pool mirror is seeded with the whole remote
+//! pool on open and then periodically, because not all the pool changes are announced.
+class SubscriptionFeeder {
+public:
+    explicit SubscriptionFeeder(asio::io_context& io_context, std::shared_ptr<grpc::Channel> channel, grpc::CompletionQueue* queue,
+        ethdb::Database& database, BlockCache& block_cache, txpool::TransactionPool& tx_pool, SubscriptionHub& hub,
+        txpool::PoolMirror& pool_mirror);
+
+    SubscriptionFeeder(const SubscriptionFeeder&) = delete;
+    SubscriptionFeeder& operator=(const SubscriptionFeeder&) = delete;
+
+    //! Open the event streams, reopening them on failure until closed (must be called on the I/O context thread)
+    void open();
+
+    //! Close the event streams cancelling any pending read (may be called on any thread)
+    void close();
+
+private:
+    void on_header(const ::remote::SubscribeReply& reply);
+
+    void on_pending_transactions(const ::txpool::OnAddReply& reply);
+
+    asio::awaitable<void> process_block(evmc::bytes32 block_hash, bool publish_logs);
+
+    asio::awaitable<void> refresh_pool_mirror();
+
+    asio::io_context& io_context_;
+    ethdb::Database& database_;
+    BlockCache& block_cache_;
+    txpool::TransactionPool& tx_pool_;
+    SubscriptionHub& hub_;
+    txpool::PoolMirror& pool_mirror_;
+    asio::steady_timer refresh_timer_;
+    std::atomic_bool closed_{false};
+    HeaderEventsClient header_client_;
+    PendingTransactionsClient pending_transactions_client_;
+};
+
+} // namespace silkrpc::core
+
+#endif // SILKRPC_CORE_SUBSCRIPTION_FEEDER_HPP_
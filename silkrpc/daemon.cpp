@@ -24,6 +24,8 @@
 #include <boost/process/environment.hpp>
 #include <grpcpp/grpcpp.h>
 
+#include <silkrpc/ethdb/file/local_database.hpp>
+
 namespace silkrpc {
 
 void DaemonChecklist::success_or_throw() const {
@@ -176,6 +178,20 @@ bool Daemon::validate_settings(const DaemonSettings& settings) {
         return false;
     }
 
+    const auto max_batch_in_flight = settings.max_batch_in_flight;
+    if (max_batch_in_flight == 0) {
+        SILKRPC_ERROR << "Parameter max_batch_in_flight is invalid: [" << max_batch_in_flight << "]\n";
+        SILKRPC_ERROR << "Use --max_batch_in_flight flag to specify the max number of concurrent requests within a batch\n";
+        return false;
+    }
+
+    const auto estimate_gas_probes = settings.estimate_gas_probes;
+    if (estimate_gas_probes == 0) {
+        SILKRPC_ERROR << "Parameter estimate_gas_probes is invalid: [" << estimate_gas_probes << "]\n";
+        SILKRPC_ERROR << "Use --estimate_gas_probes flag to specify the number of gas limits executed concurrently by eth_estimateGas\n";
+        return false;
+    }
+
     return true;
 }
 
@@ -185,27 +201,35 @@ ChannelFactory Daemon::make_channel_factory(const DaemonSettings& settings) {
     };
 }
 
+std::shared_ptr<mdbx::env_managed> Daemon::open_chaindata_env(const DaemonSettings& settings) {
+    if (settings.chaindata.empty()) {
+        return {};
+    }
+    SILKRPC_LOG << "Opening chaindata " << settings.chaindata << " in read-only mode\n";
+    return ethdb::file::open_chaindata(settings.chaindata);
+}
+
 Daemon::Daemon(const DaemonSettings& settings)
     : settings_(settings),
       create_channel_{make_channel_factory(settings_)},
-      context_pool_{settings_.num_contexts, create_channel_, settings_.wait_mode},
+      chaindata_env_{open_chaindata_env(settings_)},
+      context_pool_{settings_.num_contexts, create_channel_, settings_.wait_mode, chaindata_env_},
       worker_pool_{settings_.num_workers} {
 }
 
 DaemonChecklist Daemon::run_checklist() {
     const auto core_service_channel{create_channel_()};
 
-    const auto kv_protocol_check{silkrpc::wait_for_kv_protocol_check(core_service_channel)};
-    const auto ethbackend_protocol_check{silkrpc::wait_for_ethbackend_protocol_check(core_service_channel)};
-    const auto mining_protocol_check{silkrpc::wait_for_mining_protocol_check(core_service_channel)};
-    const auto txpool_protocol_check{silkrpc::wait_for_txpool_protocol_check(core_service_channel)};
-
-    DaemonChecklist checklist{{
-        kv_protocol_check,
-        ethbackend_protocol_check,
-        mining_protocol_check,
-        txpool_protocol_check
-    }};
+    DaemonChecklist checklist;
+
+    // KV protocol is not used when reading chaindata locally
+    if (!chaindata_env_) {
+        checklist.protocol_checklist.push_back(silkrpc::wait_for_kv_protocol_check(core_service_channel));
+    }
+    checklist.protocol_checklist.push_back(silkrpc::wait_for_ethbackend_protocol_check(core_service_channel));
+    checklist.protocol_checklist.push_back(silkrpc::wait_for_mining_protocol_check(core_service_channel));
+    checklist.protocol_checklist.push_back(silkrpc::wait_for_txpool_protocol_check(core_service_channel));
+
     return checklist;
 }
 
@@ -213,9 +237,11 @@ void Daemon::start() {
     for (int i = 0; i < settings_.num_contexts; ++i) {
         auto& context = context_pool_.next_context();
         rpc_services_.emplace_back(
-            std::make_unique<http::Server>(settings_.http_port, settings_.api_spec, context, worker_pool_));
+            std::make_unique<http::Server>(settings_.http_port, settings_.api_spec, context, worker_pool_, settings_.max_batch_in_flight,
+                settings_.estimate_gas_probes));
         rpc_services_.emplace_back(
-            std::make_unique<http::Server>(settings_.engine_port, kDefaultEth2ApiSpec, context, worker_pool_));
+            std::make_unique<http::Server>(settings_.engine_port, kDefaultEth2ApiSpec, context, worker_pool_, settings_.max_batch_in_flight,
+                settings_.estimate_gas_probes));
     }
 
     for (auto& service : rpc_services_) {
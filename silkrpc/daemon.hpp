@@ -22,6 +22,7 @@
 #include <vector>
 
 #include <asio/thread_pool.hpp>
+#include <silkworm/db/mdbx.hpp>
 
 #include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
@@ -42,6 +43,8 @@ struct DaemonSettings {
     uint32_t num_workers;
     LogLevel log_verbosity;
     WaitMode wait_mode;
+    uint32_t max_batch_in_flight{kDefaultMaxBatchInFlight};
+    uint32_t estimate_gas_probes{kDefaultEstimateGasProbes};
 };
 
 struct DaemonInfo {
@@ -74,9 +77,11 @@ class Daemon {
   protected:
     static bool validate_settings(const DaemonSettings& settings);
     static ChannelFactory make_channel_factory(const DaemonSettings& settings);
+    static std::shared_ptr<mdbx::env_managed> open_chaindata_env(const DaemonSettings& settings);
 
     const DaemonSettings& settings_;
     ChannelFactory create_channel_;
+    std::shared_ptr<mdbx::env_managed> chaindata_env_;
     ContextPool context_pool_;
     asio::thread_pool worker_pool_;
     std::vector<std::unique_ptr<http::Server>> rpc_services_;
@@ -50,7 +50,7 @@ static Roaring fast_or(size_t n, const std::vector<std::unique_ptr<Roaring>>& in
     return ans;
 }
 
-asio::awaitable<Roaring> get(core::rawdb::DatabaseReader& db_reader, const std::string& table, silkworm::Bytes& key, uint32_t from_block, uint32_t to_block) {
+asio::awaitable<Roaring> get(core::rawdb::DatabaseReader& db_reader, const std::string& table, const silkworm::Bytes& key, uint32_t from_block, uint32_t to_block) {
     std::vector<std::unique_ptr<Roaring>> chuncks;
 
     silkworm::Bytes from_key{key.begin(), key.end()};
@@ -74,4 +74,39 @@ asio::awaitable<Roaring> get(core::rawdb::DatabaseReader& db_reader, const std::
     co_return result;
 }
 
+asio::awaitable<std::vector<Roaring>> get_batch(core::rawdb::DatabaseReader& db_reader, const std::string& table,
+    const std::vector<silkworm::Bytes>& keys, uint32_t from_block, uint32_t to_block) {
+    // Seek the first chunk of every key at once, the lookups share the reader so they can be pipelined in one round trip
+    std::vector<silkworm::Bytes> from_keys;
+    from_keys.reserve(keys.size());
+    std::vector<TableKey> table_keys;
+    table_keys.reserve(keys.size());
+    for (const auto& key : keys) {
+        auto& from_key = from_keys.emplace_back(key);
+        from_key.resize(key.size() + sizeof(uint32_t));
+        boost::endian::store_big_u32(&from_key[key.size()], from_block);
+        table_keys.push_back(TableKey{table, from_key});
+    }
+    const auto kv_pairs = co_await db_reader.get_batch(table_keys);
+
+    std::vector<Roaring> bitmaps(keys.size());
+    for (std::size_t i{0}; i < keys.size(); ++i) {
+        const auto& key = keys[i];
+        const auto& kv_pair = kv_pairs[i];
+        if (kv_pair.key.size() != key.size() + sizeof(uint32_t) || kv_pair.key.compare(0, key.size(), key) != 0) {
+            SILKRPC_DEBUG << "table: " << table << " key: " << key << " no chunk from block: " << from_block << "\n";
+            continue;
+        }
+        bitmaps[i] = Roaring::readSafe(reinterpret_cast<const char*>(kv_pair.value.data()), kv_pair.value.size());
+
+        // Only when the first chunk ends before the range does the key need its own walk over the following chunks
+        const auto block = boost::endian::load_big_u32(&kv_pair.key[key.size()]);
+        if (block < to_block) {
+            bitmaps[i] |= co_await get(db_reader, table, key, block + 1, to_block);
+        }
+        SILKRPC_TRACE << "key: " << key << " bitmap: " << bitmaps[i].toString() << "\n";
+    }
+    co_return bitmaps;
+}
+
 } // namespace silkrpc::ethdb::bitmap
@@ -18,6 +18,7 @@
 #define SILKRPC_ETHDB_BITMAP_HPP_
 
 #include <string>
+#include <vector>
 
 #include <silkrpc/config.hpp>
 
@@ -29,7 +30,10 @@
 
 namespace silkrpc::ethdb::bitmap {
 
-asio::awaitable<roaring::Roaring> get(core::rawdb::DatabaseReader& db_reader, const std::string& table, silkworm::Bytes& key, uint32_t from_block, uint32_t to_block);
+asio::awaitable<roaring::Roaring> get(core::rawdb::DatabaseReader& db_reader, const std::string& table, const silkworm::Bytes& key, uint32_t from_block, uint32_t to_block);
+
+asio::awaitable<std::vector<roaring::Roaring>> get_batch(core::rawdb::DatabaseReader& db_reader, const std::string& table,
+    const std::vector<silkworm::Bytes>& keys, uint32_t from_block, uint32_t to_block);
 
 } // silkrpc::ethdb::bitmap
 
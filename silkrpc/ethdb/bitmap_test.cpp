@@ -16,6 +16,17 @@
 
 #include "bitmap.hpp"
 
+#include <climits>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <asio/co_spawn.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/use_future.hpp>
+#include <boost/endian/conversion.hpp>
 #include <catch2/catch.hpp>
 
 namespace silkrpc {
@@ -24,3 +35,134 @@ using Catch::Matchers::Message;
 
 } // namespace silkrpc
 
+namespace silkrpc::ethdb::bitmap {
+
+//! In-memory single-table DatabaseReader with the seek semantics of TransactionDatabase
+class SortedDatabaseReader : public core::rawdb::DatabaseReader {
+public:
+    void put_chunk(const silkworm::Bytes& key, uint32_t block, const roaring::Roaring& chunk) {
+        silkworm::Bytes chunk_key{key};
+        chunk_key.resize(key.size() + sizeof(uint32_t));
+        boost::endian::store_big_u32(&chunk_key[key.size()], block);
+        silkworm::Bytes value(chunk.getSizeInBytes(), '\0');
+        chunk.write(reinterpret_cast<char*>(value.data()));
+        data_[chunk_key] = value;
+    }
+
+    asio::awaitable<KeyValue> get(const std::string& /*table*/, const silkworm::ByteView& key) const override {
+        ++gets;
+        const auto it = data_.lower_bound(silkworm::Bytes{key});
+        co_return it == data_.end() ? KeyValue{} : KeyValue{it->first, it->second};
+    }
+    asio::awaitable<silkworm::Bytes> get_one(const std::string& /*table*/, const silkworm::ByteView& /*key*/) const override {
+        co_return silkworm::Bytes{};
+    }
+    asio::awaitable<std::optional<silkworm::Bytes>> get_both_range(const std::string& /*table*/, const silkworm::ByteView& /*key*/,
+        const silkworm::ByteView& /*subkey*/) const override {
+        co_return std::nullopt;
+    }
+    asio::awaitable<void> walk(const std::string& /*table*/, const silkworm::ByteView& start_key, uint32_t fixed_bits, core::rawdb::Walker w) const override {
+        ++walks;
+        const auto fixed_bytes{fixed_bits / CHAR_BIT};
+        for (auto it = data_.lower_bound(silkworm::Bytes{start_key}); it != data_.end(); ++it) {
+            if (it->first.compare(0, fixed_bytes, start_key.substr(0, fixed_bytes)) != 0) {
+                break;
+            }
+            silkworm::Bytes k{it->first}, v{it->second};
+            if (!w(k, v)) {
+                break;
+            }
+        }
+        co_return;
+    }
+    asio::awaitable<void> for_prefix(const std::string& /*table*/, const silkworm::ByteView& /*prefix*/, core::rawdb::Walker /*w*/) const override {
+        co_return;
+    }
+
+    mutable std::size_t gets{0};
+    mutable std::size_t walks{0};
+
+private:
+    std::map<silkworm::Bytes, silkworm::Bytes> data_;
+};
+
+TEST_CASE("get_batch", "[silkrpc][ethdb][bitmap]") {
+    asio::thread_pool pool{1};
+    SortedDatabaseReader db_reader;
+    const std::string table{"LogAddressIndex"};
+    const silkworm::Bytes key1{*silkworm::from_hex("0x01")};
+    const silkworm::Bytes key2{*silkworm::from_hex("0x02")};
+    const silkworm::Bytes key3{*silkworm::from_hex("0x03")};
+
+    // key1 is split into three chunks, key2 fits into its last chunk, key3 has no chunk at all
+    db_reader.put_chunk(key1, 15, roaring::Roaring::bitmapOf(3, 5, 10, 15));
+    db_reader.put_chunk(key1, 30, roaring::Roaring::bitmapOf(2, 20, 30));
+    db_reader.put_chunk(key1, UINT32_MAX, roaring::Roaring::bitmapOf(1, 40));
+    db_reader.put_chunk(key2, UINT32_MAX, roaring::Roaring::bitmapOf(2, 12, 25));
+    db_reader.put_chunk(*silkworm::from_hex("0x0400"), UINT32_MAX, roaring::Roaring::bitmapOf(1, 7));
+
+    SECTION("no keys") {
+        const std::vector<silkworm::Bytes> keys;
+        auto result = asio::co_spawn(pool, get_batch(db_reader, table, keys, 0, 100), asio::use_future);
+        CHECK(result.get().empty());
+    }
+
+    SECTION("range within first chunk needs no walk") {
+        const std::vector<silkworm::Bytes> keys{key1};
+        auto result = asio::co_spawn(pool, get_batch(db_reader, table, keys, 0, 10), asio::use_future);
+        const auto bitmaps = result.get();
+        CHECK(bitmaps.size() == 1);
+        CHECK(bitmaps[0] == roaring::Roaring::bitmapOf(3, 5, 10, 15));
+        CHECK(db_reader.walks == 0);
+    }
+
+    SECTION("range split across chunks is merged") {
+        const std::vector<silkworm::Bytes> keys{key1};
+        auto result = asio::co_spawn(pool, get_batch(db_reader, table, keys, 12, 25), asio::use_future);
+        const auto bitmaps = result.get();
+        CHECK(bitmaps.size() == 1);
+        CHECK(bitmaps[0] == roaring::Roaring::bitmapOf(5, 5, 10, 15, 20, 30));
+        CHECK(db_reader.walks == 1);
+    }
+
+    SECTION("range over all chunks is merged") {
+        const std::vector<silkworm::Bytes> keys{key1};
+        auto result = asio::co_spawn(pool, get_batch(db_reader, table, keys, 0, 1'000), asio::use_future);
+        const auto bitmaps = result.get();
+        CHECK(bitmaps.size() == 1);
+        CHECK(bitmaps[0] == roaring::Roaring::bitmapOf(6, 5, 10, 15, 20, 30, 40));
+    }
+
+    SECTION("range starting at later chunk skips earlier ones") {
+        const std::vector<silkworm::Bytes> keys{key1};
+        auto result = asio::co_spawn(pool, get_batch(db_reader, table, keys, 31, 1'000), asio::use_future);
+        const auto bitmaps = result.get();
+        CHECK(bitmaps.size() == 1);
+        CHECK(bitmaps[0] == roaring::Roaring::bitmapOf(1, 40));
+    }
+
+    SECTION("bitmaps follow key order") {
+        const std::vector<silkworm::Bytes> keys{key3, key2, key1};
+        auto result = asio::co_spawn(pool, get_batch(db_reader, table, keys, 12, 25), asio::use_future);
+        const auto bitmaps = result.get();
+        CHECK(bitmaps.size() == 3);
+        CHECK(bitmaps[0].isEmpty());
+        CHECK(bitmaps[1] == roaring::Roaring::bitmapOf(2, 12, 25));
+        CHECK(bitmaps[2] == roaring::Roaring::bitmapOf(5, 5, 10, 15, 20, 30));
+        CHECK(db_reader.gets == 3);
+        CHECK(db_reader.walks == 1);
+    }
+
+    SECTION("same as sequential lookups") {
+        const std::vector<silkworm::Bytes> keys{key1, key2, key3};
+        auto batch_result = asio::co_spawn(pool, get_batch(db_reader, table, keys, 12, 25), asio::use_future);
+        const auto bitmaps = batch_result.get();
+        for (const auto& [i, key] : std::vector<std::pair<std::size_t, silkworm::Bytes>>{{0, key1}, {1, key2}}) {
+            auto result = asio::co_spawn(pool, get(db_reader, table, key, 12, 25), asio::use_future);
+            CHECK(bitmaps[i] == result.get());
+        }
+    }
+}
+
+} // namespace silkrpc::ethdb::bitmap
+
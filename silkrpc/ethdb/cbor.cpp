@@ -16,41 +16,243 @@
 
 #include "cbor.hpp"
 
-#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <system_error>
+
+#include <silkworm/common/util.hpp>
 
 #include <silkrpc/common/log.hpp>
-#include <silkrpc/json/types.hpp>
 
 namespace silkrpc {
 
-bool cbor_decode(const silkworm::Bytes& bytes, std::vector<Log>& logs) {
-    if (bytes.size() == 0) {
-        return false;
+namespace {
+
+// CBOR major types (RFC 8949 section 3.1)
+constexpr uint8_t kUnsignedInteger{0};
+constexpr uint8_t kNegativeInteger{1};
+constexpr uint8_t kByteString{2};
+constexpr uint8_t kTextString{3};
+constexpr uint8_t kArray{4};
+constexpr uint8_t kMap{5};
+constexpr uint8_t kTag{6};
+constexpr uint8_t kSimpleOrFloat{7};
+
+constexpr uint8_t kNull{0xf6};
+constexpr uint8_t kIndefiniteLength{31};
+
+[[noreturn]] void throw_invalid_argument(const char* message) {
+    throw std::system_error{std::make_error_code(std::errc::invalid_argument), message};
+}
+
+//! Streaming reader for the definite-length CBOR subset written by Erigon for logs and receipts: items are decoded
+//! in place from the input buffer, so no intermediate document is ever built.
+class CborReader {
+  public:
+    explicit CborReader(silkworm::ByteView data) : data_{data} {}
+
+    [[nodiscard]] bool at_end() const { return position_ == data_.size(); }
+
+    [[nodiscard]] uint8_t peek_major_type() const { return peek() >> 5; }
+
+    [[nodiscard]] bool peek_null() const { return peek() == kNull; }
+
+    void read_null() {
+        if (peek() != kNull) {
+            throw_invalid_argument("CBOR: null expected");
+        }
+        ++position_;
+    }
+
+    uint64_t read_unsigned() { return read_head(kUnsignedInteger); }
+
+    std::size_t read_array_size() { return read_length(kArray); }
+
+    silkworm::ByteView read_byte_string() {
+        return read_raw(read_length(kByteString));
+    }
+
+    //! Skip the next data item whatever its type, recursing into containers
+    void skip() {
+        const auto major_type = peek_major_type();
+        switch (major_type) {
+            case kUnsignedInteger:
+            case kNegativeInteger:
+                read_head(major_type);
+                break;
+            case kByteString:
+            case kTextString:
+                read_raw(read_length(major_type));
+                break;
+            case kArray:
+                for (auto n = read_length(major_type); n > 0; --n) {
+                    skip();
+                }
+                break;
+            case kMap:
+                for (auto n = read_length(major_type); n > 0; --n) {
+                    skip();
+                    skip();
+                }
+                break;
+            case kTag:
+                read_head(major_type);
+                skip();
+                break;
+            default:
+                read_head(kSimpleOrFloat);
+                break;
+        }
+    }
+
+  private:
+    [[nodiscard]] uint8_t peek() const {
+        if (position_ >= data_.size()) {
+            throw_invalid_argument("CBOR: unexpected end of input");
+        }
+        return data_[position_];
+    }
+
+    silkworm::ByteView read_raw(uint64_t length) {
+        if (length > data_.size() - position_) {
+            throw_invalid_argument("CBOR: unexpected end of input");
+        }
+        const auto bytes = data_.substr(position_, length);
+        position_ += length;
+        return bytes;
+    }
+
+    //! Read the initial byte plus the following argument bytes, checking the expected major type
+    uint64_t read_head(uint8_t major_type) {
+        const uint8_t initial_byte = peek();
+        if (initial_byte >> 5 != major_type) {
+            throw_invalid_argument("CBOR: unexpected major type");
+        }
+        ++position_;
+        const uint8_t additional_info = initial_byte & 0x1f;
+        if (additional_info < 24) {
+            return additional_info;
+        }
+        if (additional_info > 27) {
+            throw_invalid_argument(additional_info == kIndefiniteLength ?
+                "CBOR: indefinite length not supported" : "CBOR: invalid additional information");
+        }
+        const auto argument = read_raw(std::size_t{1} << (additional_info - 24));
+        uint64_t value{0};
+        for (const auto b : argument) {
+            value = (value << 8) | b;
+        }
+        return value;
+    }
+
+    std::size_t read_length(uint8_t major_type) {
+        const auto length = read_head(major_type);
+        // Every item takes at least one byte, so any length beyond the input size is surely malformed
+        if (length > data_.size() - position_) {
+            throw_invalid_argument("CBOR: unexpected end of input");
+        }
+        return static_cast<std::size_t>(length);
     }
-    auto json = nlohmann::json::from_cbor(bytes);
-    SILKRPC_TRACE << "cbor_decode<std::vector<Log>> json: " << json.dump() << "\n";
-    if (json.is_array()) {
-        logs = json.get<std::vector<Log>>();
-        return true;
+
+    silkworm::ByteView data_;
+    std::size_t position_{0};
+};
+
+void decode_log(CborReader& reader, Log& log) {
+    if (reader.peek_major_type() != kArray) {
+        throw_invalid_argument("Log CBOR: array expected");
+    }
+    const auto size = reader.read_array_size();
+    if (size < 3) {
+        throw_invalid_argument("Log CBOR: missing entries");
+    }
+    if (reader.peek_major_type() != kByteString) {
+        throw_invalid_argument("Log CBOR: binary expected in [0]");
+    }
+    log.address = silkworm::to_evmc_address(reader.read_byte_string());
+    if (reader.peek_major_type() != kArray) {
+        throw_invalid_argument("Log CBOR: array expected in [1]");
+    }
+    const auto num_topics = reader.read_array_size();
+    log.topics.clear();
+    log.topics.reserve(num_topics);
+    for (std::size_t i{0}; i < num_topics; ++i) {
+        if (reader.peek_major_type() != kByteString) {
+            throw_invalid_argument("Log CBOR: binary expected in topics");
+        }
+        log.topics.push_back(silkworm::to_bytes32(reader.read_byte_string()));
+    }
+    if (reader.peek_major_type() == kByteString) {
+        log.data = reader.read_byte_string();
+    } else if (reader.peek_null()) {
+        reader.read_null();
+        log.data.clear();
     } else {
-        SILKRPC_ERROR << "cbor_decode<std::vector<Log>> unexpected json: " << json.dump() << "\n";
-        return false;
+        throw_invalid_argument("Log CBOR: binary or null expected in [2]");
+    }
+    for (std::size_t i{3}; i < size; ++i) {
+        reader.skip();
+    }
+}
+
+void decode_receipt(CborReader& reader, Receipt& receipt) {
+    if (reader.peek_major_type() != kArray) {
+        throw_invalid_argument("Receipt CBOR: array expected");
+    }
+    const auto size = reader.read_array_size();
+    if (size < 4) {
+        throw_invalid_argument("Receipt CBOR: missing entries");
+    }
+    if (reader.peek_major_type() != kUnsignedInteger) {
+        throw_invalid_argument("Receipt CBOR: number expected in [0]");
+    }
+    receipt.type = static_cast<uint8_t>(reader.read_unsigned());
+    if (!reader.peek_null()) {
+        throw_invalid_argument("Receipt CBOR: null expected in [1]");
+    }
+    reader.read_null();
+    if (reader.peek_major_type() != kUnsignedInteger) {
+        throw_invalid_argument("Receipt CBOR: number expected in [2]");
+    }
+    receipt.success = reader.read_unsigned() == 1u;
+    if (reader.peek_major_type() != kUnsignedInteger) {
+        throw_invalid_argument("Receipt CBOR: number expected in [3]");
+    }
+    receipt.cumulative_gas_used = reader.read_unsigned();
+    for (std::size_t i{4}; i < size; ++i) {
+        reader.skip();
     }
 }
 
-bool cbor_decode(const silkworm::Bytes& bytes, std::vector<Receipt>& receipts) {
+template <typename T, typename Decoder>
+bool cbor_decode_array(silkworm::ByteView bytes, std::vector<T>& items, Decoder decode_item, const char* type_name) {
     if (bytes.size() == 0) {
         return false;
     }
-    auto json = nlohmann::json::from_cbor(bytes);
-    SILKRPC_TRACE << "cbor_decode<std::vector<Receipt>> json: " << json.dump() << "\n";
-    if (json.is_array()) {
-        receipts = json.get<std::vector<Receipt>>();
-        return true;
-    } else {
-        SILKRPC_ERROR << "cbor_decode<std::vector<Receipt>> unexpected json: " << json.dump() << "\n";
+    CborReader reader{bytes};
+    if (reader.peek_major_type() != kArray) {
+        SILKRPC_ERROR << "cbor_decode<std::vector<" << type_name << ">> unexpected CBOR: " << silkworm::to_hex(bytes) << "\n";
         return false;
     }
+    const auto size = reader.read_array_size();
+    items.clear();
+    items.resize(size);
+    for (auto& item : items) {
+        decode_item(reader, item);
+    }
+    if (!reader.at_end()) {
+        throw_invalid_argument("CBOR: unexpected trailing bytes");
+    }
+    return true;
+}
+
+} // namespace
+
+bool cbor_decode(silkworm::ByteView bytes, std::vector<Log>& logs) {
+    return cbor_decode_array(bytes, logs, decode_log, "Log");
+}
+
+bool cbor_decode(silkworm::ByteView bytes, std::vector<Receipt>& receipts) {
+    return cbor_decode_array(bytes, receipts, decode_receipt, "Receipt");
 }
 
 } // namespace silkrpc
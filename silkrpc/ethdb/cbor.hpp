@@ -26,9 +26,11 @@
 
 namespace silkrpc {
 
-[[nodiscard]] bool cbor_decode(const silkworm::Bytes& bytes, std::vector<Log>& logs);
+//! Decode the Erigon CBOR encoding of logs, i.e. array of [address, [topics...], data]
+[[nodiscard]] bool cbor_decode(silkworm::ByteView bytes, std::vector<Log>& logs);
 
-[[nodiscard]] bool cbor_decode(const silkworm::Bytes& bytes, std::vector<Receipt>& receipts);
+//! Decode the Erigon CBOR encoding of receipts, i.e. array of [type, null, status, cumulative_gas_used]
+[[nodiscard]] bool cbor_decode(silkworm::ByteView bytes, std::vector<Receipt>& receipts);
 
 } // namespace silkrpc
 
@@ -101,6 +101,32 @@ TEST_CASE("decode logs from incorrect bytes", "[silkrpc][ethdb][cbor]") {
     CHECK_THROWS(cbor_decode(b1, logs));
     const auto b2 = *silkworm::from_hex("83808040");
     CHECK_THROWS_MATCHES(cbor_decode(b2, logs), std::system_error, Message("Log CBOR: missing entries: Invalid argument"));
+    const auto b3 = *silkworm::from_hex("818354000000000000000000000000000000000000000080f6ff");
+    CHECK_THROWS_MATCHES(cbor_decode(b3, logs), std::system_error, Message("CBOR: unexpected trailing bytes: Invalid argument"));
+    const auto b4 = *silkworm::from_hex("9fff");
+    CHECK_THROWS_MATCHES(cbor_decode(b4, logs), std::system_error, Message("CBOR: indefinite length not supported: Invalid argument"));
+    const auto b5 = *silkworm::from_hex("81835400000000000000000000000000000000000000008001");
+    CHECK_THROWS_MATCHES(cbor_decode(b5, logs), std::system_error, Message("Log CBOR: binary or null expected in [2]: Invalid argument"));
+    const auto b6 = *silkworm::from_hex("8183540000000000000000000000000000000000000000805910");
+    CHECK_THROWS_MATCHES(cbor_decode(b6, logs), std::system_error, Message("CBOR: unexpected end of input: Invalid argument"));
+}
+
+TEST_CASE("decode logs from non-array CBOR", "[silkrpc][ethdb][cbor]") {
+    Logs logs{};
+    CHECK(!cbor_decode(*silkworm::from_hex("a0"), logs));
+    CHECK(!cbor_decode(*silkworm::from_hex("00"), logs));
+}
+
+TEST_CASE("decode logs skipping extra entries", "[silkrpc][ethdb][cbor]") {
+    Logs logs{};
+    CHECK(cbor_decode(*silkworm::from_hex(
+        "82"
+        "8654ea674fdde714fd979de3edf0f56aa9716b898ec8804301004382f56161a1011b0000000100000000f6"
+        "83540715a7794a1dc8e42615f059dd6e406a6594651a80f6"), logs));
+    CHECK(logs.size() == 2);
+    CHECK(logs[0].address == 0xea674fdde714fd979de3edf0f56aa9716b898ec8_address);
+    CHECK(silkworm::to_hex(logs[0].data) == "010043");
+    CHECK(logs[1].address == 0x0715a7794a1dc8e42615f059dd6e406a6594651a_address);
 }
 
 TEST_CASE("decode receipts from empty bytes", "[silkrpc][ethdb][cbor]") {
@@ -158,6 +184,19 @@ TEST_CASE("decode receipts from incorrect bytes", "[silkrpc][ethdb][cbor]") {
     CHECK_THROWS(cbor_decode(b1, receipts));
     const auto b2 = *silkworm::from_hex("83808040");
     CHECK_THROWS_MATCHES(cbor_decode(b2, receipts), std::system_error, Message("Receipt CBOR: missing entries: Invalid argument"));
+    const auto b3 = *silkworm::from_hex("818420f60101");
+    CHECK_THROWS_MATCHES(cbor_decode(b3, receipts), std::system_error, Message("Receipt CBOR: number expected in [0]: Invalid argument"));
+    const auto b4 = *silkworm::from_hex("818400000101");
+    CHECK_THROWS_MATCHES(cbor_decode(b4, receipts), std::system_error, Message("Receipt CBOR: null expected in [1]: Invalid argument"));
+}
+
+TEST_CASE("decode receipts with large cumulative gas", "[silkrpc][ethdb][cbor]") {
+    Receipts receipts{};
+    CHECK(cbor_decode(*silkworm::from_hex("818402f6001b0000000100000000"), receipts));
+    CHECK(receipts.size() == 1);
+    CHECK(receipts[0].type == 2);
+    CHECK(receipts[0].success == false);
+    CHECK(receipts[0].cumulative_gas_used == 0x100000000);
 }
 
 } // namespace silkrpc
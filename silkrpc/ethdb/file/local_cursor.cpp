@@ -0,0 +1,94 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "local_cursor.hpp"
+
+#include <silkrpc/common/clock_time.hpp>
+#include <silkrpc/common/log.hpp>
+
+namespace silkrpc::ethdb::file {
+
+asio::awaitable<void> LocalCursor::open_cursor(const std::string& table_name) {
+    const auto start_time = clock_time::now();
+    SILKRPC_DEBUG << "LocalCursor::open_cursor opening new cursor for table: " << table_name << "\n";
+    // Open the table using its existing flags (e.g. DupSort) because the database is owned by Erigon
+    MDBX_dbi dbi{0};
+    mdbx::error::success_or_throw(::mdbx_dbi_open(txn_, table_name.c_str(), MDBX_DB_ACCEDE, &dbi));
+    db_cursor_ = txn_.open_cursor(mdbx::map_handle{dbi});
+    SILKRPC_DEBUG << "LocalCursor::open_cursor [" << table_name << "] c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return;
+}
+
+asio::awaitable<KeyValue> LocalCursor::seek(silkworm::ByteView key) {
+    const auto start_time = clock_time::now();
+    SILKRPC_DEBUG << "LocalCursor::seek cursor: " << cursor_id_ << " key: " << key << "\n";
+    const auto result = key.empty() ? db_cursor_.to_first(/*throw_notfound=*/false)
+                                    : db_cursor_.lower_bound(silkworm::db::to_slice(key), /*throw_notfound=*/false);
+    const auto kv_pair = to_key_value(result);
+    SILKRPC_DEBUG << "LocalCursor::seek k: " << kv_pair.key << " v: " << kv_pair.value << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return kv_pair;
+}
+
+asio::awaitable<KeyValue> LocalCursor::seek_exact(silkworm::ByteView key) {
+    const auto start_time = clock_time::now();
+    SILKRPC_DEBUG << "LocalCursor::seek_exact cursor: " << cursor_id_ << " key: " << key << "\n";
+    const auto result = db_cursor_.find(silkworm::db::to_slice(key), /*throw_notfound=*/false);
+    const auto kv_pair = to_key_value(result);
+    SILKRPC_DEBUG << "LocalCursor::seek_exact k: " << kv_pair.key << " v: " << kv_pair.value << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return kv_pair;
+}
+
+asio::awaitable<KeyValue> LocalCursor::next() {
+    const auto start_time = clock_time::now();
+    const auto result = db_cursor_.to_next(/*throw_notfound=*/false);
+    const auto kv_pair = to_key_value(result);
+    SILKRPC_DEBUG << "LocalCursor::next k: " << kv_pair.key << " v: " << kv_pair.value << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return kv_pair;
+}
+
+asio::awaitable<silkworm::Bytes> LocalCursor::seek_both(silkworm::ByteView key, silkworm::ByteView value) {
+    const auto start_time = clock_time::now();
+    SILKRPC_DEBUG << "LocalCursor::seek_both cursor: " << cursor_id_ << " key: " << key << " subkey: " << value << "\n";
+    const auto result = db_cursor_.lower_bound_multivalue(silkworm::db::to_slice(key), silkworm::db::to_slice(value), /*throw_notfound=*/false);
+    const auto kv_pair = to_key_value(result);
+    SILKRPC_DEBUG << "LocalCursor::seek_both k: " << kv_pair.key << " v: " << kv_pair.value << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return kv_pair.value;
+}
+
+asio::awaitable<KeyValue> LocalCursor::seek_both_exact(silkworm::ByteView key, silkworm::ByteView value) {
+    const auto start_time = clock_time::now();
+    SILKRPC_DEBUG << "LocalCursor::seek_both_exact cursor: " << cursor_id_ << " key: " << key << " subkey: " << value << "\n";
+    const auto result = db_cursor_.find_multivalue(silkworm::db::to_slice(key), silkworm::db::to_slice(value), /*throw_notfound=*/false);
+    const auto kv_pair = to_key_value(result);
+    SILKRPC_DEBUG << "LocalCursor::seek_both_exact k: " << kv_pair.key << " v: " << kv_pair.value << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return kv_pair;
+}
+
+asio::awaitable<void> LocalCursor::close_cursor() {
+    SILKRPC_DEBUG << "LocalCursor::close_cursor c=" << cursor_id_ << "\n";
+    db_cursor_.close();
+    co_return;
+}
+
+KeyValue LocalCursor::to_key_value(const mdbx::cursor::move_result& result) {
+    // Same convention as the remote KV interface: end-of-table or key-not-found as empty key/value pair
+    if (!result.done) {
+        return KeyValue{};
+    }
+    return KeyValue{silkworm::Bytes{silkworm::db::from_slice(result.key)}, silkworm::Bytes{silkworm::db::from_slice(result.value)}};
+}
+
+} // namespace silkrpc::ethdb::file
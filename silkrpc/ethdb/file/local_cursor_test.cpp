@@ -0,0 +1,140 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "local_cursor.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <asio/co_spawn.hpp>
+#include <asio/io_context.hpp>
+#include <asio/use_future.hpp>
+#include <catch2/catch.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+namespace silkrpc::ethdb::file {
+
+using Catch::Matchers::Message;
+using silkworm::operator""_hex;
+
+class TestChaindata {
+public:
+    TestChaindata() : path_{std::filesystem::temp_directory_path() / ("silkrpc_local_cursor_test_" + std::to_string(reinterpret_cast<uintptr_t>(this)))} {
+        std::filesystem::create_directories(path_);
+        env_ = silkworm::db::open_env(silkworm::db::EnvConfig{.path = path_.string(), .create = true});
+        auto txn = env_.start_write();
+        auto table = silkworm::db::open_map(txn, {"Plain", mdbx::key_mode::usual, mdbx::value_mode::single});
+        txn.upsert(table, silkworm::db::to_slice(*silkworm::from_hex("0x01")), silkworm::db::to_slice(*silkworm::from_hex("0xaa")));
+        txn.upsert(table, silkworm::db::to_slice(*silkworm::from_hex("0x03")), silkworm::db::to_slice(*silkworm::from_hex("0xcc")));
+        auto dup_table = silkworm::db::open_map(txn, {"DupSort", mdbx::key_mode::usual, mdbx::value_mode::multi});
+        txn.upsert(dup_table, silkworm::db::to_slice(*silkworm::from_hex("0x01")), silkworm::db::to_slice(*silkworm::from_hex("0x0011")));
+        txn.upsert(dup_table, silkworm::db::to_slice(*silkworm::from_hex("0x01")), silkworm::db::to_slice(*silkworm::from_hex("0x0322")));
+        txn.commit();
+    }
+
+    ~TestChaindata() {
+        env_.close();
+        std::filesystem::remove_all(path_);
+    }
+
+    mdbx::env_managed& env() { return env_; }
+
+private:
+    std::filesystem::path path_;
+    mdbx::env_managed env_;
+};
+
+TEST_CASE("LocalCursor", "[silkrpc][ethdb][file][local_cursor]") {
+    TestChaindata chaindata;
+    auto txn = chaindata.env().start_read();
+    asio::io_context io_context;
+
+    SECTION("seek") {
+        LocalCursor cursor{txn, 1};
+        CHECK(cursor.cursor_id() == 1);
+        asio::co_spawn(io_context, cursor.open_cursor("Plain"), asio::use_future);
+        io_context.run();
+        io_context.restart();
+        auto result{asio::co_spawn(io_context, cursor.seek(*silkworm::from_hex("0x02")), asio::use_future)};
+        io_context.run();
+        const auto kv = result.get();
+        CHECK(kv.key == *silkworm::from_hex("0x03"));
+        CHECK(kv.value == *silkworm::from_hex("0xcc"));
+    }
+
+    SECTION("seek_exact not found") {
+        LocalCursor cursor{txn, 1};
+        asio::co_spawn(io_context, cursor.open_cursor("Plain"), asio::use_future);
+        io_context.run();
+        io_context.restart();
+        auto result{asio::co_spawn(io_context, cursor.seek_exact(*silkworm::from_hex("0x02")), asio::use_future)};
+        io_context.run();
+        const auto kv = result.get();
+        CHECK(kv.key.empty());
+        CHECK(kv.value.empty());
+    }
+
+    SECTION("next until end") {
+        LocalCursor cursor{txn, 1};
+        asio::co_spawn(io_context, cursor.open_cursor("Plain"), asio::use_future);
+        io_context.run();
+        io_context.restart();
+        auto result1{asio::co_spawn(io_context, cursor.seek(silkworm::ByteView{}), asio::use_future)};
+        io_context.run();
+        io_context.restart();
+        CHECK(result1.get().key == *silkworm::from_hex("0x01"));
+        auto result2{asio::co_spawn(io_context, cursor.next(), asio::use_future)};
+        io_context.run();
+        io_context.restart();
+        CHECK(result2.get().key == *silkworm::from_hex("0x03"));
+        auto result3{asio::co_spawn(io_context, cursor.next(), asio::use_future)};
+        io_context.run();
+        CHECK(result3.get().key.empty());
+    }
+
+    SECTION("seek_both on dup-sorted table") {
+        LocalCursor cursor{txn, 1};
+        asio::co_spawn(io_context, cursor.open_cursor("DupSort"), asio::use_future);
+        io_context.run();
+        io_context.restart();
+        auto result{asio::co_spawn(io_context, cursor.seek_both(*silkworm::from_hex("0x01"), *silkworm::from_hex("0x02")), asio::use_future)};
+        io_context.run();
+        CHECK(result.get() == *silkworm::from_hex("0x0322"));
+    }
+
+    SECTION("seek_both_exact on dup-sorted table") {
+        LocalCursor cursor{txn, 1};
+        asio::co_spawn(io_context, cursor.open_cursor("DupSort"), asio::use_future);
+        io_context.run();
+        io_context.restart();
+        auto result{asio::co_spawn(io_context, cursor.seek_both_exact(*silkworm::from_hex("0x01"), *silkworm::from_hex("0x0011")), asio::use_future)};
+        io_context.run();
+        const auto kv = result.get();
+        CHECK(kv.key == *silkworm::from_hex("0x01"));
+        CHECK(kv.value == *silkworm::from_hex("0x0011"));
+    }
+
+    SECTION("open_cursor unknown table") {
+        LocalCursor cursor{txn, 1};
+        auto result{asio::co_spawn(io_context, cursor.open_cursor("Unknown"), asio::use_future)};
+        io_context.run();
+        CHECK_THROWS(result.get());
+    }
+}
+
+} // namespace silkrpc::ethdb::file
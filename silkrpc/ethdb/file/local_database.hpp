@@ -0,0 +1,59 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_ETHDB_FILE_LOCAL_DATABASE_HPP_
+#define SILKRPC_ETHDB_FILE_LOCAL_DATABASE_HPP_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <silkrpc/config.hpp>
+
+#include <asio/awaitable.hpp>
+#include <silkworm/db/mdbx.hpp>
+
+#include <silkrpc/common/log.hpp>
+#include <silkrpc/ethdb/database.hpp>
+#include <silkrpc/ethdb/file/local_transaction.hpp>
+
+namespace silkrpc::ethdb::file {
+
+//! Open the chain database located at the specified path in read-only shared mode.
+std::shared_ptr<mdbx::env_managed> open_chaindata(const std::string& chaindata);
+
+class LocalDatabase: public Database {
+public:
+    explicit LocalDatabase(std::shared_ptr<mdbx::env_managed> chaindata_env) : chaindata_env_{std::move(chaindata_env)} {
+        SILKRPC_TRACE << "LocalDatabase::ctor " << this << "\n";
+    }
+
+    ~LocalDatabase() {
+        SILKRPC_TRACE << "LocalDatabase::dtor " << this << "\n";
+    }
+
+    LocalDatabase(const LocalDatabase&) = delete;
+    LocalDatabase& operator=(const LocalDatabase&) = delete;
+
+    asio::awaitable<std::unique_ptr<Transaction>> begin() override;
+
+private:
+    std::shared_ptr<mdbx::env_managed> chaindata_env_;
+};
+
+} // namespace silkrpc::ethdb::file
+
+#endif  // SILKRPC_ETHDB_FILE_LOCAL_DATABASE_HPP_
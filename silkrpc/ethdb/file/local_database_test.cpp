@@ -0,0 +1,34 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "local_database.hpp"
+
+#include <filesystem>
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc::ethdb::file {
+
+using Catch::Matchers::Message;
+
+TEST_CASE("open_chaindata", "[silkrpc][ethdb][file][local_database]") {
+    SECTION("non-existent path") {
+        const auto chaindata = std::filesystem::temp_directory_path() / "silkrpc_local_database_test_nonexistent";
+        CHECK_THROWS(open_chaindata(chaindata.string()));
+    }
+}
+
+} // namespace silkrpc::ethdb::file
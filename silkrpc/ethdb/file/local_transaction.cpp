@@ -0,0 +1,56 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "local_transaction.hpp"
+
+namespace silkrpc::ethdb::file {
+
+asio::awaitable<void> LocalTransaction::open() {
+    txn_ = chaindata_env_->start_read();
+    tx_id_ = txn_.id();
+    SILKRPC_DEBUG << "LocalTransaction::open tx_id: " << tx_id_ << "\n";
+    co_return;
+}
+
+asio::awaitable<std::shared_ptr<Cursor>> LocalTransaction::cursor(const std::string& table) {
+    co_return co_await get_cursor(table);
+}
+
+asio::awaitable<std::shared_ptr<CursorDupSort>> LocalTransaction::cursor_dup_sort(const std::string& table) {
+    co_return co_await get_cursor(table);
+}
+
+asio::awaitable<void> LocalTransaction::close() {
+    cursors_.clear();
+    if (txn_) {
+        txn_.abort();
+    }
+    SILKRPC_DEBUG << "LocalTransaction::close tx_id: " << tx_id_ << "\n";
+    co_return;
+}
+
+asio::awaitable<std::shared_ptr<CursorDupSort>> LocalTransaction::get_cursor(const std::string& table) {
+    auto cursor_it = cursors_.find(table);
+    if (cursor_it != cursors_.end()) {
+        co_return cursor_it->second;
+    }
+    auto cursor = std::make_shared<LocalCursor>(txn_, ++last_cursor_id_);
+    co_await cursor->open_cursor(table);
+    cursors_[table] = cursor;
+    co_return cursor;
+}
+
+} // namespace silkrpc::ethdb::file
@@ -19,11 +19,13 @@
 
 #include <silkrpc/config.hpp>
 
+#include <cstddef>
 #include <functional>
 #include <string>
 #include <system_error>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <asio/async_result.hpp>
 #include <asio/detail/non_const_lvalue.hpp>
@@ -51,6 +53,12 @@ using async_open_cursor = async_reply_operation<Handler, IoExecutor, uint32_t>;
 template <typename Handler, typename IoExecutor>
 using async_next = async_reply_operation<Handler, IoExecutor, const remote::Pair&>;
 
+template <typename Handler, typename IoExecutor>
+using async_next_batch = async_reply_operation<Handler, IoExecutor, std::vector<remote::Pair>>;
+
+template <typename Handler, typename IoExecutor>
+using async_pipeline = async_reply_operation<Handler, IoExecutor, std::vector<remote::Pair>>;
+
 template <typename Handler, typename IoExecutor>
 using async_seek = async_reply_operation<Handler, IoExecutor, const remote::Pair&>;
 
@@ -288,6 +296,136 @@ private:
     void* wrapper_;
 };
 
+template<typename Executor>
+class initiate_async_next_batch {
+public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_next_batch(KvAsioAwaitable<Executor>* self, uint32_t cursor_id, std::size_t batch_size)
+    : self_(self), cursor_id_(cursor_id), batch_size_(batch_size) {}
+
+    executor_type get_executor() const noexcept { return self_->get_executor(); }
+
+    template <typename WaitHandler>
+    void operator()(WaitHandler&& handler) {
+        asio::detail::non_const_lvalue<WaitHandler> handler2(handler);
+        using op = async_next_batch<WaitHandler, Executor>;
+        typename op::ptr p = {asio::detail::addressof(handler2.value), op::ptr::allocate(handler2.value), 0};
+        wrapper_ = new op(handler2.value, self_->context_.get_executor());
+
+        next_message_.set_op(remote::Op::NEXT);
+        next_message_.set_cursor(cursor_id_);
+        next_pairs_.reserve(batch_size_);
+        write_next<op>(0);
+    }
+
+private:
+    // Pipeline all the NEXT requests on the stream before reading any reply, so that the whole batch costs one round trip
+    template <typename Op>
+    void write_next(std::size_t index) {
+        self_->client_.write_start(next_message_, [this, index](const grpc::Status& status) {
+            if (!status.ok()) {
+                auto next_batch_op = static_cast<Op*>(wrapper_);
+                next_batch_op->complete(this, make_error_code(status.error_code(), status.error_message()), {});
+                return;
+            }
+            if (index + 1 < batch_size_) {
+                write_next<Op>(index + 1);
+            } else {
+                read_next<Op>();
+            }
+        });
+    }
+
+    // Replies to the pipelined requests come back in order
+    template <typename Op>
+    void read_next() {
+        self_->client_.read_start([this](const grpc::Status& status, const remote::Pair& next_pair) {
+            auto next_batch_op = static_cast<Op*>(wrapper_);
+            if (!status.ok()) {
+                next_batch_op->complete(this, make_error_code(status.error_code(), status.error_message()), {});
+                return;
+            }
+            next_pairs_.push_back(next_pair);
+            if (next_pairs_.size() < batch_size_) {
+                read_next<Op>();
+            } else {
+                next_batch_op->complete(this, {}, std::move(next_pairs_));
+            }
+        });
+    }
+
+    KvAsioAwaitable<Executor>* self_;
+    uint32_t cursor_id_;
+    std::size_t batch_size_;
+    remote::Cursor next_message_;
+    std::vector<remote::Pair> next_pairs_;
+    void* wrapper_;
+};
+
+template<typename Executor>
+class initiate_async_pipeline {
+public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_pipeline(KvAsioAwaitable<Executor>* self, std::vector<remote::Cursor> requests)
+    : self_(self), requests_(std::move(requests)) {}
+
+    executor_type get_executor() const noexcept { return self_->get_executor(); }
+
+    template <typename WaitHandler>
+    void operator()(WaitHandler&& handler) {
+        asio::detail::non_const_lvalue<WaitHandler> handler2(handler);
+        using op = async_pipeline<WaitHandler, Executor>;
+        typename op::ptr p = {asio::detail::addressof(handler2.value), op::ptr::allocate(handler2.value), 0};
+        wrapper_ = new op(handler2.value, self_->context_.get_executor());
+
+        replies_.reserve(requests_.size());
+        write_request<op>(0);
+    }
+
+private:
+    // Write all the requests on the stream before reading any reply, so that independent lookups cost one round trip
+    template <typename Op>
+    void write_request(std::size_t index) {
+        self_->client_.write_start(requests_[index], [this, index](const grpc::Status& status) {
+            if (!status.ok()) {
+                auto pipeline_op = static_cast<Op*>(wrapper_);
+                pipeline_op->complete(this, make_error_code(status.error_code(), status.error_message()), {});
+                return;
+            }
+            if (index + 1 < requests_.size()) {
+                write_request<Op>(index + 1);
+            } else {
+                read_reply<Op>();
+            }
+        });
+    }
+
+    // Replies to the pipelined requests come back in order
+    template <typename Op>
+    void read_reply() {
+        self_->client_.read_start([this](const grpc::Status& status, const remote::Pair& reply) {
+            auto pipeline_op = static_cast<Op*>(wrapper_);
+            if (!status.ok()) {
+                pipeline_op->complete(this, make_error_code(status.error_code(), status.error_message()), {});
+                return;
+            }
+            replies_.push_back(reply);
+            if (replies_.size() < requests_.size()) {
+                read_reply<Op>();
+            } else {
+                pipeline_op->complete(this, {}, std::move(replies_));
+            }
+        });
+    }
+
+    KvAsioAwaitable<Executor>* self_;
+    std::vector<remote::Cursor> requests_;
+    std::vector<remote::Pair> replies_;
+    void* wrapper_;
+};
+
 template<typename Executor>
 class initiate_async_close_cursor {
 public:
@@ -407,6 +545,17 @@ struct KvAsioAwaitable {
         return asio::async_initiate<WaitHandler, void(asio::error_code, const remote::Pair&)>(initiate_async_next{this, cursor_id}, handler);
     }
 
+    template<typename WaitHandler>
+    auto async_next_batch(uint32_t cursor_id, std::size_t batch_size, WaitHandler&& handler) {
+        return asio::async_initiate<WaitHandler, void(asio::error_code, std::vector<remote::Pair>)>(initiate_async_next_batch{this, cursor_id, batch_size}, handler);
+    }
+
+    //! Send the given (non-empty) sequence of requests in one round trip, collecting the replies in the same order
+    template<typename WaitHandler>
+    auto async_pipeline(std::vector<remote::Cursor> requests, WaitHandler&& handler) {
+        return asio::async_initiate<WaitHandler, void(asio::error_code, std::vector<remote::Pair>)>(initiate_async_pipeline{this, std::move(requests)}, handler);
+    }
+
     template<typename WaitHandler>
     auto async_close_cursor(uint32_t cursor_id, WaitHandler&& handler) {
         return asio::async_initiate<WaitHandler, void(asio::error_code, uint32_t)>(initiate_async_close_cursor{this, cursor_id}, handler);
@@ -71,6 +71,11 @@ public:
         co_return seek_pair;
     }
 
+    asio::awaitable<std::vector<remote::Pair>> async_pipeline(std::vector<remote::Cursor> requests) {
+        auto replies = co_await kv_awaitable_.async_pipeline(std::move(requests), asio::use_awaitable);
+        co_return replies;
+    }
+
     asio::awaitable<uint32_t> async_close_cursor(uint32_t cursor_id) {
         uint32_t ret_cursor_id = co_await kv_awaitable_.async_close_cursor(cursor_id, asio::use_awaitable);
         co_return ret_cursor_id;
@@ -944,6 +949,76 @@ TEST_CASE("async_seek_next") {
    }
 }
 
+TEST_CASE("async_pipeline") {
+    SECTION("success with all requests written before any reply") {
+       class MockStreamingClient : public AsyncTxStreamingClient {
+       public:
+          void start_call(std::function<void(const grpc::Status&)> start_completed) override {}
+          void end_call(std::function<void(const grpc::Status&)> end_completed) override {}
+          void write_start(const ::remote::Cursor& cursor, std::function<void(const grpc::Status&)> write_completed) override {
+               written_keys.push_back(cursor.k());
+               write_completed(::grpc::Status::OK);
+          }
+          void read_start(std::function<void(const grpc::Status&, const ::remote::Pair&)> read_completed) override {
+               // All requests must be already on the stream when the first reply is read
+               CHECK(written_keys.size() == 3);
+               ::remote::Pair reply;
+               reply.set_k(written_keys[replies_read++]);
+               read_completed(::grpc::Status::OK, reply);
+          }
+          std::vector<std::string> written_keys;
+          std::size_t replies_read{0};
+      };
+
+      ContextPool cp{1, []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); }};
+      auto context_pool_thread = std::thread([&]() { cp.run(); });
+      std::vector<remote::Pair> replies;
+      try {
+        MockStreamingClient sct;
+        AwaitableWrap test{*cp.next_context().io_context(), sct };
+        std::vector<remote::Cursor> requests(3);
+        requests[0].set_k("KEY1");
+        requests[1].set_k("KEY2");
+        requests[2].set_k("KEY3");
+        auto result{asio::co_spawn(cp.next_io_context(), test.async_pipeline(std::move(requests)), asio::use_future)};
+        replies = result.get();
+       } catch (...) {
+           CHECK(false);
+       }
+       CHECK(replies.size() == 3);
+       CHECK(replies[0].k() == "KEY1");
+       CHECK(replies[1].k() == "KEY2");
+       CHECK(replies[2].k() == "KEY3");
+       cp.stop();
+       context_pool_thread.join();
+    }
+
+    SECTION("write_start fails ") {
+       class MockStreamingClient : public AsyncTxStreamingClient {
+          void start_call(std::function<void(const grpc::Status&)> start_completed) override {}
+          void end_call(std::function<void(const grpc::Status&)> end_completed) override {}
+          void read_start(std::function<void(const grpc::Status&, const ::remote::Pair&)> read_completed) override {}
+          void write_start(const ::remote::Cursor& cursor, std::function<void(const grpc::Status&)> write_completed) override {
+             write_completed(::grpc::Status::CANCELLED);
+          }
+      };
+
+      ContextPool cp{1, []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); }};
+      auto context_pool_thread = std::thread([&]() { cp.run(); });
+      try {
+        MockStreamingClient sct;
+        AwaitableWrap test{*cp.next_context().io_context(), sct };
+        auto result{asio::co_spawn(cp.next_io_context(), test.async_pipeline(std::vector<remote::Cursor>(2)), asio::use_future)};
+        result.get();
+        CHECK(false);
+       } catch (const std::system_error& e) {
+             CHECK(e.code().value() == 1);
+       }
+       cp.stop();
+       context_pool_thread.join();
+   }
+}
+
 TEST_CASE("async_close_cursor") {
     SECTION("success with sync call") {
        class MockStreamingClient : public AsyncTxStreamingClient {
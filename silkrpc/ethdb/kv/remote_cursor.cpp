@@ -16,6 +16,9 @@
 
 #include "remote_cursor.hpp"
 
+#include <algorithm>
+#include <utility>
+
 #include <silkrpc/common/clock_time.hpp>
 
 namespace silkrpc::ethdb::kv {
@@ -33,6 +36,7 @@ asio::awaitable<void> RemoteCursor::open_cursor(const std::string& table_name) {
 
 asio::awaitable<KeyValue> RemoteCursor::seek(silkworm::ByteView key) {
     const auto start_time = clock_time::now();
+    reset_prefetch();
     SILKRPC_DEBUG << "RemoteCursor::seek cursor: " << cursor_id_ << " key: " << key << "\n";
     auto seek_pair = co_await kv_awaitable_.async_seek(cursor_id_, key, asio::use_awaitable);
     const auto k = silkworm::bytes_of_string(seek_pair.k());
@@ -43,6 +47,7 @@ asio::awaitable<KeyValue> RemoteCursor::seek(silkworm::ByteView key) {
 
 asio::awaitable<KeyValue> RemoteCursor::seek_exact(silkworm::ByteView key) {
     const auto start_time = clock_time::now();
+    reset_prefetch();
     SILKRPC_DEBUG << "RemoteCursor::seek_exact cursor: " << cursor_id_ << " key: " << key << "\n";
     auto seek_pair = co_await kv_awaitable_.async_seek_exact(cursor_id_, key, asio::use_awaitable);
     const auto k = silkworm::bytes_of_string(seek_pair.k());
@@ -53,15 +58,18 @@ asio::awaitable<KeyValue> RemoteCursor::seek_exact(silkworm::ByteView key) {
 
 asio::awaitable<KeyValue> RemoteCursor::next() {
     const auto start_time = clock_time::now();
-    auto next_pair = co_await kv_awaitable_.async_next(cursor_id_, asio::use_awaitable);
-    const auto k = silkworm::bytes_of_string(next_pair.k());
-    const auto v = silkworm::bytes_of_string(next_pair.v());
-    SILKRPC_DEBUG << "RemoteCursor::next k: " << k << " v: " << v << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
-    co_return KeyValue{k, v};
+    if (prefetched_pairs_.empty()) {
+        co_await prefetch_next();
+    }
+    const auto kv_pair = std::move(prefetched_pairs_.front());
+    prefetched_pairs_.pop_front();
+    SILKRPC_DEBUG << "RemoteCursor::next k: " << kv_pair.key << " v: " << kv_pair.value << " c=" << cursor_id_ << " t=" << clock_time::since(start_time) << "\n";
+    co_return kv_pair;
 }
 
 asio::awaitable<silkworm::Bytes> RemoteCursor::seek_both(silkworm::ByteView key, silkworm::ByteView value) {
     const auto start_time = clock_time::now();
+    reset_prefetch();
     SILKRPC_DEBUG << "RemoteCursor::seek_both cursor: " << cursor_id_ << " key: " << key << " subkey: " << value << "\n";
     auto seek_pair = co_await kv_awaitable_.async_seek_both(cursor_id_, key, value, asio::use_awaitable);
     const auto k = silkworm::bytes_of_string(seek_pair.k());
@@ -72,6 +80,7 @@ asio::awaitable<silkworm::Bytes> RemoteCursor::seek_both(silkworm::ByteView key,
 
 asio::awaitable<KeyValue> RemoteCursor::seek_both_exact(silkworm::ByteView key, silkworm::ByteView value) {
     const auto start_time = clock_time::now();
+    reset_prefetch();
     SILKRPC_DEBUG << "RemoteCursor::seek_both_exact cursor: " << cursor_id_ << " key: " << key << " subkey: " << value << "\n";
     auto seek_pair = co_await kv_awaitable_.async_seek_both_exact(cursor_id_, key, value, asio::use_awaitable);
     const auto k = silkworm::bytes_of_string(seek_pair.k());
@@ -82,6 +91,7 @@ asio::awaitable<KeyValue> RemoteCursor::seek_both_exact(silkworm::ByteView key,
 
 asio::awaitable<void> RemoteCursor::close_cursor() {
     const auto start_time = clock_time::now();
+    reset_prefetch();
     const auto cursor_id = cursor_id_;
     if (cursor_id_ != 0) {
         SILKRPC_DEBUG << "RemoteCursor::close_cursor closing cursor: " << cursor_id_ << "\n";
@@ -93,4 +103,26 @@ asio::awaitable<void> RemoteCursor::close_cursor() {
     co_return;
 }
 
+asio::awaitable<void> RemoteCursor::prefetch_next() {
+    const auto batch_size = std::max<std::size_t>(std::min(prefetch_size_, max_prefetch_size_), 1);
+    SILKRPC_DEBUG << "RemoteCursor::prefetch_next cursor: " << cursor_id_ << " batch_size: " << batch_size << "\n";
+    const auto next_pairs = co_await kv_awaitable_.async_next_batch(cursor_id_, batch_size, asio::use_awaitable);
+    for (const auto& next_pair : next_pairs) {
+        auto k = silkworm::bytes_of_string(next_pair.k());
+        auto v = silkworm::bytes_of_string(next_pair.v());
+        const auto end_reached = k.empty();
+        prefetched_pairs_.push_back(KeyValue{std::move(k), std::move(v)});
+        if (end_reached) {
+            // Any following pair is also empty: just keep the first one
+            break;
+        }
+    }
+    prefetch_size_ = std::min(prefetch_size_ * 2, max_prefetch_size_);
+}
+
+void RemoteCursor::reset_prefetch() {
+    prefetched_pairs_.clear();
+    prefetch_size_ = 1;
+}
+
 } // namespace silkrpc::ethdb::kv
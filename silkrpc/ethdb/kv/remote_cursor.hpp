@@ -19,6 +19,8 @@
 
 #include <silkrpc/config.hpp>
 
+#include <cstddef>
+#include <deque>
 #include <memory>
 #include <string>
 
@@ -27,6 +29,7 @@
 #include <asio/use_awaitable.hpp>
 
 #include <silkworm/common/util.hpp>
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/common/util.hpp>
 #include <silkrpc/ethdb/kv/awaitables.hpp>
@@ -36,8 +39,14 @@ namespace silkrpc::ethdb::kv {
 
 class RemoteCursor : public CursorDupSort {
 public:
-    explicit RemoteCursor(KvAsioAwaitable<asio::io_context::executor_type>& kv_awaitable)
-    : kv_awaitable_(kv_awaitable), cursor_id_{0} {}
+    explicit RemoteCursor(KvAsioAwaitable<asio::io_context::executor_type>& kv_awaitable,
+        std::size_t max_prefetch_size = kDefaultCursorMaxPrefetchSize)
+    : kv_awaitable_(kv_awaitable), cursor_id_{0}, max_prefetch_size_{max_prefetch_size} {}
+
+    //! Wrap a remote cursor already opened by the caller with the given identifier
+    explicit RemoteCursor(KvAsioAwaitable<asio::io_context::executor_type>& kv_awaitable, uint32_t cursor_id,
+        std::size_t max_prefetch_size)
+    : kv_awaitable_(kv_awaitable), cursor_id_{cursor_id}, max_prefetch_size_{max_prefetch_size} {}
 
     RemoteCursor(const RemoteCursor&) = delete;
     RemoteCursor& operator=(const RemoteCursor&) = delete;
@@ -58,9 +67,24 @@ public:
 
     asio::awaitable<KeyValue> seek_both_exact(silkworm::ByteView key, silkworm::ByteView value) override;
 
+    //! Discard any read-ahead pairs because the remote cursor has been repositioned
+    void reset_prefetch();
+
 private:
+    //! Read the next batch of pairs from the remote cursor, doubling the batch size at each sequential read
+    asio::awaitable<void> prefetch_next();
+
     KvAsioAwaitable<asio::io_context::executor_type>& kv_awaitable_;
     uint32_t cursor_id_;
+
+    //! The max number of pairs read ahead in one round trip by sequential next() calls
+    std::size_t max_prefetch_size_;
+
+    //! The number of pairs to read ahead in the next round trip
+    std::size_t prefetch_size_{1};
+
+    //! The pairs already read ahead from the remote cursor but not yet consumed
+    std::deque<KeyValue> prefetched_pairs_;
 };
 
 } // namespace silkrpc::ethdb::kv
@@ -17,6 +17,8 @@
 #include "remote_cursor.hpp"
 
 #include <future>
+#include <string>
+#include <vector>
 
 #include <asio/co_spawn.hpp>
 #include <asio/use_future.hpp>
@@ -485,6 +487,63 @@ TEST_CASE("RemoteCursor::next", "[silkrpc][ethdb][kv][remote_cursor]") {
             CHECK(false);
         }
     }
+
+    SECTION("read-ahead pipelines next requests and stops at end of table") {
+        class MockStreamingClient13 : public MockBaseStreamingClient {
+        public:
+            MockStreamingClient13(std::shared_ptr<grpc::Channel> channel, grpc::CompletionQueue* queue) {}
+            void read_start(std::function<void(const grpc::Status&, const remote::Pair&)> read_completed) override {
+                remote::Pair pair;
+                pair.set_cursorid(3);
+                ++reads;
+                if (next_count > 0 && next_count <= 4) {
+                    pair.set_k("000" + std::to_string(next_count));
+                    pair.set_v("100" + std::to_string(next_count));
+                }
+                if (pending_writes > 0) {
+                    --pending_writes;
+                    ++next_count;
+                }
+                read_completed(grpc::Status::OK, pair);
+            }
+            void write_start(const remote::Cursor& cursor, std::function<void(const grpc::Status&)> write_completed) override {
+                if (cursor.op() == remote::Op::NEXT) {
+                    ++pending_writes;
+                    ++next_writes;
+                }
+                write_completed(grpc::Status::OK);
+            }
+            int reads{0};
+            int next_writes{0};
+            int pending_writes{0};
+            int next_count{1};
+        };
+        asio::io_context io_context;
+        auto channel = grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials());
+        grpc::CompletionQueue queue;
+        MockStreamingClient13 client{channel, &queue};
+        KvAsioAwaitable<asio::io_context::executor_type> kv_awaitable{io_context, client};
+        RemoteCursor remote_cursor{kv_awaitable, 4};
+        auto result1{asio::co_spawn(io_context, remote_cursor.open_cursor("table1"), asio::use_future)};
+        io_context.run();
+        result1.get();
+        client.next_count = 1;
+        std::vector<KeyValue> kv_pairs;
+        for (int i{0}; i < 5; i++) {
+            auto result{asio::co_spawn(io_context, remote_cursor.next(), asio::use_future)};
+            io_context.reset();
+            io_context.run();
+            kv_pairs.push_back(result.get());
+        }
+        // Batches of 1, 2 and 4 pairs: 3 round trips for 5 next() calls
+        CHECK(client.next_writes == 7);
+        CHECK(silkworm::to_hex(kv_pairs[0].key) == "30303031");
+        CHECK(silkworm::to_hex(kv_pairs[1].key) == "30303032");
+        CHECK(silkworm::to_hex(kv_pairs[2].key) == "30303033");
+        CHECK(silkworm::to_hex(kv_pairs[3].key) == "30303034");
+        CHECK(silkworm::to_hex(kv_pairs[3].value) == "31303034");
+        CHECK(kv_pairs[4].key.empty());
+    }
 }
 
 TEST_CASE("RemoteCursor::seek_both", "[silkrpc][ethdb][kv][remote_cursor]") {
@@ -17,16 +17,20 @@
 #ifndef SILKRPC_ETHDB_KV_REMOTE_TRANSACTION_HPP_
 #define SILKRPC_ETHDB_KV_REMOTE_TRANSACTION_HPP_
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <silkrpc/config.hpp>
 
 #include <asio/use_awaitable.hpp>
 #include <grpcpp/grpcpp.h>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/ethdb/cursor.hpp>
 #include <silkrpc/ethdb/kv/awaitables.hpp>
@@ -69,6 +73,53 @@ public:
         co_return co_await get_cursor(table);
     }
 
+    asio::awaitable<std::vector<KeyValue>> seek_batch(const std::vector<TableKey>& table_keys) override {
+        if (table_keys.empty()) {
+            co_return std::vector<KeyValue>{};
+        }
+
+        // Open all the missing cursors in one round trip
+        std::vector<std::string> new_tables;
+        std::vector<remote::Cursor> open_requests;
+        for (const auto& table_key : table_keys) {
+            if (cursors_.contains(table_key.table) || std::find(new_tables.begin(), new_tables.end(), table_key.table) != new_tables.end()) {
+                continue;
+            }
+            auto open_message = remote::Cursor{};
+            open_message.set_op(remote::Op::OPEN);
+            open_message.set_bucketname(table_key.table);
+            open_requests.push_back(std::move(open_message));
+            new_tables.push_back(table_key.table);
+        }
+        if (!open_requests.empty()) {
+            const auto open_pairs = co_await kv_awaitable_.async_pipeline(std::move(open_requests), asio::use_awaitable);
+            for (std::size_t i{0}; i < new_tables.size(); i++) {
+                SILKRPC_DEBUG << "RemoteTransaction::seek_batch cursor: " << open_pairs[i].cursorid() << " for table: " << new_tables[i] << "\n";
+                cursors_[new_tables[i]] = std::make_shared<RemoteCursor>(kv_awaitable_, open_pairs[i].cursorid(), kDefaultCursorMaxPrefetchSize);
+            }
+        }
+
+        // Then seek all the keys in one round trip
+        std::vector<remote::Cursor> seek_requests;
+        seek_requests.reserve(table_keys.size());
+        for (const auto& table_key : table_keys) {
+            auto cursor = std::static_pointer_cast<RemoteCursor>(cursors_[table_key.table]);
+            cursor->reset_prefetch();
+            auto seek_message = remote::Cursor{};
+            seek_message.set_op(remote::Op::SEEK);
+            seek_message.set_cursor(cursor->cursor_id());
+            seek_message.set_k(table_key.key.data(), table_key.key.length());
+            seek_requests.push_back(std::move(seek_message));
+        }
+        const auto seek_pairs = co_await kv_awaitable_.async_pipeline(std::move(seek_requests), asio::use_awaitable);
+        std::vector<KeyValue> kv_pairs;
+        kv_pairs.reserve(seek_pairs.size());
+        for (const auto& seek_pair : seek_pairs) {
+            kv_pairs.push_back(KeyValue{silkworm::bytes_of_string(seek_pair.k()), silkworm::bytes_of_string(seek_pair.v())});
+        }
+        co_return kv_pairs;
+    }
+
     asio::awaitable<void> close() override {
         cursors_.clear();
         co_await kv_awaitable_.async_end(asio::use_awaitable);
@@ -0,0 +1,141 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_changes_stream.hpp"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <boost/endian/conversion.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/types/account.hpp>
+
+#include <silkrpc/common/log.hpp>
+
+namespace silkrpc::ethdb::kv {
+
+StateChangesStream::StateChangesStream(asio::io_context& io_context, std::shared_ptr<grpc::Channel> channel, grpc::CompletionQueue* queue,
+    CoherentStateCache& cache, CodeCache& code_cache, StateCache& state_cache)
+    : cache_(cache), code_cache_(code_cache), state_cache_(state_cache), client_{io_context, remote::KV::NewStub(channel), queue} {}
+
+void StateChangesStream::open() {
+    remote::StateChangeRequest request;
+    request.set_withstorage(true);
+    request.set_withtransactions(false);
+    client_.open(request, [&](const remote::StateChangeBatch& batch) { apply(batch); }, [&]() {
+        // State diffs notified meanwhile would be lost, so cached entries cannot be trusted anymore
+        cache_.clear();
+        state_cache_.clear();
+    });
+}
+
+void StateChangesStream::close() {
+    client_.close();
+}
+
+void StateChangesStream::apply(const remote::StateChangeBatch& batch) {
+    if (batch.changebatch_size() == 0) {
+        SILKRPC_DEBUG << "StateChangesStream::apply empty batch view_id: " << batch.databaseviewid() << "\n";
+        return;
+    }
+
+    std::vector<BlockStateChanges> changes;
+    changes.reserve(static_cast<std::size_t>(batch.changebatch_size()));
+    uint64_t block_number{0};
+    bool unwound{false};
+    for (const auto& state_change : batch.changebatch()) {
+        // Unwound entries are just dropped: the restored values are read again from the database when needed
+        const bool unwind{state_change.direction() == remote::Direction::UNWIND};
+        unwound = unwound || unwind;
+        block_number = unwind ? state_change.blockheight() - 1 : state_change.blockheight();
+
+        auto& block_changes = changes.emplace_back();
+        for (const auto& account_change : state_change.changes()) {
+            const auto address{address_from_H160(account_change.address())};
+            const auto action{account_change.action()};
+
+            if (action == remote::Action::CODE || action == remote::Action::UPSERT_CODE) {
+                // Code is immutable for its hash, so new contract code can be cached regardless of the view
+                auto code{silkworm::bytes_of_string(account_change.code())};
+                if (!code.empty()) {
+                    const auto hash{silkworm::keccak256(code)};
+                    evmc::bytes32 code_hash;
+                    std::memcpy(code_hash.bytes, hash.bytes, silkworm::kHashLength);
+                    code_cache_.insert(code_hash, std::move(code));
+                }
+            }
+
+            if (action == remote::Action::UPSERT || action == remote::Action::UPSERT_CODE) {
+                std::optional<std::optional<silkworm::Account>> account;
+                if (!unwind) {
+                    auto [decoded_account, err]{silkworm::Account::from_encoded_storage(silkworm::bytes_of_string(account_change.data()))};
+                    if (err == silkworm::rlp::DecodingResult::kOk) {
+                        account = std::optional<silkworm::Account>{decoded_account};
+                    }
+                }
+                block_changes.accounts.push_back({address, account});
+            } else if (action == remote::Action::DELETE) {
+                std::optional<std::optional<silkworm::Account>> account;
+                if (!unwind) {
+                    account = std::optional<silkworm::Account>{};
+                }
+                block_changes.accounts.push_back({address, account});
+            } else if (action == remote::Action::CODE) {
+                block_changes.accounts.push_back({address, std::nullopt});
+            }
+
+            for (const auto& storage_change : account_change.storagechanges()) {
+                std::optional<evmc::bytes32> value;
+                if (!unwind) {
+                    const auto& data = storage_change.data();
+                    if (data.size() <= silkworm::kHashLength) {
+                        value = evmc::bytes32{};
+                        std::memcpy(value->bytes + silkworm::kHashLength - data.size(), data.data(), data.size());
+                    }
+                }
+                block_changes.storage.push_back({address, account_change.incarnation(), bytes32_from_H256(storage_change.location()), value});
+            }
+        }
+    }
+
+    // Historical values bound to the unwound blocks may differ on the new chain
+    if (unwound) {
+        state_cache_.invalidate(batch.databaseviewid());
+    }
+    cache_.on_new_view(batch.databaseviewid(), block_number, changes);
+    SILKRPC_DEBUG << "StateChangesStream::apply view_id: " << batch.databaseviewid() << " block_number: " << block_number
+        << " blocks: " << changes.size() << "\n";
+}
+
+evmc::address StateChangesStream::address_from_H160(const types::H160& h160) {
+    evmc::address address{};
+    boost::endian::store_big_u64(address.bytes +  0, h160.hi().hi());
+    boost::endian::store_big_u64(address.bytes +  8, h160.hi().lo());
+    boost::endian::store_big_u32(address.bytes + 16, h160.lo());
+    return address;
+}
+
+evmc::bytes32 StateChangesStream::bytes32_from_H256(const types::H256& h256) {
+    evmc::bytes32 bytes32{};
+    boost::endian::store_big_u64(bytes32.bytes +  0, h256.hi().hi());
+    boost::endian::store_big_u64(bytes32.bytes +  8, h256.hi().lo());
+    boost::endian::store_big_u64(bytes32.bytes + 16, h256.lo().hi());
+    boost::endian::store_big_u64(bytes32.bytes + 24, h256.lo().lo());
+    return bytes32;
+}
+
+} // namespace silkrpc::ethdb::kv
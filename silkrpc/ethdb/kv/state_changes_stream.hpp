@@ -0,0 +1,76 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_ETHDB_KV_STATE_CHANGES_STREAM_HPP_
+#define SILKRPC_ETHDB_KV_STATE_CHANGES_STREAM_HPP_
+
+#include <memory>
+
+#include <asio/io_context.hpp>
+#include <evmc/evmc.hpp>
+#include <grpcpp/grpcpp.h>
+
+#include <silkrpc/common/code_cache.hpp>
+#include <silkrpc/common/coherent_state_cache.hpp>
+#include <silkrpc/common/state_cache.hpp>
+#include <silkrpc/grpc/async_server_streaming_client.hpp>
+#include <silkrpc/interfaces/remote/kv.grpc.pb.h>
+#include <silkrpc/interfaces/types/types.pb.h>
+
+namespace silkrpc::ethdb::kv {
+
+using StateChangesClient = AsyncServerStreamingClient<
+    ::remote::KV::StubInterface,
+    ::remote::StateChangeRequest,
+    ::remote::StateChangeBatch,
+    &::remote::KV::StubInterface::PrepareAsyncStateChanges
+>;
+
+//! Subscription to the KV StateChanges stream applying each state diff to the coherent state cache. Whenever the stream
+//! breaks the cache is cleared, because some diffs may be missed, and the stream is reopened after a while.
+//! Unwinds also invalidate the historical state cache, because the values of the unwound blocks are not final.
+class StateChangesStream {
+public:
+    explicit StateChangesStream(asio::io_context& io_context, std::shared_ptr<grpc::Channel> channel, grpc::CompletionQueue* queue,
+        CoherentStateCache& cache, CodeCache& code_cache, StateCache& state_cache);
+
+    StateChangesStream(const StateChangesStream&) = delete;
+    StateChangesStream& operator=(const StateChangesStream&) = delete;
+
+    //! Open the stream, reopening it on failure until closed (must be called on the I/O context thread)
+    void open();
+
+    //! Close the stream cancelling any pending read (may be called on any thread)
+    void close();
+
+    //! Apply the given state diffs to the caches
+    void apply(const remote::StateChangeBatch& batch);
+
+private:
+
+    static evmc::address address_from_H160(const types::H160& h160);
+
+    static evmc::bytes32 bytes32_from_H256(const types::H256& h256);
+
+    CoherentStateCache& cache_;
+    CodeCache& code_cache_;
+    StateCache& state_cache_;
+    StateChangesClient client_;
+};
+
+} // namespace silkrpc::ethdb::kv
+
+#endif // SILKRPC_ETHDB_KV_STATE_CHANGES_STREAM_HPP_
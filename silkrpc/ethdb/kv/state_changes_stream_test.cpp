@@ -0,0 +1,191 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_changes_stream.hpp"
+
+#include <cstring>
+#include <string>
+
+#include <asio/io_context.hpp>
+#include <boost/endian/conversion.hpp>
+#include <catch2/catch.hpp>
+#include <grpcpp/grpcpp.h>
+#include <silkworm/common/util.hpp>
+#include <silkworm/types/account.hpp>
+
+namespace silkrpc::ethdb::kv {
+
+using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
+
+static void set_address(::types::H160* h160, const evmc::address& address) {
+    h160->mutable_hi()->set_hi(boost::endian::load_big_u64(address.bytes + 0));
+    h160->mutable_hi()->set_lo(boost::endian::load_big_u64(address.bytes + 8));
+    h160->set_lo(boost::endian::load_big_u32(address.bytes + 16));
+}
+
+static void set_location(::types::H256* h256, const evmc::bytes32& location) {
+    h256->mutable_hi()->set_hi(boost::endian::load_big_u64(location.bytes + 0));
+    h256->mutable_hi()->set_lo(boost::endian::load_big_u64(location.bytes + 8));
+    h256->mutable_lo()->set_hi(boost::endian::load_big_u64(location.bytes + 16));
+    h256->mutable_lo()->set_lo(boost::endian::load_big_u64(location.bytes + 24));
+}
+
+static std::string to_string(const silkworm::Bytes& bytes) {
+    return std::string{bytes.cbegin(), bytes.cend()};
+}
+
+static remote::StateChange* add_state_change(remote::StateChangeBatch& batch, remote::Direction direction, uint64_t block_height) {
+    auto state_change = batch.add_changebatch();
+    state_change->set_direction(direction);
+    state_change->set_blockheight(block_height);
+    return state_change;
+}
+
+static remote::AccountChange* add_account_change(remote::StateChange* state_change, const evmc::address& address, remote::Action action) {
+    auto account_change = state_change->add_changes();
+    set_address(account_change->mutable_address(), address);
+    account_change->set_action(action);
+    return account_change;
+}
+
+TEST_CASE("StateChangesStream::apply", "[silkrpc][ethdb][kv][state_changes_stream]") {
+    const auto address{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto code_hash{0x04491edcd115127caedbd478e2e7895ed80c7847e903431f94f9cfa579cad47f_bytes32};
+
+    asio::io_context io_context;
+    grpc::CompletionQueue queue;
+    CoherentStateCache cache;
+    CodeCache code_cache;
+    StateCache state_cache;
+    StateChangesStream stream{io_context, grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()), &queue,
+        cache, code_cache, state_cache};
+
+    // Make block 100 the head of view 5 and cache the account and storage read on top of it
+    remote::StateChangeBatch first_batch;
+    first_batch.set_databaseviewid(5);
+    add_state_change(first_batch, remote::Direction::FORWARD, 100);
+    stream.apply(first_batch);
+    CHECK(cache.latest_view_id() == 5);
+
+    silkworm::Account account;
+    account.nonce = 12;
+    account.incarnation = 1;
+    account.code_hash = code_hash;
+    cache.insert_account(5, 101, address, account);
+    cache.insert_storage(5, 101, address, 1, location, 0x0000000000000000000000000000000000000000000000000000000000000002_bytes32);
+
+    remote::StateChangeBatch batch;
+    batch.set_databaseviewid(6);
+
+    SECTION("empty batch ignored") {
+        stream.apply(batch);
+        CHECK(cache.latest_view_id() == 5);
+    }
+
+    SECTION("UPSERT updates cached account") {
+        silkworm::Account new_account;
+        new_account.nonce = 13;
+        auto state_change = add_state_change(batch, remote::Direction::FORWARD, 101);
+        auto account_change = add_account_change(state_change, address, remote::Action::UPSERT);
+        account_change->set_data(to_string(new_account.encode_for_storage()));
+        stream.apply(batch);
+
+        CHECK(cache.latest_view_id() == 6);
+        const auto cached_account = cache.get_account(6, 102, address);
+        CHECK(cached_account);
+        CHECK(*cached_account);
+        CHECK((*cached_account)->nonce == 13);
+    }
+
+    SECTION("UPSERT without code hash restores it from same incarnation") {
+        silkworm::Account new_account;
+        new_account.nonce = 13;
+        new_account.incarnation = 1;
+        auto state_change = add_state_change(batch, remote::Direction::FORWARD, 101);
+        auto account_change = add_account_change(state_change, address, remote::Action::UPSERT);
+        account_change->set_data(to_string(new_account.encode_for_storage(/*omit_code_hash=*/true)));
+        stream.apply(batch);
+
+        const auto cached_account = cache.get_account(6, 102, address);
+        CHECK(cached_account);
+        CHECK(*cached_account);
+        CHECK((*cached_account)->nonce == 13);
+        CHECK((*cached_account)->code_hash == code_hash);
+    }
+
+    SECTION("DELETE caches account as non-existent") {
+        auto state_change = add_state_change(batch, remote::Direction::FORWARD, 101);
+        add_account_change(state_change, address, remote::Action::DELETE);
+        stream.apply(batch);
+
+        const auto cached_account = cache.get_account(6, 102, address);
+        CHECK(cached_account);
+        CHECK(!*cached_account);
+        CHECK(!cache.get_storage(6, 102, address, 1, location));
+    }
+
+    SECTION("CODE caches code and evicts account") {
+        const silkworm::Bytes code{*silkworm::from_hex("0x6042")};
+        auto state_change = add_state_change(batch, remote::Direction::FORWARD, 101);
+        auto account_change = add_account_change(state_change, address, remote::Action::CODE);
+        account_change->set_code(to_string(code));
+        stream.apply(batch);
+
+        CHECK(!cache.get_account(6, 102, address));
+        const auto hash{silkworm::keccak256(code)};
+        evmc::bytes32 new_code_hash;
+        std::memcpy(new_code_hash.bytes, hash.bytes, silkworm::kHashLength);
+        const auto cached_code = code_cache.get(new_code_hash);
+        CHECK(cached_code);
+        CHECK(*cached_code == code);
+    }
+
+    SECTION("STORAGE updates cached slot") {
+        auto state_change = add_state_change(batch, remote::Direction::FORWARD, 101);
+        auto account_change = add_account_change(state_change, address, remote::Action::STORAGE);
+        account_change->set_incarnation(1);
+        auto storage_change = account_change->add_storagechanges();
+        set_location(storage_change->mutable_location(), location);
+        storage_change->set_data(std::string{"\x01\x02", 2});
+        stream.apply(batch);
+
+        CHECK(cache.get_storage(6, 102, address, 1, location) == 0x0000000000000000000000000000000000000000000000000000000000000102_bytes32);
+    }
+
+    SECTION("UNWIND evicts entries and invalidates historical state") {
+        state_cache.insert_account(address, 50, account, 5);
+
+        auto state_change = add_state_change(batch, remote::Direction::UNWIND, 101);
+        auto account_change = add_account_change(state_change, address, remote::Action::UPSERT);
+        account_change->set_incarnation(1);
+        auto storage_change = account_change->add_storagechanges();
+        set_location(storage_change->mutable_location(), location);
+        stream.apply(batch);
+
+        CHECK(cache.latest_view_id() == 6);
+        CHECK(cache.is_latest(6, 101));
+        CHECK(!cache.get_account(6, 101, address));
+        CHECK(!cache.get_storage(6, 101, address, 1, location));
+        CHECK(!state_cache.get_account(address, 50));
+
+        // Values read before the unwind cannot be cached anymore
+        state_cache.insert_account(address, 50, account, 5);
+        CHECK(!state_cache.get_account(address, 50));
+    }
+}
+
+} // namespace silkrpc::ethdb::kv
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <silkrpc/config.hpp>
 
@@ -47,6 +48,17 @@ public:
 
     virtual asio::awaitable<std::shared_ptr<CursorDupSort>> cursor_dup_sort(const std::string& table) = 0;
 
+    //! Seek each key in its table and return the pairs in the same order, implementations may pipeline the lookups
+    virtual asio::awaitable<std::vector<KeyValue>> seek_batch(const std::vector<TableKey>& table_keys) {
+        std::vector<KeyValue> kv_pairs;
+        kv_pairs.reserve(table_keys.size());
+        for (const auto& table_key : table_keys) {
+            const auto cursor = co_await this->cursor(table_key.table);
+            kv_pairs.push_back(co_await cursor->seek(table_key.key));
+        }
+        co_return kv_pairs;
+    }
+
     virtual asio::awaitable<void> close() = 0;
 };
 
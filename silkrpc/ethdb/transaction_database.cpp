@@ -103,4 +103,9 @@ asio::awaitable<void> TransactionDatabase::for_prefix(const std::string& table,
     co_return;
 }
 
+asio::awaitable<std::vector<KeyValue>> TransactionDatabase::get_batch(const std::vector<TableKey>& table_keys) const {
+    SILKRPC_TRACE << "TransactionDatabase::get_batch #table_keys: " << table_keys.size() << "\n";
+    co_return co_await tx_.seek_batch(table_keys);
+}
+
 } // namespace silkrpc::ethdb
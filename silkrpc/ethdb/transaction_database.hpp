@@ -19,6 +19,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <silkworm/common/util.hpp>
 #include <silkrpc/core/rawdb/accessors.hpp>
@@ -43,6 +44,8 @@ public:
 
     asio::awaitable<void> for_prefix(const std::string& table, const silkworm::ByteView& prefix, core::rawdb::Walker w) const override;
 
+    asio::awaitable<std::vector<KeyValue>> get_batch(const std::vector<TableKey>& table_keys) const override;
+
 private:
     Transaction& tx_;
 };
@@ -0,0 +1,152 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_GRPC_ASYNC_SERVER_STREAMING_CLIENT_HPP_
+#define SILKRPC_GRPC_ASYNC_SERVER_STREAMING_CLIENT_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+#include <asio/steady_timer.hpp>
+#include <grpcpp/grpcpp.h>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/log.hpp>
+#include <silkworm/rpc/completion_tag.hpp>
+
+namespace silkrpc {
+
+//! Long-lived subscription to a server streaming call, delivering each reply to the given handler. Whenever the stream
+//! breaks the reset handler is notified, because replies may be missed, and the call is restarted after a while.
+//! Completions must be processed on the given I/O context, which is where handlers are called.
+template<
+    typename StubInterface,
+    typename Request,
+    typename Reply,
+    std::unique_ptr<grpc::ClientAsyncReaderInterface<Reply>>(StubInterface::*PrepareAsync)(grpc::ClientContext*, const Request&, grpc::CompletionQueue*)
+>
+class AsyncServerStreamingClient final {
+    enum CallStatus { CALL_IDLE, CALL_STARTED, READ_STARTED, FINISH_STARTED };
+
+public:
+    using ReplyHandler = std::function<void(const Reply&)>;
+    using ResetHandler = std::function<void()>;
+
+    explicit AsyncServerStreamingClient(asio::io_context& io_context, std::unique_ptr<StubInterface> stub, grpc::CompletionQueue* queue,
+        std::chrono::milliseconds retry_interval = kServerStreamingRetryInterval)
+    : io_context_(io_context), stub_{std::move(stub)}, queue_(queue), retry_interval_{retry_interval}, retry_timer_{io_context} {
+        completion_processor_ = [this](bool ok) { completed(ok); };
+    }
+
+    AsyncServerStreamingClient(const AsyncServerStreamingClient&) = delete;
+    AsyncServerStreamingClient& operator=(const AsyncServerStreamingClient&) = delete;
+
+    //! Open the stream, reopening it on failure until closed (must be called on the I/O context thread)
+    void open(const Request& request, ReplyHandler on_reply, ResetHandler on_reset = {}) {
+        request_ = request;
+        on_reply_ = std::move(on_reply);
+        on_reset_ = std::move(on_reset);
+        closed_ = false;
+        start_call();
+    }
+
+    //! Close the stream cancelling any pending read (may be called on any thread)
+    void close() {
+        SILKRPC_DEBUG << "AsyncServerStreamingClient::close " << this << "\n";
+        closed_ = true;
+        asio::post(io_context_, [&]() { retry_timer_.cancel(); });
+        std::scoped_lock lock{context_access_};
+        if (context_) {
+            context_->TryCancel();
+        }
+    }
+
+private:
+    void start_call() {
+        SILKRPC_DEBUG << "AsyncServerStreamingClient::start_call " << this << "\n";
+        {
+            std::scoped_lock lock{context_access_};
+            context_ = std::make_unique<grpc::ClientContext>();
+            reader_ = (stub_.get()->*PrepareAsync)(context_.get(), request_, queue_);
+        }
+        result_ = grpc::Status{};
+        status_ = CALL_STARTED;
+        reader_->StartCall(&completion_processor_);
+    }
+
+    void completed(bool ok) {
+        SILKRPC_TRACE << "AsyncServerStreamingClient::completed " << this << " status: " << status_ << " ok: " << ok << "\n";
+        if (!ok && status_ != FINISH_STARTED) {
+            status_ = FINISH_STARTED;
+            reader_->Finish(&result_, &completion_processor_);
+            return;
+        }
+        switch (status_) {
+            case READ_STARTED:
+                on_reply_(reply_);
+                [[fallthrough]];
+            case CALL_STARTED:
+                status_ = READ_STARTED;
+                reader_->Read(&reply_, &completion_processor_);
+            break;
+            case FINISH_STARTED:
+                SILKRPC_WARN << "AsyncServerStreamingClient::completed stream closed error_code: " << result_.error_code()
+                    << " error_message: " << result_.error_message() << "\n";
+                status_ = CALL_IDLE;
+                if (on_reset_) {
+                    on_reset_();
+                }
+                if (!closed_) {
+                    retry_timer_.expires_after(retry_interval_);
+                    retry_timer_.async_wait([&](const asio::error_code& ec) {
+                        if (!ec && !closed_) {
+                            start_call();
+                        }
+                    });
+                }
+            break;
+            default:
+            break;
+        }
+    }
+
+    asio::io_context& io_context_;
+    std::unique_ptr<StubInterface> stub_;
+    grpc::CompletionQueue* queue_;
+    std::chrono::milliseconds retry_interval_;
+    asio::steady_timer retry_timer_;
+    Request request_;
+    ReplyHandler on_reply_;
+    ResetHandler on_reset_;
+    std::mutex context_access_;
+    std::unique_ptr<grpc::ClientContext> context_;
+    std::unique_ptr<grpc::ClientAsyncReaderInterface<Reply>> reader_;
+    Reply reply_;
+    grpc::Status result_;
+    CallStatus status_{CALL_IDLE};
+    std::atomic_bool closed_{false};
+    silkworm::rpc::TagProcessor completion_processor_;
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_GRPC_ASYNC_SERVER_STREAMING_CLIENT_HPP_
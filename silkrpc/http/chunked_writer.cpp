@@ -0,0 +1,86 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "chunked_writer.hpp"
+
+#include <array>
+#include <sstream>
+
+#include <asio/buffer.hpp>
+#include <asio/use_awaitable.hpp>
+#include <asio/write.hpp>
+
+#include <silkrpc/common/log.hpp>
+
+namespace silkrpc::http {
+
+constexpr std::string_view kChunkedReplyHeaders{
+    "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nTransfer-Encoding: chunked\r\n\r\n"};
+constexpr std::string_view kCrlf{"\r\n"};
+constexpr std::string_view kLastChunk{"0\r\n\r\n"};
+
+ChunkedWriter::ChunkedWriter(asio::ip::tcp::socket& socket, std::size_t chunk_size)
+    : socket_(socket), chunk_size_(chunk_size) {
+    buffer_.reserve(chunk_size_);
+}
+
+asio::awaitable<void> ChunkedWriter::write(std::string_view content) {
+    buffer_.append(content);
+    if (buffer_.size() >= chunk_size_) {
+        co_await flush();
+    }
+}
+
+asio::awaitable<void> ChunkedWriter::close() {
+    if (closed_) {
+        co_return;
+    }
+    if (!started_) {
+        // All the content fits into one chunk: send it as a plain reply
+        std::ostringstream headers;
+        headers << "HTTP/1.1 200 OK\r\nContent-Length: " << buffer_.size() << "\r\nContent-Type: application/json\r\n\r\n";
+        const auto headers_string = headers.str();
+        const std::array<asio::const_buffer, 2> buffers{asio::buffer(headers_string), asio::buffer(buffer_)};
+        co_await asio::async_write(socket_, buffers, asio::use_awaitable);
+        started_ = true;
+    } else {
+        co_await flush();
+        co_await asio::async_write(socket_, asio::buffer(kLastChunk), asio::use_awaitable);
+    }
+    buffer_.clear();
+    closed_ = true;
+    SILKRPC_TRACE << "ChunkedWriter::close reply completed\n";
+}
+
+asio::awaitable<void> ChunkedWriter::flush() {
+    if (buffer_.empty()) {
+        co_return;
+    }
+    std::ostringstream chunk_size;
+    chunk_size << std::hex << buffer_.size() << kCrlf;
+    const auto chunk_size_string = chunk_size.str();
+    const std::array<asio::const_buffer, 4> buffers{
+        asio::buffer(started_ ? std::string_view{} : kChunkedReplyHeaders),
+        asio::buffer(chunk_size_string),
+        asio::buffer(buffer_),
+        asio::buffer(kCrlf)};
+    const auto bytes_transferred = co_await asio::async_write(socket_, buffers, asio::use_awaitable);
+    SILKRPC_TRACE << "ChunkedWriter::flush bytes_transferred: " << bytes_transferred << "\n";
+    started_ = true;
+    buffer_.clear();
+}
+
+} // namespace silkrpc::http
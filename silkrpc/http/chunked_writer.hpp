@@ -0,0 +1,66 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_HTTP_CHUNKED_WRITER_HPP_
+#define SILKRPC_HTTP_CHUNKED_WRITER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <silkrpc/config.hpp>
+
+#include <asio/awaitable.hpp>
+#include <asio/ip/tcp.hpp>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/writer.hpp>
+
+namespace silkrpc::http {
+
+/// Writer sending the content of one reply to the client using HTTP chunked transfer encoding.
+/// Content is buffered up to the chunk size: if the whole content fits into one chunk, it is sent as
+/// a plain reply with Content-Length instead.
+class ChunkedWriter : public Writer {
+public:
+    explicit ChunkedWriter(asio::ip::tcp::socket& socket, std::size_t chunk_size = kHttpChunkSize);
+
+    ChunkedWriter(const ChunkedWriter&) = delete;
+    ChunkedWriter& operator=(const ChunkedWriter&) = delete;
+
+    asio::awaitable<void> write(std::string_view content) override;
+
+    asio::awaitable<void> close() override;
+
+    /// Whether some content has already been sent to the client.
+    bool started() const noexcept { return started_; }
+
+    /// Whether the reply has been completely sent to the client.
+    bool closed() const noexcept { return closed_; }
+
+private:
+    asio::awaitable<void> flush();
+
+    asio::ip::tcp::socket& socket_;
+    std::size_t chunk_size_;
+    std::string buffer_;
+    bool started_{false};
+    bool closed_{false};
+};
+
+} // namespace silkrpc::http
+
+#endif // SILKRPC_HTTP_CHUNKED_WRITER_HPP_
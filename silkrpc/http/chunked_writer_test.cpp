@@ -0,0 +1,70 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "chunked_writer.hpp"
+
+#include <string>
+#include <vector>
+
+#include <asio/co_spawn.hpp>
+#include <asio/connect.hpp>
+#include <asio/io_context.hpp>
+#include <asio/read.hpp>
+#include <asio/use_future.hpp>
+#include <catch2/catch.hpp>
+
+namespace silkrpc::http {
+
+static std::string write_and_read(std::size_t chunk_size, const std::vector<std::string>& contents) {
+    asio::io_context io_context;
+    asio::ip::tcp::acceptor acceptor{io_context, asio::ip::tcp::endpoint{asio::ip::address_v4::loopback(), 0}};
+    asio::ip::tcp::socket server_socket{io_context};
+    asio::ip::tcp::socket client_socket{io_context};
+    client_socket.connect(acceptor.local_endpoint());
+    acceptor.accept(server_socket);
+
+    ChunkedWriter writer{server_socket, chunk_size};
+    auto result = asio::co_spawn(io_context, [&]() -> asio::awaitable<void> {
+        for (const auto& content : contents) {
+            co_await writer.write(content);
+        }
+        co_await writer.close();
+        server_socket.close();
+    }, asio::use_future);
+    io_context.run();
+    result.get();
+
+    std::string received;
+    asio::error_code ec;
+    asio::read(client_socket, asio::dynamic_buffer(received), ec);
+    CHECK(ec == asio::error::eof);
+    return received;
+}
+
+TEST_CASE("ChunkedWriter", "[silkrpc][http][chunked_writer]") {
+    SECTION("content fitting into one chunk is sent as plain reply") {
+        const auto received = write_and_read(64, {"{\"result\":", "[]}"});
+        CHECK(received == "HTTP/1.1 200 OK\r\nContent-Length: 13\r\nContent-Type: application/json\r\n\r\n{\"result\":[]}");
+    }
+
+    SECTION("content exceeding chunk size is sent in chunks") {
+        const auto received = write_and_read(8, {"{\"result\":", "[1,2]}"});
+        CHECK(received == "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nTransfer-Encoding: chunked\r\n\r\n"
+            "a\r\n{\"result\":\r\n6\r\n[1,2]}\r\n0\r\n\r\n");
+    }
+}
+
+} // namespace silkrpc::http
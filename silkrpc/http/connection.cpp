@@ -23,6 +23,7 @@
 #include "connection.hpp"
 
 #include <exception>
+#include <memory>
 #include <system_error>
 #include <string_view>
 #include <utility>
@@ -34,11 +35,16 @@
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/common/util.hpp>
 #include <silkrpc/ethdb/database.hpp>
+#include <silkrpc/http/chunked_writer.hpp>
+#include <silkrpc/http/websocket.hpp>
+#include <silkrpc/http/websocket_session.hpp>
 
 namespace silkrpc::http {
 
-Connection::Connection(Context& context, asio::thread_pool& workers, commands::RpcApiTable& handler_table)
-: socket_{*context.io_context()}, request_handler_{context, workers, handler_table} {
+Connection::Connection(Context& context, asio::thread_pool& workers, commands::RpcApiTable& handler_table,
+    std::size_t max_batch_in_flight, std::size_t estimate_gas_probes)
+: socket_{*context.io_context()}, request_handler_{context, workers, handler_table, max_batch_in_flight, estimate_gas_probes},
+  subscription_hub_{context.subscription_hub()} {
     request_.content.reserve(kRequestContentInitialCapacity);
     request_.headers.reserve(kRequestHeadersInitialCapacity);
     request_.method.reserve(kRequestMethodInitialCapacity);
@@ -64,9 +70,17 @@ asio::awaitable<void> Connection::do_read() {
 
         RequestParser::ResultType result = request_parser_.parse(request_, buffer_.data(), buffer_.data() + bytes_read);
 
-        if (result == RequestParser::good) {
-            co_await request_handler_.handle_request(request_, reply_);
-            co_await do_write();
+        if (result == RequestParser::good && websocket::is_upgrade_request(request_)) {
+            // The socket is handed over to the WebSocket session, which serves it until closed
+            auto session = std::make_shared<WebSocketSession>(std::move(socket_), request_handler_, subscription_hub_);
+            co_await session->run(request_);
+            co_return;
+        } else if (result == RequestParser::good) {
+            ChunkedWriter chunked_writer{socket_};
+            co_await request_handler_.handle_request(request_, reply_, &chunked_writer);
+            if (!chunked_writer.started()) {
+                co_await do_write();
+            }
             clean();
         } else if (result == RequestParser::bad) {
             reply_ = Reply::stock_reply(Reply::bad_request);
@@ -24,6 +24,8 @@
 #define SILKRPC_HTTP_CONNECTION_HPP_
 
 #include <array>
+#include <cstddef>
+#include <memory>
 
 #include <silkrpc/config.hpp>
 
@@ -48,7 +50,8 @@ public:
     Connection& operator=(const Connection&) = delete;
 
     /// Construct a connection running within the given execution context.
-    Connection(Context& context, asio::thread_pool& workers, commands::RpcApiTable& handler_table);
+    Connection(Context& context, asio::thread_pool& workers, commands::RpcApiTable& handler_table,
+        std::size_t max_batch_in_flight = kDefaultMaxBatchInFlight, std::size_t estimate_gas_probes = kDefaultEstimateGasProbes);
 
     ~Connection();
 
@@ -73,6 +76,9 @@ private:
     /// The handler used to process the incoming request.
     RequestHandler request_handler_;
 
+    /// The hub where the subscriptions of the connection are registered once upgraded to WebSocket.
+    std::shared_ptr<SubscriptionHub> subscription_hub_;
+
     /// Buffer for incoming data.
     std::array<char, kHttpIncomingBufferSize> buffer_;
 
@@ -36,6 +36,7 @@ const std::string not_implemented = "HTTP/1.1 501 Not Implemented\r\n";
 const std::string bad_gateway = "HTTP/1.1 502 Bad Gateway\r\n";                     // NOLINT(runtime/string)
 const std::string service_unavailable = "HTTP/1.1 503 Service Unavailable\r\n";     // NOLINT(runtime/string)
 const std::string processing_continue = "HTTP/1.1 100 Continue\r\n";                // NOLINT(runtime/string)
+const std::string switching_protocols = "HTTP/1.1 101 Switching Protocols\r\n";     // NOLINT(runtime/string)
 
 asio::const_buffer to_buffer(Reply::StatusType status) {
     switch (status) {
@@ -73,6 +74,8 @@ asio::const_buffer to_buffer(Reply::StatusType status) {
             return asio::buffer(service_unavailable);
         case Reply::processing_continue:
             return asio::buffer(processing_continue);
+        case Reply::switching_protocols:
+            return asio::buffer(switching_protocols);
         default:
             return asio::buffer(internal_server_error);
     }
@@ -24,6 +24,7 @@ struct Reply {
     /// The status of the reply.
     enum StatusType {
         processing_continue = 100,
+        switching_protocols = 101,
         ok = 200,
         created = 201,
         accepted = 202,
@@ -22,9 +22,16 @@
 
 #include "request_handler.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <utility>
+#include <vector>
 
+#include <asio/co_spawn.hpp>
+#include <asio/redirect_error.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/this_coro.hpp>
+#include <asio/use_awaitable.hpp>
 #include <nlohmann/json.hpp>
 
 #include <silkrpc/common/clock_time.hpp>
@@ -33,11 +40,10 @@
 
 namespace silkrpc::http {
 
-asio::awaitable<void> RequestHandler::handle_request(const http::Request& request, http::Reply& reply) {
+asio::awaitable<void> RequestHandler::handle_request(const http::Request& request, http::Reply& reply, Writer* stream_writer) {
     SILKRPC_DEBUG << "handle_request content: " << request.content << "\n";
     auto start = clock_time::now();
 
-    auto request_id{0};
     try {
         if (request.content.empty()) {
             reply.content = "";
@@ -50,43 +56,33 @@ asio::awaitable<void> RequestHandler::handle_request(const http::Request& reques
         }
 
         const auto request_json = nlohmann::json::parse(request.content);
-        request_id = request_json["id"].get<uint32_t>();
-        if (!request_json.contains("method")) {
-            reply.content = make_json_error(request_id, -32600, "method missing").dump() + "\n";
-            reply.status = http::Reply::bad_request;
-            reply.headers.reserve(2);
-            reply.headers.emplace_back(http::Header{"Content-Length", std::to_string(reply.content.size())});
-            reply.headers.emplace_back(http::Header{"Content-Type", "application/json"});
-            SILKRPC_INFO << "handle_request t=" << clock_time::since(start) << "ns\n";
-            co_return;
-        }
 
-        const auto method = request_json["method"].get<std::string>();
-        const auto handle_method_opt = rpc_api_table_.find_handler(method);
-        if (!handle_method_opt) {
-            reply.content = make_json_error(request_id, -32601, "method not existent or not implemented: " + method).dump() + "\n";
-            reply.status = http::Reply::not_implemented;
-            reply.headers.reserve(2);
-            reply.headers.emplace_back(http::Header{"Content-Length", std::to_string(reply.content.size())});
-            reply.headers.emplace_back(http::Header{"Content-Type", "application/json"});
-            SILKRPC_INFO << "handle_request t=" << clock_time::since(start) << "ns\n";
-            co_return;
+        if (stream_writer && request_json.is_object() && request_json.contains("method")) {
+            const auto handle_stream_opt = rpc_api_table_.find_stream_handler(request_json["method"].get<std::string>());
+            if (handle_stream_opt) {
+                // The reply is written by the handler through the stream writer as it is produced
+                co_await (rpc_api_.*handle_stream_opt.value())(request_json, *stream_writer);
+                SILKRPC_INFO << "handle_request t=" << clock_time::since(start) << "ns\n";
+                co_return;
+            }
         }
-        const auto handle_method = handle_method_opt.value();
 
         nlohmann::json reply_json;
-        co_await (rpc_api_.*handle_method)(request_json, reply_json);
+        if (request_json.is_array()) {
+            reply.status = co_await handle_batch_request(request_json, reply_json);
+        } else {
+            reply.status = co_await handle_single_request(request_json, reply_json);
+        }
 
         reply.content = reply_json.dump(
             /*indent=*/-1, /*indent_char=*/' ', /*ensure_ascii=*/false, nlohmann::json::error_handler_t::replace) + "\n";
-        reply.status = http::Reply::ok;
     } catch (const std::exception& e) {
         SILKRPC_ERROR << "exception: " << e.what() << "\n";
-        reply.content = make_json_error(request_id, 100, e.what()).dump() + "\n";
+        reply.content = make_json_error(0, 100, e.what()).dump() + "\n";
         reply.status = http::Reply::internal_server_error;
     } catch (...) {
         SILKRPC_ERROR << "unexpected exception\n";
-        reply.content = make_json_error(request_id, 100, "unexpected exception").dump() + "\n";
+        reply.content = make_json_error(0, 100, "unexpected exception").dump() + "\n";
         reply.status = http::Reply::internal_server_error;
     }
 
@@ -98,4 +94,94 @@ asio::awaitable<void> RequestHandler::handle_request(const http::Request& reques
     co_return;
 }
 
+asio::awaitable<http::Reply::StatusType> RequestHandler::handle_single_request(const nlohmann::json& request_json, nlohmann::json& reply_json) {
+    auto request_id{0};
+    try {
+        if (!request_json.is_object()) {
+            reply_json = make_json_error(request_id, -32600, "invalid request");
+            co_return http::Reply::bad_request;
+        }
+
+        request_id = request_json["id"].get<uint32_t>();
+        if (!request_json.contains("method")) {
+            reply_json = make_json_error(request_id, -32600, "method missing");
+            co_return http::Reply::bad_request;
+        }
+
+        if (connection_handler_) {
+            if (auto connection_reply = connection_handler_(request_json)) {
+                reply_json = std::move(*connection_reply);
+                co_return http::Reply::ok;
+            }
+        }
+
+        const auto method = request_json["method"].get<std::string>();
+        const auto handle_method_opt = rpc_api_table_.find_handler(method);
+        if (!handle_method_opt) {
+            reply_json = make_json_error(request_id, -32601, "method not existent or not implemented: " + method);
+            co_return http::Reply::not_implemented;
+        }
+        const auto handle_method = handle_method_opt.value();
+
+        co_await (rpc_api_.*handle_method)(request_json, reply_json);
+
+        co_return http::Reply::ok;
+    } catch (const std::exception& e) {
+        SILKRPC_ERROR << "exception: " << e.what() << "\n";
+        reply_json = make_json_error(request_id, 100, e.what());
+    } catch (...) {
+        SILKRPC_ERROR << "unexpected exception\n";
+        reply_json = make_json_error(request_id, 100, "unexpected exception");
+    }
+
+    co_return http::Reply::internal_server_error;
+}
+
+asio::awaitable<http::Reply::StatusType> RequestHandler::handle_batch_request(const nlohmann::json& request_json, nlohmann::json& reply_json) {
+    const auto batch_size = request_json.size();
+    SILKRPC_DEBUG << "handle_batch_request batch_size: " << batch_size << "\n";
+
+    if (batch_size == 0) {
+        reply_json = make_json_error(0, -32600, "empty batch");
+        co_return http::Reply::bad_request;
+    }
+
+    // Each batch entry gets its own reply slot, so that the reply array keeps the request order
+    std::vector<nlohmann::json> entry_replies(batch_size);
+
+    // Spawn up to max_batch_in_flight_ executors on this context: each one picks the next batch entry until exhausted
+    const auto num_executors = std::min(batch_size, std::max<std::size_t>(max_batch_in_flight_, 1));
+    auto executor = co_await asio::this_coro::executor;
+    asio::steady_timer batch_completion{executor, asio::steady_timer::time_point::max()};
+    std::size_t next_entry{0};
+    std::size_t running_executors{num_executors};
+    for (std::size_t i{0}; i < num_executors; ++i) {
+        asio::co_spawn(executor, [&]() -> asio::awaitable<void> {
+            while (next_entry < batch_size) {
+                const auto entry_index = next_entry++;
+                co_await handle_single_request(request_json[entry_index], entry_replies[entry_index]);
+            }
+        }, [&](std::exception_ptr eptr) {
+            if (eptr) {
+                SILKRPC_ERROR << "handle_batch_request unexpected exception in batch executor\n";
+            }
+            if (--running_executors == 0) {
+                batch_completion.cancel();
+            }
+        });
+    }
+
+    // Wait for all the executors to complete: completion is signalled by cancelling the timer
+    asio::error_code ec;
+    co_await batch_completion.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    SILKRPC_DEBUG << "handle_batch_request batch_size: " << batch_size << " completed\n";
+
+    reply_json = nlohmann::json::array();
+    for (auto& entry_reply : entry_replies) {
+        reply_json.push_back(std::move(entry_reply));
+    }
+
+    co_return http::Reply::ok;
+}
+
 } // namespace silkrpc::http
@@ -17,15 +17,22 @@
 #ifndef SILKRPC_HTTP_REQUEST_HANDLER_HPP_
 #define SILKRPC_HTTP_REQUEST_HANDLER_HPP_
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 
 #include <silkrpc/config.hpp>
 
 #include <asio/awaitable.hpp>
 #include <asio/thread_pool.hpp>
+#include <nlohmann/json.hpp>
 
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/writer.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/commands/rpc_api.hpp>
 #include <silkrpc/commands/rpc_api_table.hpp>
@@ -36,17 +43,35 @@ namespace silkrpc::http {
 
 class RequestHandler {
 public:
-    RequestHandler(Context& context, asio::thread_pool& workers, const commands::RpcApiTable& rpc_api_table)
-        : rpc_api_{context, workers}, rpc_api_table_(rpc_api_table) {}
+    //! Handler of the methods bound to the connection (e.g. subscriptions), returning no reply for any other method.
+    using ConnectionHandler = std::function<std::optional<nlohmann::json>(const nlohmann::json& request_json)>;
+
+    RequestHandler(Context& context, asio::thread_pool& workers, const commands::RpcApiTable& rpc_api_table,
+        std::size_t max_batch_in_flight = kDefaultMaxBatchInFlight, std::size_t estimate_gas_probes = kDefaultEstimateGasProbes)
+        : rpc_api_{context, workers, estimate_gas_probes}, rpc_api_table_(rpc_api_table), max_batch_in_flight_{max_batch_in_flight} {}
 
     RequestHandler(const RequestHandler&) = delete;
     RequestHandler& operator=(const RequestHandler&) = delete;
 
-    asio::awaitable<void> handle_request(const http::Request& request, http::Reply& reply);
+    //! Handle the request, either filling the reply or, for methods supporting it, streaming the reply into the given writer.
+    asio::awaitable<void> handle_request(const http::Request& request, http::Reply& reply, Writer* stream_writer = nullptr);
+
+    //! Serve through the given handler the requests it replies to, both single and batch entries, before the API ones.
+    void set_connection_handler(ConnectionHandler connection_handler) { connection_handler_ = std::move(connection_handler); }
 
 private:
+    asio::awaitable<http::Reply::StatusType> handle_single_request(const nlohmann::json& request_json, nlohmann::json& reply_json);
+
+    asio::awaitable<http::Reply::StatusType> handle_batch_request(const nlohmann::json& request_json, nlohmann::json& reply_json);
+
     commands::RpcApi rpc_api_;
     const commands::RpcApiTable& rpc_api_table_;
+
+    //! The max number of batch entries executed concurrently for each batch request
+    std::size_t max_batch_in_flight_;
+
+    //! The handler of the methods bound to the connection, if any
+    ConnectionHandler connection_handler_;
 };
 
 } // namespace silkrpc::http
@@ -16,27 +16,51 @@
 
 #include "request_handler.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <asio/co_spawn.hpp>
 #include <asio/thread_pool.hpp>
 #include <asio/use_future.hpp>
 #include <catch2/catch.hpp>
+#include <grpcpp/grpcpp.h>
+#include <nlohmann/json.hpp>
 #include <silkworm/common/util.hpp>
 
+#include <silkrpc/commands/rpc_api_table.hpp>
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/common/log.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/http/request.hpp>
 #include <silkrpc/http/reply.hpp>
 #include <silkrpc/http/header.hpp>
+#include <silkrpc/json/types.hpp>
 
 namespace silkrpc::http {
 
 using Catch::Matchers::Message;
 
-TEST_CASE("check handle_request  empty content ", "[silkrpc][handle_request]") {
+static void handle_request(const Request& req, Reply& reply, std::size_t max_batch_in_flight = kDefaultMaxBatchInFlight,
+    RequestHandler::ConnectionHandler connection_handler = {}) {
+    ContextPool cp{1, []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); }};
+    auto context_pool_thread = std::thread([&]() { cp.run(); });
+    asio::thread_pool workers{1};
+    commands::RpcApiTable handler_table{"eth"};
+
+    RequestHandler h{cp.next_context(), workers, handler_table, max_batch_in_flight};
+    h.set_connection_handler(std::move(connection_handler));
+    auto result{asio::co_spawn(cp.next_io_context(), h.handle_request(req, reply), asio::use_future)};
+    CHECK_NOTHROW(result.get());
+
+    cp.stop();
+    context_pool_thread.join();
+}
+
+TEST_CASE("check handle_request empty content ", "[silkrpc][handle_request]") {
     silkrpc::http::Request req {
         "eth_call",
         "",
@@ -48,17 +72,7 @@ TEST_CASE("check handle_request  empty content ", "[silkrpc][handle_request]") {
     };
     silkrpc::http::Reply reply {};
 
-/*
-    ContextPool cp{1, []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); }};
-    auto context_pool_thread = std::thread([&]() { cp.run(); });
-    asio::thread_pool workers{1};
-    try {
-        silkrpc::http::RequestHandler h{cp.next_context(), workers};
-        auto result{asio::co_spawn(cp.next_io_context(), h.handle_request(req, reply), asio::use_future)};
-        result.get();
-    } catch (...) {
-       CHECK(false);
-    }
+    handle_request(req, reply);
 
     CHECK(reply.content == "");
     CHECK(reply.status == 204);
@@ -67,9 +81,6 @@ TEST_CASE("check handle_request  empty content ", "[silkrpc][handle_request]") {
     CHECK(reply.headers[0].value == "0");
     CHECK(reply.headers[1].name == "Content-Type");
     CHECK(reply.headers[1].value == "application/json");
-    cp.stop();
-    context_pool_thread.join();
-*/
 }
 
 TEST_CASE("check handle_request no method", "[silkrpc][handle_request]") {
@@ -84,18 +95,8 @@ TEST_CASE("check handle_request no method", "[silkrpc][handle_request]") {
     };
     silkrpc::http::Reply reply {};
 
-/*
-    ContextPool cp{1, []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); }};
-    auto context_pool_thread = std::thread([&]() { cp.run(); });
-    asio::thread_pool workers{1};
+    handle_request(req, reply);
 
-    try {
-        silkrpc::http::RequestHandler h{cp.next_context(), workers};
-        auto result{asio::co_spawn(cp.next_io_context(), h.handle_request(req, reply), asio::use_future)};
-        result.get();
-    } catch (...) {
-       CHECK(false);
-    }
     CHECK(reply.content == "{\"error\":{\"code\":-32600,\"message\":\"method missing\"},\"id\":3,\"jsonrpc\":\"2.0\"}\n");
     CHECK(reply.status == 400);
     CHECK(reply.headers.size() == 2);
@@ -103,9 +104,6 @@ TEST_CASE("check handle_request no method", "[silkrpc][handle_request]") {
     CHECK(reply.headers[0].value == "76");
     CHECK(reply.headers[1].name == "Content-Type");
     CHECK(reply.headers[1].value == "application/json");
-    cp.stop();
-    context_pool_thread.join();
-*/
 }
 
 TEST_CASE("check handle_request invalid method", "[silkrpc][handle_request]") {
@@ -120,28 +118,15 @@ TEST_CASE("check handle_request invalid method", "[silkrpc][handle_request]") {
     };
     silkrpc::http::Reply reply {};
 
-/*
-    ContextPool cp{1, []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); }};
-    auto context_pool_thread = std::thread([&]() { cp.run(); });
-    asio::thread_pool workers{1};
+    handle_request(req, reply);
 
-    try {
-        silkrpc::http::RequestHandler h{cp.next_context(), workers};
-        auto result{asio::co_spawn(cp.next_io_context(), h.handle_request(req, reply), asio::use_future)};
-        result.get();
-    } catch (...) {
-       CHECK(false);
-    }
-    CHECK(reply.content == "{\"error\":{\"code\":-32601,\"message\":\"method not existent or not implemented\"},\"id\":3,\"jsonrpc\":\"2.0\"}\n");
+    CHECK(reply.content == "{\"error\":{\"code\":-32601,\"message\":\"method not existent or not implemented: eth_AAA\"},\"id\":3,\"jsonrpc\":\"2.0\"}\n");
     CHECK(reply.status == 501);
     CHECK(reply.headers.size() == 2);
     CHECK(reply.headers[0].name == "Content-Length");
-    CHECK(reply.headers[0].value == "100");
+    CHECK(reply.headers[0].value == "109");
     CHECK(reply.headers[1].name == "Content-Type");
     CHECK(reply.headers[1].value == "application/json");
-    cp.stop();
-    context_pool_thread.join();
-*/
 }
 
 TEST_CASE("check handle_request method return failed", "[silkrpc][handle_request]") {
@@ -156,19 +141,8 @@ TEST_CASE("check handle_request method return failed", "[silkrpc][handle_request
     };
     silkrpc::http::Reply reply {};
 
-/*
-    ContextPool cp{1, []() { return grpc::CreateChannel("localhost", grpc::InsecureChannelCredentials()); }};
-    auto context_pool_thread = std::thread([&]() { cp.run(); });
-    asio::thread_pool workers{1};
+    handle_request(req, reply);
 
-    silkrpc::http::RequestHandler h{cp.next_context(), workers};
-    try {
-        silkrpc::http::RequestHandler h{cp.next_context(), workers};
-        auto result{asio::co_spawn(cp.next_io_context(), h.handle_request(req, reply), asio::use_future)};
-        result.get();
-    } catch (...) {
-       CHECK(false);
-    }
     CHECK(reply.content == "{\"error\":{\"code\":100,\"message\":\"invalid getBlockByNumber params: []\"},\"id\":3,\"jsonrpc\":\"2.0\"}\n");
     CHECK(reply.status == 200);
     CHECK(reply.headers.size() == 2);
@@ -176,10 +150,108 @@ TEST_CASE("check handle_request method return failed", "[silkrpc][handle_request
     CHECK(reply.headers[0].value == "94");
     CHECK(reply.headers[1].name == "Content-Type");
     CHECK(reply.headers[1].value == "application/json");
-    cp.stop();
-    context_pool_thread.join();
-*/
 }
 
-} // namespace silkrpc::http
+TEST_CASE("check handle_request empty batch", "[silkrpc][handle_request]") {
+    silkrpc::http::Request req {
+        "eth_call",
+        "",
+        1,
+        3,
+        {{"v", "1"}},
+        2,
+        "[]"
+    };
+    silkrpc::http::Reply reply {};
+
+    handle_request(req, reply);
+
+    CHECK(reply.content == "{\"error\":{\"code\":-32600,\"message\":\"empty batch\"},\"id\":0,\"jsonrpc\":\"2.0\"}\n");
+    CHECK(reply.status == 400);
+    CHECK(reply.headers.size() == 2);
+    CHECK(reply.headers[0].name == "Content-Length");
+    CHECK(reply.headers[0].value == "73");
+    CHECK(reply.headers[1].name == "Content-Type");
+    CHECK(reply.headers[1].value == "application/json");
+}
+
+TEST_CASE("check handle_request batch keeps entry order", "[silkrpc][handle_request]") {
+    silkrpc::http::Request req {
+        "eth_call",
+        "",
+        1,
+        3,
+        {{"v", "1"}},
+        115,
+        "[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"eth_AAA\"},{\"jsonrpc\":\"2.0\",\"id\":2 },{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"eth_BBB\"}]"
+    };
+    silkrpc::http::Reply reply {};
+
+    handle_request(req, reply, /*max_batch_in_flight=*/2);
+
+    const auto reply_json = nlohmann::json::parse(reply.content);
+    CHECK(reply_json.is_array());
+    CHECK(reply_json.size() == 3);
+    CHECK(reply_json[0]["id"] == 1);
+    CHECK(reply_json[0]["error"]["code"] == -32601);
+    CHECK(reply_json[1]["id"] == 2);
+    CHECK(reply_json[1]["error"]["code"] == -32600);
+    CHECK(reply_json[2]["id"] == 3);
+    CHECK(reply_json[2]["error"]["code"] == -32601);
+    CHECK(reply.status == 200);
+}
+
+static std::optional<nlohmann::json> handle_subscription(const nlohmann::json& request) {
+    if (request["method"] == "eth_subscribe") {
+        return make_json_content(request["id"], "0x01");
+    }
+    return std::nullopt;
+}
 
+TEST_CASE("check handle_request connection handler", "[silkrpc][handle_request]") {
+    SECTION("single request") {
+        silkrpc::http::Request req {
+            "eth_call",
+            "",
+            1,
+            3,
+            {{"v", "1"}},
+            71,
+            "{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"eth_subscribe\",\"params\":[\"newHeads\"]}"
+        };
+        silkrpc::http::Reply reply {};
+
+        handle_request(req, reply, kDefaultMaxBatchInFlight, handle_subscription);
+
+        CHECK(reply.content == "{\"id\":3,\"jsonrpc\":\"2.0\",\"result\":\"0x01\"}\n");
+        CHECK(reply.status == 200);
+    }
+
+    SECTION("batch request") {
+        silkrpc::http::Request req {
+            "eth_call",
+            "",
+            1,
+            3,
+            {{"v", "1"}},
+            143,
+            "[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"eth_AAA\"},{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"eth_subscribe\",\"params\":[\"newHeads\"]},{\"jsonrpc\":\"2.0\",\"id\":3 }]"
+        };
+        silkrpc::http::Reply reply {};
+
+        handle_request(req, reply, /*max_batch_in_flight=*/2, handle_subscription);
+
+        const auto reply_json = nlohmann::json::parse(reply.content);
+        CHECK(reply_json.is_array());
+        CHECK(reply_json.size() == 3);
+        CHECK(reply_json[0]["id"] == 1);
+        CHECK(reply_json[0]["error"]["code"] == -32601);
+        CHECK(reply_json[1]["id"] == 2);
+        CHECK(reply_json[1]["result"] == "0x01");
+        CHECK(reply_json[2]["id"] == 3);
+        CHECK(reply_json[2]["error"]["code"] == -32600);
+        CHECK(reply.status == 200);
+    }
+}
+
+} // namespace silkrpc::http
@@ -24,6 +24,8 @@
 
 #include <algorithm>
 
+#include "websocket.hpp"
+
 namespace silkrpc::http {
 
 RequestParser::RequestParser() : state_(method_start) {
@@ -214,7 +216,8 @@ RequestParser::ResultType RequestParser::consume(Request& req, char input) {
                         return h.name == "Content-Length";
                     });
                     if (it == req.headers.end()) {
-                        return bad;
+                        // Only protocol upgrade requests (e.g. WebSocket handshake) can come without content
+                        return websocket::is_upgrade_request(req) ? good : bad;
                     }
                     req.content_length = std::atoi((*it).value.c_str());
                 }
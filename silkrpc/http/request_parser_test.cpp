@@ -94,6 +94,7 @@ TEST_CASE("parse", "[silkrpc][http][request_parser]") {
             "POST / HTTP/1.1\r\nHost: localhost:8545\r\nUser-Agent: curl/7.68.0\r\nAccept: */*\r\nContent-Type: application/json\r\nContent-Length: 0\r\n\r\t", // invalid char instead of \n
             "POST / HTTP/1.1\r\nHost: localhost:8545\r\nUser-Agent: curl/7.68.0\r\nAccept: */*\r\nContent-Type: application/json\r\nContent-Length: 0\r\n{", // missing \r\n
             "POST / HTTP/1.1\r\nExpect: 100-continue\r\n\r\n",
+            "GET / HTTP/1.1\r\nHost: localhost:8545\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n\r\n", // missing Sec-WebSocket-Key
         };
         for (const auto& s : bad_requests) {
             silkrpc::http::RequestParser parser;
@@ -131,6 +132,7 @@ TEST_CASE("parse", "[silkrpc][http][request_parser]") {
             "POST / HTTP/1.1\r\nHost: localhost:8545 \r\nUser-Agent: curl/7.68.0 \r\nAccept: */* \r\nContent-Type: application/json \r\nContent-Length: 0\r\n\r\n",
             "POST / HTTP/1.1\r\nHost: localhost:8545\r\n User-Agent: curl/7.68.0\r\n Accept: */*\r\n Content-Type: application/json\r\nContent-Length: 0\r\n\r\n",
             "POST / HTTP/1.1\r\nHost: localhost:8545\r\n User-Agent: curl/7.68.0\r\n Accept: */*\r\n Content-Type: application/json\r\nContent-Length: 15\r\n\r\n{\"json\": \"2.0\"}",
+            "GET / HTTP/1.1\r\nHost: localhost:8545\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n",
         };
         for (const auto& s : good_requests) {
             silkrpc::http::RequestParser parser;
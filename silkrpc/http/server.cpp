@@ -47,8 +47,10 @@ std::tuple<std::string, std::string> Server::parse_endpoint(const std::string& t
     return {host, port};
 }
 
-Server::Server(const std::string& end_point, const std::string& api_spec, Context& context, asio::thread_pool& workers)
-: context_(context), workers_(workers), acceptor_{*context.io_context()}, handler_table_{api_spec} {
+Server::Server(const std::string& end_point, const std::string& api_spec, Context& context, asio::thread_pool& workers,
+    std::size_t max_batch_in_flight, std::size_t estimate_gas_probes)
+: context_(context), workers_(workers), acceptor_{*context.io_context()}, handler_table_{api_spec}, max_batch_in_flight_{max_batch_in_flight},
+  estimate_gas_probes_{estimate_gas_probes} {
     const auto [host, port] = parse_endpoint(end_point);
 
     // Open the acceptor with the option to reuse the address (i.e. SO_REUSEADDR).
@@ -75,7 +77,7 @@ asio::awaitable<void> Server::run() {
 
             SILKRPC_DEBUG << "Server::start accepting using io_context " << io_context << "...\n" << std::flush;
 
-            auto new_connection = std::make_shared<Connection>(context_, workers_, handler_table_);
+            auto new_connection = std::make_shared<Connection>(context_, workers_, handler_table_, max_batch_in_flight_, estimate_gas_probes_);
             co_await acceptor_.async_accept(new_connection->socket(), asio::use_awaitable);
             if (!acceptor_.is_open()) {
                 SILKRPC_TRACE << "Server::start returning...\n";
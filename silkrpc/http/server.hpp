@@ -23,6 +23,7 @@
 #ifndef SILKRPC_HTTP_SERVER_HPP_
 #define SILKRPC_HTTP_SERVER_HPP_
 
+#include <cstddef>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -33,6 +34,7 @@
 #include <asio/ip/tcp.hpp>
 #include <asio/thread_pool.hpp>
 
+#include <silkrpc/common/constants.hpp>
 #include <silkrpc/concurrency/context_pool.hpp>
 #include <silkrpc/http/request_handler.hpp>
 
@@ -47,7 +49,8 @@ public:
     Server& operator=(const Server&) = delete;
 
     // Construct the server to listen on the specified local TCP end-point
-    explicit Server(const std::string& end_point, const std::string& api_spec, Context& context, asio::thread_pool& workers);
+    explicit Server(const std::string& end_point, const std::string& api_spec, Context& context, asio::thread_pool& workers,
+        std::size_t max_batch_in_flight = kDefaultMaxBatchInFlight, std::size_t estimate_gas_probes = kDefaultEstimateGasProbes);
 
     void start();
 
@@ -68,6 +71,12 @@ private:
     asio::ip::tcp::acceptor acceptor_;
 
     asio::thread_pool& workers_;
+
+    // The max number of concurrent entries for each batch request
+    std::size_t max_batch_in_flight_;
+
+    // The number of gas limits executed concurrently at each eth_estimateGas search step
+    std::size_t estimate_gas_probes_;
 };
 
 } // namespace silkrpc::http
@@ -0,0 +1,196 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "websocket.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/uuid/detail/sha1.hpp>
+
+#include <silkrpc/common/util.hpp>
+
+namespace silkrpc::http::websocket {
+
+static const char* kWebSocketGuid{"258EAFA5-E914-47DA-95CA-C5AB0DC85B11"};
+
+static bool iequals(std::string_view lhs, std::string_view rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
+}
+
+static bool icontains(std::string_view text, std::string_view token) {
+    if (token.size() > text.size()) {
+        return false;
+    }
+    for (std::size_t i{0}; i <= text.size() - token.size(); ++i) {
+        if (iequals(text.substr(i, token.size()), token)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::optional<std::string_view> find_header(const Request& request, std::string_view name) {
+    const auto it = std::find_if(request.headers.begin(), request.headers.end(), [&](const Header& h) { return iequals(h.name, name); });
+    if (it == request.headers.end()) {
+        return std::nullopt;
+    }
+    return it->value;
+}
+
+bool is_upgrade_request(const Request& request) {
+    const auto upgrade = find_header(request, "Upgrade");
+    const auto connection = find_header(request, "Connection");
+    const auto key = find_header(request, "Sec-WebSocket-Key");
+    return request.method == "GET" && upgrade && iequals(*upgrade, "websocket") && connection && icontains(*connection, "upgrade") &&
+        key && !key->empty();
+}
+
+std::string accept_key(std::string_view key) {
+    std::string challenge{key};
+    challenge.append(kWebSocketGuid);
+    boost::uuids::detail::sha1 sha1;
+    sha1.process_bytes(challenge.data(), challenge.size());
+    boost::uuids::detail::sha1::digest_type words;
+    sha1.get_digest(words);
+
+    // Older Boost versions return the digest as 32-bit words, to be serialized in big-endian order
+    std::array<uint8_t, 20> digest{};
+    constexpr std::size_t kWordSize{sizeof(words[0])};
+    for (std::size_t i{0}; i < digest.size(); ++i) {
+        digest[i] = static_cast<uint8_t>(words[i / kWordSize] >> (8 * (kWordSize - 1 - i % kWordSize)));
+    }
+    return base64_encode(digest.data(), digest.size(), /*url=*/false);
+}
+
+Reply handshake_reply(const Request& request) {
+    Reply reply;
+    reply.status = Reply::switching_protocols;
+    reply.headers.reserve(3);
+    reply.headers.emplace_back(Header{"Upgrade", "websocket"});
+    reply.headers.emplace_back(Header{"Connection", "Upgrade"});
+    reply.headers.emplace_back(Header{"Sec-WebSocket-Accept", accept_key(find_header(request, "Sec-WebSocket-Key").value_or(""))});
+    return reply;
+}
+
+std::string encode_frame(Opcode opcode, std::string_view payload) {
+    std::string frame;
+    frame.reserve(payload.size() + 10);
+    frame.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));
+    const uint64_t size{payload.size()};
+    if (size < 126) {
+        frame.push_back(static_cast<char>(size));
+    } else if (size <= 0xFFFF) {
+        frame.push_back(static_cast<char>(126));
+        frame.push_back(static_cast<char>((size >> 8) & 0xFF));
+        frame.push_back(static_cast<char>(size & 0xFF));
+    } else {
+        frame.push_back(static_cast<char>(127));
+        for (int i{7}; i >= 0; --i) {
+            frame.push_back(static_cast<char>((size >> (i * 8)) & 0xFF));
+        }
+    }
+    frame.append(payload);
+    return frame;
+}
+
+std::optional<Frame> FrameParser::next() {
+    if (buffer_.size() < 2) {
+        return std::nullopt;
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(buffer_.data());
+    const bool fin = (data[0] & 0x80) != 0;
+    if ((data[0] & 0x70) != 0) {
+        throw std::runtime_error{"websocket frame with reserved bits set"};
+    }
+    const auto opcode = static_cast<Opcode>(data[0] & 0x0F);
+    const bool is_control = (data[0] & 0x08) != 0;
+    if ((data[0] & 0x0F) > 0xA || (!is_control && (data[0] & 0x0F) > 0x2)) {
+        throw std::runtime_error{"websocket frame with unknown opcode"};
+    }
+    if (is_control && (!fin || (data[1] & 0x7F) > 125)) {
+        throw std::runtime_error{"websocket control frame fragmented or too large"};
+    }
+    const bool masked = (data[1] & 0x80) != 0;
+    if (!masked) {
+        throw std::runtime_error{"websocket client frame not masked"};
+    }
+
+    std::size_t header_size{2};
+    uint64_t payload_size{data[1] & 0x7Fu};
+    if (payload_size == 126) {
+        header_size += 2;
+        if (buffer_.size() < header_size) {
+            return std::nullopt;
+        }
+        payload_size = (uint64_t{data[2]} << 8) | uint64_t{data[3]};
+    } else if (payload_size == 127) {
+        header_size += 8;
+        if (buffer_.size() < header_size) {
+            return std::nullopt;
+        }
+        payload_size = 0;
+        for (std::size_t i{2}; i < 10; ++i) {
+            payload_size = (payload_size << 8) | uint64_t{data[i]};
+        }
+    }
+    if (payload_size > max_payload_size_) {
+        throw std::runtime_error{"websocket frame too large: " + std::to_string(payload_size)};
+    }
+    header_size += 4;
+    if (buffer_.size() < header_size + payload_size) {
+        return std::nullopt;
+    }
+
+    const uint8_t* mask = data + header_size - 4;
+    Frame frame{fin, opcode, buffer_.substr(header_size, payload_size)};
+    for (std::size_t i{0}; i < frame.payload.size(); ++i) {
+        frame.payload[i] = static_cast<char>(static_cast<uint8_t>(frame.payload[i]) ^ mask[i % 4]);
+    }
+    buffer_.erase(0, header_size + payload_size);
+    return frame;
+}
+
+std::optional<std::string> MessageAssembler::add(Frame&& frame) {
+    if (frame.opcode == Opcode::kContinuation) {
+        if (!in_progress_) {
+            throw std::runtime_error{"websocket continuation frame without message"};
+        }
+    } else if (in_progress_) {
+        throw std::runtime_error{"websocket data frame within fragmented message"};
+    }
+    if (message_.size() + frame.payload.size() > max_message_size_) {
+        throw std::runtime_error{"websocket message too large"};
+    }
+    if (frame.fin && !in_progress_) {
+        return std::move(frame.payload);
+    }
+    message_.append(frame.payload);
+    in_progress_ = !frame.fin;
+    if (in_progress_) {
+        return std::nullopt;
+    }
+    std::string message;
+    message.swap(message_);
+    return message;
+}
+
+} // namespace silkrpc::http::websocket
@@ -0,0 +1,94 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_HTTP_WEBSOCKET_HPP_
+#define SILKRPC_HTTP_WEBSOCKET_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/http/reply.hpp>
+#include <silkrpc/http/request.hpp>
+
+namespace silkrpc::http::websocket {
+
+/// Frame opcodes as defined in RFC 6455.
+enum class Opcode : uint8_t {
+    kContinuation = 0x0,
+    kText = 0x1,
+    kBinary = 0x2,
+    kClose = 0x8,
+    kPing = 0x9,
+    kPong = 0xA,
+};
+
+/// A complete frame received from a client, payload already unmasked.
+struct Frame {
+    bool fin{true};
+    Opcode opcode{Opcode::kText};
+    std::string payload;
+};
+
+/// Whether the request asks to upgrade the connection to the WebSocket protocol.
+bool is_upgrade_request(const Request& request);
+
+/// The Sec-WebSocket-Accept value answering the given Sec-WebSocket-Key.
+std::string accept_key(std::string_view key);
+
+/// The 101 Switching Protocols reply completing the handshake of the given upgrade request.
+Reply handshake_reply(const Request& request);
+
+/// Encode one unfragmented server frame, which is never masked.
+std::string encode_frame(Opcode opcode, std::string_view payload);
+
+/// Incremental parser of the frames sent by a client, which must always be masked.
+class FrameParser {
+public:
+    explicit FrameParser(std::size_t max_payload_size = kMaxWebSocketMessageSize) : max_payload_size_(max_payload_size) {}
+
+    /// Append the received bytes to the data to parse.
+    void feed(const char* begin, const char* end) { buffer_.append(begin, end); }
+
+    /// Extract the next complete frame, if any. Throws std::runtime_error if data violates the protocol.
+    std::optional<Frame> next();
+
+private:
+    std::size_t max_payload_size_;
+    std::string buffer_;
+};
+
+/// Reassembler of fragmented messages on top of FrameParser frames.
+class MessageAssembler {
+public:
+    explicit MessageAssembler(std::size_t max_message_size = kMaxWebSocketMessageSize) : max_message_size_(max_message_size) {}
+
+    /// Add one data frame, returning the complete message once its final fragment arrives.
+    /// Throws std::runtime_error if fragments are out of sequence or the message is too large.
+    std::optional<std::string> add(Frame&& frame);
+
+private:
+    std::size_t max_message_size_;
+    std::string message_;
+    bool in_progress_{false};
+};
+
+} // namespace silkrpc::http::websocket
+
+#endif // SILKRPC_HTTP_WEBSOCKET_HPP_
@@ -0,0 +1,243 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "websocket_session.hpp"
+
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <asio/co_spawn.hpp>
+#include <asio/post.hpp>
+#include <asio/redirect_error.hpp>
+#include <asio/use_awaitable.hpp>
+#include <asio/write.hpp>
+
+#include <silkrpc/common/log.hpp>
+#include <silkrpc/common/writer.hpp>
+#include <silkrpc/http/reply.hpp>
+#include <silkrpc/json/types.hpp>
+#include <silkrpc/types/filter.hpp>
+
+namespace silkrpc::http {
+
+// Status code of the close frame sent on protocol violations, see RFC 6455 section 7.4.1
+static const char* kCloseProtocolError{"\x03\xea"};
+
+WebSocketSession::WebSocketSession(asio::ip::tcp::socket&& socket, RequestHandler& request_handler,
+    std::shared_ptr<SubscriptionHub> subscription_hub, std::size_t max_pending_frames)
+: socket_{std::move(socket)}, request_handler_(request_handler), subscription_hub_{std::move(subscription_hub)}, write_signal_{socket_.get_executor()}, max_pending_frames_{max_pending_frames} {
+    SILKRPC_DEBUG << "WebSocketSession::WebSocketSession socket " << &socket_ << " created\n";
+}
+
+WebSocketSession::~WebSocketSession() {
+    for (const auto& subscription_id : subscriptions_) {
+        subscription_hub_->unsubscribe(subscription_id);
+    }
+    asio::error_code ec;
+    socket_.close(ec);
+    SILKRPC_DEBUG << "WebSocketSession::~WebSocketSession socket " << &socket_ << " deleted\n";
+}
+
+asio::awaitable<void> WebSocketSession::run(const Request& upgrade_request) {
+    auto reply = websocket::handshake_reply(upgrade_request);
+    co_await asio::async_write(socket_, reply.to_buffers(), asio::use_awaitable);
+    SILKRPC_DEBUG << "WebSocketSession::run handshake completed for socket " << &socket_ << "\n";
+
+    // Subscription management is connection-bound, hence served here instead of by the API, also within batches
+    request_handler_.set_connection_handler([this](const nlohmann::json& request) -> std::optional<nlohmann::json> {
+        const auto& method = request["method"];
+        if (method == "eth_subscribe") {
+            return handle_subscribe(request);
+        }
+        if (method == "eth_unsubscribe") {
+            return handle_unsubscribe(request);
+        }
+        return std::nullopt;
+    });
+
+    // The writer keeps this session alive until all the queued frames have been written
+    asio::co_spawn(socket_.get_executor(), [self = shared_from_this()]() -> asio::awaitable<void> {
+        co_await self->do_write();
+    }, [](std::exception_ptr eptr) {
+        if (eptr) {
+            SILKRPC_ERROR << "WebSocketSession::run unexpected exception in writer\n";
+        }
+    });
+
+    co_await do_read();
+    request_handler_.set_connection_handler({});
+
+    // Stop the notifications as soon as the client has gone
+    for (const auto& subscription_id : subscriptions_) {
+        subscription_hub_->unsubscribe(subscription_id);
+    }
+    subscriptions_.clear();
+    close();
+}
+
+asio::awaitable<void> WebSocketSession::do_read() {
+    try {
+        while (!closed_) {
+            const auto bytes_read = co_await socket_.async_read_some(asio::buffer(buffer_), asio::use_awaitable);
+            SILKRPC_TRACE << "WebSocketSession::do_read bytes_read: " << bytes_read << "\n";
+            frame_parser_.feed(buffer_.data(), buffer_.data() + bytes_read);
+
+            while (auto frame = frame_parser_.next()) {
+                switch (frame->opcode) {
+                    case websocket::Opcode::kPing:
+                        enqueue(websocket::encode_frame(websocket::Opcode::kPong, frame->payload));
+                        break;
+                    case websocket::Opcode::kPong:
+                        break;
+                    case websocket::Opcode::kClose:
+                        // Echo the status code, if any, to complete the closing handshake
+                        enqueue(websocket::encode_frame(websocket::Opcode::kClose, frame->payload.substr(0, 2)));
+                        co_return;
+                    default:
+                        if (const auto message = message_assembler_.add(std::move(*frame))) {
+                            const auto reply = co_await handle_message(*message);
+                            if (!reply.empty()) {
+                                enqueue(websocket::encode_frame(websocket::Opcode::kText, reply));
+                            }
+                        }
+                }
+            }
+        }
+    } catch (const std::system_error& se) {
+        if (se.code() == asio::error::eof || se.code() == asio::error::connection_reset || se.code() == asio::error::broken_pipe) {
+            SILKRPC_DEBUG << "WebSocketSession::do_read close from client with code: " << se.code() << "\n" << std::flush;
+        } else if (se.code() != asio::error::operation_aborted) {
+            SILKRPC_ERROR << "WebSocketSession::do_read system_error: " << se.what() << "\n" << std::flush;
+        }
+    } catch (const std::runtime_error& re) {
+        SILKRPC_WARN << "WebSocketSession::do_read protocol error: " << re.what() << "\n" << std::flush;
+        enqueue(websocket::encode_frame(websocket::Opcode::kClose, kCloseProtocolError));
+    }
+}
+
+asio::awaitable<void> WebSocketSession::do_write() {
+    try {
+        while (true) {
+            while (!pending_frames_.empty()) {
+                const auto frame = std::move(pending_frames_.front());
+                pending_frames_.pop_front();
+                co_await asio::async_write(socket_, asio::buffer(frame), asio::use_awaitable);
+            }
+            if (closed_) {
+                break;
+            }
+            // Wait for new frames or closure: both are signalled by cancelling the timer
+            asio::error_code ec;
+            write_signal_.expires_at(asio::steady_timer::time_point::max());
+            co_await write_signal_.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        }
+    } catch (const std::system_error& se) {
+        SILKRPC_DEBUG << "WebSocketSession::do_write system_error: " << se.what() << "\n" << std::flush;
+    }
+
+    asio::error_code ec;
+    socket_.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+    socket_.close(ec);
+}
+
+asio::awaitable<std::string> WebSocketSession::handle_message(const std::string& message) {
+    Request request;
+    request.content = message;
+    Reply reply;
+    StringWriter writer;
+    co_await request_handler_.handle_request(request, reply, &writer);
+    co_return writer.content().empty() ? std::move(reply.content) : writer.content();
+}
+
+nlohmann::json WebSocketSession::handle_subscribe(const nlohmann::json& request) {
+    const auto& params = request["params"];
+    if (!params.is_array() || params.empty() || params.size() > 2 || !params[0].is_string()) {
+        return make_json_error(request["id"], -32602, "invalid eth_subscribe params: " + params.dump());
+    }
+    const auto kind_name = params[0].get<std::string>();
+
+    SubscriptionHub::SubscriptionKind kind;
+    std::optional<Filter> filter;
+    if (kind_name == "newHeads") {
+        kind = SubscriptionHub::SubscriptionKind::kNewHeads;
+    } else if (kind_name == "logs") {
+        kind = SubscriptionHub::SubscriptionKind::kLogs;
+        if (params.size() == 2) {
+            filter = params[1].get<Filter>();
+        }
+    } else if (kind_name == "newPendingTransactions") {
+        kind = SubscriptionHub::SubscriptionKind::kNewPendingTransactions;
+    } else {
+        return make_json_error(request["id"], -32602, "unsupported subscription: " + kind_name);
+    }
+
+    // Notifications come from the publishing thread: hand them off to the connection executor
+    auto notifier = [weak_self = weak_from_this(), executor = socket_.get_executor()](const std::string& notification) {
+        asio::post(executor, [weak_self, frame = websocket::encode_frame(websocket::Opcode::kText, notification)]() mutable {
+            if (auto self = weak_self.lock()) {
+                self->enqueue(std::move(frame));
+            }
+        });
+    };
+
+    try {
+        const auto subscription_id = subscription_hub_->subscribe(kind, std::move(notifier), std::move(filter));
+        subscriptions_.insert(subscription_id);
+        SILKRPC_DEBUG << "WebSocketSession::handle_subscribe " << kind_name << " subscription: " << subscription_id << "\n";
+        return make_json_content(request["id"], subscription_id);
+    } catch (const std::invalid_argument& ia) {
+        return make_json_error(request["id"], -32000, ia.what());
+    }
+}
+
+nlohmann::json WebSocketSession::handle_unsubscribe(const nlohmann::json& request) {
+    const auto& params = request["params"];
+    if (!params.is_array() || params.size() != 1 || !params[0].is_string()) {
+        return make_json_error(request["id"], -32602, "invalid eth_unsubscribe params: " + params.dump());
+    }
+    const auto subscription_id = params[0].get<std::string>();
+
+    // Only the subscriptions registered by this session can be removed through it
+    const bool removed = subscriptions_.erase(subscription_id) > 0 && subscription_hub_->unsubscribe(subscription_id);
+    return make_json_content(request["id"], removed);
+}
+
+void WebSocketSession::enqueue(std::string frame) {
+    if (closed_) {
+        return;
+    }
+    if (pending_frames_.size() >= max_pending_frames_) {
+        SILKRPC_WARN << "WebSocketSession::enqueue client too slow, dropping socket " << &socket_ << "\n";
+        pending_frames_.clear();
+        closed_ = true;
+        asio::error_code ec;
+        socket_.close(ec);
+        write_signal_.cancel();
+        return;
+    }
+    pending_frames_.push_back(std::move(frame));
+    write_signal_.cancel();
+}
+
+void WebSocketSession::close() {
+    closed_ = true;
+    write_signal_.cancel();
+}
+
+} // namespace silkrpc::http
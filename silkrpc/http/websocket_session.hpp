@@ -0,0 +1,113 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_HTTP_WEBSOCKET_SESSION_HPP_
+#define SILKRPC_HTTP_WEBSOCKET_SESSION_HPP_
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <silkrpc/config.hpp>
+
+#include <asio/awaitable.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/steady_timer.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/common/subscription_hub.hpp>
+#include <silkrpc/http/request.hpp>
+#include <silkrpc/http/request_handler.hpp>
+#include <silkrpc/http/websocket.hpp>
+
+namespace silkrpc::http {
+
+/// A connection upgraded to the WebSocket protocol.
+/// Each text message carries one JSON-RPC request (or batch) and gets its reply back as one text message. Additionally,
+/// eth_subscribe and eth_unsubscribe are served here by registering into SubscriptionHub subscriptions owned by this
+/// session, whose notifications are queued and pushed to the client until the session ends.
+class WebSocketSession : public std::enable_shared_from_this<WebSocketSession> {
+public:
+    WebSocketSession(const WebSocketSession&) = delete;
+    WebSocketSession& operator=(const WebSocketSession&) = delete;
+
+    /// Take over the given socket, using the given handler to process the requests and the given hub to register the
+    /// subscriptions, which are served as connection-bound methods of the handler. The handler must outlive the run operation.
+    WebSocketSession(asio::ip::tcp::socket&& socket, RequestHandler& request_handler, std::shared_ptr<SubscriptionHub> subscription_hub,
+        std::size_t max_pending_frames = kMaxWebSocketPendingFrames);
+
+    ~WebSocketSession();
+
+    /// Complete the handshake for the given upgrade request and serve the connection until it gets closed.
+    asio::awaitable<void> run(const Request& upgrade_request);
+
+private:
+    /// Read the client frames and handle the complete messages.
+    asio::awaitable<void> do_read();
+
+    /// Write the queued frames as they come.
+    asio::awaitable<void> do_write();
+
+    /// Process one text message, returning the reply to send if any.
+    asio::awaitable<std::string> handle_message(const std::string& message);
+
+    /// Handle eth_subscribe and eth_unsubscribe requests.
+    nlohmann::json handle_subscribe(const nlohmann::json& request);
+    nlohmann::json handle_unsubscribe(const nlohmann::json& request);
+
+    /// Queue the given frame for writing, must be called on the socket executor.
+    void enqueue(std::string frame);
+
+    /// Stop serving the connection, must be called on the socket executor.
+    void close();
+
+    /// Socket for the connection.
+    asio::ip::tcp::socket socket_;
+
+    /// The handler used to process the requests, including subscriptions while the session runs.
+    RequestHandler& request_handler_;
+
+    /// The hub where the subscriptions of this session are registered.
+    std::shared_ptr<SubscriptionHub> subscription_hub_;
+
+    /// Signal raised when new frames are queued or the session is closed.
+    asio::steady_timer write_signal_;
+
+    /// The frames waiting to be written.
+    std::deque<std::string> pending_frames_;
+
+    /// The max number of frames waiting to be written before the client is considered too slow and dropped.
+    std::size_t max_pending_frames_;
+
+    /// The identifiers of the subscriptions registered by this session.
+    std::set<std::string> subscriptions_;
+
+    /// Buffer for incoming data.
+    std::array<char, kHttpIncomingBufferSize> buffer_;
+
+    websocket::FrameParser frame_parser_;
+    websocket::MessageAssembler message_assembler_;
+
+    bool closed_{false};
+};
+
+} // namespace silkrpc::http
+
+#endif // SILKRPC_HTTP_WEBSOCKET_SESSION_HPP_
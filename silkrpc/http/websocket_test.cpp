@@ -0,0 +1,203 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "websocket.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+namespace silkrpc::http::websocket {
+
+static std::string mask_frame(uint8_t first_byte, const std::string& payload) {
+    const uint8_t mask[4]{0x37, 0xfa, 0x21, 0x3d};
+    std::string frame;
+    frame.push_back(static_cast<char>(first_byte));
+    if (payload.size() < 126) {
+        frame.push_back(static_cast<char>(0x80 | payload.size()));
+    } else {
+        frame.push_back(static_cast<char>(0x80 | 126));
+        frame.push_back(static_cast<char>((payload.size() >> 8) & 0xFF));
+        frame.push_back(static_cast<char>(payload.size() & 0xFF));
+    }
+    frame.append(reinterpret_cast<const char*>(mask), 4);
+    for (std::size_t i{0}; i < payload.size(); ++i) {
+        frame.push_back(static_cast<char>(static_cast<uint8_t>(payload[i]) ^ mask[i % 4]));
+    }
+    return frame;
+}
+
+static Request upgrade_request() {
+    Request request;
+    request.method = "GET";
+    request.uri = "/";
+    request.headers = {
+        {"Host", "localhost:8545"},
+        {"upgrade", "WebSocket"},
+        {"Connection", "keep-alive, Upgrade"},
+        {"Sec-WebSocket-Key", "dGhlIHNhbXBsZSBub25jZQ=="},
+        {"Sec-WebSocket-Version", "13"},
+    };
+    return request;
+}
+
+TEST_CASE("is_upgrade_request", "[silkrpc][http][websocket]") {
+    SECTION("upgrade request") {
+        CHECK(is_upgrade_request(upgrade_request()));
+    }
+
+    SECTION("plain request") {
+        Request request;
+        request.method = "POST";
+        request.headers = {{"Content-Length", "0"}};
+        CHECK(!is_upgrade_request(request));
+    }
+
+    SECTION("missing key") {
+        auto request{upgrade_request()};
+        request.headers.erase(request.headers.begin() + 3);
+        CHECK(!is_upgrade_request(request));
+    }
+}
+
+TEST_CASE("accept_key", "[silkrpc][http][websocket]") {
+    // Test vector from RFC 6455 section 1.3
+    CHECK(accept_key("dGhlIHNhbXBsZSBub25jZQ==") == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST_CASE("handshake_reply", "[silkrpc][http][websocket]") {
+    const auto reply{handshake_reply(upgrade_request())};
+    CHECK(reply.status == Reply::switching_protocols);
+    REQUIRE(reply.headers.size() == 3);
+    CHECK(reply.headers[2].name == "Sec-WebSocket-Accept");
+    CHECK(reply.headers[2].value == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST_CASE("encode_frame", "[silkrpc][http][websocket]") {
+    SECTION("small payload") {
+        CHECK(encode_frame(Opcode::kText, "Hello") == std::string{"\x81\x05Hello"});
+    }
+
+    SECTION("empty pong") {
+        CHECK(encode_frame(Opcode::kPong, "") == std::string{"\x8a\x00", 2});
+    }
+
+    SECTION("16-bit payload length") {
+        const auto frame{encode_frame(Opcode::kText, std::string(256, 'a'))};
+        CHECK(frame.size() == 4 + 256);
+        CHECK(frame.substr(0, 4) == std::string{"\x81\x7e\x01\x00", 4});
+    }
+
+    SECTION("64-bit payload length") {
+        const auto frame{encode_frame(Opcode::kBinary, std::string(65536, 'a'))};
+        CHECK(frame.size() == 10 + 65536);
+        CHECK(frame.substr(0, 10) == std::string{"\x82\x7f\x00\x00\x00\x00\x00\x01\x00\x00", 10});
+    }
+}
+
+TEST_CASE("FrameParser", "[silkrpc][http][websocket]") {
+    FrameParser parser;
+
+    SECTION("masked frame") {
+        const auto data{mask_frame(0x81, "Hello")};
+        parser.feed(data.data(), data.data() + data.size());
+        const auto frame{parser.next()};
+        REQUIRE(frame);
+        CHECK(frame->fin);
+        CHECK(frame->opcode == Opcode::kText);
+        CHECK(frame->payload == "Hello");
+        CHECK(!parser.next());
+    }
+
+    SECTION("frame split across reads") {
+        const auto data{mask_frame(0x81, std::string(300, 'x'))};
+        parser.feed(data.data(), data.data() + 3);
+        CHECK(!parser.next());
+        parser.feed(data.data() + 3, data.data() + 100);
+        CHECK(!parser.next());
+        parser.feed(data.data() + 100, data.data() + data.size());
+        const auto frame{parser.next()};
+        REQUIRE(frame);
+        CHECK(frame->payload == std::string(300, 'x'));
+    }
+
+    SECTION("two frames in one read") {
+        const auto data{mask_frame(0x89, "ping") + mask_frame(0x81, "text")};
+        parser.feed(data.data(), data.data() + data.size());
+        const auto ping{parser.next()};
+        REQUIRE(ping);
+        CHECK(ping->opcode == Opcode::kPing);
+        CHECK(ping->payload == "ping");
+        const auto text{parser.next()};
+        REQUIRE(text);
+        CHECK(text->payload == "text");
+    }
+
+    SECTION("unmasked frame") {
+        const auto data{encode_frame(Opcode::kText, "Hello")};
+        parser.feed(data.data(), data.data() + data.size());
+        CHECK_THROWS_AS(parser.next(), std::runtime_error);
+    }
+
+    SECTION("too large frame") {
+        FrameParser small_parser{4};
+        const auto data{mask_frame(0x81, "Hello")};
+        small_parser.feed(data.data(), data.data() + data.size());
+        CHECK_THROWS_AS(small_parser.next(), std::runtime_error);
+    }
+
+    SECTION("fragmented control frame") {
+        const auto data{mask_frame(0x09, "ping")};
+        parser.feed(data.data(), data.data() + data.size());
+        CHECK_THROWS_AS(parser.next(), std::runtime_error);
+    }
+}
+
+TEST_CASE("MessageAssembler", "[silkrpc][http][websocket]") {
+    MessageAssembler assembler;
+
+    SECTION("unfragmented message") {
+        const auto message{assembler.add(Frame{true, Opcode::kText, "Hello"})};
+        REQUIRE(message);
+        CHECK(*message == "Hello");
+    }
+
+    SECTION("fragmented message") {
+        CHECK(!assembler.add(Frame{false, Opcode::kText, "Hel"}));
+        CHECK(!assembler.add(Frame{false, Opcode::kContinuation, "l"}));
+        const auto message{assembler.add(Frame{true, Opcode::kContinuation, "o"})};
+        REQUIRE(message);
+        CHECK(*message == "Hello");
+    }
+
+    SECTION("continuation without message") {
+        CHECK_THROWS_AS(assembler.add(Frame{true, Opcode::kContinuation, "o"}), std::runtime_error);
+    }
+
+    SECTION("new message within fragmented one") {
+        CHECK(!assembler.add(Frame{false, Opcode::kText, "Hel"}));
+        CHECK_THROWS_AS(assembler.add(Frame{true, Opcode::kText, "lo"}), std::runtime_error);
+    }
+
+    SECTION("too large message") {
+        MessageAssembler small_assembler{4};
+        CHECK(!small_assembler.add(Frame{false, Opcode::kText, "Hel"}));
+        CHECK_THROWS_AS(small_assembler.add(Frame{true, Opcode::kContinuation, "lo"}), std::runtime_error);
+    }
+}
+
+} // namespace silkrpc::http::websocket
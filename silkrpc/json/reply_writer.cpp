@@ -0,0 +1,56 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "reply_writer.hpp"
+
+#include <silkrpc/json/types.hpp>
+
+namespace silkrpc {
+
+asio::awaitable<void> JsonReplyWriter::write(std::string_view content) {
+    if (!started_) {
+        // Same member order as make_json_content
+        started_ = true;
+        co_await writer_.write(R"({"id":)" + id_.dump() + R"(,"jsonrpc":"2.0","result":)");
+    }
+    co_await writer_.write(content);
+}
+
+asio::awaitable<void> JsonReplyWriter::close() {
+    co_await close(std::nullopt);
+}
+
+asio::awaitable<void> JsonReplyWriter::close(const std::optional<Error>& error) {
+    if (!started_ && error) {
+        // Nothing has been written yet, so this is a plain error reply
+        const nlohmann::json reply{{"jsonrpc", "2.0"}, {"id", id_}, {"error", *error}};
+        co_await writer_.write(reply.dump() + "\n");
+    } else {
+        if (!started_) {
+            co_await write("null");
+        }
+        if (error) {
+            // Result has been partially written already, so the error is appended after it
+            const nlohmann::json error_json = *error;
+            co_await writer_.write(R"(,"error":)" + error_json.dump() + "}\n");
+        } else {
+            co_await writer_.write("}\n");
+        }
+    }
+    co_await writer_.close();
+}
+
+} // namespace silkrpc
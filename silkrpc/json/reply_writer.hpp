@@ -0,0 +1,64 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_JSON_REPLY_WRITER_HPP_
+#define SILKRPC_JSON_REPLY_WRITER_HPP_
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <silkrpc/config.hpp>
+
+#include <asio/awaitable.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkrpc/common/writer.hpp>
+#include <silkrpc/types/error.hpp>
+
+namespace silkrpc {
+
+//! Writer of one JSON-RPC reply whose result is streamed to the underlying writer.
+//! The reply opening is written just before the first result content, so errors raised before any result
+//! content become plain error replies. The request id is echoed whatever its type (number, string or null).
+class JsonReplyWriter : public Writer {
+public:
+    JsonReplyWriter(const nlohmann::json& id, Writer& writer) : id_(id), writer_(writer) {}
+
+    JsonReplyWriter(const JsonReplyWriter&) = delete;
+    JsonReplyWriter& operator=(const JsonReplyWriter&) = delete;
+
+    //! Write the given result content, preceded by the reply opening the first time.
+    asio::awaitable<void> write(std::string_view content) override;
+
+    //! Complete the reply with no error.
+    asio::awaitable<void> close() override;
+
+    //! Complete the reply with the given error, if any: it is appended to the result if already started.
+    asio::awaitable<void> close(const std::optional<Error>& error);
+
+    //! Whether the reply opening has already been written.
+    bool started() const noexcept { return started_; }
+
+private:
+    nlohmann::json id_;
+    Writer& writer_;
+    bool started_{false};
+};
+
+} // namespace silkrpc
+
+#endif // SILKRPC_JSON_REPLY_WRITER_HPP_
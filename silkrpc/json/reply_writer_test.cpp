@@ -0,0 +1,82 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "reply_writer.hpp"
+
+#include <asio/co_spawn.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/use_future.hpp>
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+namespace silkrpc {
+
+TEST_CASE("JsonReplyWriter", "[silkrpc][json][reply_writer]") {
+    asio::thread_pool pool{1};
+    StringWriter writer;
+
+    SECTION("result content") {
+        JsonReplyWriter reply_writer{1, writer};
+        asio::co_spawn(pool, [&]() -> asio::awaitable<void> {
+            co_await reply_writer.write("[1,");
+            co_await reply_writer.write("2]");
+            co_await reply_writer.close();
+        }, asio::use_future).get();
+        CHECK(reply_writer.started());
+        CHECK(writer.content() == "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":[1,2]}\n");
+        CHECK(nlohmann::json::parse(writer.content()) == R"({"id":1,"jsonrpc":"2.0","result":[1,2]})"_json);
+    }
+
+    SECTION("no result content") {
+        JsonReplyWriter reply_writer{1, writer};
+        asio::co_spawn(pool, reply_writer.close(), asio::use_future).get();
+        CHECK(writer.content() == "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":null}\n");
+    }
+
+    SECTION("error before result content") {
+        JsonReplyWriter reply_writer{1, writer};
+        asio::co_spawn(pool, reply_writer.close(Error{-32000, "failed"}), asio::use_future).get();
+        CHECK(!reply_writer.started());
+        CHECK(nlohmann::json::parse(writer.content()) == R"({"id":1,"jsonrpc":"2.0","error":{"code":-32000,"message":"failed"}})"_json);
+    }
+
+    SECTION("error after result content") {
+        JsonReplyWriter reply_writer{1, writer};
+        asio::co_spawn(pool, [&]() -> asio::awaitable<void> {
+            co_await reply_writer.write("[1");
+            co_await reply_writer.write("]");
+            co_await reply_writer.close(Error{100, "failed"});
+        }, asio::use_future).get();
+        CHECK(writer.content() == "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":[1],\"error\":{\"code\":100,\"message\":\"failed\"}}\n");
+    }
+
+    SECTION("string id") {
+        JsonReplyWriter reply_writer{"abc", writer};
+        asio::co_spawn(pool, [&]() -> asio::awaitable<void> {
+            co_await reply_writer.write("[]");
+            co_await reply_writer.close();
+        }, asio::use_future).get();
+        CHECK(writer.content() == "{\"id\":\"abc\",\"jsonrpc\":\"2.0\",\"result\":[]}\n");
+    }
+
+    SECTION("null id") {
+        JsonReplyWriter reply_writer{nullptr, writer};
+        asio::co_spawn(pool, reply_writer.close(Error{-32000, "failed"}), asio::use_future).get();
+        CHECK(nlohmann::json::parse(writer.content()) == R"({"id":null,"jsonrpc":"2.0","error":{"code":-32000,"message":"failed"}})"_json);
+    }
+}
+
+} // namespace silkrpc
@@ -251,15 +251,19 @@ void to_json(nlohmann::json& json, const Block& b) {
             json_txn["gasPrice"] = silkrpc::to_quantity(b.block.transactions[i].effective_gas_price(b.block.header.base_fee_per_gas.value_or(0)));
         }
     } else {
-        std::vector<evmc::bytes32> transaction_hashes;
-        transaction_hashes.reserve(b.block.transactions.size());
-        for (auto i{0}; i < b.block.transactions.size(); i++) {
-            auto ethash_hash{hash_of_transaction(b.block.transactions[i])};
-            auto bytes32_hash = silkworm::to_bytes32({ethash_hash.bytes, silkworm::kHashLength});
-            transaction_hashes.emplace(transaction_hashes.end(), std::move(bytes32_hash));
-            SILKRPC_DEBUG << "transaction_hashes[" << i << "]: " << silkworm::to_hex({transaction_hashes[i].bytes, silkworm::kHashLength}) << "\n";
+        if (b.transaction_hashes.size() == b.block.transactions.size()) {
+            json["transactions"] = b.transaction_hashes;
+        } else {
+            std::vector<evmc::bytes32> transaction_hashes;
+            transaction_hashes.reserve(b.block.transactions.size());
+            for (auto i{0}; i < b.block.transactions.size(); i++) {
+                auto ethash_hash{hash_of_transaction(b.block.transactions[i])};
+                auto bytes32_hash = silkworm::to_bytes32({ethash_hash.bytes, silkworm::kHashLength});
+                transaction_hashes.emplace(transaction_hashes.end(), std::move(bytes32_hash));
+                SILKRPC_DEBUG << "transaction_hashes[" << i << "]: " << silkworm::to_hex({transaction_hashes[i].bytes, silkworm::kHashLength}) << "\n";
+            }
+            json["transactions"] = transaction_hashes;
         }
-        json["transactions"] = transaction_hashes;
     }
     std::vector<evmc::bytes32> ommer_hashes;
     ommer_hashes.reserve(b.block.ommers.size());
@@ -619,6 +623,25 @@ void to_json(nlohmann::json& json, const Issuance& issuance) {
     }
 }
 
+void to_json(nlohmann::json& json, const FeeHistory& fee_history) {
+    json["oldestBlock"] = to_quantity(fee_history.oldest_block);
+    json["baseFeePerGas"] = nlohmann::json::array();
+    for (const auto& base_fee : fee_history.base_fees) {
+        json["baseFeePerGas"].push_back(to_quantity(base_fee));
+    }
+    json["gasUsedRatio"] = fee_history.gas_used_ratios;
+    if (!fee_history.rewards.empty()) {
+        json["reward"] = nlohmann::json::array();
+        for (const auto& block_rewards : fee_history.rewards) {
+            auto json_block_rewards = nlohmann::json::array();
+            for (const auto& reward : block_rewards) {
+                json_block_rewards.push_back(to_quantity(reward));
+            }
+            json["reward"].push_back(json_block_rewards);
+        }
+    }
+}
+
 void to_json(nlohmann::json& json, const Error& error) {
     json = {{"code", error.code}, {"message", error.message}};
 }
@@ -30,6 +30,7 @@
 #include <silkrpc/types/call.hpp>
 #include <silkrpc/types/chain_config.hpp>
 #include <silkrpc/types/error.hpp>
+#include <silkrpc/types/fee_history.hpp>
 #include <silkrpc/types/filter.hpp>
 #include <silkrpc/types/issuance.hpp>
 #include <silkrpc/types/log.hpp>
@@ -112,6 +113,8 @@ void to_json(nlohmann::json& json, const Forks& forks);
 
 void to_json(nlohmann::json& json, const Issuance& issuance);
 
+void to_json(nlohmann::json& json, const FeeHistory& fee_history);
+
 void to_json(nlohmann::json& json, const Error& error);
 void to_json(nlohmann::json& json, const RevertError& error);
 
@@ -1435,6 +1435,38 @@ TEST_CASE("serialize issuance", "[silkrpc::json][to_json]") {
     })"_json);
 }
 
+TEST_CASE("serialize fee history", "[silkrpc::json][to_json]") {
+    SECTION("without rewards") {
+        silkrpc::FeeHistory fee_history{
+            .oldest_block = 0x10,
+            .base_fees = {0x7, 0x8},
+            .gas_used_ratios = {0.5}
+        };
+        nlohmann::json j = fee_history;
+        CHECK(j == R"({
+            "oldestBlock":"0x10",
+            "baseFeePerGas":["0x7","0x8"],
+            "gasUsedRatio":[0.5]
+        })"_json);
+    }
+
+    SECTION("with rewards") {
+        silkrpc::FeeHistory fee_history{
+            .oldest_block = 0x10,
+            .base_fees = {0x7, 0x8},
+            .gas_used_ratios = {0.5},
+            .rewards = {{0x1, 0x2}}
+        };
+        nlohmann::json j = fee_history;
+        CHECK(j == R"({
+            "oldestBlock":"0x10",
+            "baseFeePerGas":["0x7","0x8"],
+            "gasUsedRatio":[0.5],
+            "reward":[["0x1","0x2"]]
+        })"_json);
+    }
+}
+
 TEST_CASE("serialize execution_payload", "[silkrpc::json][to_json]") {
     // uint64_t are kept as hex for readability
     silkrpc::ExecutionPayload execution_payload{
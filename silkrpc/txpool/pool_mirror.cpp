@@ -0,0 +1,270 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "pool_mirror.hpp"
+
+#include <string>
+#include <utility>
+
+#include <silkworm/rlp/decode.hpp>
+
+#include <silkrpc/common/log.hpp>
+#include <silkrpc/common/util.hpp>
+
+namespace silkrpc::txpool {
+
+static unsigned int& counter(StatusInfo& status, TransactionType type) {
+    switch (type) {
+        case PENDING:
+            return status.pending_count;
+        case QUEUED:
+            return status.queued_count;
+        default:
+            return status.base_fee_count;
+    }
+}
+
+void PoolMirror::begin_seed() {
+    std::scoped_lock lock{access_};
+    seeding_ = true;
+    seed_additions_.clear();
+    seed_additions_overflow_ = false;
+}
+
+void PoolMirror::abort_seed() {
+    std::scoped_lock lock{access_};
+    seeding_ = false;
+    seed_additions_.clear();
+    seed_additions_overflow_ = false;
+}
+
+void PoolMirror::seed(const TransactionsInPool& transactions) {
+    // Decode everything before taking the lock, readers keep being served the previous content meanwhile
+    std::vector<std::pair<TransactionType, Transaction>> decoded;
+    decoded.reserve(transactions.size());
+    for (const auto& transaction_info : transactions) {
+        auto transaction = decode(transaction_info.rlp);
+        if (!transaction) {
+            SILKRPC_WARN << "PoolMirror::seed invalid RLP transaction from sender: " << transaction_info.sender << "\n";
+            continue;
+        }
+        transaction->from = transaction_info.sender;
+        decoded.emplace_back(transaction_info.transaction_type, std::move(*transaction));
+    }
+
+    std::scoped_lock lock{access_};
+    clear_locked();
+    bool complete{!seed_additions_overflow_};
+    for (auto& [type, transaction] : decoded) {
+        complete = complete && insert_locked(type, std::move(transaction));
+    }
+
+    // The transactions added while the content was being read may be missing from it, unless found there unchanged
+    for (auto& addition : seed_additions_) {
+        const auto sender_it = senders_.find(*addition.transaction.from);
+        if (sender_it != senders_.end()) {
+            const auto it = sender_it->second.find(addition.transaction.nonce);
+            if (it != sender_it->second.end() &&
+                static_cast<const silkworm::Transaction&>(it->second.transaction) == static_cast<const silkworm::Transaction&>(addition.transaction)) {
+                continue;
+            }
+        }
+        complete = complete && insert_locked(addition.type, std::move(addition.transaction));
+    }
+    const auto num_additions = seed_additions_.size();
+    seed_additions_.clear();
+    seed_additions_overflow_ = false;
+    seeding_ = false;
+
+    // A partial content would answer nonce, status and content queries wrongly, so leave them to the remote pool
+    if (!complete) {
+        clear_locked();
+        ready_ = false;
+        SILKRPC_WARN << "PoolMirror::seed pool content exceeds max transactions: " << max_transactions_ << "\n";
+        return;
+    }
+    ready_ = true;
+    SILKRPC_DEBUG << "PoolMirror::seed #transactions: " << size_ << " #senders: " << senders_.size() << " #additions: " << num_additions
+                  << " #unclassified: " << unclassified_ << "\n";
+}
+
+bool PoolMirror::add(std::optional<TransactionType> type, Transaction transaction) {
+    if (!transaction.from) {
+        return false;
+    }
+    std::scoped_lock lock{access_};
+    if (!ready_ && !seeding_) {
+        return false;
+    }
+    if (seeding_) {
+        if (seed_additions_.size() < max_transactions_) {
+            seed_additions_.push_back(Entry{type, transaction});
+        } else {
+            seed_additions_overflow_ = true;
+        }
+    }
+    if (ready_ && !insert_locked(type, std::move(transaction))) {
+        // Readers fall back to the remote pool until the next seed fits
+        clear_locked();
+        ready_ = false;
+        SILKRPC_WARN << "PoolMirror::add max transactions reached: " << max_transactions_ << "\n";
+    }
+    return true;
+}
+
+bool PoolMirror::add(silkworm::ByteView rlp_tx) {
+    auto transaction = decode(rlp_tx);
+    if (!transaction) {
+        SILKRPC_WARN << "PoolMirror::add invalid RLP transaction\n";
+        return false;
+    }
+    transaction->recover_sender();
+    // The announcement does not tell the sub-pool: the transaction may well be queued or below the base fee
+    return add(std::nullopt, std::move(*transaction));
+}
+
+bool PoolMirror::accepts_additions() const {
+    std::scoped_lock lock{access_};
+    return ready_ || seeding_;
+}
+
+std::size_t PoolMirror::prune(const std::vector<silkworm::Transaction>& included_transactions) {
+    std::scoped_lock lock{access_};
+    std::size_t pruned{0};
+    for (const auto& included : included_transactions) {
+        if (!included.from) {
+            continue;
+        }
+        const auto sender_it = senders_.find(*included.from);
+        if (sender_it == senders_.end()) {
+            continue;
+        }
+        auto& nonces = sender_it->second;
+        const auto end = nonces.upper_bound(included.nonce);
+        for (auto it = nonces.begin(); it != end; ++pruned) {
+            count_locked(it->second.type, -1);
+            it = nonces.erase(it);
+            --size_;
+        }
+        if (nonces.empty()) {
+            senders_.erase(sender_it);
+        }
+    }
+    SILKRPC_DEBUG << "PoolMirror::prune #included: " << included_transactions.size() << " #pruned: " << pruned << "\n";
+    return pruned;
+}
+
+void PoolMirror::invalidate() {
+    std::scoped_lock lock{access_};
+    clear_locked();
+    ready_ = false;
+}
+
+bool PoolMirror::ready() const {
+    std::scoped_lock lock{access_};
+    return ready_;
+}
+
+std::optional<uint64_t> PoolMirror::nonce(const evmc::address& sender) const {
+    std::scoped_lock lock{access_};
+    const auto sender_it = senders_.find(sender);
+    if (!ready_ || sender_it == senders_.end()) {
+        return std::nullopt;
+    }
+    return sender_it->second.rbegin()->first;
+}
+
+std::optional<StatusInfo> PoolMirror::status() const {
+    std::scoped_lock lock{access_};
+    if (!ready_ || unclassified_ > 0) {
+        return std::nullopt;
+    }
+    return status_;
+}
+
+std::optional<TransactionContent> PoolMirror::content() const {
+    TransactionContent transactions_content;
+    transactions_content["queued"];
+    transactions_content["pending"];
+    transactions_content["baseFee"];
+
+    std::scoped_lock lock{access_};
+    if (!ready_ || unclassified_ > 0) {
+        return std::nullopt;
+    }
+    for (const auto& [sender, nonces] : senders_) {
+        const auto sender_hex = silkworm::to_hex(sender, true);
+        for (const auto& [nonce, entry] : nonces) {
+            const auto sub_pool = *entry.type == QUEUED ? "queued" : *entry.type == PENDING ? "pending" : "baseFee";
+            transactions_content[sub_pool][sender_hex].emplace(std::to_string(nonce), entry.transaction);
+        }
+    }
+    return transactions_content;
+}
+
+std::size_t PoolMirror::size() const {
+    std::scoped_lock lock{access_};
+    return size_;
+}
+
+std::optional<Transaction> PoolMirror::decode(silkworm::ByteView rlp_tx) {
+    Transaction transaction{};
+    if (silkworm::rlp::decode(rlp_tx, dynamic_cast<silkworm::Transaction&>(transaction)) != silkworm::DecodingResult::kOk) {
+        return std::nullopt;
+    }
+    return transaction;
+}
+
+void PoolMirror::clear_locked() {
+    senders_.clear();
+    size_ = 0;
+    status_ = StatusInfo{0, 0, 0};
+    unclassified_ = 0;
+}
+
+bool PoolMirror::insert_locked(std::optional<TransactionType> type, Transaction&& transaction) {
+    transaction.queued_in_pool = true;
+    auto& nonces = senders_[*transaction.from];
+    const auto nonce = transaction.nonce;
+    const auto it = nonces.find(nonce);
+    if (it != nonces.end()) {
+        // Replacement of a transaction with the same nonce
+        count_locked(it->second.type, -1);
+        it->second = Entry{type, std::move(transaction)};
+        count_locked(type, 1);
+        return true;
+    }
+    if (size_ >= max_transactions_) {
+        if (nonces.empty()) {
+            senders_.erase(*transaction.from);
+        }
+        return false;
+    }
+    nonces.emplace(nonce, Entry{type, std::move(transaction)});
+    count_locked(type, 1);
+    ++size_;
+    return true;
+}
+
+void PoolMirror::count_locked(const std::optional<TransactionType>& type, int delta) {
+    if (type) {
+        counter(status_, *type) += delta;
+    } else {
+        unclassified_ += delta;
+    }
+}
+
+} // namespace silkrpc::txpool
@@ -0,0 +1,125 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_TXPOOL_POOL_MIRROR_HPP_
+#define SILKRPC_TXPOOL_POOL_MIRROR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+#include <silkworm/common/base.hpp>
+#include <silkworm/types/transaction.hpp>
+
+#include <silkrpc/common/constants.hpp>
+#include <silkrpc/txpool/transaction_pool.hpp>
+#include <silkrpc/types/transaction.hpp>
+
+namespace silkrpc::txpool {
+
+//! Local copy of the remote transaction pool, indexed by sender and nonce.
+//! It is seeded by the full pool content, then kept current by adding the announced transactions and pruning those
+//! included in new blocks. Promotions, replacements and evictions happening within the remote pool are not announced,
+//! so the content is reseeded periodically. Announced transactions do not carry their sub-pool either, so they stay
+//! unclassified until the next seed: they count for the sender nonce, but status and content are not answered meanwhile.
+//! Queries are answered only while the mirror is ready, i.e. seeded and not invalidated since, callers falling back to
+//! the remote pool otherwise. Exceeding the max number of transactions invalidates the mirror, a partial content is never served.
+class PoolMirror {
+public:
+    explicit PoolMirror(std::size_t max_transactions = kMaxTxPoolMirrorTransactions) : max_transactions_(max_transactions) {}
+
+    PoolMirror(const PoolMirror&) = delete;
+    PoolMirror& operator=(const PoolMirror&) = delete;
+
+    //! Start recording the added transactions, which the pool content being read may miss, until the next seed
+    void begin_seed();
+
+    //! Stop recording the added transactions, the pool content could not be read
+    void abort_seed();
+
+    //! Replace the whole content with the given pool transactions, replay on top the ones added since begin_seed and
+    //! make the mirror ready
+    void seed(const TransactionsInPool& transactions);
+
+    //! Add the given transaction, whose sender must be known, replacing any other with the same sender and nonce.
+    //! The transaction is left unclassified if its sub-pool is not given.
+    bool add(std::optional<TransactionType> type, Transaction transaction);
+
+    //! Add the given RLP-encoded announced transaction, recovering its sender
+    bool add(silkworm::ByteView rlp_tx);
+
+    //! Whether the added transactions are used, i.e. the mirror is either ready or being seeded
+    bool accepts_additions() const;
+
+    //! Remove the transactions made obsolete by the given included ones, i.e. those having same sender and lower or equal nonce
+    std::size_t prune(const std::vector<silkworm::Transaction>& included_transactions);
+
+    //! Drop the content and stop answering queries until seeded again
+    void invalidate();
+
+    bool ready() const;
+
+    //! The highest nonce among the transactions of the given sender, if any
+    std::optional<uint64_t> nonce(const evmc::address& sender) const;
+
+    //! The number of transactions for each sub-pool, if the mirror is ready and all its transactions are classified
+    std::optional<StatusInfo> status() const;
+
+    //! The transactions grouped by sub-pool, sender and nonce, if the mirror is ready and all its transactions are classified
+    std::optional<TransactionContent> content() const;
+
+    std::size_t size() const;
+
+private:
+    struct Entry {
+        std::optional<TransactionType> type;
+        Transaction transaction;
+    };
+
+    static std::optional<Transaction> decode(silkworm::ByteView rlp_tx);
+
+    //! Insert the given transaction, failing if the max number of transactions is reached
+    bool insert_locked(std::optional<TransactionType> type, Transaction&& transaction);
+
+    void clear_locked();
+
+    void count_locked(const std::optional<TransactionType>& type, int delta);
+
+    std::size_t max_transactions_;
+    mutable std::mutex access_;
+    std::map<evmc::address, std::map<uint64_t, Entry>> senders_;
+    std::size_t size_{0};
+    StatusInfo status_{0, 0, 0};
+    std::size_t unclassified_{0};
+    bool ready_{false};
+
+    //! Whether the added transactions are recorded for the next seed
+    bool seeding_{false};
+
+    //! The transactions added since begin_seed, at most max_transactions_
+    std::vector<Entry> seed_additions_;
+
+    //! Whether some transactions added since begin_seed did not fit in seed_additions_
+    bool seed_additions_overflow_{false};
+};
+
+} // namespace silkrpc::txpool
+
+#endif // SILKRPC_TXPOOL_POOL_MIRROR_HPP_
@@ -0,0 +1,262 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "pool_mirror.hpp"
+
+#include <optional>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+
+namespace silkrpc::txpool {
+
+using evmc::literals::operator""_address;
+
+static const evmc::address kSender1{0x0715a7794a1dc8e42615f059dd6e406a6594651a_address};
+static const evmc::address kSender2{0x8ced5ad0d8da4ec211c17355ed3dbfec4cf0e5b9_address};
+
+static Transaction make_transaction(const evmc::address& sender, uint64_t nonce, uint64_t gas_limit = 21000) {
+    Transaction transaction{};
+    transaction.from = sender;
+    transaction.nonce = nonce;
+    transaction.gas_limit = gas_limit;
+    return transaction;
+}
+
+TEST_CASE("PoolMirror::ready", "[silkrpc][txpool][pool_mirror]") {
+    PoolMirror mirror;
+
+    SECTION("not seeded") {
+        CHECK(!mirror.ready());
+        CHECK(!mirror.add(PENDING, make_transaction(kSender1, 1)));
+        CHECK(!mirror.nonce(kSender1));
+        CHECK(!mirror.status());
+        CHECK(!mirror.content());
+    }
+
+    SECTION("seeded") {
+        mirror.seed({});
+        CHECK(mirror.ready());
+        CHECK(mirror.size() == 0);
+        const auto status = mirror.status();
+        REQUIRE(status);
+        CHECK(status->pending_count == 0);
+    }
+
+    SECTION("invalidated") {
+        mirror.seed({});
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 1)));
+        mirror.invalidate();
+        CHECK(!mirror.ready());
+        CHECK(mirror.size() == 0);
+        CHECK(!mirror.nonce(kSender1));
+    }
+}
+
+TEST_CASE("PoolMirror::add", "[silkrpc][txpool][pool_mirror]") {
+    PoolMirror mirror{3};
+    mirror.seed({});
+
+    SECTION("unknown sender") {
+        Transaction transaction{};
+        CHECK(!mirror.add(PENDING, transaction));
+        CHECK(mirror.size() == 0);
+    }
+
+    SECTION("highest nonce per sender") {
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 1)));
+        CHECK(mirror.add(QUEUED, make_transaction(kSender1, 3)));
+        CHECK(mirror.add(BASE_FEE, make_transaction(kSender2, 7)));
+        CHECK(mirror.size() == 3);
+        CHECK(mirror.nonce(kSender1) == 3);
+        CHECK(mirror.nonce(kSender2) == 7);
+        const auto status = mirror.status();
+        REQUIRE(status);
+        CHECK(status->pending_count == 1);
+        CHECK(status->queued_count == 1);
+        CHECK(status->base_fee_count == 1);
+    }
+
+    SECTION("replacement") {
+        CHECK(mirror.add(QUEUED, make_transaction(kSender1, 1)));
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 1, 50000)));
+        CHECK(mirror.size() == 1);
+        const auto status = mirror.status();
+        REQUIRE(status);
+        CHECK(status->pending_count == 1);
+        CHECK(status->queued_count == 0);
+        const auto content = mirror.content();
+        REQUIRE(content);
+        CHECK(content->at("pending").at("0x0715a7794a1dc8e42615f059dd6e406a6594651a").at("1").gas_limit == 50000);
+    }
+
+    SECTION("unclassified") {
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 1)));
+        CHECK(mirror.add(std::nullopt, make_transaction(kSender1, 2)));
+        CHECK(mirror.size() == 2);
+        CHECK(mirror.nonce(kSender1) == 2);
+        CHECK(!mirror.status());
+        CHECK(!mirror.content());
+
+        std::vector<silkworm::Transaction> included{make_transaction(kSender1, 2)};
+        CHECK(mirror.prune(included) == 2);
+        REQUIRE(mirror.status());
+        CHECK(mirror.status()->pending_count == 0);
+        CHECK(mirror.content());
+    }
+
+    SECTION("unclassified replacement") {
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 1)));
+        CHECK(mirror.add(std::nullopt, make_transaction(kSender1, 1, 50000)));
+        CHECK(mirror.size() == 1);
+        CHECK(!mirror.status());
+    }
+
+    SECTION("max transactions") {
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 1)));
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 2)));
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 3)));
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 4, 50000)));
+        CHECK(!mirror.add(PENDING, make_transaction(kSender2, 1)));
+
+        // Nothing is answered from a partial content: callers fall back to the remote pool
+        CHECK(!mirror.ready());
+        CHECK(mirror.size() == 0);
+        CHECK(!mirror.nonce(kSender1));
+        CHECK(!mirror.status());
+        CHECK(!mirror.content());
+
+        // Until a seed fitting the max number of transactions
+        mirror.seed({});
+        CHECK(mirror.ready());
+    }
+
+    SECTION("max transactions replacement") {
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 1)));
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 2)));
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 3)));
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 3, 50000)));
+        CHECK(mirror.ready());
+        CHECK(mirror.size() == 3);
+    }
+}
+
+TEST_CASE("PoolMirror::seed", "[silkrpc][txpool][pool_mirror]") {
+    PoolMirror mirror;
+
+    SECTION("additions before first seed") {
+        CHECK(!mirror.accepts_additions());
+        mirror.begin_seed();
+        CHECK(mirror.accepts_additions());
+        CHECK(!mirror.ready());
+        CHECK(mirror.add(std::nullopt, make_transaction(kSender1, 1)));
+        CHECK(mirror.size() == 0);
+        mirror.seed({});
+        CHECK(mirror.ready());
+        CHECK(mirror.size() == 1);
+        CHECK(mirror.nonce(kSender1) == 1);
+        CHECK(!mirror.status());
+    }
+
+    SECTION("additions during reseed") {
+        mirror.seed({});
+        mirror.begin_seed();
+        CHECK(mirror.add(QUEUED, make_transaction(kSender1, 3)));
+        CHECK(mirror.size() == 1);
+        mirror.seed({});
+        CHECK(mirror.size() == 1);
+        REQUIRE(mirror.status());
+        CHECK(mirror.status()->queued_count == 1);
+    }
+
+    SECTION("additions after seed not replayed twice") {
+        mirror.begin_seed();
+        mirror.add(PENDING, make_transaction(kSender1, 1));
+        mirror.seed({});
+        mirror.seed({});
+        CHECK(mirror.size() == 0);
+        CHECK(mirror.accepts_additions());
+    }
+
+    SECTION("additions overflow during seed") {
+        PoolMirror small_mirror{1};
+        small_mirror.begin_seed();
+        CHECK(small_mirror.add(PENDING, make_transaction(kSender1, 1)));
+        CHECK(small_mirror.add(PENDING, make_transaction(kSender1, 2)));
+        small_mirror.seed({});
+        CHECK(!small_mirror.ready());
+        CHECK(!small_mirror.nonce(kSender1));
+        CHECK(!small_mirror.accepts_additions());
+    }
+
+    SECTION("aborted seed") {
+        mirror.begin_seed();
+        CHECK(mirror.add(PENDING, make_transaction(kSender1, 1)));
+        mirror.abort_seed();
+        CHECK(!mirror.accepts_additions());
+        CHECK(!mirror.add(PENDING, make_transaction(kSender1, 2)));
+        mirror.seed({});
+        CHECK(mirror.size() == 0);
+    }
+}
+
+TEST_CASE("PoolMirror::prune", "[silkrpc][txpool][pool_mirror]") {
+    PoolMirror mirror;
+    mirror.seed({});
+    mirror.add(PENDING, make_transaction(kSender1, 1));
+    mirror.add(PENDING, make_transaction(kSender1, 2));
+    mirror.add(QUEUED, make_transaction(kSender1, 4));
+    mirror.add(PENDING, make_transaction(kSender2, 5));
+
+    SECTION("lower or equal nonces") {
+        std::vector<silkworm::Transaction> included{make_transaction(kSender1, 2)};
+        CHECK(mirror.prune(included) == 2);
+        CHECK(mirror.size() == 2);
+        CHECK(mirror.nonce(kSender1) == 4);
+        CHECK(mirror.status()->pending_count == 1);
+    }
+
+    SECTION("all transactions of sender") {
+        std::vector<silkworm::Transaction> included{make_transaction(kSender2, 5), make_transaction(kSender2, 6)};
+        CHECK(mirror.prune(included) == 1);
+        CHECK(!mirror.nonce(kSender2));
+        CHECK(mirror.content()->at("pending").count("0x8ced5ad0d8da4ec211c17355ed3dbfec4cf0e5b9") == 0);
+    }
+
+    SECTION("unknown sender") {
+        std::vector<silkworm::Transaction> included{silkworm::Transaction{}};
+        CHECK(mirror.prune(included) == 0);
+        CHECK(mirror.size() == 4);
+    }
+}
+
+TEST_CASE("PoolMirror::content", "[silkrpc][txpool][pool_mirror]") {
+    PoolMirror mirror;
+    mirror.seed({});
+    mirror.add(PENDING, make_transaction(kSender1, 1));
+    mirror.add(QUEUED, make_transaction(kSender1, 3));
+    mirror.add(BASE_FEE, make_transaction(kSender2, 7));
+
+    const auto content = mirror.content();
+    REQUIRE(content);
+    CHECK(content->size() == 3);
+    CHECK(content->at("pending").at("0x0715a7794a1dc8e42615f059dd6e406a6594651a").count("1") == 1);
+    CHECK(content->at("queued").at("0x0715a7794a1dc8e42615f059dd6e406a6594651a").count("3") == 1);
+    CHECK(content->at("baseFee").at("0x8ced5ad0d8da4ec211c17355ed3dbfec4cf0e5b9").at("7").queued_in_pool);
+}
+
+} // namespace silkrpc::txpool
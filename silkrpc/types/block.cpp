@@ -19,6 +19,7 @@
 #include <iomanip>
 #include <limits>
 #include <string>
+#include <utility>
 
 #include <silkrpc/common/util.hpp>
 #include <silkworm/common/endian.hpp>
@@ -55,6 +56,25 @@ std::ostream& operator<<(std::ostream& out, const Block& b) {
     return out;
 }
 
+IndexedBlock::IndexedBlock(silkworm::BlockWithHash block_with_hash) : silkworm::BlockWithHash(std::move(block_with_hash)) {
+    const auto& transactions = block.transactions;
+    transaction_hashes.reserve(transactions.size());
+    transaction_indexes_.reserve(transactions.size());
+    for (std::size_t i{0}; i < transactions.size(); i++) {
+        const auto ethash_hash{hash_of_transaction(transactions[i])};
+        transaction_hashes.push_back(silkworm::to_bytes32({ethash_hash.bytes, silkworm::kHashLength}));
+        transaction_indexes_.emplace(transaction_hashes.back(), i);
+    }
+}
+
+std::optional<std::size_t> IndexedBlock::transaction_index(const evmc::bytes32& transaction_hash) const {
+    const auto it = transaction_indexes_.find(transaction_hash);
+    if (it == transaction_indexes_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
 uint64_t Block::get_block_size() const {
    silkworm::rlp::Header rlp_head{true, 0};
    rlp_head.payload_length = silkworm::rlp::length(block.header);
@@ -17,10 +17,14 @@
 #ifndef SILKRPC_TYPES_BLOCK_HPP_
 #define SILKRPC_TYPES_BLOCK_HPP_
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 #include <intx/intx.hpp>
 
@@ -32,10 +36,24 @@ namespace silkrpc {
 struct Block : public silkworm::BlockWithHash {
     intx::uint256 total_difficulty{0};
     bool full_tx{false};
+    std::vector<evmc::bytes32> transaction_hashes;  // optional, computed on demand if empty
 
     uint64_t get_block_size() const;
 };
 
+//! Block with the hashes of its transactions computed once at construction and indexed by hash, so that
+//! cached blocks serve lookups by transaction hash without any further RLP encoding and Keccak hashing.
+struct IndexedBlock : public silkworm::BlockWithHash {
+    explicit IndexedBlock(silkworm::BlockWithHash block_with_hash);
+
+    std::optional<std::size_t> transaction_index(const evmc::bytes32& transaction_hash) const;
+
+    std::vector<evmc::bytes32> transaction_hashes;
+
+private:
+    std::unordered_map<evmc::bytes32, std::size_t> transaction_indexes_;
+};
+
 std::ostream& operator<<(std::ostream& out, const Block& b);
 
 class BlockNumberOrHash {
@@ -275,5 +275,26 @@ TEST_CASE("check size of EIP-2718 block from RLP", "[silkrpc][types][block]") {
     CHECK_NOTHROW(null_stream() << rpc_block_with_hash);
 }
 
+TEST_CASE("create indexed block", "[silkrpc][types][block]") {
+    SECTION("empty block") {
+        IndexedBlock indexed_block{silkworm::BlockWithHash{}};
+        CHECK(indexed_block.transaction_hashes.empty());
+        CHECK(!indexed_block.transaction_index(kZeroHash));
+    }
+
+    SECTION("block with transactions") {
+        silkworm::BlockWithHash block_with_hash;
+        block_with_hash.block.transactions.resize(2);
+        block_with_hash.block.transactions[0].nonce = 1;
+        block_with_hash.block.transactions[1].nonce = 2;
+        IndexedBlock indexed_block{block_with_hash};
+        REQUIRE(indexed_block.transaction_hashes.size() == 2);
+        CHECK(indexed_block.transaction_hashes[0] != indexed_block.transaction_hashes[1]);
+        CHECK(indexed_block.transaction_index(indexed_block.transaction_hashes[0]) == 0);
+        CHECK(indexed_block.transaction_index(indexed_block.transaction_hashes[1]) == 1);
+        CHECK(!indexed_block.transaction_index(kZeroHash));
+    }
+}
+
 } // namespace silkrpc
 
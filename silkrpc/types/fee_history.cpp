@@ -0,0 +1,29 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "fee_history.hpp"
+
+namespace silkrpc {
+
+std::ostream& operator<<(std::ostream& out, const FeeHistory& fee_history) {
+    out << "oldest_block: " << fee_history.oldest_block << " "
+        << "#base_fees: " << fee_history.base_fees.size() << " "
+        << "#gas_used_ratios: " << fee_history.gas_used_ratios.size() << " "
+        << "#rewards: " << fee_history.rewards.size() << " ";
+    return out;
+}
+
+} // namespace silkrpc
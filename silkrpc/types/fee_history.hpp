@@ -0,0 +1,39 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKRPC_TYPES_FEE_HISTORY_HPP_
+#define SILKRPC_TYPES_FEE_HISTORY_HPP_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <intx/intx.hpp>
+
+namespace silkrpc {
+
+struct FeeHistory {
+    uint64_t oldest_block{0};
+    std::vector<intx::uint256> base_fees;  // one more than the blocks: the last is the base fee of the block after the newest
+    std::vector<double> gas_used_ratios;
+    std::vector<std::vector<intx::uint256>> rewards;  // empty unless reward percentiles are requested
+};
+
+std::ostream& operator<<(std::ostream& out, const FeeHistory& fee_history);
+
+} // namespace silkrpc
+
+#endif  // SILKRPC_TYPES_FEE_HISTORY_HPP_
@@ -0,0 +1,38 @@
+/*
+   Copyright 2022 The Silkrpc Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "fee_history.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkrpc/common/log.hpp>
+
+namespace silkrpc {
+
+TEST_CASE("create empty fee history", "[silkrpc][types][fee_history]") {
+    FeeHistory fh{};
+    CHECK(fh.oldest_block == 0);
+    CHECK(fh.base_fees.empty());
+    CHECK(fh.gas_used_ratios.empty());
+    CHECK(fh.rewards.empty());
+}
+
+TEST_CASE("print empty fee history", "[silkrpc][types][fee_history]") {
+    FeeHistory fh{};
+    CHECK_NOTHROW(null_stream() << fh);
+}
+
+} // namespace silkrpc
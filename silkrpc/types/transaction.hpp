@@ -19,6 +19,7 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 #include <string>
@@ -30,6 +31,8 @@
 #include <silkworm/types/block.hpp>
 #include <silkworm/types/transaction.hpp>
 
+#include <silkrpc/types/block.hpp>
+
 namespace silkrpc {
 
 struct Transaction : public silkworm::Transaction {
@@ -47,7 +50,7 @@ struct Rlp  {
 };
 
 struct TransactionWithBlock {
-    silkworm::BlockWithHash block_with_hash;
+    std::shared_ptr<const IndexedBlock> block_with_hash;
     Transaction transaction;
 };
 